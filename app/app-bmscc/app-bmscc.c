@@ -21,6 +21,7 @@
 #include "stdint.h"
 #include <string.h>
 #include <stdio.h>
+#include <math.h>
 /* Stack include */
 #include "contiki.h"
 #include "sys/node-id.h"
@@ -35,13 +36,19 @@
 #include "sf_types.h"
 #include "sf_configMgmt.h"
 #include "sf_deviceMgmt.h"
+#include "sf_persistentDataStorage.h"
 #include "sf_callbackHandler.h"
+#include "sf_frameType.h"
 #include "sf_joinManager.h"
 #include "sf_app_api.h"
+#include "sf_app_measStore.h"
+#include "sf_app_packStats.h"
 #include "sf_absoluteTime.h"
 #include "sf_tsch.h"
 #include "sf_led.h"
+#if !CONTIKI_TARGET_NATIVE
 #include DeviceFamily_constructPath(driverlib/sys_ctrl.h)
+#endif
 
 /*=============================================================================
                                 MACROS
@@ -63,6 +70,122 @@
 #endif
 /* The maximum length of payload */
 #define SF_APP_PAYLOAD_LENGTH_MAX       (40U)
+/* Send the SC commands in the enhanced ACK of the measurement */
+#ifndef SF_APP_CONF_CMD_IN_ACK
+#define SF_APP_CMD_IN_ACK               0
+#else
+#define SF_APP_CMD_IN_ACK               SF_APP_CONF_CMD_IN_ACK
+#endif
+/* SC command: bypass the cell. The value is odd, so that the ACK status bit
+   of the enhanced ACK is set as well. */
+#define SF_APP_CMD_BYPASS               (25U)
+/* SC command: insert the cell */
+#define SF_APP_CMD_INSERT               (12U)
+/* The enhanced ACK carries no IE (TSCH_PACKET_CONF_EACK_WITH_ACK_NACK_TCORR),
+   only the lowest bit of the command reaches the SC as the ACK status bit of
+   the FCF. A set bit means bypass, any other command needs the downlink. */
+#define SF_APP_CMD_FITS_ACK(cmd)        (SF_APP_CMD_BYPASS == (cmd))
+/* Measurement value (ADC output) below which a cell is bypassed, 1.1V */
+#define SF_APP_BYPASS_THRESHOLD         (1100000)
+/* Coalescing keys of the downlinks, a queued downlink is replaced by a newer
+   one with the same key (TSCH_CONF_WITH_QUEUE_COALESCING) */
+#define SF_APP_COALESCE_KEY_CMD         (1U)
+#define SF_APP_COALESCE_KEY_REMOTE      (2U)
+#define SF_APP_COALESCE_KEY_MULTICAST   (3U)
+/* Number of retransmissions of a multicast downlink to the SCs that have
+   not confirmed it. Broadcasts are not acknowledged, a SC confirms the
+   multicast downlink by echoing its sequence number in a measurement, see
+   loc_confirmMulticast(). The SCs drop the retransmissions by the sequence
+   number. */
+#ifndef SF_APP_CONF_MULTICAST_RETRY_MAX
+#define SF_APP_MULTICAST_RETRY_MAX      (3U)
+#else
+#define SF_APP_MULTICAST_RETRY_MAX      SF_APP_CONF_MULTICAST_RETRY_MAX
+#endif
+/* Time the SCs have to confirm a transmission of a multicast downlink
+   before it is retransmitted, two slotframes (7.5 ms timeslots) */
+#ifndef SF_APP_CONF_MULTICAST_CONFIRM_PERIOD
+#define SF_APP_MULTICAST_CONFIRM_PERIOD ((2UL * APP_SLOTFRAME_SIZE * 75UL * \
+                                          CLOCK_SECOND) / 10000UL)
+#else
+#define SF_APP_MULTICAST_CONFIRM_PERIOD SF_APP_CONF_MULTICAST_CONFIRM_PERIOD
+#endif
+/* Length of the SC bitmap of a multicast downlink */
+#define SF_APP_MULTICAST_BITMAP_LEN     SF_FRAME_BITMAP_LEN(SF_CONF_SENSOR_CNT_MAX)
+/* Length of the multicast header: sequence number and SC bitmap */
+#define SF_APP_MULTICAST_HDR_LEN        (1U + SF_APP_MULTICAST_BITMAP_LEN)
+/* Maximum number of samples of a batched measurement. With several
+   quantities, SF_APP_MEAS_BATCH_FRAME_MAX allows fewer samples. */
+#ifndef SF_APP_CONF_MEAS_BATCH_SAMPLE_MAX
+#define SF_APP_MEAS_BATCH_SAMPLE_MAX    (16U)
+#else
+#define SF_APP_MEAS_BATCH_SAMPLE_MAX    SF_APP_CONF_MEAS_BATCH_SAMPLE_MAX
+#endif
+/* Length of the batched measurement header: uint32_t base timestamp,
+   quantities and sample count */
+#define SF_APP_MEAS_BATCH_HDR_LEN       (4U + 2U)
+/* Length of a batched sample: uint16_t timestamp delta and an int16_t value
+   per quantity */
+#define SF_APP_MEAS_BATCH_SAMPLE_LEN(valueCnt)  (2U + (valueCnt) * 2U)
+/* Maximum length of a batched measurement frame: the 127 byte PSDU without
+   the MAC header with PAN ID and short addresses (9 bytes), the FCS
+   (2 bytes) and, with security, the longest MIC (16 bytes) */
+#if WITH_SECURITY
+#define SF_APP_MEAS_BATCH_FRAME_MAX     (127U - 9U - 2U - 16U)
+#else
+#define SF_APP_MEAS_BATCH_FRAME_MAX     (127U - 9U - 2U)
+#endif
+#if (SF_FRAME_TYPE_LEN + SF_APP_MEAS_BATCH_HDR_LEN + \
+     SF_APP_MEAS_BATCH_SAMPLE_MAX * SF_APP_MEAS_BATCH_SAMPLE_LEN(1U)) > \
+    SF_APP_MEAS_BATCH_FRAME_MAX
+#error "SF_APP_CONF_MEAS_BATCH_SAMPLE_MAX samples do not fit into a frame"
+#endif
+/* Period of the pack statistics */
+#ifndef SF_APP_CONF_PACK_STATS_PERIOD
+#define SF_APP_PACK_STATS_PERIOD        (5 * CLOCK_SECOND)
+#else
+#define SF_APP_PACK_STATS_PERIOD        SF_APP_CONF_PACK_STATS_PERIOD
+#endif
+/* Deviation from the pack mean above which the voltage of a SC is an
+   outlier, in mV */
+#ifndef SF_APP_CONF_PACK_OUTLIER_VOLTAGE
+#define SF_APP_PACK_OUTLIER_VOLTAGE     (50)
+#else
+#define SF_APP_PACK_OUTLIER_VOLTAGE     SF_APP_CONF_PACK_OUTLIER_VOLTAGE
+#endif
+/* Deviation from the pack mean above which the temperature of a SC is an
+   outlier, in 0.1 degC */
+#ifndef SF_APP_CONF_PACK_OUTLIER_TEMPERATURE
+#define SF_APP_PACK_OUTLIER_TEMPERATURE (50)
+#else
+#define SF_APP_PACK_OUTLIER_TEMPERATURE SF_APP_CONF_PACK_OUTLIER_TEMPERATURE
+#endif
+/* Length of a SC bitmap */
+#define SF_APP_SC_BITMAP_LEN            SF_FRAME_BITMAP_LEN(SF_CONF_SENSOR_CNT_MAX)
+
+/* Logs a measured value as text. Cooja has no float support in printf. */
+#if !CONTIKI_TARGET_COOJA
+#define SF_APP_LOG_MEAS_VALUE(value)    LOG_INFO("Measurement value: %f \n", (value))
+#else
+#define SF_APP_LOG_MEAS_VALUE(value)    LOG_INFO("Measurement value: %d.%u \n", (int)(value), \
+                                                 (uint32_t)(1000*((value)-(int)(value))))
+#endif
+
+/* Binary log records, see LOG_CONF_BINARY. The module is
+   E_SF_LOG_BIN_MODULE_APP. */
+enum
+{
+  LOG_ID_APP_TX = 0x0901,              /*! "A downlink is transmitted to ; %A; %B" */
+  LOG_ID_APP_TX_OK = 0x0902,           /*! "Tx successful" */
+  LOG_ID_APP_TX_FAIL = 0x0903,         /*! "Tx failed" */
+  LOG_ID_APP_MEAS_RX = 0x0904,         /*! "Measurement received; device address; %A RSSI; %d;%B" */
+  LOG_ID_APP_MEAS_VALUE = 0x0905,      /*! "Measurement timestamp: %uh : %umin : %usec value: %f" */
+  LOG_ID_APP_MEAS_UNKNOWN = 0x0906,    /*! "!Device is not in sensor list. Reject measurement message." */
+  LOG_ID_APP_BATCH_RX = 0x0907,        /*! "Measurement batch received; device address; %A RSSI; %d;%B" */
+  LOG_ID_APP_BATCH_INVALID = 0x0908,   /*! "!Invalid measurement batch. Reject measurement message." */
+  LOG_ID_APP_BATCH_VALUE = 0x0909,     /*! "Measurement batch: %u samples, quantities 0x%02x, timestamp %u..%u" */
+  LOG_ID_APP_PACK_STATS = 0x090A,      /*! "Pack statistics of quantity %u: %u SCs, min %d max %d mean %f std dev %f, %u outliers; %B" */
+};
 
 /*=============================================================================
                               STRUCTS
@@ -79,6 +202,52 @@ typedef struct
   float value;
 } meas_t;
 
+/*! Command state of a SC */
+typedef struct
+{
+  /* Serial number of the SC the state belongs to */
+  uint32_t serialNr;
+  /* Command decided on the last measurement, 0 if none */
+  uint8_t desiredCmd;
+  /* Command the SC has received, 0 if none */
+  uint8_t ackedCmd;
+  /* Command of the downlink in the TSCH queue, 0 if none */
+  uint8_t txCmd;
+} cellCmd_t;
+
+/*! Multicast downlink */
+typedef struct
+{
+  /* Sequence number, SC bitmap of the last transmission and data */
+  uint8_t payload[SF_APP_PAYLOAD_LENGTH_MAX - SF_FRAME_TYPE_LEN];
+  /* Length of the payload */
+  uint8_t payloadLen;
+  /* Sequence number of the last multicast downlink */
+  uint8_t seqNr;
+  /* Sequence number of the last transmission put in the TSCH queue */
+  uint8_t txSeqNr;
+  /* Bitmap of the SCs that have not confirmed the multicast downlink, bit
+     n for sensor list index n */
+  uint8_t pending[SF_APP_MULTICAST_BITMAP_LEN];
+  /* Number of retransmissions left */
+  uint8_t retryCnt;
+  /* A transmission is in the TSCH queue */
+  bool queued;
+  /* The multicast downlink waits for the confirmations of the SCs */
+  bool active;
+} multicast_t;
+
+/*! Pack statistics of a quantity */
+typedef struct
+{
+  /* Statistics of the last computation */
+  sf_app_packStats_t stats;
+  /* Bitmap of the outlier SCs, bit n for sensor list index n */
+  uint8_t outliers[SF_APP_SC_BITMAP_LEN];
+  /* The statistics are valid */
+  bool valid;
+} packStats_t;
+
 /*=============================================================================
                                 GLOBAL VARIABLES
 =============================================================================*/
@@ -97,16 +266,525 @@ int connected_slaves = 0; //This gives the total number of connected slaves.
 float slave_data;
 uint16_t slave_addr_test;
 
+/* Command state of each SC, indexed like the sensor list. With
+   SF_APP_CMD_IN_ACK it is also updated from the ACK callback within the
+   timeslot. */
+static volatile cellCmd_t gAppCellCmd[SF_CONF_SENSOR_CNT_MAX];
+/* Callback handler context of the command downlink of each SC. */
+static sf_callbackHandlerCtxt_t gAppCellCallbackCtxt[SF_CONF_SENSOR_CNT_MAX];
+/* Multicast downlink and its callback handler context. */
+static multicast_t gAppMulticast;
+static sf_callbackHandlerCtxt_t gAppMulticastCallbackCtxt = {sf_app_output_callback,
+                                                             &gAppMulticast};
+/* Retransmission timer of the multicast downlink. */
+static struct ctimer gAppMulticastTimer;
+/* Scale from the fixed-point value of a quantity in a batched measurement
+   (voltage in mV, temperature in 0.1 degC, current in mA) to its unit in
+   the measurement store. The values of a sample are sent in the order of
+   E_APP_QUANTITY_t. */
+static const float gAppQuantityScale[E_APP_QUANTITY_CNT] = {1000.0f, 0.1f, 1.0f};
+/* Outlier limits of the pack statistics, in the fixed-point unit of the
+   batched measurement. Quantities with a limit of 0 are not analysed. */
+static const int16_t gAppPackOutlierLimit[E_APP_QUANTITY_CNT] =
+  {SF_APP_PACK_OUTLIER_VOLTAGE, SF_APP_PACK_OUTLIER_TEMPERATURE, 0};
+/* Pack statistics of each quantity. */
+static packStats_t gAppPackStats[E_APP_QUANTITY_CNT];
+
 /*=============================================================================
                                 PROCESSES
 =============================================================================*/
 PROCESS(bmscc_app_process, "The main BMS-CC process");
 AUTOSTART_PROCESSES(&bmscc_app_process);
 PROCESS(button_process, "Button process");
+PROCESS(pack_stats_process, "Pack statistics process");
+#if TSCH_WITH_SLOT_TIMING
+PROCESS(slot_timing_process, "Slot timing process");
+#endif
 
 /*=============================================================================
                                 LOCAL FUNCTIONS
 =============================================================================*/
+/*============================================================================*/
+/**
+ * \brief Returns the SC command for a measurement value.
+ */
+/*============================================================================*/
+static uint8_t loc_getCommand(float value)
+{
+  return (value < SF_APP_BYPASS_THRESHOLD) ? SF_APP_CMD_BYPASS :
+                                             SF_APP_CMD_INSERT;
+}/* loc_getCommand() */
+
+/*============================================================================*/
+/**
+ * \brief Returns the command state of a registered SC. The state is reset
+ *        if the list entry has been taken over by another SC.
+ */
+/*============================================================================*/
+static volatile cellCmd_t* loc_getCellCmd(const sf_sensor_t *pSensor)
+{
+  volatile cellCmd_t *pCell =
+    &gAppCellCmd[pSensor - sf_deviceMgmt_getSensorList()];
+
+  if(pCell->serialNr != pSensor->serialNr)
+  {
+    pCell->serialNr = pSensor->serialNr;
+    pCell->desiredCmd = 0;
+    pCell->ackedCmd = 0;
+    pCell->txCmd = 0;
+  }
+
+  return pCell;
+}/* loc_getCellCmd() */
+
+/*============================================================================*/
+/**
+ * \brief Builds a remote or multicast frame and schedules it for
+ *        transmission.
+ */
+/*============================================================================*/
+static E_SF_RETURN_t loc_txData(E_FRAME_TYPE_t frameType,
+                                uint8_t* pData, uint8_t dataLen,
+                                linkaddr_t* pDest,
+                                sf_callbackHandlerCtxt_t* pCtxt,
+                                uint16_t coalesceKey)
+{
+  /* Storage for the frame. */
+  uint8_t pFrameBuf[SF_APP_PAYLOAD_LENGTH_MAX] = {0x00};
+  /* Frame length */
+  uint8_t frameLen = 0;
+
+  if(NULL == pData || NULL == pDest)
+  {
+    return E_SF_ERROR_NPE;
+  }
+
+  if(dataLen > SF_APP_PAYLOAD_LENGTH_MAX - SF_FRAME_TYPE_LEN)
+  {
+    return E_SF_ERROR_INVALID_PARAM;
+  }
+
+  /* Build the frame */
+  sf_frameType_set(pFrameBuf, frameType);
+  frameLen += SF_FRAME_TYPE_LEN;
+
+  memcpy(pFrameBuf + frameLen, pData, dataLen);
+  frameLen += dataLen;
+
+  LOG_BIN_OR_TEXT(LOG_BIN_INFO_BYTES(LOG_ID_APP_TX, pFrameBuf, frameLen, LOG_BIN_LLADDR(pDest)),
+                  LOG_INFO("A downlink is transmitted to ; ");
+                  LOG_INFO_LLADDR(pDest);
+                  LOG_INFO_("; ");
+                  LOG_INFO_BYTES(pFrameBuf, frameLen);
+                  LOG_INFO_("\n"));
+
+  /* Schedule frame Tx */
+  return sf_tsch_sendCoalesced(pFrameBuf, frameLen, pDest, pCtxt, coalesceKey);
+}/* loc_txData() */
+
+/*============================================================================*/
+/**
+ * \brief Sends the desired command of a SC if the SC has not received it
+ *        yet and no downlink is queued for the SC. A failed downlink is
+ *        retried with the next measurement of the SC.
+ */
+/*============================================================================*/
+static void loc_updateCellCmd(sf_sensor_t *pSensor)
+{
+  volatile cellCmd_t *pCell = loc_getCellCmd(pSensor);
+  uint16_t sensorIndex = (uint16_t)(pCell - gAppCellCmd);
+  sf_callbackHandlerCtxt_t *pCtxt = &gAppCellCallbackCtxt[sensorIndex];
+  uint8_t pData[3];
+
+  if((0 == pCell->desiredCmd) || (pCell->desiredCmd == pCell->ackedCmd) ||
+     (0 != pCell->txCmd))
+  {
+    return;
+  }
+
+  // data format used for the BMS:
+  // pData[0] --> actual advertiseData used to toggle or hold the slave PWM
+  // pData[1] --> right now a dummy value 173 corresponds to 0xad.
+  // pData[2] --> indicates the slave address. this needs to be unique to each slave.
+  pData[0] = pCell->desiredCmd;
+  pData[1] = 173;
+  pData[2] = (uint8_t)pSensor->shortAddress.u16;
+
+  pCtxt->callbackFctPointer = sf_app_output_callback;
+  pCtxt->callbackFctDataPointer = (void*)pCell;
+  if(E_SF_SUCCESS == loc_txData(E_FRAME_TYPE_REMOTE, pData, sizeof(pData),
+                                &pSensor->shortAddress, pCtxt,
+                                SF_APP_COALESCE_KEY_CMD))
+  {
+    pCell->txCmd = pCell->desiredCmd;
+  }
+}/* loc_updateCellCmd() */
+
+/*============================================================================*/
+/**
+ * \brief Returns true if no SC is set in a SC bitmap.
+ */
+/*============================================================================*/
+static bool loc_isBitmapEmpty(const uint8_t *pBitmap)
+{
+  for(uint8_t i = 0; i < SF_APP_SC_BITMAP_LEN; i++)
+  {
+    if(0 != pBitmap[i])
+    {
+      return false;
+    }
+  }
+
+  return true;
+}/* loc_isBitmapEmpty() */
+
+/*============================================================================*/
+/**
+ * \brief Ends the multicast downlink and reports the SCs that have not
+ *        confirmed it.
+ */
+/*============================================================================*/
+static void loc_finishMulticast(void)
+{
+  gAppMulticast.active = false;
+  ctimer_stop(&gAppMulticastTimer);
+  sf_app_multicastDone(gAppMulticast.pending);
+}/* loc_finishMulticast() */
+
+/*============================================================================*/
+/**
+ * \brief Schedules a transmission of the multicast downlink in the
+ *        broadcast slot, addressed to the SCs that have not confirmed it.
+ */
+/*============================================================================*/
+static void loc_sendMulticast(void)
+{
+  /* Broadcast destination */
+  linkaddr_t dest = linkaddr_null;
+
+  /* A retransmission only addresses the pending SCs */
+  memcpy(gAppMulticast.payload + 1U, gAppMulticast.pending,
+         SF_APP_MULTICAST_BITMAP_LEN);
+
+  if(E_SF_SUCCESS == loc_txData(E_FRAME_TYPE_MULTICAST, gAppMulticast.payload,
+                                gAppMulticast.payloadLen, &dest,
+                                &gAppMulticastCallbackCtxt,
+                                SF_APP_COALESCE_KEY_MULTICAST))
+  {
+    gAppMulticast.queued = true;
+    gAppMulticast.txSeqNr = gAppMulticast.seqNr;
+  }
+}/* loc_sendMulticast() */
+
+/*============================================================================*/
+/**
+ * \brief Retransmits the multicast downlink to the SCs that have not
+ *        confirmed it within SF_APP_MULTICAST_CONFIRM_PERIOD. The multicast
+ *        downlink ends once all SCs have confirmed it or after
+ *        SF_APP_MULTICAST_RETRY_MAX retransmissions.
+ */
+/*============================================================================*/
+static void loc_retryMulticast(void *ptr)
+{
+  (void)ptr;
+
+  if(!gAppMulticast.active)
+  {
+    return;
+  }
+
+  if(loc_isBitmapEmpty(gAppMulticast.pending) ||
+     0 == gAppMulticast.retryCnt)
+  {
+    loc_finishMulticast();
+    return;
+  }
+
+  gAppMulticast.retryCnt--;
+  loc_sendMulticast();
+}/* loc_retryMulticast() */
+
+/*============================================================================*/
+/**
+ * \brief Clears the pending bit of a SC whose uplink confirms the multicast
+ *        downlink. A SC appends the sequence number of the last multicast
+ *        downlink it received to its measurement frames, behind frameLen
+ *        bytes. A frame without it confirms nothing.
+ */
+/*============================================================================*/
+static void loc_confirmMulticast(const sf_sensor_t *pSensor,
+                                 const uint8_t *pBuf, uint16_t length,
+                                 uint16_t frameLen)
+{
+  uint16_t sensorIndex = (uint16_t)(pSensor - sf_deviceMgmt_getSensorList());
+
+  if(!gAppMulticast.active || 0 == frameLen || length <= frameLen ||
+     pBuf[frameLen] != gAppMulticast.seqNr)
+  {
+    return;
+  }
+
+  gAppMulticast.pending[sensorIndex / 8U] &= (uint8_t)~(1U << (sensorIndex % 8U));
+
+  /* A queued transmission ends the multicast downlink from the output
+     callback */
+  if(!gAppMulticast.queued && loc_isBitmapEmpty(gAppMulticast.pending))
+  {
+    loc_finishMulticast();
+  }
+}/* loc_confirmMulticast() */
+
+/*============================================================================*/
+/**
+ * \brief Returns the length of a batched measurement frame with the given
+ *        header, 0 if the header is invalid.
+ */
+/*============================================================================*/
+static uint16_t loc_getMeasBatchLen(const uint8_t *pBuf, uint16_t length)
+{
+  uint8_t quantities;
+  uint8_t sampleCnt;
+  uint8_t valueCnt = 0;
+
+  if(length < SF_FRAME_TYPE_LEN + SF_APP_MEAS_BATCH_HDR_LEN)
+  {
+    return 0;
+  }
+
+  quantities = pBuf[SF_FRAME_TYPE_LEN + sizeof(uint32_t)];
+  sampleCnt = pBuf[SF_FRAME_TYPE_LEN + sizeof(uint32_t) + 1U];
+  if(0 == quantities || 0 != (quantities >> E_APP_QUANTITY_CNT) ||
+     0 == sampleCnt || sampleCnt > SF_APP_MEAS_BATCH_SAMPLE_MAX)
+  {
+    return 0;
+  }
+
+  for(uint8_t q = 0; q < E_APP_QUANTITY_CNT; q++)
+  {
+    valueCnt += (quantities >> q) & 1U;
+  }
+
+  /* The more quantities a sample holds, the fewer samples fit in a frame */
+  if(sampleCnt > (SF_APP_MEAS_BATCH_FRAME_MAX - SF_FRAME_TYPE_LEN -
+                  SF_APP_MEAS_BATCH_HDR_LEN) /
+                 SF_APP_MEAS_BATCH_SAMPLE_LEN(valueCnt))
+  {
+    return 0;
+  }
+
+  return SF_FRAME_TYPE_LEN + SF_APP_MEAS_BATCH_HDR_LEN +
+         sampleCnt * SF_APP_MEAS_BATCH_SAMPLE_LEN(valueCnt);
+}/* loc_getMeasBatchLen() */
+
+#if SF_APP_CMD_IN_ACK
+/*============================================================================*/
+/**
+ * \brief Returns the last voltage sample of a batched measurement frame.
+ *        Called within the timeslot, the frame is not decoded.
+ */
+/*============================================================================*/
+static bool loc_getMeasBatchVoltage(const uint8_t *pBuf, uint16_t length,
+                                    float *pValue)
+{
+  uint16_t frameLen = loc_getMeasBatchLen(pBuf, length);
+  uint16_t sampleLen;
+  int16_t raw;
+
+  if(0 == frameLen || frameLen > length ||
+     0 == (pBuf[SF_FRAME_TYPE_LEN + sizeof(uint32_t)] &
+           (1U << E_APP_QUANTITY_VOLTAGE)))
+  {
+    return false;
+  }
+
+  /* The voltage is the first value of the last sample */
+  sampleLen = (frameLen - SF_FRAME_TYPE_LEN - SF_APP_MEAS_BATCH_HDR_LEN) /
+              pBuf[SF_FRAME_TYPE_LEN + sizeof(uint32_t) + 1U];
+  memcpy(&raw, pBuf + frameLen - sampleLen + sizeof(uint16_t), sizeof(raw));
+  *pValue = raw * gAppQuantityScale[E_APP_QUANTITY_VOLTAGE];
+
+  return true;
+}/* loc_getMeasBatchVoltage() */
+#endif
+
+/*============================================================================*/
+/**
+ * \brief Decodes a batched measurement frame into the measurement store.
+ *        The timestamps are sent as a base timestamp and a delta to the
+ *        previous sample per sample.
+ */
+/*============================================================================*/
+static E_SF_RETURN_t loc_parseMeasBatch(const sf_sensor_t *pSensor,
+                                        const uint8_t *pBuf, uint16_t length,
+                                        uint32_t *pFirst, uint32_t *pLast)
+{
+  uint16_t frameLen = loc_getMeasBatchLen(pBuf, length);
+  const uint8_t *pSample = pBuf + SF_FRAME_TYPE_LEN + SF_APP_MEAS_BATCH_HDR_LEN;
+  float values[E_APP_QUANTITY_CNT];
+  uint32_t timeStamp;
+  uint8_t quantities;
+  uint8_t sampleCnt;
+  uint16_t delta;
+  int16_t raw;
+
+  if(0 == frameLen || frameLen > length)
+  {
+    return E_SF_ERROR_INVALID_PARAM;
+  }
+
+  /* Batched measurement frame structure
+     frame type | base timestamp | quantities | sample count | samples
+     -----------|----------------|------------|--------------|----------------
+       uint8_t  | uint32_t       | uint8_t    | uint8_t      | sample count x
+                                                             | uint16_t delta,
+                                                             | int16_t value
+                                                             | per quantity */
+  memcpy(&timeStamp, pBuf + SF_FRAME_TYPE_LEN, sizeof(timeStamp));
+  quantities = pBuf[SF_FRAME_TYPE_LEN + sizeof(uint32_t)];
+  sampleCnt = pBuf[SF_FRAME_TYPE_LEN + sizeof(uint32_t) + 1U];
+
+  for(uint8_t i = 0; i < sampleCnt; i++)
+  {
+    memcpy(&delta, pSample, sizeof(delta));
+    pSample += sizeof(delta);
+    timeStamp += delta;
+    if(0 == i)
+    {
+      *pFirst = timeStamp;
+    }
+
+    for(uint8_t q = 0; q < E_APP_QUANTITY_CNT; q++)
+    {
+      values[q] = 0.0f;
+      if(quantities & (1U << q))
+      {
+        memcpy(&raw, pSample, sizeof(raw));
+        pSample += sizeof(raw);
+        values[q] = raw * gAppQuantityScale[q];
+      }
+    }
+    sf_app_measStore_append(pSensor, timeStamp, quantities, values);
+  }
+  *pLast = timeStamp;
+
+  return E_SF_SUCCESS;
+}/* loc_parseMeasBatch() */
+
+/*============================================================================*/
+/**
+ * \brief Decides the command of a SC on its measured voltage and sends it
+ *        if needed.
+ */
+/*============================================================================*/
+static void loc_handleCellVoltage(sf_sensor_t *pSensor, linkaddr_t* pSrc,
+                                  float value)
+{
+  slave_data = value;
+  slave_addr_test = pSrc->u16;
+
+  // some logic to send data to slave based on what we receive
+  //-----------------------------------------------------------
+  // when the voltage of a slave < threshold, we set choose_sc to the address of that sc.
+  // for eg. if 1st sc has low voltage, we make advertiseData = 25 and choose_sc = slave_addr_test - 1.
+  // we do slave_addr_test - 1 because there is an offset of 1. choose_sc needs to start from 0 but first sc in slave_addr_test starts from 1.
+
+  // once the voltage goes back up, we reduce the advertiseData. this needs to be resent to stop the toggle.
+  // TBD: check if we need to repeat choose_sc here as well. I think yes.
+
+
+  // to initiate bypass if the voltage goes low
+  advertiseData = loc_getCommand(slave_data);
+  if(SF_APP_CMD_BYPASS == advertiseData)
+  {
+      choose_sc = slave_addr_test-1;
+  }
+
+
+  // a downlink is only sent when the command of the SC changes or the SC
+  // has not received it yet, see loc_updateCellCmd().
+  if(NULL != pSensor)
+  {
+#if SF_APP_CMD_IN_ACK
+    /* The command for this SC was decided on the enhanced ACK of the
+       measurement, see sf_app_ackCommand(). */
+    if(0 == packetbuf_attr(PACKETBUF_ATTR_MAC_ACK))
+#endif
+    {
+      loc_getCellCmd(pSensor)->desiredCmd = (uint8_t)advertiseData;
+    }
+    loc_updateCellCmd(pSensor);
+  }
+
+  // else we do not do anything, so the slave will be inserted.
+}/* loc_handleCellVoltage() */
+
+/*============================================================================*/
+/**
+ * \brief Computes the pack statistics of a quantity over the latest value
+ *        of all SCs.
+ */
+/*============================================================================*/
+static void loc_updatePackStats(E_APP_QUANTITY_t quantity)
+{
+  /* Latest values by sensor list index, compacted to fixed point */
+  static float values[SF_CONF_SENSOR_CNT_MAX];
+  static int16_t fixedValues[SF_CONF_SENSOR_CNT_MAX];
+  uint8_t valueBitmap[SF_APP_SC_BITMAP_LEN];
+  uint8_t outliers[SF_APP_SC_BITMAP_LEN];
+  packStats_t *pPackStats = &gAppPackStats[quantity];
+  float value;
+  uint16_t cnt = 0;
+
+  sf_app_measStore_getSnapshot(quantity, UINT32_MAX, values, valueBitmap);
+  for(uint16_t index = 0; index < SF_CONF_SENSOR_CNT_MAX; index++)
+  {
+    if(valueBitmap[index / 8U] & (1U << (index % 8U)))
+    {
+      value = roundf(values[index] / gAppQuantityScale[quantity]);
+      value = (value > INT16_MAX) ? INT16_MAX : value;
+      value = (value < INT16_MIN) ? INT16_MIN : value;
+      fixedValues[cnt++] = (int16_t)value;
+    }
+  }
+
+  pPackStats->valid = (E_SF_SUCCESS == sf_app_packStats_compute(
+                         fixedValues, cnt, gAppPackOutlierLimit[quantity],
+                         outliers, &pPackStats->stats));
+  if(!pPackStats->valid)
+  {
+    return;
+  }
+
+  /* The outliers are indexed like the compacted values */
+  memset(pPackStats->outliers, 0, sizeof(pPackStats->outliers));
+  cnt = 0;
+  for(uint16_t index = 0; index < SF_CONF_SENSOR_CNT_MAX; index++)
+  {
+    if(valueBitmap[index / 8U] & (1U << (index % 8U)))
+    {
+      if(outliers[cnt / 8U] & (1U << (cnt % 8U)))
+      {
+        pPackStats->outliers[index / 8U] |= (uint8_t)(1U << (index % 8U));
+      }
+      cnt++;
+    }
+  }
+
+  LOG_BIN_OR_TEXT(LOG_BIN_INFO_BYTES(LOG_ID_APP_PACK_STATS, pPackStats->outliers,
+                                     sizeof(pPackStats->outliers), quantity,
+                                     pPackStats->stats.cnt, pPackStats->stats.min,
+                                     pPackStats->stats.max,
+                                     LOG_BIN_FLOAT(pPackStats->stats.mean),
+                                     LOG_BIN_FLOAT(pPackStats->stats.stdDev),
+                                     pPackStats->stats.outlierCnt),
+                  LOG_INFO("Pack statistics of quantity %u: %u SCs, min %d max %d mean %d std dev %d, %u outliers; ",
+                           quantity, pPackStats->stats.cnt, pPackStats->stats.min,
+                           pPackStats->stats.max, (int)pPackStats->stats.mean,
+                           (int)pPackStats->stats.stdDev, pPackStats->stats.outlierCnt);
+                  LOG_INFO_BYTES(pPackStats->outliers, sizeof(pPackStats->outliers));
+                  LOG_INFO_("\n"));
+}/* loc_updatePackStats() */
+
 /*============================================================================*/
 /**
  * \brief Check is a valid sensor list stored in the internal flash.
@@ -118,10 +796,12 @@ static void load_registered_sensors(void)
   if(E_SF_SUCCESS == sf_deviceMgmt_readSensorList() &&
      0 != sf_deviceMgmt_getRegisteredDeviceCount())
   {
+    linkaddr_t addrList[SF_CONF_SENSOR_CNT_MAX];
+    uint8_t addrCnt = 0;
+
     LOG_INFO("Valid sensor list is found in the flash \n");
 
-    /* Add data slot of all registered SCs and set last
-      seen timestamp to the current time for each */
+    /* Collect all registered SCs */
     for(uint8_t i = 0; i < SF_CONF_SENSOR_CNT_MAX; i++)
     {
       sf_sensor_t *pSensor = sf_deviceMgmt_getDeviceByIndex(i);
@@ -130,11 +810,16 @@ static void load_registered_sensors(void)
         if(0 != pSensor->serialNr &&
             !linkaddr_cmp(&pSensor->shortAddress, &linkaddr_null))
         {
-          /* Add device data slots for regular communication */
-          sf_tsch_addDataSlots(&pSensor->shortAddress);
+          linkaddr_copy(&addrList[addrCnt++], &pSensor->shortAddress);
         }
       }
     }
+
+    /* Add device data slots for regular communication in one go */
+    if(E_SF_SUCCESS != sf_tsch_addDataSlotsBulk(addrList, addrCnt))
+    {
+      LOG_ERR("Failed to add the data slots of the registered sensors\n");
+    }
   }
   else
   {
@@ -193,6 +878,9 @@ PROCESS_THREAD(button_process, ev, data)
         if(pressDuration > 10)
         {
           /* Only for testing */
+          linkaddr_t addrList[SF_CONF_SENSOR_CNT_MAX];
+          uint8_t addrCnt = 0;
+
           LOG_INFO("Remove all registered sensors from the sensor list \n");
           for(uint8_t i = 0; i < SF_CONF_SENSOR_CNT_MAX; i++)
           {
@@ -202,53 +890,73 @@ PROCESS_THREAD(button_process, ev, data)
               if(0 != pSensor->serialNr &&
                   !linkaddr_cmp(&pSensor->shortAddress, &linkaddr_null))
               {
-                sf_tsch_deleteDataSlots(&pSensor->shortAddress);
-                sf_deviceMgmt_removeDevice(pSensor->shortAddress);
+                linkaddr_copy(&addrList[addrCnt++], &pSensor->shortAddress);
               }
             }
           }
+
+          /* Delete the data slots in one go, a device whose slots are
+             still scheduled stays registered */
+          if(E_SF_SUCCESS != sf_tsch_deleteDataSlotsBulk(addrList, addrCnt))
+          {
+            LOG_ERR("Failed to delete the data slots of the registered sensors\n");
+            for(uint8_t i = 0; i < addrCnt; i++)
+            {
+              if(E_SF_SUCCESS == sf_tsch_deleteDataSlots(&addrList[i]))
+              {
+                sf_deviceMgmt_removeDevice(addrList[i]);
+              }
+              else
+              {
+                LOG_ERR("Failed to delete the data slots of sensor ");
+                LOG_ERR_LLADDR(&addrList[i]);
+                LOG_ERR_("\n");
+              }
+            }
+          }
+          else
+          {
+            for(uint8_t i = 0; i < addrCnt; i++)
+            {
+              sf_deviceMgmt_removeDevice(addrList[i]);
+            }
+          }
         }
         else if (pressDuration > 3U)
         {
           /* Only for testing */
-          /* Send dummy downlink to all connected SCs */
-//          for(uint8_t i = 0; i < SF_CONF_SENSOR_CNT_MAX; i++)
-//          {
-//            sf_sensor_t *pSensor = sf_deviceMgmt_getDeviceByIndex(i);
-//            if(NULL != pSensor)
-//            {
-//              if(0 != pSensor->serialNr &&
-//                  !linkaddr_cmp(&pSensor->shortAddress, &linkaddr_null))
-//              {
-//                sf_app_txData(pData, sizeof(pData), &pSensor->shortAddress);
-//              }
-//            }
-//          }
-          // Original code above - sends to all slaves
+          uint8_t pBitmap[SF_APP_MULTICAST_BITMAP_LEN] = {0};
+          bool addressed = false;
 
-          sf_sensor_t *pSensor = sf_deviceMgmt_getDeviceByIndex(choose_sc);
-          if(NULL != pSensor)
+          /* Send the dummy downlink to all registered SCs at once in the
+             broadcast slot */
+          for(uint8_t i = 0; i < SF_CONF_SENSOR_CNT_MAX; i++)
           {
-            if(0 != pSensor->serialNr &&
-                !linkaddr_cmp(&pSensor->shortAddress, &linkaddr_null))
+            sf_sensor_t *pSensor = sf_deviceMgmt_getDeviceByIndex(i);
+            if(NULL != pSensor)
             {
-              sf_app_txData(pData, sizeof(pData), &pSensor->shortAddress);
+              if(0 != pSensor->serialNr &&
+                  !linkaddr_cmp(&pSensor->shortAddress, &linkaddr_null))
+              {
+                pBitmap[i / 8] |= (uint8_t)(1U << (i % 8));
+                addressed = true;
+              }
             }
           }
 
-
-
-
-
-
+          if(addressed &&
+             E_SF_SUCCESS != sf_app_txDataMulti(pData, sizeof(pData), pBitmap))
+          {
+            LOG_ERR("Failed to send the multicast downlink\n");
+          }
         }
-
-
         else if(pressDuration <= 3U)
         {
           /* Open manual join window */
           sf_joinManger_openManualWindow();
+#if !CONTIKI_TARGET_NATIVE
           GPIO_writeDio(IOID_12,0);
+#endif
           //advertiseData++; // old code just incrementing. if this number >20, the slave would bypass.
 
           //we will now change this advertiseData based on the value sent by slave itself.
@@ -256,7 +964,7 @@ PROCESS_THREAD(button_process, ev, data)
 
 
           //choose_sc++; //just updating the next slave to bypass
-          connected_slaves = (int)sf_deviceMgmt_getRegisteredDeviceCount;
+          connected_slaves = (int)sf_deviceMgmt_getRegisteredDeviceCount();
 
 
           //Get the serial numbers of all the slaves that are connected to BMS.
@@ -274,6 +982,57 @@ PROCESS_THREAD(button_process, ev, data)
   PROCESS_END();
 } /* button_process() */
 
+/*------------------------------------------------------------------------------
+  pack_stats_process()
+------------------------------------------------------------------------------*/
+PROCESS_THREAD(pack_stats_process, ev, data)
+{
+  static struct etimer statsTimer;
+
+  PROCESS_BEGIN();
+
+  while(1)
+  {
+    etimer_set(&statsTimer, SF_APP_PACK_STATS_PERIOD);
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&statsTimer));
+
+    for(uint8_t q = 0; q < E_APP_QUANTITY_CNT; q++)
+    {
+      if(0 != gAppPackOutlierLimit[q])
+      {
+        loc_updatePackStats((E_APP_QUANTITY_t)q);
+      }
+    }
+  }
+
+  PROCESS_END();
+} /* pack_stats_process() */
+
+#if TSCH_WITH_SLOT_TIMING
+/*------------------------------------------------------------------------------
+  slot_timing_process()
+------------------------------------------------------------------------------*/
+PROCESS_THREAD(slot_timing_process, ev, data)
+{
+  static struct etimer printTimer;
+
+  PROCESS_BEGIN();
+
+  while(1)
+  {
+    etimer_set(&printTimer, SF_APP_SLOT_TIMING_PRINT_PERIOD);
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&printTimer));
+
+    /* Dump the slot timing recorded by TSCH over the UART, then start
+       over so that each report covers one period. */
+    tsch_slot_timing_print();
+    tsch_slot_timing_reset();
+  }
+
+  PROCESS_END();
+} /* slot_timing_process() */
+#endif
+
 /*------------------------------------------------------------------------------
   bmscc_app_process()
 ------------------------------------------------------------------------------*/
@@ -292,6 +1051,7 @@ PROCESS_THREAD(bmscc_app_process, ev, data)
   LOG_INFO("- 802.15.4 PANID: 0x%04x\n", IEEE802154_PANID);
 
   /* Get reboot source of last restart. */
+#if !CONTIKI_TARGET_NATIVE
     uint32_t resetSource = SysCtrlResetSourceGet();
     if(RSTSRC_WAKEUP_FROM_SHUTDOWN == resetSource)
     {
@@ -321,6 +1081,7 @@ PROCESS_THREAD(bmscc_app_process, ev, data)
       /* Reboot source is unknown. */
       LOG_ERR("Reboot unk\n");
     }
+#endif
 
   /* Select 2.4GHz radio frequency region */
   if(false == sf_rf_selectRegion(E_SF_RF_REGION_GLOB2G4))
@@ -331,6 +1092,12 @@ PROCESS_THREAD(bmscc_app_process, ev, data)
   /* Set Tx power to to Max */
   sf_tsch_setTxPowerMax();
 
+  /* Register the handlers of the application frames */
+  sf_callbackHandler_registerInput(E_FRAME_TYPE_MEASUREMENT,
+                                   sf_app_handleMeasurement);
+  sf_callbackHandler_registerInput(E_FRAME_TYPE_MEASUREMENT_BATCH,
+                                   sf_app_handleMeasurementBatch);
+
   /* Initialize TSCH */
   sf_tsch_init();
 
@@ -340,6 +1107,11 @@ PROCESS_THREAD(bmscc_app_process, ev, data)
   /* Start button handle process. */
   process_start(&button_process, NULL);
 
+#if TSCH_WITH_SLOT_TIMING
+  /* Start periodic slot timing dump. */
+  process_start(&slot_timing_process, NULL);
+#endif
+
   /* Read device configuration. */
   if(E_SF_SUCCESS == sf_configMgmt_readConfig())
   {
@@ -360,6 +1132,9 @@ PROCESS_THREAD(bmscc_app_process, ev, data)
     {
       LOG_INFO("The default configurations are set \n");
     }
+
+    /* TSCH is not running yet, store the configuration right away. */
+    sf_persistentDataStorage_flush();
   }
 
   /* Set the configured link address, if valid, into the TSCH stack */
@@ -410,11 +1185,17 @@ PROCESS_THREAD(bmscc_app_process, ev, data)
     PROCESS_YIELD_UNTIL(0 != sf_tsch_getPanId());
   }
 
+  /* Clear the stored measurements */
+  sf_app_measStore_init();
+
   /* Check if a valid sensor list is stored in the flash.
      If so, configure TSCH to open the communication to the
      registered smart cells */
   load_registered_sensors();
 
+  /* Start the periodic pack statistics */
+  process_start(&pack_stats_process, NULL);
+
   /* Start absolute time incrementing */
   sf_absoluteTime_startTimer();
 
@@ -449,52 +1230,243 @@ PROCESS_THREAD(bmscc_app_process, ev, data)
 =============================================================================*/
 E_SF_RETURN_t sf_app_txData(uint8_t* pData, uint8_t dataLen, linkaddr_t* pDest)
 {
-  /* Storage for the frame. */
-  uint8_t pFrameBuf[SF_APP_PAYLOAD_LENGTH_MAX] = {0x00};
-  /* Frame length */
-  uint8_t frameLen = 0;
-  /* Return value */
-  E_SF_RETURN_t retVal = E_SF_ERROR;
+  /* A newer downlink to the same SC replaces a queued one */
+  return loc_txData(E_FRAME_TYPE_REMOTE, pData, dataLen, pDest,
+                    &gAppCallbackHandlerCtxt,
+                    SF_APP_COALESCE_KEY_REMOTE);
+}
 
-  if(NULL == pData || NULL == pDest)
+/*------------------------------------------------------------------------------
+  sf_app_txDataMulti()
+------------------------------------------------------------------------------*/
+E_SF_RETURN_t sf_app_txDataMulti(uint8_t* pData, uint8_t dataLen,
+                                 const uint8_t* pBitmap)
+{
+  /* SCs the multicast downlink is addressed to */
+  uint8_t pSensorBitmap[SF_APP_MULTICAST_BITMAP_LEN] = {0};
+
+  if(NULL == pData)
   {
     return E_SF_ERROR_NPE;
   }
 
-  /* Build the frame */
-  sf_frameType_set(pFrameBuf, E_FRAME_TYPE_REMOTE);
-  frameLen += SF_FRAME_TYPE_LEN;
+  if(dataLen > sizeof(gAppMulticast.payload) - SF_APP_MULTICAST_HDR_LEN)
+  {
+    return E_SF_ERROR_INVALID_PARAM;
+  }
 
-  memcpy(pFrameBuf + frameLen, pData, dataLen);
-  frameLen += dataLen;
+  /* Multicast frame structure
+     frame type | sequence number | SC bitmap                   | data
+     -----------|-----------------|-----------------------------|--------
+       uint8_t  | uint8_t         | SF_APP_MULTICAST_BITMAP_LEN | dataLen */
+  if(NULL != pBitmap)
+  {
+    memcpy(pSensorBitmap, pBitmap, SF_APP_MULTICAST_BITMAP_LEN);
+  }
+  else
+  {
+    /* All registered SCs, bit n is the SC at index n of the sensor list */
+    for(uint16_t i = 0; i < SF_CONF_SENSOR_CNT_MAX; i++)
+    {
+      sf_sensor_t *pSensor = sf_deviceMgmt_getDeviceByIndex(i);
+      if(NULL != pSensor && 0 != pSensor->serialNr &&
+         !linkaddr_cmp(&pSensor->shortAddress, &linkaddr_null))
+      {
+        pSensorBitmap[i / 8U] |= (uint8_t)(1U << (i % 8U));
+      }
+    }
+  }
 
-  LOG_INFO("A downlink is transmitted to ; ");
-  LOG_INFO_LLADDR(pDest);
-  LOG_INFO_("; ");
-  LOG_INFO_BYTES(pFrameBuf, frameLen);
-  LOG_INFO_("\n");
+  if(loc_isBitmapEmpty(pSensorBitmap))
+  {
+    return E_SF_ERROR_INVALID_PARAM;
+  }
 
-  /* Schedule frame Tx */
-  retVal = sf_tsch_send(pFrameBuf, frameLen, pDest, &gAppCallbackHandlerCtxt);
+  /* The new downlink replaces the one waiting for confirmations, its
+     unconfirmed SCs are reported */
+  if(gAppMulticast.active)
+  {
+    loc_finishMulticast();
+  }
 
-  return retVal;
-}
+  memcpy(gAppMulticast.pending, pSensorBitmap, SF_APP_MULTICAST_BITMAP_LEN);
+  gAppMulticast.payload[0] = ++gAppMulticast.seqNr;
+  memcpy(gAppMulticast.payload + SF_APP_MULTICAST_HDR_LEN, pData, dataLen);
+  gAppMulticast.payloadLen = SF_APP_MULTICAST_HDR_LEN + dataLen;
+  gAppMulticast.retryCnt = SF_APP_MULTICAST_RETRY_MAX;
+  gAppMulticast.active = true;
+
+  /* A queued transmission is replaced by the new downlink. Without
+     coalescing, the new downlink is sent once the queued one is done. */
+  if(!gAppMulticast.queued || TSCH_WITH_QUEUE_COALESCING)
+  {
+    loc_sendMulticast();
+  }
+
+  return E_SF_SUCCESS;
+}/* sf_app_txDataMulti() */
+
+/*------------------------------------------------------------------------------
+  sf_app_getPackStats()
+------------------------------------------------------------------------------*/
+E_SF_RETURN_t sf_app_getPackStats(E_APP_QUANTITY_t quantity,
+                                  sf_app_packStats_t *pStats,
+                                  uint8_t *pOutliers)
+{
+  if(NULL == pStats)
+  {
+    return E_SF_ERROR_NPE;
+  }
+
+  if(quantity >= E_APP_QUANTITY_CNT)
+  {
+    return E_SF_ERROR_INVALID_PARAM;
+  }
+
+  if(!gAppPackStats[quantity].valid)
+  {
+    return E_SF_ERROR;
+  }
+
+  *pStats = gAppPackStats[quantity].stats;
+  if(NULL != pOutliers)
+  {
+    memcpy(pOutliers, gAppPackStats[quantity].outliers, SF_APP_SC_BITMAP_LEN);
+  }
+
+  return E_SF_SUCCESS;
+}/* sf_app_getPackStats() */
+
+#if SF_APP_CMD_IN_ACK
+/*------------------------------------------------------------------------------
+  sf_app_ackCommand()
+------------------------------------------------------------------------------*/
+uint8_t sf_app_ackCommand(const linkaddr_t *pSrc, const void *pData,
+                          uint16_t length)
+{
+  /* Pointer to sensor element. */
+  sf_sensor_t *pSensor = NULL;
+  /* Command state of the sensor */
+  volatile cellCmd_t *pCell = NULL;
+  /* Storage for the received measurement. */
+  meas_t meas;
+  E_FRAME_TYPE_t frameType = E_FRAME_TYPE_UNDEFINED;
+
+  if(NULL == pSrc || NULL == pData)
+  {
+    return SF_APP_CMD_INSERT;
+  }
+
+  pSensor = sf_deviceMgmt_getDevice(*pSrc);
+  if(NULL == pSensor)
+  {
+    /* Joining SC, nothing pending */
+    return SF_APP_CMD_INSERT;
+  }
+  pCell = loc_getCellCmd(pSensor);
+
+  if(length >= SF_FRAME_TYPE_LEN + sizeof(meas_t) &&
+     E_SF_SUCCESS == sf_frameType_get(pData, &frameType) &&
+     E_FRAME_TYPE_MEASUREMENT == frameType)
+  {
+    /* Decide on the measurement this ACK acknowledges. The SC has received
+       the command once its transmission succeeded. */
+    memcpy(&meas, (const uint8_t*)pData + SF_FRAME_TYPE_LEN, sizeof(meas_t));
+    pCell->desiredCmd = loc_getCommand(meas.value);
+  }
+  else if(E_FRAME_TYPE_MEASUREMENT_BATCH == frameType &&
+          loc_getMeasBatchVoltage(pData, length, &meas.value))
+  {
+    /* Decide on the last voltage sample of the batch */
+    pCell->desiredCmd = loc_getCommand(meas.value);
+  }
+
+  /* Only a command that fits in the ACK status bit is delivered with this
+     ACK. Any other command stays pending for the downlink, see
+     loc_updateCellCmd(). */
+  if(SF_APP_CMD_FITS_ACK(pCell->desiredCmd))
+  {
+    pCell->ackedCmd = pCell->desiredCmd;
+  }
+
+  /* A return value of 0 would drop the frame. */
+  return (0 != pCell->desiredCmd) ? pCell->desiredCmd : SF_APP_CMD_INSERT;
+}/* sf_app_ackCommand() */
+#endif
 
 /*------------------------------------------------------------------------------
   sf_output_callback_handler()
 ------------------------------------------------------------------------------*/
 __attribute__((weak)) void sf_app_output_callback(void *ptr, nullnet_tx_status_t status)
 {
-  if(NULLNET_TX_OK == status)
+  /* Command state of the SC */
+  volatile cellCmd_t *pCell = NULL;
+  sf_sensor_t *pSensor = NULL;
+
+  if(&gAppMulticast == ptr)
   {
-    LOG_INFO("Tx successful\n");
+    gAppMulticast.queued = false;
+    if(!gAppMulticast.active)
+    {
+      /* Ended while it was queued */
+    }
+    else if(gAppMulticast.txSeqNr != gAppMulticast.seqNr)
+    {
+      /* Send the multicast downlink that was requested while the previous
+         one was queued. */
+      loc_sendMulticast();
+    }
+    else if(loc_isBitmapEmpty(gAppMulticast.pending))
+    {
+      loc_finishMulticast();
+    }
+    else
+    {
+      /* Give the SCs time to confirm before the retransmission */
+      ctimer_set(&gAppMulticastTimer, SF_APP_MULTICAST_CONFIRM_PERIOD,
+                 loc_retryMulticast, NULL);
+    }
   }
-  else
+  else if(NULL != ptr)
   {
-    LOG_INFO("Tx failed\n");
+    /* Command downlink, ptr is NULL for a downlink of sf_app_txData() */
+    pCell = (volatile cellCmd_t*)ptr;
+    if(0 != pCell->txCmd && NULLNET_TX_OK == status)
+    {
+      pCell->ackedCmd = pCell->txCmd;
+    }
+    pCell->txCmd = 0;
+
+    /* Send the command that was decided while the downlink was queued. A
+       failed downlink is retried with the next measurement. */
+    pSensor = sf_deviceMgmt_getDeviceByIndex((uint16_t)(pCell - gAppCellCmd));
+    if(NULLNET_TX_OK == status && NULL != pSensor &&
+       pSensor->serialNr == pCell->serialNr)
+    {
+      loc_updateCellCmd(pSensor);
+    }
   }
+
+  LOG_BIN_OR_TEXT(LOG_BIN_INFO(NULLNET_TX_OK == status ? LOG_ID_APP_TX_OK : LOG_ID_APP_TX_FAIL),
+                  LOG_INFO(NULLNET_TX_OK == status ? "Tx successful\n" : "Tx failed\n"));
 } /* sf_output_callback_handler() */
 
+/*------------------------------------------------------------------------------
+  sf_app_multicastDone()
+------------------------------------------------------------------------------*/
+__attribute__((weak)) void sf_app_multicastDone(const uint8_t *pUnconfirmed)
+{
+  if(loc_isBitmapEmpty(pUnconfirmed))
+  {
+    LOG_INFO("Multicast downlink confirmed by all SCs\n");
+    return;
+  }
+
+  LOG_WARN("Multicast downlink not confirmed by the SCs of the bitmap ");
+  LOG_WARN_BYTES(pUnconfirmed, SF_APP_MULTICAST_BITMAP_LEN);
+  LOG_WARN_("\n");
+} /* sf_app_multicastDone() */
+
 /*------------------------------------------------------------------------------
   sf_app_handleMeasurement()
 
@@ -517,7 +1489,7 @@ __attribute__((weak)) void sf_app_output_callback(void *ptr, nullnet_tx_status_t
 
 
 ------------------------------------------------------------------------------*/
-__attribute__((weak)) void sf_app_handleMeasurement(uint8_t* pInBuf, uint8_t length, linkaddr_t* pSrc)
+__attribute__((weak)) void sf_app_handleMeasurement(uint8_t* pInBuf, uint16_t length, linkaddr_t* pSrc)
 {
   int8_t rssi = 0;
   /* Pointer to sensor element. */
@@ -528,11 +1500,12 @@ __attribute__((weak)) void sf_app_handleMeasurement(uint8_t* pInBuf, uint8_t len
   /* Get RSSI of received packet */
   rssi = packetbuf_attr(PACKETBUF_ATTR_RSSI);
 
-  LOG_INFO("Measurement received; device address; ");
-  LOG_INFO_LLADDR(pSrc);
-  LOG_INFO_(" RSSI; %d;", rssi);
-  LOG_INFO_BYTES(pInBuf, length);
-  LOG_INFO_("\n");
+  LOG_BIN_OR_TEXT(LOG_BIN_INFO_BYTES(LOG_ID_APP_MEAS_RX, pInBuf, length, LOG_BIN_LLADDR(pSrc), rssi),
+                  LOG_INFO("Measurement received; device address; ");
+                  LOG_INFO_LLADDR(pSrc);
+                  LOG_INFO_(" RSSI; %d;", rssi);
+                  LOG_INFO_BYTES(pInBuf, length);
+                  LOG_INFO_("\n"));
 
   /* Measurement frame structure
      frame type  |  measurement data
@@ -540,77 +1513,98 @@ __attribute__((weak)) void sf_app_handleMeasurement(uint8_t* pInBuf, uint8_t len
         uint8_t  | meas_t              */
   memcpy(&meas, pInBuf + SF_FRAME_TYPE_LEN, sizeof(meas_t));
 
-  slave_data = meas.value;
-  slave_addr_test = pSrc->u16;
-
-  // some logic to send data to slave based on what we receive
-  //-----------------------------------------------------------
-  // when the voltage of a slave < threshold, we set choose_sc to the address of that sc.
-  // for eg. if 1st sc has low voltage, we make advertiseData = 25 and choose_sc = slave_addr_test - 1.
-  // we do slave_addr_test - 1 because there is an offset of 1. choose_sc needs to start from 0 but first sc in slave_addr_test starts from 1.
-
-  // once the voltage goes back up, we reduce the advertiseData. this needs to be resent to stop the toggle.
-  // TBD: check if we need to repeat choose_sc here as well. I think yes.
-
-
-  // to initiate bypass if the voltage goes low
-  if(slave_data < 1100000) //corresponds to 1.1V from adc output, here we need to bypass
+  /* Get sensor element corresponding to the source address. */
+  sensor = sf_deviceMgmt_getDevice(*pSrc);
+  if(NULL != sensor)
   {
-      advertiseData = 25;
-      choose_sc = slave_addr_test-1;
-  }
-  else
-      advertiseData = 12;
-
-
-  //send data after processing the measurement?
-  //uint8_t pData[] = {advertiseData}; //orig 1
-
-  uint8_t pData[3];
-  pData[0] = advertiseData; //this is used now by the slave to toggle PWM
-  pData[1] = 173; // dummy integer, 0xAD for test.
-  pData[2] = (uint8_t)slave_addr_test; //to check what we get here.
-
-  // data format used for the BMS:
-  // pData[3] --> will have 4 bytes. the first byte is not in control and it is default 0x04.
-  // pData[0] --> actual advertiseData used to toggle or hold the slave PWM
-  // pData[1] --> right now a dummy value 173 corresponds to 0xad. we can change it to choose the data from slave.
-  // to design pData[1] we also need to update slave code. TBD
-  // pData[2] --> indicates the slave address. this needs to be unique to each slave.
-
-
+    float values[E_APP_QUANTITY_CNT] = {0};
 
+    loc_confirmMulticast(sensor, pInBuf, length,
+                         SF_FRAME_TYPE_LEN + sizeof(meas_t));
 
+    values[E_APP_QUANTITY_VOLTAGE] = meas.value;
+    sf_app_measStore_append(sensor, meas.timeStamp,
+                            1U << E_APP_QUANTITY_VOLTAGE, values);
+  }
+  loc_handleCellVoltage(sensor, pSrc, meas.value);
+
+  LOG_BIN_OR_TEXT(LOG_BIN_INFO(LOG_ID_APP_MEAS_VALUE,
+                               sf_absoluteTime_getHours(meas.timeStamp),
+                               sf_absoluteTime_getMinutes(meas.timeStamp),
+                               sf_absoluteTime_getSeconds(meas.timeStamp),
+                               LOG_BIN_FLOAT(meas.value)),
+                  LOG_INFO("Measurement timestamp: %uh : %umin : %usec \n",
+                            (unsigned int)sf_absoluteTime_getHours(meas.timeStamp),
+                            (unsigned int)sf_absoluteTime_getMinutes(meas.timeStamp),
+                            (unsigned int)sf_absoluteTime_getSeconds(meas.timeStamp));
+                  SF_APP_LOG_MEAS_VALUE(meas.value));
 
-  sf_sensor_t *pSensor = sf_deviceMgmt_getDeviceByIndex(choose_sc);
-  if(NULL != pSensor)
+  /* Update last seen timestamp for message source device */
+  if(NULL == sensor)
   {
-    if(0 != pSensor->serialNr &&
-        !linkaddr_cmp(&pSensor->shortAddress, &linkaddr_null))
-    {
-      sf_app_txData(pData, sizeof(pData), &pSensor->shortAddress);
-    }
+    LOG_BIN_OR_TEXT(LOG_BIN_ERR(LOG_ID_APP_MEAS_UNKNOWN),
+                    LOG_ERR("!Device is not in sensor list. Reject measurement message.\n"));
   }
+} /* sf_app_handleMeasurement() */
 
+/*------------------------------------------------------------------------------
+  sf_app_handleMeasurementBatch()
+------------------------------------------------------------------------------*/
+__attribute__((weak)) void sf_app_handleMeasurementBatch(uint8_t* pInBuf,
+                                                         uint16_t length,
+                                                         linkaddr_t* pSrc)
+{
+  int8_t rssi = 0;
+  /* Pointer to sensor element. */
+  sf_sensor_t *sensor = NULL;
+  /* Timestamps of the first and the last sample */
+  uint32_t first = 0;
+  uint32_t last = 0;
+  /* Last voltage sample */
+  float value = 0;
 
-  // else we do not do anything, so the slave will be inserted.
+  /* Get RSSI of received packet */
+  rssi = packetbuf_attr(PACKETBUF_ATTR_RSSI);
 
-  LOG_INFO("Measurement timestamp: %uh : %umin : %usec \n",
-            (unsigned int)sf_absoluteTime_getHours(meas.timeStamp),
-            (unsigned int)sf_absoluteTime_getMinutes(meas.timeStamp),
-            (unsigned int)sf_absoluteTime_getSeconds(meas.timeStamp));
-#if !CONTIKI_TARGET_COOJA
-  LOG_INFO("Measurement value: %f \n", meas.value);
-#else
-  LOG_INFO("Measurement value: %d.%u \n", (int)meas.value,
-          (uint32_t)(1000*(meas.value-(int)meas.value)));
-#endif
+  LOG_BIN_OR_TEXT(LOG_BIN_INFO_BYTES(LOG_ID_APP_BATCH_RX, pInBuf, length, LOG_BIN_LLADDR(pSrc), rssi),
+                  LOG_INFO("Measurement batch received; device address; ");
+                  LOG_INFO_LLADDR(pSrc);
+                  LOG_INFO_(" RSSI; %d;", rssi);
+                  LOG_INFO_BYTES(pInBuf, length);
+                  LOG_INFO_("\n"));
 
   /* Get sensor element corresponding to the source address. */
   sensor = sf_deviceMgmt_getDevice(*pSrc);
-  /* Update last seen timestamp for message source device */
   if(NULL == sensor)
   {
-    LOG_ERR("!Device is not in sensor list. Reject measurement message.\n");
+    LOG_BIN_OR_TEXT(LOG_BIN_ERR(LOG_ID_APP_MEAS_UNKNOWN),
+                    LOG_ERR("!Device is not in sensor list. Reject measurement message.\n"));
+    return;
   }
-} /* sf_app_handleMeasurement() */
+
+  if(E_SF_SUCCESS != loc_parseMeasBatch(sensor, pInBuf, length, &first, &last))
+  {
+    LOG_BIN_OR_TEXT(LOG_BIN_ERR(LOG_ID_APP_BATCH_INVALID),
+                    LOG_ERR("!Invalid measurement batch. Reject measurement message.\n"));
+    return;
+  }
+  loc_confirmMulticast(sensor, pInBuf, length,
+                       loc_getMeasBatchLen(pInBuf, length));
+
+  LOG_BIN_OR_TEXT(LOG_BIN_INFO(LOG_ID_APP_BATCH_VALUE,
+                               pInBuf[SF_FRAME_TYPE_LEN + sizeof(uint32_t) + 1U],
+                               pInBuf[SF_FRAME_TYPE_LEN + sizeof(uint32_t)], first, last),
+                  LOG_INFO("Measurement batch: %u samples, quantities 0x%02x, timestamp %lu..%lu\n",
+                           pInBuf[SF_FRAME_TYPE_LEN + sizeof(uint32_t) + 1U],
+                           pInBuf[SF_FRAME_TYPE_LEN + sizeof(uint32_t)],
+                           (unsigned long)first, (unsigned long)last));
+
+  if((pInBuf[SF_FRAME_TYPE_LEN + sizeof(uint32_t)] &
+      (1U << E_APP_QUANTITY_VOLTAGE)) &&
+     E_SF_SUCCESS == sf_app_measStore_getLatest(
+                       (uint16_t)(sensor - sf_deviceMgmt_getSensorList()),
+                       E_APP_QUANTITY_VOLTAGE, NULL, &value))
+  {
+    loc_handleCellVoltage(sensor, pSrc, value);
+  }
+} /* sf_app_handleMeasurementBatch() */
@@ -116,12 +116,26 @@
 /** Disable ACK/NAK time correction IE in EACKS */
 #define TSCH_PACKET_CONF_EACK_WITH_ACK_NACK_TCORR 0
 
-/* Schedule selection */
+/* Schedule selection, each schedule is a layout engine of sf-tsch-schedule-engine.c:
+   A: per section the beacon and join slots, the Device Tx Slots of all
+      devices, then their Device Rx Slots.
+   B: the Device Rx Slot of a device follows its Device Tx Slot, so a
+      command answering a measurement is sent in the same slotframe.
+   C: the devices are spread over several short sections, each with its
+      own beacon and join slots.
+   The slot counts below can be overridden with make DEFINES=..., the pack
+   is sized with tools/schedule-sim.c built with the same defines. */
+#ifndef SCHEDULE_A
 #define SCHEDULE_A                                1
+#endif
+#ifndef SCHEDULE_B
 #define SCHEDULE_B                                0
+#endif
+#ifndef SCHEDULE_C
 #define SCHEDULE_C                                0
+#endif
 
-#if !SCHEDULE_A && !SCHEDULE_B && !SCHEDULE_A
+#if !SCHEDULE_A && !SCHEDULE_B && !SCHEDULE_C
 #error "A schedule needs to be selected"
 #endif
 
@@ -132,13 +146,25 @@
 /** Put all cells on the same slotframe */
 #define APP_SLOTFRAME_HANDLE                      1
 
-#if SCHEDULE_A
+/** Maximum number of devices */
+#define APP_MAX_DEVICES                           1000
+
+/** Maximum number of device slots */
+#ifndef APP_MAX_DEVICE_SLOTS
+#define APP_MAX_DEVICE_SLOTS                      30
+#endif
+
+#if SCHEDULE_A && !defined(APP_SLOTFRAME_SECTION_SIZE)
 /** Size of the Slotframe Section */
 #define APP_SLOTFRAME_SECTION_SIZE                425
-#endif /* #if SCHEDULE_A */
+#endif /* #if SCHEDULE_A && !defined(APP_SLOTFRAME_SECTION_SIZE) */
 
 /** Number of Sections */
+#if SCHEDULE_C
+#define APP_SLOTFRAME_SECTION_NUM                 4
+#else
 #define APP_SLOTFRAME_SECTION_NUM                 1
+#endif /* #if SCHEDULE_C */
 
 /** Size of the Slotframe */
 #define APP_SLOTFRAME_SIZE                        (APP_SLOTFRAME_SECTION_SIZE *\
@@ -147,33 +173,212 @@
 /** Number of Beacon Slots per Slotframe section */
 #define APP_SLOTFRAME_SECTION_BEACON_SLOTS        1
 
+#if SCHEDULE_C
 /** Number of Join Request Slots per Slotframe section */
+#ifndef APP_SLOTFRAME_SECTION_JOIN_REQUEST_SLOTS
+#define APP_SLOTFRAME_SECTION_JOIN_REQUEST_SLOTS  3
+#endif
+
+/** Number of Join Process Slots per Slotframe section, one per concurrent
+    join */
+#ifndef APP_SLOTFRAME_SECTION_JOIN_PROCESS_SLOTS
+#define APP_SLOTFRAME_SECTION_JOIN_PROCESS_SLOTS  4
+#endif
+#else
+/** Number of Join Request Slots per Slotframe section */
+#ifndef APP_SLOTFRAME_SECTION_JOIN_REQUEST_SLOTS
 #define APP_SLOTFRAME_SECTION_JOIN_REQUEST_SLOTS  12
+#endif
 
 /** Number of Join Process Slots per Slotframe section */
+#ifndef APP_SLOTFRAME_SECTION_JOIN_PROCESS_SLOTS
 #define APP_SLOTFRAME_SECTION_JOIN_PROCESS_SLOTS  12
+#endif
+#endif /* #if SCHEDULE_C */
 
 /** Number of Join Slots per Slotframe section */
 #define APP_SLOTFRAME_SECTION_JOIN_SLOTS          (APP_SLOTFRAME_SECTION_JOIN_REQUEST_SLOTS + \
                                                    APP_SLOTFRAME_SECTION_JOIN_PROCESS_SLOTS)
 
+#if SCHEDULE_C
+/** Number of Device Tx Slots per Slotframe section, the sections share
+    the devices */
+#ifndef APP_SLOTFRAME_SECTION_DEVICE_TX_SLOTS
+#define APP_SLOTFRAME_SECTION_DEVICE_TX_SLOTS     8
+#endif
+
+/** Number of Device Rx Slots per Slotframe section */
+#ifndef APP_SLOTFRAME_SECTION_DEVICE_RX_SLOTS
+#define APP_SLOTFRAME_SECTION_DEVICE_RX_SLOTS     8
+#endif
+#else
 /** Number of Device Tx Slots per Slotframe section */
+#ifndef APP_SLOTFRAME_SECTION_DEVICE_TX_SLOTS
 #define APP_SLOTFRAME_SECTION_DEVICE_TX_SLOTS     100
+#endif
 
 /** Number of Device Rx Slots per Slotframe section */
+#ifndef APP_SLOTFRAME_SECTION_DEVICE_RX_SLOTS
 #define APP_SLOTFRAME_SECTION_DEVICE_RX_SLOTS     100
+#endif
+#endif /* #if SCHEDULE_C */
+
+/** Number of Broadcast Slots per Slotframe section, placed after the Device
+    Rx Slots. Used for downlinks to several devices at once. */
+#define APP_SLOTFRAME_SECTION_BROADCAST_SLOTS     1
+
+/** Number of channel offsets the device slots are spread over. Devices
+    sharing a timeslot use different channel offsets (frequencies), so the
+    device slots of a section serve this many times the devices. Must not
+    exceed the length of the hopping sequence. The coordinator needs a
+    receiver per channel offset: with a single radio TSCH serves one link
+    per timeslot, and the schedule the devices learn does not carry the
+    number of channel offsets. Only 1 is supported until a coordinator with
+    several receivers exists. */
+#ifndef APP_SLOTFRAME_CHANNEL_OFFSETS
+#define APP_SLOTFRAME_CHANNEL_OFFSETS             1
+#endif
 
-/** Maximum number of devices */
-#define APP_MAX_DEVICES                           1000
+#if APP_SLOTFRAME_CHANNEL_OFFSETS < 1
+#error "At least one channel offset is needed"
+#endif
+#if APP_SLOTFRAME_CHANNEL_OFFSETS > 1
+#error "Several channel offsets need a coordinator with a receiver per channel offset"
+#endif
 
-/** Maximum number of device slots */
-#define APP_MAX_DEVICE_SLOTS                      30
+/** Reserve a slot only for retransmissions behind the Rx Slot of each
+    device. Without it the device Rx Slots are packed and the devices
+    retransmit in the shared retry slots, which nearly halves the timeslots
+    of the Device Tx Slots. */
+#ifndef APP_SLOTFRAME_DEDICATED_RETRY_SLOT
+#define APP_SLOTFRAME_DEDICATED_RETRY_SLOT        1
+#endif
+
+/** Uplink loss in percent, measured as retry / (first + retry) with
+    sf_tsch_schedule_get_retry_stats(). Sizes the shared retry slots. */
+#ifndef APP_SLOTFRAME_UPLINK_LOSS_PERCENT
+#define APP_SLOTFRAME_UPLINK_LOSS_PERCENT         10
+#endif
+
+/** Number of Retry Slots per Slotframe section, placed after the Device Tx
+    Slots. The SCs retransmit in them on a shared link of type
+    LINK_TYPE_NORMAL_RTX, so the TSCH backoff spreads the retransmissions.
+    A shared slot with random backoff carries about 1/e frames, so there are
+    e times as many as retransmissions expected per slotframe. */
+#if APP_SLOTFRAME_DEDICATED_RETRY_SLOT
+#define APP_SLOTFRAME_SECTION_RETRY_SLOTS         0
+#else
+#define APP_SLOTFRAME_SECTION_RETRY_SLOTS         ((((APP_MAX_DEVICE_SLOTS + \
+                                                      APP_SLOTFRAME_SECTION_NUM - 1) / \
+                                                     APP_SLOTFRAME_SECTION_NUM) * \
+                                                    APP_SLOTFRAME_UPLINK_LOSS_PERCENT * \
+                                                    272 + 9999) / 10000)
+#endif
+
+#if !SCHEDULE_A && !defined(APP_SLOTFRAME_SECTION_SIZE)
+/** Size of the Slotframe Section, the slots without gaps */
+#define APP_SLOTFRAME_SECTION_SIZE                (APP_SLOTFRAME_SECTION_BEACON_SLOTS + \
+                                                   APP_SLOTFRAME_SECTION_JOIN_SLOTS + \
+                                                   (APP_SLOTFRAME_SECTION_DEVICE_TX_SLOTS * \
+                                                    (1 + APP_SLOTFRAME_DEDICATED_RETRY_SLOT)) + \
+                                                   APP_SLOTFRAME_SECTION_RETRY_SLOTS + \
+                                                   APP_SLOTFRAME_SECTION_DEVICE_RX_SLOTS + \
+                                                   APP_SLOTFRAME_SECTION_BROADCAST_SLOTS)
+#endif /* #if !SCHEDULE_A && !defined(APP_SLOTFRAME_SECTION_SIZE) */
+
+#if SCHEDULE_B && (APP_SLOTFRAME_SECTION_DEVICE_TX_SLOTS != APP_SLOTFRAME_SECTION_DEVICE_RX_SLOTS)
+#error "SCHEDULE_B needs a Device Rx Slot for each Device Tx Slot"
+#endif
+
+#if (APP_SLOTFRAME_SECTION_NUM * APP_SLOTFRAME_SECTION_DEVICE_TX_SLOTS * \
+     APP_SLOTFRAME_CHANNEL_OFFSETS) < APP_MAX_DEVICE_SLOTS
+#error "The sections do not hold APP_MAX_DEVICE_SLOTS devices"
+#endif
+
+#if (APP_SLOTFRAME_SECTION_BEACON_SLOTS + APP_SLOTFRAME_SECTION_JOIN_SLOTS + \
+     (APP_SLOTFRAME_SECTION_DEVICE_TX_SLOTS * \
+      (1 + APP_SLOTFRAME_DEDICATED_RETRY_SLOT)) + \
+     APP_SLOTFRAME_SECTION_RETRY_SLOTS + \
+     APP_SLOTFRAME_SECTION_DEVICE_RX_SLOTS + \
+     APP_SLOTFRAME_SECTION_BROADCAST_SLOTS) > APP_SLOTFRAME_SECTION_SIZE
+#error "The slots do not fit into the slotframe section"
+#endif
+
+/** Resize the slotframe to the devices with data slots instead of keeping
+    APP_SLOTFRAME_SIZE timeslots. The slotframe then holds the RX slots,
+    retry slots and TX slots of as many device positions as the highest device id needs,
+    rounded up to APP_SLOTFRAME_COMPACT_STEP. A new size is announced in the
+    schedule descriptor of the EBs and becomes active
+    APP_SLOTFRAME_COMPACT_LEAD slotframes later, the SCs have to follow the
+    descriptor. Only for SCHEDULE_A with a single section, enable it with
+    make APP_SLOTFRAME_COMPACT=1. */
+#ifndef APP_SLOTFRAME_COMPACT
+#define APP_SLOTFRAME_COMPACT                     0
+#endif
+
+/** Handle of the slotframe replacing the active one after a resize */
+#define APP_SLOTFRAME_COMPACT_HANDLE              2
+
+/** Device positions are added and removed in steps of this many */
+#define APP_SLOTFRAME_COMPACT_STEP                4
+
+/** Slotframes of the old size until a new size becomes active, the time
+    the SCs have to receive the schedule descriptor */
+#define APP_SLOTFRAME_COMPACT_LEAD                4
+
+#if APP_SLOTFRAME_COMPACT && (!SCHEDULE_A || (APP_SLOTFRAME_SECTION_NUM != 1))
+#error "The slotframe compaction needs SCHEDULE_A with a single section"
+#endif
+
+/** Take the beacon, join request, broadcast and retry slots and the data
+    slots of all devices from a table in flash instead of allocating a link
+    for each of them, only the join process slots are allocated. The table is
+    generated at build time by tools/schedule-table-gen.c from this
+    configuration, enable it with make APP_SLOTFRAME_STATIC=1. Not with the
+    slotframe compaction. */
+#ifndef APP_SLOTFRAME_STATIC
+#define APP_SLOTFRAME_STATIC                      0
+#endif
+
+#if APP_SLOTFRAME_STATIC && APP_SLOTFRAME_COMPACT
+#error "The static schedule table needs a slotframe of fixed size"
+#endif
+
+/** Links in flash are enabled by a bit each */
+#define TSCH_SCHEDULE_CONF_WITH_STATIC_LINKS      APP_SLOTFRAME_STATIC
+
+/** Activate a resized slotframe at an ASN and announce it in the EBs */
+#define TSCH_SCHEDULE_CONF_WITH_ACTIVATION        APP_SLOTFRAME_COMPACT
+#define TSCH_PACKET_CONF_EB_WITH_SCHEDULE_DESC    APP_SLOTFRAME_COMPACT
 
 /** Number of links that can be used by the device (10 + 240 Join + 2*APP_MAX_DEVICES Tx + APP_MAX_DEVICES Rx)*/
-#define TSCH_SCHEDULE_CONF_MAX_LINKS              (APP_SLOTFRAME_SECTION_NUM + \
+#if APP_SLOTFRAME_STATIC
+/* only the join process slots are not in the table */
+#define TSCH_SCHEDULE_CONF_MAX_LINKS              (APP_SLOTFRAME_SECTION_NUM * \
+                                                   APP_SLOTFRAME_SECTION_JOIN_PROCESS_SLOTS)
+#else
+#define TSCH_SCHEDULE_CONF_MAX_LINKS              ((APP_SLOTFRAME_SECTION_NUM + \
                                                    (APP_SLOTFRAME_SECTION_NUM * \
                                                    APP_SLOTFRAME_SECTION_JOIN_SLOTS) \
-                                                   + (APP_MAX_DEVICE_SLOTS*3))
+                                                   + (APP_SLOTFRAME_SECTION_NUM * \
+                                                   APP_SLOTFRAME_SECTION_BROADCAST_SLOTS) \
+                                                   + (APP_SLOTFRAME_SECTION_NUM * \
+                                                   APP_SLOTFRAME_SECTION_RETRY_SLOTS) \
+                                                   + (APP_MAX_DEVICE_SLOTS * \
+                                                   (2 + APP_SLOTFRAME_DEDICATED_RETRY_SLOT))) * \
+                                                   (1 + APP_SLOTFRAME_COMPACT))
+#endif /* #if APP_SLOTFRAME_STATIC */
+
+/** All cells are kept in a single slotframe, replaced by a second one when
+    the slotframe is resized */
+#define TSCH_SCHEDULE_CONF_MAX_SLOTFRAMES         (1 + APP_SLOTFRAME_COMPACT)
+
+/** Index the slotframe by timeslot, so finding the next active link does not
+    depend on the number of links */
+#define TSCH_SCHEDULE_CONF_WITH_SLOT_INDEX        1
+
+/** The timeslot index must cover the whole slotframe */
+#define TSCH_SCHEDULE_CONF_SLOT_INDEX_MAX_LENGTH  APP_SLOTFRAME_SIZE
 
 /** NBR_TABLE_CONF_MAX_NEIGHBORS specifies the maximum number of neighbors
    that each node will be able to handle. */
@@ -185,6 +390,16 @@
 /** Maximum incoming packets. */
 #define TSCH_CONF_MAX_INCOMING_PACKETS            32
 
+/** Pass incoming frames to nullnet without copying them to the packetbuf. */
+#ifndef TSCH_CONF_RX_ZERO_COPY
+#define TSCH_CONF_RX_ZERO_COPY                    1
+#endif
+
+/** Replace a queued downlink by a newer one to the same device. */
+#ifndef TSCH_CONF_WITH_QUEUE_COALESCING
+#define TSCH_CONF_WITH_QUEUE_COALESCING           1
+#endif
+
 /** Set the beacon update rate */
 #define TSCH_CONF_EB_PERIOD                       (3 * CLOCK_SECOND)
 
@@ -268,6 +483,34 @@
 /* The maximum number of smart cells that can connect. */
 #define SF_CONF_SENSOR_CNT_MAX                      30
 
+/* The maximum number of smart cells joining at the same time. Each join uses
+   every SF_JOIN_CONF_CONCURRENT_MAX-th join process slot. */
+#ifndef SF_JOIN_CONF_CONCURRENT_MAX
+#define SF_JOIN_CONF_CONCURRENT_MAX                 4
+#endif
+
+/* Send the bypass command in the ACK status bit of the enhanced ACK of the
+   measurement instead of a separate downlink. The insert command still
+   needs the downlink. */
+#ifndef SF_APP_CONF_CMD_IN_ACK
+#define SF_APP_CONF_CMD_IN_ACK                      1
+#endif
+#if SF_APP_CONF_CMD_IN_ACK
+#define TSCH_CALLBACK_ACK_APP_IE_TX                 sf_app_ackCommand
+#endif
+
+/* Count the valid uplink frames received in the RX slots and in the retry
+   slots. */
+#define TSCH_CALLBACK_RX_VALID_FRAME                sf_tsch_schedule_count_rx
+
+/* Compute the pack statistics once per slotframe (7.5 ms timeslots). */
+#define SF_APP_CONF_PACK_STATS_PERIOD               ((APP_SLOTFRAME_SIZE * 75UL * \
+                                                      CLOCK_SECOND) / 10000UL)
+/* Deviation from the pack mean above which a SC is an outlier, voltage in
+   mV and temperature in 0.1 degC. */
+#define SF_APP_CONF_PACK_OUTLIER_VOLTAGE            50
+#define SF_APP_CONF_PACK_OUTLIER_TEMPERATURE        50
+
 /* Logging */
 
 /** Log level for RPL. */
@@ -294,6 +537,10 @@
 #define LOG_CONF_APP                               LOG_LEVEL_INFO
 /** The join LOG level. */
 #define LOG_CONF_JOIN                              LOG_LEVEL_INFO
+/** Writes the hot path logs as binary records, see tools/log-decoder.py. */
+#ifndef LOG_CONF_BINARY
+#define LOG_CONF_BINARY                            0
+#endif
 
 /** Enables LED. */
 #define LED_ENABLED                                1
@@ -301,6 +548,14 @@
 // #define DEBUG_TSCH_TIMING                          1
 // #define DEBUG_TSCH_TIMING_RX                       1
 
+/** Records the timing of each TSCH slot, printed and cleared every
+    SF_APP_SLOT_TIMING_PRINT_PERIOD. */
+#ifndef TSCH_CONF_WITH_SLOT_TIMING
+#define TSCH_CONF_WITH_SLOT_TIMING                 0
+#endif
+/** Slot timing print period. */
+#define SF_APP_SLOT_TIMING_PRINT_PERIOD            (60 * CLOCK_SECOND)
+
 #ifdef DEBUG_TSCH_TIMING
 /* TSCH Timing Debug */
 #undef TSCH_TIMING_PIN_0
@@ -29,8 +29,13 @@ extern "C" {
  *    | API Function                              | Description                                     |
  *    |-------------------------------------------|-------------------------------------------------|
  *    | @ref sf_app_txData()                      | @copybrief sf_app_txData()                      |
+ *    | @ref sf_app_txDataMulti()                 | @copybrief sf_app_txDataMulti()                 |
  *    | @ref sf_app_output_callback()             | @copybrief sf_app_output_callback()             |
+ *    | @ref sf_app_multicastDone()               | @copybrief sf_app_multicastDone()               |
  *    | @ref sf_app_handleMeasurement()           | @copybrief sf_app_handleMeasurement()           |
+ *    | @ref sf_app_handleMeasurementBatch()      | @copybrief sf_app_handleMeasurementBatch()      |
+ *    | @ref sf_app_ackCommand()                  | @copybrief sf_app_ackCommand()                  |
+ *    | @ref sf_app_getPackStats()                | @copybrief sf_app_getPackStats()                |
  *  @{
  */
 
@@ -44,6 +49,8 @@ extern "C" {
 #include "nullnet.h"
 /* Application includes */
 #include "sf_types.h"
+#include "sf_app_measStore.h"
+#include "sf_app_packStats.h"
 
 /*=============================================================================
                                 API FUNCTIONS
@@ -63,6 +70,29 @@ extern "C" {
 /*============================================================================*/
 E_SF_RETURN_t sf_app_txData(uint8_t* pData, uint8_t dataLen, linkaddr_t* pDest);
 
+/*============================================================================*/
+/**
+ * \brief This function sends data to several SCs at once in the broadcast
+ *        slot. The SCs are addressed by a bitmap, bit n (LSB first) addresses
+ *        the SC with the short address n + 1. A SC confirms the data by
+ *        echoing its sequence number in a measurement. The frame is
+ *        retransmitted to the SCs that have not confirmed it, up to
+ *        SF_APP_CONF_MULTICAST_RETRY_MAX times, then
+ *        sf_app_multicastDone() reports the unconfirmed SCs. A newer call
+ *        replaces the pending data, which is reported first.
+ *
+ * \param pData       Pointer to the data storage.
+ * \param dataLen     The length of the data.
+ * \param pBitmap     Pointer to the SC bitmap of
+ *                    SF_FRAME_BITMAP_LEN(SF_CONF_SENSOR_CNT_MAX) bytes, NULL
+ *                    for all registered SCs.
+ *
+ * \return @ref E_SF_RETURN_t
+ */
+/*============================================================================*/
+E_SF_RETURN_t sf_app_txDataMulti(uint8_t* pData, uint8_t dataLen,
+                                 const uint8_t* pBitmap);
+
 /*============================================================================*/
 /**
  * \brief This is a Tx callback function. TSCH calls this function to inform the
@@ -74,6 +104,20 @@ E_SF_RETURN_t sf_app_txData(uint8_t* pData, uint8_t dataLen, linkaddr_t* pDest);
 /*============================================================================*/
 void sf_app_output_callback(void *ptr, nullnet_tx_status_t status);
 
+/*============================================================================*/
+/**
+ * \brief Reports the end of the data sent with sf_app_txDataMulti(), once
+ *        all SCs have confirmed it or the retransmissions are used up. The
+ *        customer can add his specific implementation.
+ *
+ * \param pUnconfirmed  Pointer to the bitmap of the SCs that have not
+ *                      confirmed the data, in the layout of the bitmap of
+ *                      sf_app_txDataMulti(). All zero if every SC has
+ *                      confirmed it.
+ */
+/*============================================================================*/
+void sf_app_multicastDone(const uint8_t *pUnconfirmed);
+
 /*============================================================================*/
 /**
  * \brief Handle received measurement. The customer can add his specific
@@ -84,7 +128,60 @@ void sf_app_output_callback(void *ptr, nullnet_tx_status_t status);
  * \param pSrc          End point short address.
  */
 /*============================================================================*/
-void sf_app_handleMeasurement(uint8_t* pInBuf, uint8_t length, linkaddr_t* pSrc);
+void sf_app_handleMeasurement(uint8_t* pInBuf, uint16_t length, linkaddr_t* pSrc);
+
+/*============================================================================*/
+/**
+ * \brief Handle a received batched measurement. The samples are stored in
+ *        the buffer of the SC, the command of the SC is decided on the last
+ *        voltage sample. The customer can add his specific implementation.
+ *
+ * \param pInBuf        Pointer to the frame.
+ * \param length        Frame length.
+ * \param pSrc          End point short address.
+ */
+/*============================================================================*/
+void sf_app_handleMeasurementBatch(uint8_t* pInBuf, uint16_t length,
+                                   linkaddr_t* pSrc);
+
+/*============================================================================*/
+/**
+ * \brief Returns the command for a SC that is sent in the enhanced ACK of a
+ *        frame of this SC. For a measurement, the command is decided on the
+ *        acknowledged measurement. TSCH calls this function in the timeslot
+ *        (TSCH_CALLBACK_ACK_APP_IE_TX), it must return within the ACK delay.
+ *        Only the lowest bit of the command reaches the SC, as the ACK
+ *        status bit of the FCF.
+ *
+ * \param pSrc          End point short address.
+ * \param pData         Pointer to the frame payload.
+ * \param length        Payload length.
+ *
+ * \return The command, never 0.
+ */
+/*============================================================================*/
+uint8_t sf_app_ackCommand(const linkaddr_t *pSrc, const void *pData,
+                          uint16_t length);
+
+/*============================================================================*/
+/**
+ * \brief Returns the pack statistics of a quantity over the latest values of
+ *        all SCs. The statistics are updated every SF_APP_PACK_STATS_PERIOD,
+ *        the values are in the fixed-point unit of the batched measurement
+ *        (voltage in mV, temperature in 0.1 degC).
+ *
+ * \param quantity      Quantity.
+ * \param pStats        Pointer to the statistics.
+ * \param pOutliers     Pointer to the bitmap of the outlier SCs, bit n (LSB
+ *                      first) for sensor list index n, SF_FRAME_BITMAP_LEN(
+ *                      SF_CONF_SENSOR_CNT_MAX) bytes. May be NULL.
+ *
+ * \return @ref E_SF_RETURN_t, E_SF_ERROR if there are no statistics.
+ */
+/*============================================================================*/
+E_SF_RETURN_t sf_app_getPackStats(E_APP_QUANTITY_t quantity,
+                                  sf_app_packStats_t *pStats,
+                                  uint8_t *pOutliers);
 
 /*! @} */
 
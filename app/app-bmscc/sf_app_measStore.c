@@ -0,0 +1,294 @@
+/**
+ * @code
+ *  ___ _____ _   ___ _  _____ ___  ___  ___ ___
+ * / __|_   _/_\ / __| |/ / __/ _ \| _ \/ __| __|
+ * \__ \ | |/ _ \ (__| ' <| _| (_) |   / (__| _|
+ * |___/ |_/_/ \_\___|_|\_\_| \___/|_|_\\___|___|
+ * embedded.connectivity.solutions.==============
+ * @endcode
+ *
+ * @copyright  STACKFORCE GmbH, Germany, www.stackforce.de
+ * @author     STACKFORCE
+ * @brief      API implementation of the measurement store.
+ *
+ */
+
+/*=============================================================================
+                                INCLUDES
+=============================================================================*/
+/* Standard include */
+#include <string.h>
+/* Module specific include */
+#include "sf_frameType.h"
+#include "sf_app_measStore.h"
+
+/*=============================================================================
+                                MACROS
+=============================================================================*/
+/* Mask of the ring buffer indexes */
+#define SF_APP_MEAS_STORE_MASK          (SF_APP_MEAS_STORE_LEN - 1U)
+
+/*=============================================================================
+                                STRUCTS
+=============================================================================*/
+/*! Samples of a SC */
+typedef struct
+{
+  /* Timestamp of each sample */
+  uint32_t timeStamp[SF_APP_MEAS_STORE_LEN];
+  /* Values of each quantity */
+  float value[E_APP_QUANTITY_CNT][SF_APP_MEAS_STORE_LEN];
+  /* Bitmask of the quantities of each sample */
+  uint8_t flags[SF_APP_MEAS_STORE_LEN];
+  /* Serial number of the SC the samples belong to */
+  uint32_t serialNr;
+  /* Index of the next sample */
+  uint16_t head;
+  /* Number of samples */
+  uint16_t cnt;
+} measCell_t;
+
+/*=============================================================================
+                            GLOBAL VARIABLES
+=============================================================================*/
+/* Samples of each SC, indexed like the sensor list. */
+static measCell_t gMeasStore[SF_CONF_SENSOR_CNT_MAX];
+
+/*=============================================================================
+                            LOCAL FUNCTIONS
+=============================================================================*/
+/*============================================================================*/
+/**
+ * \brief Returns the samples of the SC at the sensor list index, NULL if
+ *        the SC is no longer registered.
+ */
+/*============================================================================*/
+static const measCell_t* loc_getCell(uint16_t index)
+{
+  const sf_sensor_t *pSensor = sf_deviceMgmt_getDeviceByIndex(index);
+
+  if(NULL == pSensor || 0 == pSensor->serialNr ||
+     pSensor->serialNr != gMeasStore[index].serialNr)
+  {
+    return NULL;
+  }
+
+  return &gMeasStore[index];
+}/* loc_getCell() */
+
+/*=============================================================================
+                              API IMPLEMENTATION
+=============================================================================*/
+/*----------------------------------------------------------------------------*/
+/*! sf_app_measStore_init */
+/*----------------------------------------------------------------------------*/
+void sf_app_measStore_init(void)
+{
+  memset(gMeasStore, 0, sizeof(gMeasStore));
+}/* sf_app_measStore_init() */
+
+/*----------------------------------------------------------------------------*/
+/*! sf_app_measStore_append */
+/*----------------------------------------------------------------------------*/
+E_SF_RETURN_t sf_app_measStore_append(const sf_sensor_t *pSensor,
+                                      uint32_t timeStamp, uint8_t quantities,
+                                      const float *pValues)
+{
+  measCell_t *pCell;
+  uint16_t head;
+
+  if(NULL == pSensor || NULL == pValues)
+  {
+    return E_SF_ERROR_NPE;
+  }
+
+  if(0 == quantities || 0 != (quantities >> E_APP_QUANTITY_CNT))
+  {
+    return E_SF_ERROR_INVALID_PARAM;
+  }
+
+  pCell = &gMeasStore[pSensor - sf_deviceMgmt_getSensorList()];
+  if(pCell->serialNr != pSensor->serialNr)
+  {
+    /* The entry has been taken over by another SC */
+    pCell->serialNr = pSensor->serialNr;
+    pCell->head = 0;
+    pCell->cnt = 0;
+  }
+
+  head = pCell->head;
+  pCell->timeStamp[head] = timeStamp;
+  pCell->flags[head] = quantities;
+  for(uint8_t q = 0; q < E_APP_QUANTITY_CNT; q++)
+  {
+    pCell->value[q][head] = (quantities & (1U << q)) ? pValues[q] : 0.0f;
+  }
+
+  pCell->head = (head + 1U) & SF_APP_MEAS_STORE_MASK;
+  if(pCell->cnt < SF_APP_MEAS_STORE_LEN)
+  {
+    pCell->cnt++;
+  }
+
+  return E_SF_SUCCESS;
+}/* sf_app_measStore_append() */
+
+/*----------------------------------------------------------------------------*/
+/*! sf_app_measStore_getLatest */
+/*----------------------------------------------------------------------------*/
+E_SF_RETURN_t sf_app_measStore_getLatest(uint16_t index,
+                                         E_APP_QUANTITY_t quantity,
+                                         uint32_t *pTimeStamp, float *pValue)
+{
+  const measCell_t *pCell;
+  uint16_t pos;
+
+  if(NULL == pValue)
+  {
+    return E_SF_ERROR_NPE;
+  }
+
+  if(index >= SF_CONF_SENSOR_CNT_MAX || quantity >= E_APP_QUANTITY_CNT)
+  {
+    return E_SF_ERROR_INVALID_PARAM;
+  }
+
+  pCell = loc_getCell(index);
+  if(NULL == pCell)
+  {
+    return E_SF_ERROR;
+  }
+
+  /* Walk back from the newest sample */
+  for(uint16_t i = 1; i <= pCell->cnt; i++)
+  {
+    pos = (pCell->head - i) & SF_APP_MEAS_STORE_MASK;
+    if(pCell->flags[pos] & (1U << quantity))
+    {
+      if(NULL != pTimeStamp)
+      {
+        *pTimeStamp = pCell->timeStamp[pos];
+      }
+      *pValue = pCell->value[quantity][pos];
+      return E_SF_SUCCESS;
+    }
+  }
+
+  return E_SF_ERROR;
+}/* sf_app_measStore_getLatest() */
+
+/*----------------------------------------------------------------------------*/
+/*! sf_app_measStore_getStats */
+/*----------------------------------------------------------------------------*/
+E_SF_RETURN_t sf_app_measStore_getStats(uint16_t index,
+                                        E_APP_QUANTITY_t quantity,
+                                        uint32_t from, uint32_t to,
+                                        sf_app_measStats_t *pStats)
+{
+  const measCell_t *pCell;
+  const float *pValue;
+  uint8_t mask;
+  float sum = 0.0f;
+
+  if(NULL == pStats)
+  {
+    return E_SF_ERROR_NPE;
+  }
+
+  if(index >= SF_CONF_SENSOR_CNT_MAX || quantity >= E_APP_QUANTITY_CNT)
+  {
+    return E_SF_ERROR_INVALID_PARAM;
+  }
+
+  pCell = loc_getCell(index);
+  if(NULL == pCell)
+  {
+    return E_SF_ERROR;
+  }
+
+  pValue = pCell->value[quantity];
+  mask = (uint8_t)(1U << quantity);
+  pStats->cnt = 0;
+
+  /* The order of the samples does not matter, so the arrays are scanned
+     from the start. Slots beyond cnt are not written yet. */
+  for(uint16_t i = 0; i < pCell->cnt; i++)
+  {
+    if((pCell->flags[i] & mask) &&
+       pCell->timeStamp[i] >= from && pCell->timeStamp[i] <= to)
+    {
+      if(0 == pStats->cnt)
+      {
+        pStats->min = pValue[i];
+        pStats->max = pValue[i];
+      }
+      else
+      {
+        pStats->min = (pValue[i] < pStats->min) ? pValue[i] : pStats->min;
+        pStats->max = (pValue[i] > pStats->max) ? pValue[i] : pStats->max;
+      }
+      sum += pValue[i];
+      pStats->cnt++;
+    }
+  }
+
+  if(0 == pStats->cnt)
+  {
+    return E_SF_ERROR;
+  }
+
+  pStats->mean = sum / pStats->cnt;
+
+  return E_SF_SUCCESS;
+}/* sf_app_measStore_getStats() */
+
+/*----------------------------------------------------------------------------*/
+/*! sf_app_measStore_getSnapshot */
+/*----------------------------------------------------------------------------*/
+uint16_t sf_app_measStore_getSnapshot(E_APP_QUANTITY_t quantity,
+                                      uint32_t timeStamp, float *pValues,
+                                      uint8_t *pBitmap)
+{
+  const measCell_t *pCell;
+  uint16_t valueCnt = 0;
+  uint16_t pos;
+  uint8_t mask;
+
+  if(NULL == pValues || quantity >= E_APP_QUANTITY_CNT)
+  {
+    return 0;
+  }
+
+  if(NULL != pBitmap)
+  {
+    memset(pBitmap, 0, SF_FRAME_BITMAP_LEN(SF_CONF_SENSOR_CNT_MAX));
+  }
+
+  mask = (uint8_t)(1U << quantity);
+  for(uint16_t index = 0; index < SF_CONF_SENSOR_CNT_MAX; index++)
+  {
+    pCell = loc_getCell(index);
+    if(NULL == pCell)
+    {
+      continue;
+    }
+
+    /* Latest sample of the SC up to the time of the snapshot */
+    for(uint16_t i = 1; i <= pCell->cnt; i++)
+    {
+      pos = (pCell->head - i) & SF_APP_MEAS_STORE_MASK;
+      if((pCell->flags[pos] & mask) && pCell->timeStamp[pos] <= timeStamp)
+      {
+        pValues[index] = pCell->value[quantity][pos];
+        if(NULL != pBitmap)
+        {
+          pBitmap[index / 8U] |= (uint8_t)(1U << (index % 8U));
+        }
+        valueCnt++;
+        break;
+      }
+    }
+  }
+
+  return valueCnt;
+}/* sf_app_measStore_getSnapshot() */
@@ -0,0 +1,192 @@
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ @code
+  ___ _____ _   ___ _  _____ ___  ___  ___ ___
+ / __|_   _/_\ / __| |/ / __/ _ \| _ \/ __| __|
+ \__ \ | |/ _ \ (__| ' <| _| (_) |   / (__| _|
+ |___/ |_/_/ \_\___|_|\_\_| \___/|_|_\\___|___|
+ embedded.connectivity.solutions.==============
+ @endcode
+
+ @file
+ @copyright  STACKFORCE GmbH, Germany, www.stackforce.de
+ @author     STACKFORCE
+ @brief      This header contains the interfaces of the measurement store.
+*/
+
+#ifndef __APP_MEAS_STORE_H__
+#define __APP_MEAS_STORE_H__
+
+/**
+ *  @addtogroup SF_APP_MEAS_STORE
+ *
+ *  @details
+ *
+ *  The measurement store keeps the last SF_APP_MEAS_STORE_LEN samples of
+ *  every registered SC in a ring buffer. The samples of a SC are stored as
+ *  structure of arrays (timestamps, values per quantity, flags), so a query
+ *  scans contiguous memory. SCs are addressed by their sensor list index,
+ *  which is the short address - 1.
+ *
+ *  - <b>Measurement store API</b>\n
+ *    | API Function                              | Description                                     |
+ *    |-------------------------------------------|-------------------------------------------------|
+ *    | @ref sf_app_measStore_init()              | @copybrief sf_app_measStore_init()              |
+ *    | @ref sf_app_measStore_append()            | @copybrief sf_app_measStore_append()            |
+ *    | @ref sf_app_measStore_getLatest()         | @copybrief sf_app_measStore_getLatest()         |
+ *    | @ref sf_app_measStore_getStats()          | @copybrief sf_app_measStore_getStats()          |
+ *    | @ref sf_app_measStore_getSnapshot()       | @copybrief sf_app_measStore_getSnapshot()       |
+ *  @{
+ */
+
+/*=============================================================================
+                                INCLUDES
+=============================================================================*/
+/* Standard include */
+#include <stdint.h>
+#include <stdbool.h>
+/* Application includes */
+#include "sf_types.h"
+#include "sf_deviceMgmt.h"
+
+/*=============================================================================
+                                MACROS
+=============================================================================*/
+/* Number of samples stored per SC, must be a power of two */
+#ifndef SF_APP_CONF_MEAS_STORE_LEN
+#define SF_APP_MEAS_STORE_LEN           (16U)
+#else
+#define SF_APP_MEAS_STORE_LEN           SF_APP_CONF_MEAS_STORE_LEN
+#endif
+
+#if (SF_APP_MEAS_STORE_LEN & (SF_APP_MEAS_STORE_LEN - 1U)) != 0
+#error "SF_APP_CONF_MEAS_STORE_LEN must be a power of two!"
+#endif
+
+/*=============================================================================
+                                ENUMS
+=============================================================================*/
+/*! Measured quantities of a SC */
+typedef enum
+{
+  /* Cell voltage in uV */
+  E_APP_QUANTITY_VOLTAGE = 0,
+  /* Cell temperature in degC */
+  E_APP_QUANTITY_TEMPERATURE = 1,
+  /* Cell current in mA */
+  E_APP_QUANTITY_CURRENT = 2,
+  /* Number of quantities */
+  E_APP_QUANTITY_CNT
+} E_APP_QUANTITY_t;
+
+/*=============================================================================
+                                STRUCTS
+=============================================================================*/
+/*! Statistics of a quantity over a time window */
+typedef struct
+{
+  /* Number of samples in the window */
+  uint16_t cnt;
+  /* Minimum value */
+  float min;
+  /* Maximum value */
+  float max;
+  /* Mean value */
+  float mean;
+} sf_app_measStats_t;
+
+/*=============================================================================
+                                API FUNCTIONS
+=============================================================================*/
+/*============================================================================*/
+/**
+ * \brief Clears the samples of all SCs.
+ */
+/*============================================================================*/
+void sf_app_measStore_init(void);
+
+/*============================================================================*/
+/**
+ * \brief Appends a sample of a SC, the oldest sample is overwritten if the
+ *        ring buffer of the SC is full. The samples of a SC are cleared when
+ *        its sensor list entry has been taken over by another SC.
+ *
+ * \param pSensor       Pointer to the sensor list entry of the SC.
+ * \param timeStamp     Timestamp of the sample.
+ * \param quantities    Bitmask of the quantities in pValues, see
+ *                      @ref E_APP_QUANTITY_t.
+ * \param pValues       Values indexed by @ref E_APP_QUANTITY_t.
+ *
+ * \return @ref E_SF_RETURN_t
+ */
+/*============================================================================*/
+E_SF_RETURN_t sf_app_measStore_append(const sf_sensor_t *pSensor,
+                                      uint32_t timeStamp, uint8_t quantities,
+                                      const float *pValues);
+
+/*============================================================================*/
+/**
+ * \brief Returns the latest sample of a quantity of a SC.
+ *
+ * \param index         Sensor list index of the SC.
+ * \param quantity      Quantity.
+ * \param pTimeStamp    Pointer to the timestamp, may be NULL.
+ * \param pValue        Pointer to the value.
+ *
+ * \return @ref E_SF_RETURN_t, E_SF_ERROR if there is no sample.
+ */
+/*============================================================================*/
+E_SF_RETURN_t sf_app_measStore_getLatest(uint16_t index,
+                                         E_APP_QUANTITY_t quantity,
+                                         uint32_t *pTimeStamp, float *pValue);
+
+/*============================================================================*/
+/**
+ * \brief Returns the minimum, maximum and mean of a quantity of a SC over
+ *        the stored samples with a timestamp in [from, to].
+ *
+ * \param index         Sensor list index of the SC.
+ * \param quantity      Quantity.
+ * \param from          First timestamp of the window.
+ * \param to            Last timestamp of the window.
+ * \param pStats        Pointer to the statistics.
+ *
+ * \return @ref E_SF_RETURN_t, E_SF_ERROR if there is no sample in the
+ *         window.
+ */
+/*============================================================================*/
+E_SF_RETURN_t sf_app_measStore_getStats(uint16_t index,
+                                        E_APP_QUANTITY_t quantity,
+                                        uint32_t from, uint32_t to,
+                                        sf_app_measStats_t *pStats);
+
+/*============================================================================*/
+/**
+ * \brief Returns the value of a quantity of all SCs at the given time, that
+ *        is the latest sample of each SC with a timestamp up to timeStamp.
+ *
+ * \param quantity      Quantity.
+ * \param timeStamp     Time of the snapshot.
+ * \param pValues       Pointer to the values, SF_CONF_SENSOR_CNT_MAX
+ *                      entries indexed by sensor list index.
+ * \param pBitmap       Pointer to the bitmap of the SCs with a value, bit n
+ *                      (LSB first) for index n, SF_FRAME_BITMAP_LEN(
+ *                      SF_CONF_SENSOR_CNT_MAX) bytes. May be NULL.
+ *
+ * \return Number of SCs with a value.
+ */
+/*============================================================================*/
+uint16_t sf_app_measStore_getSnapshot(E_APP_QUANTITY_t quantity,
+                                      uint32_t timeStamp, float *pValues,
+                                      uint8_t *pBitmap);
+
+/*! @} */
+
+#endif /* __APP_MEAS_STORE_H__ */
+
+#ifdef __cplusplus
+}
+#endif
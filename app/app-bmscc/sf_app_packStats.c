@@ -0,0 +1,196 @@
+/**
+ * @code
+ *  ___ _____ _   ___ _  _____ ___  ___  ___ ___
+ * / __|_   _/_\ / __| |/ / __/ _ \| _ \/ __| __|
+ * \__ \ | |/ _ \ (__| ' <| _| (_) |   / (__| _|
+ * |___/ |_/_/ \_\___|_|\_\_| \___/|_|_\\___|___|
+ * embedded.connectivity.solutions.==============
+ * @endcode
+ *
+ * @copyright  STACKFORCE GmbH, Germany, www.stackforce.de
+ * @author     STACKFORCE
+ * @brief      API implementation of the pack statistics kernel.
+ *
+ */
+
+/*=============================================================================
+                                INCLUDES
+=============================================================================*/
+/* Standard include */
+#include <string.h>
+#include <math.h>
+/* Module specific include */
+#include "sf_frameType.h"
+#include "sf_app_packStats.h"
+#if SF_APP_PACK_STATS_SIMD
+#include CMSIS_CONF_HEADER_PATH
+#endif
+
+/*=============================================================================
+                                STRUCTS
+=============================================================================*/
+/*! Sums of the values */
+typedef struct
+{
+  /* Sum of the values */
+  int64_t sum;
+  /* Sum of the squared values */
+  int64_t sumSq;
+  /* Minimum value */
+  int16_t min;
+  /* Maximum value */
+  int16_t max;
+} packSums_t;
+
+/*=============================================================================
+                            LOCAL FUNCTIONS
+=============================================================================*/
+#if SF_APP_PACK_STATS_SIMD
+/*============================================================================*/
+/**
+ * \brief Sums up the values two at a time with the SIMD instructions.
+ */
+/*============================================================================*/
+static void loc_sumValues(const int16_t *pValues, uint16_t cnt,
+                          packSums_t *pSums)
+{
+  uint64_t sum = 0;
+  uint64_t sumSq = 0;
+  uint32_t pair;
+  uint32_t minPair;
+  uint32_t maxPair;
+  uint16_t i;
+
+  /* Both lanes start with the first value */
+  minPair = (uint16_t)pValues[0] | ((uint32_t)(uint16_t)pValues[0] << 16);
+  maxPair = minPair;
+
+  for(i = 0; i + 1U < cnt; i += 2U)
+  {
+    /* The values are not necessarily word aligned */
+    memcpy(&pair, &pValues[i], sizeof(pair));
+    /* lo * 1 + hi * 1 and lo * lo + hi * hi */
+    sum = __SMLALD(pair, 0x00010001U, sum);
+    sumSq = __SMLALD(pair, pair, sumSq);
+    /* GE flags are set for the lanes where pair >= minPair */
+    __SSUB16(pair, minPair);
+    minPair = __SEL(minPair, pair);
+    /* GE flags are set for the lanes where pair >= maxPair */
+    __SSUB16(pair, maxPair);
+    maxPair = __SEL(pair, maxPair);
+  }
+
+  pSums->sum = (int64_t)sum;
+  pSums->sumSq = (int64_t)sumSq;
+  pSums->min = (int16_t)minPair;
+  if((int16_t)(minPair >> 16) < pSums->min)
+  {
+    pSums->min = (int16_t)(minPair >> 16);
+  }
+  pSums->max = (int16_t)maxPair;
+  if((int16_t)(maxPair >> 16) > pSums->max)
+  {
+    pSums->max = (int16_t)(maxPair >> 16);
+  }
+
+  /* Odd number of values */
+  if(i < cnt)
+  {
+    pSums->sum += pValues[i];
+    pSums->sumSq += (int32_t)pValues[i] * pValues[i];
+    pSums->min = (pValues[i] < pSums->min) ? pValues[i] : pSums->min;
+    pSums->max = (pValues[i] > pSums->max) ? pValues[i] : pSums->max;
+  }
+}/* loc_sumValues() */
+#else
+/*============================================================================*/
+/**
+ * \brief Sums up the values.
+ */
+/*============================================================================*/
+static void loc_sumValues(const int16_t *pValues, uint16_t cnt,
+                          packSums_t *pSums)
+{
+  int64_t sum = 0;
+  int64_t sumSq = 0;
+  int16_t min = pValues[0];
+  int16_t max = pValues[0];
+
+  for(uint16_t i = 0; i < cnt; i++)
+  {
+    sum += pValues[i];
+    sumSq += (int32_t)pValues[i] * pValues[i];
+    min = (pValues[i] < min) ? pValues[i] : min;
+    max = (pValues[i] > max) ? pValues[i] : max;
+  }
+
+  pSums->sum = sum;
+  pSums->sumSq = sumSq;
+  pSums->min = min;
+  pSums->max = max;
+}/* loc_sumValues() */
+#endif
+
+/*=============================================================================
+                              API IMPLEMENTATION
+=============================================================================*/
+/*----------------------------------------------------------------------------*/
+/*! sf_app_packStats_compute */
+/*----------------------------------------------------------------------------*/
+E_SF_RETURN_t sf_app_packStats_compute(const int16_t *pValues, uint16_t cnt,
+                                       int16_t outlierLimit,
+                                       uint8_t *pOutliers,
+                                       sf_app_packStats_t *pStats)
+{
+  packSums_t sums;
+  int64_t deviation;
+  int64_t limit;
+
+  if(NULL == pValues || NULL == pStats)
+  {
+    return E_SF_ERROR_NPE;
+  }
+
+  if(0 == cnt || outlierLimit < 0)
+  {
+    return E_SF_ERROR_INVALID_PARAM;
+  }
+
+  loc_sumValues(pValues, cnt, &sums);
+
+  pStats->cnt = cnt;
+  pStats->min = sums.min;
+  pStats->max = sums.max;
+  pStats->mean = (float)sums.sum / cnt;
+  /* cnt^2 * variance = cnt * sum(v^2) - sum(v)^2, exact in 64 bit */
+  pStats->stdDev = sqrtf((float)(cnt * sums.sumSq - sums.sum * sums.sum)) /
+                   cnt;
+  pStats->outlierCnt = 0;
+
+  if(NULL != pOutliers)
+  {
+    memset(pOutliers, 0, SF_FRAME_BITMAP_LEN(cnt));
+  }
+
+  /* |v - mean| > limit is checked as |cnt * v - sum| > cnt * limit, so no
+     cell is missed by rounding. Skipped if all values are within the limit
+     of each other. */
+  limit = (int64_t)cnt * outlierLimit;
+  if(sums.max - sums.min > outlierLimit)
+  {
+    for(uint16_t i = 0; i < cnt; i++)
+    {
+      deviation = (int64_t)cnt * pValues[i] - sums.sum;
+      if(deviation > limit || deviation < -limit)
+      {
+        if(NULL != pOutliers)
+        {
+          pOutliers[i / 8U] |= (uint8_t)(1U << (i % 8U));
+        }
+        pStats->outlierCnt++;
+      }
+    }
+  }
+
+  return E_SF_SUCCESS;
+}/* sf_app_packStats_compute() */
@@ -0,0 +1,113 @@
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ @code
+  ___ _____ _   ___ _  _____ ___  ___  ___ ___
+ / __|_   _/_\ / __| |/ / __/ _ \| _ \/ __| __|
+ \__ \ | |/ _ \ (__| ' <| _| (_) |   / (__| _|
+ |___/ |_/_/ \_\___|_|\_\_| \___/|_|_\\___|___|
+ embedded.connectivity.solutions.==============
+ @endcode
+
+ @file
+ @copyright  STACKFORCE GmbH, Germany, www.stackforce.de
+ @author     STACKFORCE
+ @brief      This header contains the interfaces of the pack statistics
+             kernel.
+*/
+
+#ifndef __APP_PACK_STATS_H__
+#define __APP_PACK_STATS_H__
+
+/**
+ *  @addtogroup SF_APP_PACK_STATS
+ *
+ *  @details
+ *
+ *  The pack statistics kernel computes the minimum, maximum, mean, standard
+ *  deviation and the outliers of one quantity over all cells of the pack.
+ *  The values are fixed point (e.g. voltage in mV), so two values fit into
+ *  a 32 bit word. On a Cortex-M4 the kernel uses the SIMD instructions of
+ *  the DSP extension (SMLALD, SSUB16, SEL) to process two cells per
+ *  instruction, on other targets a scalar loop with the same result.
+ *
+ *  - <b>Pack statistics API</b>\n
+ *    | API Function                              | Description                                     |
+ *    |-------------------------------------------|-------------------------------------------------|
+ *    | @ref sf_app_packStats_compute()           | @copybrief sf_app_packStats_compute()           |
+ *  @{
+ */
+
+/*=============================================================================
+                                INCLUDES
+=============================================================================*/
+/* Standard include */
+#include <stdint.h>
+/* Application includes */
+#include "sf_types.h"
+
+/*=============================================================================
+                                MACROS
+=============================================================================*/
+/* Use the SIMD instructions of the Cortex-M4 DSP extension */
+#ifdef SF_APP_CONF_PACK_STATS_SIMD
+#define SF_APP_PACK_STATS_SIMD          SF_APP_CONF_PACK_STATS_SIMD
+#elif defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#define SF_APP_PACK_STATS_SIMD          1
+#else
+#define SF_APP_PACK_STATS_SIMD          0
+#endif
+
+/*=============================================================================
+                                STRUCTS
+=============================================================================*/
+/*! Statistics of a quantity over the cells of the pack */
+typedef struct
+{
+  /* Number of cells */
+  uint16_t cnt;
+  /* Minimum value */
+  int16_t min;
+  /* Maximum value */
+  int16_t max;
+  /* Mean value */
+  float mean;
+  /* Standard deviation of the values */
+  float stdDev;
+  /* Number of cells deviating more than the outlier limit from the mean */
+  uint16_t outlierCnt;
+} sf_app_packStats_t;
+
+/*=============================================================================
+                                API FUNCTIONS
+=============================================================================*/
+/*============================================================================*/
+/**
+ * \brief Computes the statistics of a quantity over the cells of the pack.
+ *
+ * \param pValues       Pointer to the fixed-point values of the cells.
+ * \param cnt           Number of values.
+ * \param outlierLimit  Maximum deviation from the mean of a cell that is no
+ *                      outlier, in the unit of the values.
+ * \param pOutliers     Pointer to the bitmap of the outliers, bit n (LSB
+ *                      first) for pValues[n], SF_FRAME_BITMAP_LEN(cnt)
+ *                      bytes. May be NULL.
+ * \param pStats        Pointer to the statistics.
+ *
+ * \return @ref E_SF_RETURN_t
+ */
+/*============================================================================*/
+E_SF_RETURN_t sf_app_packStats_compute(const int16_t *pValues, uint16_t cnt,
+                                       int16_t outlierLimit,
+                                       uint8_t *pOutliers,
+                                       sf_app_packStats_t *pStats);
+
+/*! @} */
+
+#endif /* __APP_PACK_STATS_H__ */
+
+#ifdef __cplusplus
+}
+#endif
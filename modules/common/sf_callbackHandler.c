@@ -27,9 +27,6 @@ extern "C" {
 #include "net/nullnet/nullnet.h"
 /* Application include */
 #include "sf_frameType.h"
-#include "sf_join.h"
-#include "sf_joinManager.h"
-#include "sf_app_api.h"
 #include "sf_callbackHandler.h"
 
 /* Log configuration */
@@ -45,9 +42,31 @@ extern "C" {
   #define LOG_LEVEL     LOG_CONF_APP
 #endif
 
+/*=============================================================================
+                            GLOBAL VARIABLES
+=============================================================================*/
+/* Input handlers indexed by frame type. */
+static sf_callbackHandler_inputFct_t gInputHandler[E_FRAME_TYPE_UNDEFINED];
+
 /*=============================================================================
                               API IMPLEMENTATION
 =============================================================================*/
+/*----------------------------------------------------------------------------*/
+/*! sf_callbackHandler_registerInput */
+/*----------------------------------------------------------------------------*/
+E_SF_RETURN_t sf_callbackHandler_registerInput(E_FRAME_TYPE_t frameType,
+                                               sf_callbackHandler_inputFct_t fct)
+{
+  if(frameType >= E_FRAME_TYPE_UNDEFINED)
+  {
+    return E_SF_ERROR_INVALID_PARAM;
+  }
+
+  gInputHandler[frameType] = fct;
+
+  return E_SF_SUCCESS;
+}/* sf_callbackHandler_registerInput() */
+
 /*----------------------------------------------------------------------------*/
 /*! sf_output_callback_handler */
 /*----------------------------------------------------------------------------*/
@@ -65,15 +84,10 @@ void sf_output_callback_handler(void *ptr, nullnet_tx_status_t status,
   /* Cast ptr into callback handler context. */
   callbackHandlerCtxt = (sf_callbackHandlerCtxt_t*) ptr;
 
-  if(callbackHandlerCtxt->callbackFctPointer == sf_join_output_callback)
+  if(NULL != callbackHandlerCtxt->callbackFctPointer)
   {
-    /* Output callback is from a join message. */
-    sf_join_output_callback(callbackHandlerCtxt->callbackFctDataPointer, status);
-  }
-  else if(callbackHandlerCtxt->callbackFctPointer == sf_app_output_callback)
-  {
-    /* Output callback is from application message. */
-    sf_app_output_callback(callbackHandlerCtxt->callbackFctDataPointer, status);
+    callbackHandlerCtxt->callbackFctPointer(
+        callbackHandlerCtxt->callbackFctDataPointer, status);
   }
 } /* sf_output_callback_handler() */
 
@@ -90,23 +104,15 @@ void sf_input_callback_handler(const void *data, uint16_t len,
   typeGet = sf_frameType_get((uint8_t*)data, &frameType);
   if(E_SF_SUCCESS == typeGet)
   {
-    switch (frameType)
+    if(frameType < E_FRAME_TYPE_UNDEFINED && NULL != gInputHandler[frameType])
+    {
+      gInputHandler[frameType]((uint8_t*)data, len, (linkaddr_t *)src);
+    }
+    else
     {
-      case E_FRAME_TYPE_REQUEST:
-        /* FALLTHROUGH */
-      case E_FRAME_TYPE_RESPONSE:
-        /* FALLTHROUGH */
-      case E_FRAME_TYPE_SUCCESSFUL:
-        sf_join_handleFrame((uint8_t*)data, len, (linkaddr_t *)src);
-        break;
-      case E_FRAME_TYPE_MEASUREMENT:
-        sf_app_handleMeasurement((uint8_t*)data, len, (linkaddr_t *)src);
-        break;
-      default:
-        LOG_INFO("!Can not handle the received frame ; device address ;");
-        LOG_INFO_LLADDR(src);
-        LOG_INFO_("\n");
-        break;
+      LOG_INFO("!Can not handle the received frame ; device address ;");
+      LOG_INFO_LLADDR(src);
+      LOG_INFO_("\n");
     }
   }
   else
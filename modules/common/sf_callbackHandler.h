@@ -28,6 +28,20 @@ extern "C" {
 #include <stdlib.h>
 /* Stack include */
 #include "net/nullnet/nullnet.h"
+/* Application include */
+#include "sf_types.h"
+#include "sf_frameType.h"
+
+/*=============================================================================
+                                TYPEDEFS
+=============================================================================*/
+/** Handler of the received frames of a frame type. */
+typedef void (*sf_callbackHandler_inputFct_t)(uint8_t *pInBuf, uint16_t length,
+                                              linkaddr_t *pSrc);
+
+/** Output callback function of a transmitted frame. */
+typedef void (*sf_callbackHandler_outputFct_t)(void *ptr,
+                                               nullnet_tx_status_t status);
 
 /*=============================================================================
                                 STRUCTS
@@ -36,7 +50,7 @@ extern "C" {
 typedef struct
 {
   /* Pointer to the output callback function */
-  const void *callbackFctPointer;
+  sf_callbackHandler_outputFct_t callbackFctPointer;
   /* Pointer to the application data */
   void *callbackFctDataPointer;
 } sf_callbackHandlerCtxt_t;
@@ -46,7 +60,23 @@ typedef struct
 =============================================================================*/
 /*============================================================================*/
 /**
- * \brief Input Callback Handler.
+ * \brief Registers the handler of the received frames of a frame type. A
+ *        frame type has at most one handler, a registered handler is
+ *        replaced.
+ *
+ * \param frameType     Frame type.
+ * \param fct           Handler, NULL to drop the frames of the frame type.
+ *
+ * \return @ref E_SF_RETURN_t
+ */
+/*============================================================================*/
+E_SF_RETURN_t sf_callbackHandler_registerInput(E_FRAME_TYPE_t frameType,
+                                               sf_callbackHandler_inputFct_t fct);
+
+/*============================================================================*/
+/**
+ * \brief Input Callback Handler. Passes the frame to the handler registered
+ *        for its frame type.
  *
  * \param	data      Data Pointer.
  * \param	len       Length of the Data.
@@ -59,7 +89,8 @@ void sf_input_callback_handler(const void *data, uint16_t len,
 
 /*============================================================================*/
 /**
- * \brief Output Callback Handler.
+ * \brief Output Callback Handler. Calls the output callback function of
+ *        the callback handler context with its data pointer.
  *
  * \param	ptr            Callback Handler Pointer.
  * \param	status         Nullnet tx status.
@@ -35,6 +35,9 @@ extern "C" {
                              MACROS
 ==============================================================================*/
 #define SF_FRAME_TYPE_LEN       0x01
+/* Length of the bitmap that addresses cnt devices in a multicast frame.
+   Bit n (LSB first) addresses the device with the short address n + 1. */
+#define SF_FRAME_BITMAP_LEN(cnt)  (((cnt) + 7U) / 8U)
 
 /*==============================================================================
                              ENUM
@@ -62,6 +65,15 @@ typedef enum
      Used for transmitting config/cmd
      to the endpoints. */
   E_FRAME_TYPE_REMOTE = 4,
+  /* Multicast remote frame type.
+     Used for transmitting config/cmd
+     to the endpoints addressed by a
+     bitmap, in a broadcast slot. */
+  E_FRAME_TYPE_MULTICAST = 5,
+  /* Batched measurement frame type.
+     Used for transmitting several
+     measurement samples at once. */
+  E_FRAME_TYPE_MEASUREMENT_BATCH = 6,
   /* Invalid frame type. */
   E_FRAME_TYPE_UNDEFINED
 } E_FRAME_TYPE_t;
@@ -18,14 +18,20 @@
 ==============================================================================*/
 /* Standard library. */
 #include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
 /* SDK includes */
 #if !CONTIKI_TARGET_COOJA
+#if !CONTIKI_TARGET_NATIVE
 #include <ti/devices/DeviceFamily.h>
 #include DeviceFamily_constructPath(driverlib/flash.h)
+#endif
 #include "flash_interface.h"
 #else
 #include "eeprom.h"
 #endif
+/* Contiki include. */
+#include "contiki.h"
 /* Module specific include. */
 #include "sf_persistentDataStorage.h"
 #include "contiki-crc16.h"
@@ -53,6 +59,82 @@
 #define SF_PERSISTENTDATASTORAGE_CONFIG_FLAG         0xB0
 /* Sensor list flag */
 #define SF_PERSISTENTDATASTORAGE_SENSORLIST_FLAG     0xC0
+/* Number of flash pages the sensor list journal rotates over. The last
+   journal page is the former sensor list page. */
+#ifndef SF_PERSISTENTDATASTORAGE_CONF_JOURNAL_PAGES
+#define SF_PERSISTENTDATASTORAGE_JOURNAL_PAGES       2
+#else
+#define SF_PERSISTENTDATASTORAGE_JOURNAL_PAGES       SF_PERSISTENTDATASTORAGE_CONF_JOURNAL_PAGES
+#endif
+/* Sensor list journal base address. */
+#define SF_PERSISTENTDATASTORAGE_JOURNAL_BASEADDR    SF_PERSISTENTDATASTORAGE_SENSORLIST_BASEADDR - \
+                                                     (SF_PERSISTENTDATASTORAGE_JOURNAL_PAGES - 1) * \
+                                                     SF_PERSISTENTDATASTORAGE_PAGE_SIZE
+/* Journal page header flag */
+#define SF_PERSISTENTDATASTORAGE_JOURNAL_FLAG        0xD0
+/* Journal record flag */
+#define SF_PERSISTENTDATASTORAGE_JOURNAL_RECORD      0xE0
+/* Marks that no journal page is in use */
+#define SF_PERSISTENTDATASTORAGE_JOURNAL_NO_PAGE     0xFF
+
+/* Time after the first change before deferred items are stored. */
+#ifndef SF_PERSISTENTDATASTORAGE_CONF_FLUSH_DELAY
+#define SF_PERSISTENTDATASTORAGE_FLUSH_DELAY         (2 * CLOCK_SECOND)
+#else
+#define SF_PERSISTENTDATASTORAGE_FLUSH_DELAY         SF_PERSISTENTDATASTORAGE_CONF_FLUSH_DELAY
+#endif
+
+#if SF_PERSISTENTDATASTORAGE_JOURNAL_PAGES < 2
+#error "The sensor list journal needs at least two pages!"
+#endif
+
+/*==============================================================================
+                          STRUCTS
+==============================================================================*/
+/*! Header at the start of each journal page. It is written after the
+    snapshot records of the page, so a page with a valid header always
+    holds the complete sensor list. */
+PACKED_STRUCT(typedef struct
+{
+  uint8_t flag;
+  /* Incremented for each page written, the highest one is the active page. */
+  uint32_t sequence;
+  /* The calculated CRC. */
+  uint16_t crc;
+}, sf_persistent_journalHeader_t);
+
+/*! A journal record sets one sensor list entry. Removed entries are
+    recorded with a zero address and serial number. */
+PACKED_STRUCT(typedef struct
+{
+  uint8_t flag;
+  /* Sensor list index. */
+  uint16_t index;
+  /* Sensor short address. */
+  uint8_t deviceAddr[2];
+  /* Serial number of the sensor. */
+  uint32_t deviceSerial;
+  /* The calculated CRC. */
+  uint16_t crc;
+}, sf_persistent_journalRecord_t);
+
+/*! State of the sensor list journal */
+typedef struct
+{
+  /* True as soon as the active page and write offset are known. */
+  bool located;
+  /* Active journal page index, SF_PERSISTENTDATASTORAGE_JOURNAL_NO_PAGE if none. */
+  uint8_t page;
+  /* Sequence number of the active page. */
+  uint32_t sequence;
+  /* Offset of the next record in the active page. */
+  uint32_t offset;
+} sf_persistent_journal_t;
+
+/* The complete sensor list must fit into one journal page. */
+#if (SF_PERSISTENT_SENSOR_CNT_MAX * 11 + 7) > SF_PERSISTENTDATASTORAGE_PAGE_SIZE
+#error "The sensor list does not fit into a journal page!"
+#endif
 
 /*==============================================================================
                           GLOBAL PARAMS
@@ -62,6 +144,10 @@
 static const uint32_t gDeviceConfigAddress = (uint32_t)SF_PERSISTENTDATASTORAGE_CONFIG_BASEADDR;
 /* Sensor list storage address */
 static const uint32_t gSensorListAddress = (uint32_t)SF_PERSISTENTDATASTORAGE_SENSORLIST_BASEADDR;
+/* Sensor list journal address */
+static const uint32_t gJournalAddress = (uint32_t)SF_PERSISTENTDATASTORAGE_JOURNAL_BASEADDR;
+/* Sensor list journal state */
+static sf_persistent_journal_t gJournal = {false, SF_PERSISTENTDATASTORAGE_JOURNAL_NO_PAGE, 0, 0};
 #else
 /* Device life time configuration address. */
 static const uint32_t gDeviceConfigAddress = 0;
@@ -69,6 +155,13 @@ static const uint32_t gDeviceConfigAddress = 0;
 static const uint32_t gSensorListAddress = sizeof(sf_persistent_deviceConfig_t);
 #endif
 
+/* Flush handlers of the items to be stored, NULL if an item is unchanged. */
+static sf_persistent_flushHandler_t gpFlushHandler[E_SF_PERSISTENT_ITEM_CNT];
+
+#if SF_PERSISTENTDATASTORAGE_FLUSH_DELAY
+PROCESS(sf_persistentDataStorage_process, "Persistence process");
+#endif
+
 /*==============================================================================
                       LOCAL FUNCTION
 ==============================================================================*/
@@ -118,6 +211,95 @@ E_SF_RETURN_t loc_readFlash(uint32_t address, uint8_t *pData, uint32_t datalen)
   return readStatus;
 }/* loc_readFlash */
 
+#if !CONTIKI_TARGET_COOJA
+/*----------------------------------------------------------------------------*/
+/*! loc_journalPageAddress */
+/*----------------------------------------------------------------------------*/
+static uint32_t loc_journalPageAddress(uint8_t page)
+{
+  return gJournalAddress + (uint32_t)page * SF_PERSISTENTDATASTORAGE_PAGE_SIZE;
+}/* loc_journalPageAddress */
+
+/*----------------------------------------------------------------------------*/
+/*! loc_journalScan */
+/*----------------------------------------------------------------------------*/
+static void loc_journalScan(sf_persistent_sensorList_t* pPersistentSensorList)
+{
+  sf_persistent_journalHeader_t header;
+  sf_persistent_journalRecord_t record;
+  uint32_t offset;
+
+  gJournal.page = SF_PERSISTENTDATASTORAGE_JOURNAL_NO_PAGE;
+  gJournal.sequence = 0;
+  gJournal.offset = 0;
+
+  /* The page with the highest sequence number is the active one. */
+  for(uint8_t page = 0; page < SF_PERSISTENTDATASTORAGE_JOURNAL_PAGES; page++)
+  {
+    if((E_SF_SUCCESS == loc_readFlash(loc_journalPageAddress(page),
+                                      (uint8_t*)&header, sizeof(header))) &&
+       (SF_PERSISTENTDATASTORAGE_JOURNAL_FLAG == header.flag) &&
+       (header.crc == crc16_data((uint8_t*)&header,
+                                 sizeof(header) - sizeof(uint16_t), 0)) &&
+       ((SF_PERSISTENTDATASTORAGE_JOURNAL_NO_PAGE == gJournal.page) ||
+        (header.sequence > gJournal.sequence)))
+    {
+      gJournal.page = page;
+      gJournal.sequence = header.sequence;
+    }
+  }
+
+  if(NULL != pPersistentSensorList)
+  {
+    memset(pPersistentSensorList, 0U, sizeof(sf_persistent_sensorList_t));
+  }
+
+  if(SF_PERSISTENTDATASTORAGE_JOURNAL_NO_PAGE != gJournal.page)
+  {
+    /* Replay the records up to the first erased one. Records with a wrong
+       CRC (interrupted write) are skipped. */
+    for(offset = sizeof(header);
+        offset + sizeof(record) <= SF_PERSISTENTDATASTORAGE_PAGE_SIZE;
+        offset += sizeof(record))
+    {
+      if((E_SF_SUCCESS != loc_readFlash(loc_journalPageAddress(gJournal.page) + offset,
+                                        (uint8_t*)&record, sizeof(record))) ||
+         (0xFF == record.flag))
+      {
+        break;
+      }
+
+      if((NULL != pPersistentSensorList) &&
+         (SF_PERSISTENTDATASTORAGE_JOURNAL_RECORD == record.flag) &&
+         (record.index < SF_PERSISTENT_SENSOR_CNT_MAX) &&
+         (record.crc == crc16_data((uint8_t*)&record,
+                                   sizeof(record) - sizeof(uint16_t), 0)))
+      {
+        memcpy(pPersistentSensorList->pSensorList[record.index].deviceAddr,
+               record.deviceAddr, sizeof(record.deviceAddr));
+        pPersistentSensorList->pSensorList[record.index].deviceSerial = record.deviceSerial;
+      }
+    }
+    gJournal.offset = offset;
+
+    if(NULL != pPersistentSensorList)
+    {
+      for(uint16_t i = 0; i < SF_PERSISTENT_SENSOR_CNT_MAX; i++)
+      {
+        if((0 != pPersistentSensorList->pSensorList[i].deviceAddr[0]) ||
+           (0 != pPersistentSensorList->pSensorList[i].deviceAddr[1]))
+        {
+          pPersistentSensorList->registeredSensorCnt++;
+        }
+      }
+      pPersistentSensorList->flag = SF_PERSISTENTDATASTORAGE_SENSORLIST_FLAG;
+    }
+  }
+
+  gJournal.located = true;
+}/* loc_journalScan */
+#endif /* #if !CONTIKI_TARGET_COOJA */
+
 /*==============================================================================
                       API FUNCTION IMPLEMENTATION
 ==============================================================================*/
@@ -222,6 +404,61 @@ E_SF_RETURN_t sf_persistentDataStorage_writeSensorList(sf_persistent_sensorList_
     return E_SF_ERROR_INVALID_PARAM;
   }
 
+#if !CONTIKI_TARGET_COOJA
+  sf_persistent_journalHeader_t header;
+  sf_persistent_journalRecord_t record;
+  uint8_t page;
+  uint32_t pageAddress;
+  uint32_t offset = sizeof(header);
+
+  if(!gJournal.located)
+  {
+    loc_journalScan(NULL);
+  }
+
+  /* Compact the journal into the next page. The active page stays valid
+     until the header of the new page is written. */
+  page = (SF_PERSISTENTDATASTORAGE_JOURNAL_NO_PAGE == gJournal.page) ? 0U :
+         (gJournal.page + 1U) % SF_PERSISTENTDATASTORAGE_JOURNAL_PAGES;
+  pageAddress = loc_journalPageAddress(page);
+
+  if(FLASH_SUCCESS != eraseFlashPg(pageAddress / SF_PERSISTENTDATASTORAGE_PAGE_SIZE))
+  {
+    return E_SF_ERROR;
+  }
+
+  writeStatus = E_SF_SUCCESS;
+  for(uint16_t i = 0; (i < SF_PERSISTENT_SENSOR_CNT_MAX) && (E_SF_SUCCESS == writeStatus); i++)
+  {
+    if((0 != pPersistentSensorList->pSensorList[i].deviceAddr[0]) ||
+       (0 != pPersistentSensorList->pSensorList[i].deviceAddr[1]))
+    {
+      record.flag = SF_PERSISTENTDATASTORAGE_JOURNAL_RECORD;
+      record.index = i;
+      memcpy(record.deviceAddr, pPersistentSensorList->pSensorList[i].deviceAddr,
+             sizeof(record.deviceAddr));
+      record.deviceSerial = pPersistentSensorList->pSensorList[i].deviceSerial;
+      record.crc = crc16_data((uint8_t*)&record, sizeof(record) - sizeof(uint16_t), 0);
+      writeStatus = loc_writeFlash(pageAddress + offset, (uint8_t*)&record, sizeof(record));
+      offset += sizeof(record);
+    }
+  }
+
+  if(E_SF_SUCCESS == writeStatus)
+  {
+    header.flag = SF_PERSISTENTDATASTORAGE_JOURNAL_FLAG;
+    header.sequence = gJournal.sequence + 1U;
+    header.crc = crc16_data((uint8_t*)&header, sizeof(header) - sizeof(uint16_t), 0);
+    writeStatus = loc_writeFlash(pageAddress, (uint8_t*)&header, sizeof(header));
+  }
+
+  if(E_SF_SUCCESS == writeStatus)
+  {
+    gJournal.page = page;
+    gJournal.sequence = header.sequence;
+    gJournal.offset = offset;
+  }
+#else
   if(E_SF_SUCCESS == sf_persistentDataStorage_removeSensorList())
   {
     pPersistentSensorList->flag = SF_PERSISTENTDATASTORAGE_SENSORLIST_FLAG;
@@ -236,6 +473,7 @@ E_SF_RETURN_t sf_persistentDataStorage_writeSensorList(sf_persistent_sensorList_
                                   (uint8_t*)pPersistentSensorList,
                                   sizeof(sf_persistent_sensorList_t));
   }
+#endif
 
   return writeStatus;
 }/* sf_persistentDataStorage_writeSensorList() */
@@ -256,7 +494,17 @@ E_SF_RETURN_t sf_persistentDataStorage_readSensorList(sf_persistent_sensorList_t
     return E_SF_ERROR_INVALID_PARAM;
   }
 
-  /* Read from NVM */
+#if !CONTIKI_TARGET_COOJA
+  /* Replay the journal */
+  loc_journalScan(pPersistentSensorList);
+  if(SF_PERSISTENTDATASTORAGE_JOURNAL_NO_PAGE != gJournal.page)
+  {
+    return E_SF_SUCCESS;
+  }
+#endif
+
+  /* No journal yet, read the sensor list written by former versions. It is
+     moved into the journal with the next change. */
   readStatus = loc_readFlash(gSensorListAddress,
                              (uint8_t*)pPersistentSensorList,
                               sizeof(sf_persistent_sensorList_t));
@@ -282,15 +530,157 @@ E_SF_RETURN_t sf_persistentDataStorage_removeSensorList(void)
 {
   E_SF_RETURN_t  eraseStatus = E_SF_ERROR;
 #if !CONTIKI_TARGET_COOJA
-  uint8_t page = gSensorListAddress / SF_PERSISTENTDATASTORAGE_PAGE_SIZE;
-
-  if(FLASH_SUCCESS == eraseFlashPg(page))
+  eraseStatus = E_SF_SUCCESS;
+  /* The former sensor list page is the last journal page. */
+  for(uint8_t page = 0; page < SF_PERSISTENTDATASTORAGE_JOURNAL_PAGES; page++)
   {
-    eraseStatus = E_SF_SUCCESS;
+    if(FLASH_SUCCESS != eraseFlashPg(loc_journalPageAddress(page) /
+                                     SF_PERSISTENTDATASTORAGE_PAGE_SIZE))
+    {
+      eraseStatus = E_SF_ERROR;
+    }
   }
+
+  gJournal.located = true;
+  gJournal.page = SF_PERSISTENTDATASTORAGE_JOURNAL_NO_PAGE;
+  gJournal.sequence = 0;
+  gJournal.offset = 0;
 #else
   eraseStatus = E_SF_SUCCESS;
 #endif
 
   return eraseStatus;
 }/* sf_persistentDataStorage_removeSensorList() */
+
+/*----------------------------------------------------------------------------*/
+/*! sf_persistentDataStorage_writeSensorListEntry */
+/*----------------------------------------------------------------------------*/
+E_SF_RETURN_t sf_persistentDataStorage_writeSensorListEntry(uint16_t index,
+                                                            sf_persistent_sensor_t* pSensor)
+{
+  if((NULL == pSensor) || (index >= SF_PERSISTENT_SENSOR_CNT_MAX))
+  {
+    return E_SF_ERROR_INVALID_PARAM;
+  }
+
+#if !CONTIKI_TARGET_COOJA
+  sf_persistent_journalRecord_t record;
+
+  if(!gJournal.located)
+  {
+    loc_journalScan(NULL);
+  }
+
+  /* No journal yet or the active page is full: the caller has to write
+     the complete list, which compacts the journal into the next page. */
+  if((SF_PERSISTENTDATASTORAGE_JOURNAL_NO_PAGE == gJournal.page) ||
+     (gJournal.offset + sizeof(record) > SF_PERSISTENTDATASTORAGE_PAGE_SIZE))
+  {
+    return E_SF_ERROR_BUSY;
+  }
+
+  record.flag = SF_PERSISTENTDATASTORAGE_JOURNAL_RECORD;
+  record.index = index;
+  memcpy(record.deviceAddr, pSensor->deviceAddr, sizeof(record.deviceAddr));
+  record.deviceSerial = pSensor->deviceSerial;
+  record.crc = crc16_data((uint8_t*)&record, sizeof(record) - sizeof(uint16_t), 0);
+
+  /* Skip the slot even if the write fails, it is not erased anymore. */
+  gJournal.offset += sizeof(record);
+
+  return loc_writeFlash(loc_journalPageAddress(gJournal.page) + gJournal.offset -
+                        sizeof(record), (uint8_t*)&record, sizeof(record));
+#else
+  /* No journal on the EEPROM, always write the complete list. */
+  return E_SF_ERROR_BUSY;
+#endif
+}/* sf_persistentDataStorage_writeSensorListEntry() */
+
+/*----------------------------------------------------------------------------*/
+/*! sf_persistentDataStorage_setDirty */
+/*----------------------------------------------------------------------------*/
+void sf_persistentDataStorage_setDirty(E_SF_PERSISTENT_ITEM_t item,
+                                       sf_persistent_flushHandler_t fnFlush)
+{
+  if((item >= E_SF_PERSISTENT_ITEM_CNT) || (NULL == fnFlush))
+  {
+    return;
+  }
+
+  gpFlushHandler[item] = fnFlush;
+
+#if SF_PERSISTENTDATASTORAGE_FLUSH_DELAY
+  if(!process_is_running(&sf_persistentDataStorage_process))
+  {
+    process_start(&sf_persistentDataStorage_process, NULL);
+  }
+  process_poll(&sf_persistentDataStorage_process);
+#else
+  sf_persistentDataStorage_flush();
+#endif
+}/* sf_persistentDataStorage_setDirty() */
+
+/*----------------------------------------------------------------------------*/
+/*! sf_persistentDataStorage_flush */
+/*----------------------------------------------------------------------------*/
+E_SF_RETURN_t sf_persistentDataStorage_flush(void)
+{
+  E_SF_RETURN_t flushStatus = E_SF_SUCCESS;
+  E_SF_RETURN_t returnValue;
+  sf_persistent_flushHandler_t fnFlush;
+
+  for(uint8_t item = 0; item < E_SF_PERSISTENT_ITEM_CNT; item++)
+  {
+    fnFlush = gpFlushHandler[item];
+    if(NULL != fnFlush)
+    {
+      /* Clear first, the handler may mark the item again. */
+      gpFlushHandler[item] = NULL;
+      returnValue = fnFlush();
+      if(E_SF_SUCCESS != returnValue)
+      {
+        /* Keep the item pending, the next flush retries it. */
+        gpFlushHandler[item] = fnFlush;
+        if(E_SF_SUCCESS == flushStatus)
+        {
+          flushStatus = returnValue;
+        }
+      }
+    }
+  }
+
+  return flushStatus;
+}/* sf_persistentDataStorage_flush() */
+
+#if SF_PERSISTENTDATASTORAGE_FLUSH_DELAY
+/*==============================================================================
+                      PROCESSES IMPLEMENTATION
+==============================================================================*/
+/*------------------------------------------------------------------------------
+  sf_persistentDataStorage_process()
+------------------------------------------------------------------------------*/
+PROCESS_THREAD(sf_persistentDataStorage_process, ev, data)
+{
+  static struct etimer flushTimer;
+
+  PROCESS_BEGIN();
+
+  while(1)
+  {
+    /* Wait for the first change */
+    PROCESS_WAIT_EVENT_UNTIL(ev == PROCESS_EVENT_POLL);
+
+    /* Collect further changes before writing to the flash */
+    etimer_set(&flushTimer, SF_PERSISTENTDATASTORAGE_FLUSH_DELAY);
+    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&flushTimer));
+
+    if(E_SF_SUCCESS != sf_persistentDataStorage_flush())
+    {
+      /* Retry the failed items after the next delay */
+      process_poll(&sf_persistentDataStorage_process);
+    }
+  }
+
+  PROCESS_END();
+}/* sf_persistentDataStorage_process() */
+#endif /* #if SF_PERSISTENTDATASTORAGE_FLUSH_DELAY */
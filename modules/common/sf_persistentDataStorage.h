@@ -113,6 +113,23 @@ extern "C" {
 #define SF_PERSISTENT_SENSOR_CNT_MAX           SF_CONF_SENSOR_CNT_MAX
 #endif
 
+/*==============================================================================
+                             ENUMS
+==============================================================================*/
+/*! Items which can be stored deferred by the persistence process */
+typedef enum
+{
+  /* Device life time configuration */
+  E_SF_PERSISTENT_ITEM_CONFIG = 0x00,
+  /* Sensor list */
+  E_SF_PERSISTENT_ITEM_SENSORLIST,
+  /* Number of items */
+  E_SF_PERSISTENT_ITEM_CNT
+} E_SF_PERSISTENT_ITEM_t;
+
+/*! Stores a deferred item, called by the persistence process */
+typedef E_SF_RETURN_t (*sf_persistent_flushHandler_t)(void);
+
 /*==============================================================================
                              STRUCTS
 ==============================================================================*/
@@ -195,6 +212,9 @@ E_SF_RETURN_t sf_persistentDataStorage_removeConfig(void);
  * \brief Store the sensor list and the registered sensors count in the
  *        NVM memory.
  *
+ *        The list is written as snapshot into the next page of the sensor
+ *        list journal, which compacts the journal.
+ *
  * \param pPersistentSensorList    Pointer to the data to be stored.
  *
  * \return @ref E_SF_RETURN_t.
@@ -217,6 +237,24 @@ E_SF_RETURN_t sf_persistentDataStorage_writeSensorList(sf_persistent_sensorList_
 E_SF_RETURN_t sf_persistentDataStorage_readSensorList(sf_persistent_sensorList_t*
                                                        pPersistentSensorList);
 
+/*============================================================================*/
+/**
+ * \brief Store a single sensor list entry in the NVM memory.
+ *
+ *        The change is appended to the sensor list journal, without erasing
+ *        flash. If the journal has no room for it, @ref E_SF_ERROR_BUSY is
+ *        returned and the complete list has to be stored with
+ *        @ref sf_persistentDataStorage_writeSensorList instead.
+ *
+ * \param index      Sensor list index of the entry.
+ * \param pSensor    The entry, zero address and serial for a removed sensor.
+ *
+ * \return @ref E_SF_RETURN_t.
+ */
+/*============================================================================*/
+E_SF_RETURN_t sf_persistentDataStorage_writeSensorListEntry(uint16_t index,
+                                                            sf_persistent_sensor_t* pSensor);
+
 /*============================================================================*/
 /**
  * \brief Remove the sensor list from the NVM memory.
@@ -226,6 +264,31 @@ E_SF_RETURN_t sf_persistentDataStorage_readSensorList(sf_persistent_sensorList_t
 /*============================================================================*/
 E_SF_RETURN_t sf_persistentDataStorage_removeSensorList(void);
 
+/*============================================================================*/
+/**
+ * \brief Mark an item to be stored in the NVM memory later.
+ *
+ *        The persistence process calls the flush handler of the item
+ *        SF_PERSISTENTDATASTORAGE_FLUSH_DELAY after the first change, so
+ *        changes within that window are stored together. With a delay of 0
+ *        the item is stored immediately.
+ *
+ * \param item       The item that changed.
+ * \param fnFlush    Handler storing the item.
+ */
+/*============================================================================*/
+void sf_persistentDataStorage_setDirty(E_SF_PERSISTENT_ITEM_t item,
+                                       sf_persistent_flushHandler_t fnFlush);
+
+/*============================================================================*/
+/**
+ * \brief Store all items marked with @ref sf_persistentDataStorage_setDirty
+ *        right away, e.g. before a shutdown or reset.
+ *
+ * \return @ref E_SF_RETURN_t.
+ */
+/*============================================================================*/
+E_SF_RETURN_t sf_persistentDataStorage_flush(void);
 
 #endif /* __SF_PERSISTENT_DATA_STORAGE_H__ */
 
@@ -93,7 +93,7 @@ uint8_t sf_stateManager_getState(stateManager_ctx_t* pCtx)
 /*----------------------------------------------------------------------------*/
 /*! sf_stateManager_execState */
 /*----------------------------------------------------------------------------*/
-E_SF_RETURN_t sf_stateManager_execState(stateManager_ctx_t* pCtx)
+E_SF_RETURN_t sf_stateManager_execState(stateManager_ctx_t* pCtx, void *pData)
 {
   /* Return value. */
   E_SF_RETURN_t execStatus = E_SF_SUCCESS;
@@ -109,7 +109,7 @@ E_SF_RETURN_t sf_stateManager_execState(stateManager_ctx_t* pCtx)
 
   if(NULL != stateFct)
   {
-    stateFct();
+    stateFct(pData);
   }
   else
   {
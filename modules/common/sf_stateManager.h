@@ -34,8 +34,9 @@ extern "C" {
 /*==============================================================================
                              FUNCTION TYPE
 ==============================================================================*/
-/*! Function prototype of state functions. */
-typedef void (*stateManager_stateFct_t)( void );
+/*! Function prototype of state functions. The argument is the data handed
+    to @ref sf_stateManager_execState. */
+typedef void (*stateManager_stateFct_t)( void *pData );
 
 /*==============================================================================
                              STRUCTS
@@ -107,11 +108,12 @@ uint8_t sf_stateManager_getState(stateManager_ctx_t* pCtx);
  * \brief Call the current state function.
  *
  * \param pCtx                 Pointer to the context storage
+ * \param pData                Data passed to the state function.
  *
  * \return @ref E_SF_RETURN_t.
  */
 /*============================================================================*/
-E_SF_RETURN_t sf_stateManager_execState(stateManager_ctx_t* pCtx);
+E_SF_RETURN_t sf_stateManager_execState(stateManager_ctx_t* pCtx, void *pData);
 
 #endif /* __SF_STATE_MANAGER_H__ */
 
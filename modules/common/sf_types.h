@@ -67,6 +67,19 @@ typedef enum
   E_SF_JOIN_BEACON_ENABLED = 0x01,
 }E_SF_JOIN_BEACON_t;
 
+/*! Binary log modules, the upper byte of the binary log IDs. */
+typedef enum
+{
+  /*!
+    * 0x08 : Join module.
+    */
+  E_SF_LOG_BIN_MODULE_JOIN = 0x08,
+  /*!
+    * 0x09 : Application.
+    */
+  E_SF_LOG_BIN_MODULE_APP = 0x09,
+}E_SF_LOG_BIN_MODULE_t;
+
 /*! @} */
 
 #endif /* __SF_TYPES_H__ */
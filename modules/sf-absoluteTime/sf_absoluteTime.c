@@ -18,7 +18,7 @@
 ==============================================================================*/
 /* Stack include */
 #include "net/mac/tsch/tsch.h"
-#if !CONTIKI_TARGET_COOJA
+#if !CONTIKI_TARGET_COOJA && !CONTIKI_TARGET_NATIVE
 #include <ti/drivers/dpl/ClockP.h>
 #else
 #include "process.h"
@@ -40,7 +40,7 @@
 /*==============================================================================
                             GLOBAL VARIABLES
 ==============================================================================*/
-#if !CONTIKI_TARGET_COOJA
+#if !CONTIKI_TARGET_COOJA && !CONTIKI_TARGET_NATIVE
 ClockP_Struct clockStruct;
 ClockP_Handle clockHandle;
 extern uint32_t ClockP_tickPeriod;
@@ -50,7 +50,7 @@ extern uint32_t ClockP_tickPeriod;
                                     ISR
 ==============================================================================*/
 /* General purpose timer callback function */
-#if !CONTIKI_TARGET_COOJA
+#if !CONTIKI_TARGET_COOJA && !CONTIKI_TARGET_NATIVE
 static void absoluteTime_isr(uintptr_t arg0);
 #endif
 
@@ -58,14 +58,14 @@ static void absoluteTime_isr(uintptr_t arg0);
                                     PROCESSES
 ==============================================================================*/
 /* Handles absolute time increment */
-#if CONTIKI_TARGET_COOJA
+#if CONTIKI_TARGET_COOJA || CONTIKI_TARGET_NATIVE
 PROCESS(absoluteTime_increment_process, "Absolute time increment process");
 #endif
 
 /*==============================================================================
                                 ISR IMPLEMENTATION
 ==============================================================================*/
-#if !CONTIKI_TARGET_COOJA
+#if !CONTIKI_TARGET_COOJA && !CONTIKI_TARGET_NATIVE
 /*----------------------------------------------------------------------------*/
 /*! absoluteTime_isr */
 /*----------------------------------------------------------------------------*/
@@ -160,7 +160,7 @@ uint32_t sf_absoluteTime_getTime(void)
 /*----------------------------------------------------------------------------*/
 E_SF_RETURN_t sf_absoluteTime_startTimer(void)
 {
-#if !CONTIKI_TARGET_COOJA
+#if !CONTIKI_TARGET_COOJA && !CONTIKI_TARGET_NATIVE
   ClockP_Params clkParams;
   ClockP_Params_init(&clkParams);
 
@@ -185,7 +185,7 @@ E_SF_RETURN_t sf_absoluteTime_startTimer(void)
 /*==============================================================================
                                 PROCESS IMPLEMENTATION
 ==============================================================================*/
-#if CONTIKI_TARGET_COOJA
+#if CONTIKI_TARGET_COOJA || CONTIKI_TARGET_NATIVE
 /*----------------------------------------------------------------------------*/
 /*! absoluteTime_increment_process */
 /*----------------------------------------------------------------------------*/
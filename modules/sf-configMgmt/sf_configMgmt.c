@@ -20,12 +20,14 @@
 #include <stdio.h>
 #include <string.h>
 /* Stack includes */
-#if !CONTIKI_TARGET_COOJA
+#if !CONTIKI_TARGET_COOJA && !CONTIKI_TARGET_NATIVE
 #include <ti/devices/DeviceFamily.h>
 #include DeviceFamily_constructPath(inc/hw_memmap.h)
 #include DeviceFamily_constructPath(inc/hw_fcfg1.h)
 #include DeviceFamily_constructPath(inc/hw_ccfg.h)
 #include "ieee-addr.h"
+#elif CONTIKI_TARGET_NATIVE
+#include "net/linkaddr.h"
 #else
 #include <dev/moteid.h>
 #endif
@@ -47,6 +49,25 @@
 /* SC configuration parameters */
 sf_deviceConfig_t gDeviceConfig = {0};
 
+/*****************************************************************************/
+/*                         LOCAL FUNCTIONS                                   */
+/*****************************************************************************/
+/*------------------------------------------------------------------------------
+  loc_writeConfig()
+------------------------------------------------------------------------------*/
+static E_SF_RETURN_t loc_writeConfig(void)
+{
+  /* Buffer to store the configuration to be written into the flash. */
+  sf_persistent_deviceConfig_t persistentDeviceConfig;
+
+  persistentDeviceConfig.deviceSerial = gDeviceConfig.deviceSerial;
+  persistentDeviceConfig.panId = gDeviceConfig.panId;
+  memcpy(persistentDeviceConfig.deviceAddr, gDeviceConfig.deviceAddr.u8,
+        sizeof(persistentDeviceConfig.deviceAddr));
+
+  return sf_persistentDataStorage_writeConfig(&persistentDeviceConfig);
+}/* loc_writeConfig() */
+
 /*****************************************************************************/
 /*                         API FUNCTIONS                                     */
 /*****************************************************************************/
@@ -57,8 +78,6 @@ E_SF_RETURN_t sf_configMgmt_setParam(const void* pParamData, size_t paramSize,
                                      SF_CONFIGMGMT_PARAM_t paramType)
 {
   E_SF_RETURN_t returnValue = E_SF_ERROR_INVALID_PARAM;
-  /* Buffer to store the configuration to be written into the flash. */
-  sf_persistent_deviceConfig_t persistentDeviceConfig;
 
   if(NULL == pParamData)
   {
@@ -97,11 +116,9 @@ E_SF_RETURN_t sf_configMgmt_setParam(const void* pParamData, size_t paramSize,
 
   if(E_SF_SUCCESS == returnValue)
   {
-    persistentDeviceConfig.deviceSerial = gDeviceConfig.deviceSerial;
-    persistentDeviceConfig.panId = gDeviceConfig.panId;
-    memcpy(persistentDeviceConfig.deviceAddr, gDeviceConfig.deviceAddr.u8,
-          sizeof(persistentDeviceConfig.deviceAddr));
-    returnValue = sf_persistentDataStorage_writeConfig(&persistentDeviceConfig);
+    /* Changes in quick succession are written to the flash at once. */
+    sf_persistentDataStorage_setDirty(E_SF_PERSISTENT_ITEM_CONFIG,
+                                      loc_writeConfig);
   }
 
   return returnValue;
@@ -166,14 +183,17 @@ E_SF_RETURN_t sf_configMgmt_setDefaultConfig(void)
   uint16_t panId = 0;
   /* Serial number */
   uint32_t serialNr = 0;
-#if !CONTIKI_TARGET_COOJA
+#if !CONTIKI_TARGET_COOJA && !CONTIKI_TARGET_NATIVE
   /* Pointer to IEEE MAC address */
   uint8_t *pMacAddr = NULL;
 #endif
 
-#if !CONTIKI_TARGET_COOJA
+#if !CONTIKI_TARGET_COOJA && !CONTIKI_TARGET_NATIVE
   /* Set the IEEE MAC address as device link address as it should be unique. */
   ieee_addr_cpy_to(bmsccAddr.u8, LINKADDR_SIZE);
+#elif CONTIKI_TARGET_NATIVE
+  /* The native platform derives the link address from the node ID. */
+  linkaddr_copy(&bmsccAddr, &linkaddr_node_addr);
 #else
   bmsccAddr.u16 = (uint16_t)simMoteID;
 #endif
@@ -184,8 +204,10 @@ E_SF_RETURN_t sf_configMgmt_setDefaultConfig(void)
   if(E_SF_SUCCESS == returnVal)
   {
     /* Use the IEEE MAC address to set the network ID as it should be unique.*/
-#if !CONTIKI_TARGET_COOJA
+#if !CONTIKI_TARGET_COOJA && !CONTIKI_TARGET_NATIVE
     ieee_addr_cpy_to((uint8_t*)&panId, sizeof(panId));
+#elif CONTIKI_TARGET_NATIVE
+    memcpy(&panId, linkaddr_node_addr.u8, sizeof(panId));
 #else
   panId = (uint16_t)simMoteID;
 #endif
@@ -196,9 +218,11 @@ E_SF_RETURN_t sf_configMgmt_setDefaultConfig(void)
 
   if(E_SF_SUCCESS == returnVal)
   {
-#if !CONTIKI_TARGET_COOJA
+#if !CONTIKI_TARGET_COOJA && !CONTIKI_TARGET_NATIVE
     pMacAddr = (uint8_t*)SF_CONFIGMGMT_MAC_PRIMARY_ADDRESS;
     memcpy(&serialNr, pMacAddr, sizeof(serialNr));
+#elif CONTIKI_TARGET_NATIVE
+    serialNr = (uint32_t)linkaddr_node_addr.u16;
 #else
     serialNr = (uint32_t)simMoteID;
 #endif
@@ -80,6 +80,9 @@ typedef enum
 /**
  * \brief Set the configuration parameter.
  *
+ *        The configuration is written to the flash by the persistence
+ *        process, see @ref sf_persistentDataStorage_setDirty.
+ *
  * \param pParamData       Pointer to the parameter value.
  * \param paramSize        Size of the parameter value.
  * \param paramType        The type of the parameter.
@@ -37,6 +37,11 @@
 #define LOG_LEVEL                   LOG_CONF_APP
 #endif
 
+/* Marks an empty slot of the serial number hash table */
+#define SF_DEVICEMGMT_HASH_EMPTY             0U
+/* Number of 32 bit words of the used entry bitmap */
+#define SF_DEVICEMGMT_USED_MAP_WORDS         ((SF_DEVICEMGMT_SENSOR_CNT_MAX + 31U) / 32U)
+
 /*****************************************************************************/
 /*                         GLOBAL VARIABLES                                  */
 /*****************************************************************************/
@@ -44,6 +49,17 @@
 static sf_sensor_t gpSensorList[SF_DEVICEMGMT_SENSOR_CNT_MAX] = {0};
 /* Stores the number of registered devices */
 static uint16_t gRegisteredDevicesCnt = 0;
+/* Open addressing hash table of the serial numbers. Holds the sensor list
+   index + 1 of each registered serial number, 0 for an empty slot. */
+static uint16_t gSerialHash[SF_DEVICEMGMT_SERIAL_HASH_SIZE] = {0};
+/* One bit per sensor list entry, set if the entry is used */
+static uint32_t gUsedMap[SF_DEVICEMGMT_USED_MAP_WORDS] = {0};
+/* One bit per sensor list entry, set if the address is reserved for a
+   device which is joining */
+static uint32_t gReservedMap[SF_DEVICEMGMT_USED_MAP_WORDS] = {0};
+/* One bit per sensor list entry, set if the entry is not yet stored in the
+   NVM */
+static uint32_t gDirtyMap[SF_DEVICEMGMT_USED_MAP_WORDS] = {0};
 
 /*****************************************************************************/
 /*                         LOCAL FUNCTIONS                                   */
@@ -57,6 +73,79 @@ static uint16_t gRegisteredDevicesCnt = 0;
 /*============================================================================*/
 static E_SF_RETURN_t loc_writeSensorList(void);
 
+/*============================================================================*/
+/**
+ * @brief Stores the changed sensor list entries, called by the persistence
+ *        process. Falls back to storing the complete list if the entries
+ *        can not be appended to the journal.
+ *
+ * @return @ref E_SF_RETURN_t
+ * */
+/*============================================================================*/
+static E_SF_RETURN_t loc_flushSensorList(void);
+
+/*============================================================================*/
+/**
+ * @brief Marks a sensor list entry to be stored by the persistence process.
+ * */
+/*============================================================================*/
+static void loc_setEntryDirty(uint16_t listIndex);
+
+/*============================================================================*/
+/**
+ * @brief Returns the sensor list index the short address is assigned to.
+ *        Short addresses are assigned as list index + 1.
+ *
+ * @return List index or SF_DEVICEMGMT_SENSOR_CNT_MAX if out of range.
+ * */
+/*============================================================================*/
+static uint16_t loc_addrToIndex(const linkaddr_t* pShortAddress);
+
+/*============================================================================*/
+/**
+ * @brief Returns the home slot of a serial number in the hash table.
+ * */
+/*============================================================================*/
+static uint16_t loc_hashSerial(uint32_t serial);
+
+/*============================================================================*/
+/**
+ * @brief Searches the hash table for a serial number.
+ *
+ * @return Hash table slot holding the serial or the empty slot where it
+ *         would be inserted.
+ * */
+/*============================================================================*/
+static uint16_t loc_findSerialSlot(uint32_t serial);
+
+/*============================================================================*/
+/**
+ * @brief Adds the serial number of a sensor list entry to the hash table.
+ * */
+/*============================================================================*/
+static void loc_hashInsert(uint16_t listIndex);
+
+/*============================================================================*/
+/**
+ * @brief Removes a serial number from the hash table.
+ * */
+/*============================================================================*/
+static void loc_hashRemove(uint32_t serial);
+
+/*============================================================================*/
+/**
+ * @brief Marks a sensor list entry as used or free.
+ * */
+/*============================================================================*/
+static void loc_setEntryUsed(uint16_t listIndex, bool isUsed);
+
+/*============================================================================*/
+/**
+ * @brief Rebuilds serial hash table and used entry bitmap from the sensor list.
+ * */
+/*============================================================================*/
+static void loc_rebuildIndex(void);
+
 /*****************************************************************************/
 /*                         LOCAL FUNCTIONS IMPLEMENTATION                    */
 /*****************************************************************************/
@@ -83,6 +172,196 @@ static E_SF_RETURN_t loc_writeSensorList(void)
   return returnValue;
 }/* loc_writeSensorList */
 
+/*----------------------------------------------------------------------------*/
+/*! loc_flushSensorList */
+/*----------------------------------------------------------------------------*/
+static E_SF_RETURN_t loc_flushSensorList(void)
+{
+  E_SF_RETURN_t returnValue = E_SF_SUCCESS;
+  E_SF_RETURN_t writeStatus;
+  sf_persistent_sensor_t persistentSensor;
+  uint32_t pending;
+  uint16_t listIndex;
+
+  for(uint16_t i = 0; i < SF_DEVICEMGMT_USED_MAP_WORDS; i++)
+  {
+    pending = gDirtyMap[i];
+    while(0 != pending)
+    {
+      listIndex = (i * 32U) + __builtin_ctz(pending);
+      pending &= pending - 1U;
+
+      memcpy(persistentSensor.deviceAddr,
+             (uint8_t*)gpSensorList[listIndex].shortAddress.u8, LINKADDR_SIZE);
+      persistentSensor.deviceSerial = gpSensorList[listIndex].serialNr;
+
+      writeStatus = sf_persistentDataStorage_writeSensorListEntry(listIndex,
+                                                                  &persistentSensor);
+      if(E_SF_ERROR_BUSY == writeStatus)
+      {
+        /* Journal is full, store and compact the complete list, which also
+           stores the entries that failed before. The entries stay dirty
+           until the list is written. */
+        writeStatus = loc_writeSensorList();
+        if(E_SF_SUCCESS == writeStatus)
+        {
+          memset(gDirtyMap, 0x00, sizeof(gDirtyMap));
+        }
+        return writeStatus;
+      }
+
+      if(E_SF_SUCCESS == writeStatus)
+      {
+        /* Only a stored entry is clean, a failed one is retried */
+        gDirtyMap[i] &= ~(1UL << (listIndex % 32U));
+      }
+      else if(E_SF_SUCCESS == returnValue)
+      {
+        /* Report the first error */
+        returnValue = writeStatus;
+      }
+    }
+  }
+
+  return returnValue;
+}/* loc_flushSensorList */
+
+/*----------------------------------------------------------------------------*/
+/*! loc_setEntryDirty */
+/*----------------------------------------------------------------------------*/
+static void loc_setEntryDirty(uint16_t listIndex)
+{
+  gDirtyMap[listIndex / 32U] |= (1UL << (listIndex % 32U));
+  sf_persistentDataStorage_setDirty(E_SF_PERSISTENT_ITEM_SENSORLIST,
+                                    loc_flushSensorList);
+}/* loc_setEntryDirty */
+
+/*----------------------------------------------------------------------------*/
+/*! loc_addrToIndex */
+/*----------------------------------------------------------------------------*/
+static uint16_t loc_addrToIndex(const linkaddr_t* pShortAddress)
+{
+  uint16_t listIndex = pShortAddress->u16 - 1U;
+
+  if(listIndex >= SF_DEVICEMGMT_SENSOR_CNT_MAX)
+  {
+    return SF_DEVICEMGMT_SENSOR_CNT_MAX;
+  }
+
+  return listIndex;
+}/* loc_addrToIndex */
+
+/*----------------------------------------------------------------------------*/
+/*! loc_hashSerial */
+/*----------------------------------------------------------------------------*/
+static uint16_t loc_hashSerial(uint32_t serial)
+{
+  /* Multiplicative (Fibonacci) hashing, keeps the upper bits */
+  return (uint16_t)((uint32_t)(serial * 2654435761UL) >>
+                    (32U - SF_DEVICEMGMT_SERIAL_HASH_BITS));
+}/* loc_hashSerial */
+
+/*----------------------------------------------------------------------------*/
+/*! loc_findSerialSlot */
+/*----------------------------------------------------------------------------*/
+static uint16_t loc_findSerialSlot(uint32_t serial)
+{
+  uint16_t slot = loc_hashSerial(serial);
+
+  /* The table is at least twice as large as the sensor list,
+     so there is always an empty slot to stop at. */
+  while((SF_DEVICEMGMT_HASH_EMPTY != gSerialHash[slot]) &&
+        (gpSensorList[gSerialHash[slot] - 1U].serialNr != serial))
+  {
+    slot = (slot + 1U) & (SF_DEVICEMGMT_SERIAL_HASH_SIZE - 1U);
+  }
+
+  return slot;
+}/* loc_findSerialSlot */
+
+/*----------------------------------------------------------------------------*/
+/*! loc_hashInsert */
+/*----------------------------------------------------------------------------*/
+static void loc_hashInsert(uint16_t listIndex)
+{
+  uint16_t slot = loc_findSerialSlot(gpSensorList[listIndex].serialNr);
+
+  gSerialHash[slot] = listIndex + 1U;
+}/* loc_hashInsert */
+
+/*----------------------------------------------------------------------------*/
+/*! loc_hashRemove */
+/*----------------------------------------------------------------------------*/
+static void loc_hashRemove(uint32_t serial)
+{
+  uint16_t slot = loc_findSerialSlot(serial);
+  uint16_t next = slot;
+
+  if(SF_DEVICEMGMT_HASH_EMPTY == gSerialHash[slot])
+  {
+    return;
+  }
+
+  /* Backward shift deletion: move following entries of the probe
+     sequence into the gap, so no tombstones are needed. */
+  while(true)
+  {
+    uint16_t home;
+
+    gSerialHash[slot] = SF_DEVICEMGMT_HASH_EMPTY;
+    do
+    {
+      next = (next + 1U) & (SF_DEVICEMGMT_SERIAL_HASH_SIZE - 1U);
+      if(SF_DEVICEMGMT_HASH_EMPTY == gSerialHash[next])
+      {
+        return;
+      }
+      home = loc_hashSerial(gpSensorList[gSerialHash[next] - 1U].serialNr);
+      /* Keep the entry if its home slot lies cyclically in (slot, next] */
+    } while((slot < next) ? ((slot < home) && (home <= next)) :
+                            ((slot < home) || (home <= next)));
+
+    gSerialHash[slot] = gSerialHash[next];
+    slot = next;
+  }
+}/* loc_hashRemove */
+
+/*----------------------------------------------------------------------------*/
+/*! loc_setEntryUsed */
+/*----------------------------------------------------------------------------*/
+static void loc_setEntryUsed(uint16_t listIndex, bool isUsed)
+{
+  if(isUsed)
+  {
+    gUsedMap[listIndex / 32U] |= (1UL << (listIndex % 32U));
+  }
+  else
+  {
+    gUsedMap[listIndex / 32U] &= ~(1UL << (listIndex % 32U));
+  }
+}/* loc_setEntryUsed */
+
+/*----------------------------------------------------------------------------*/
+/*! loc_rebuildIndex */
+/*----------------------------------------------------------------------------*/
+static void loc_rebuildIndex(void)
+{
+  memset(gSerialHash, 0x00, sizeof(gSerialHash));
+  memset(gUsedMap, 0x00, sizeof(gUsedMap));
+
+  for(uint16_t i = 0; i < SF_DEVICEMGMT_SENSOR_CNT_MAX; i++)
+  {
+    if(!linkaddr_cmp(&gpSensorList[i].shortAddress, &linkaddr_null))
+    {
+      loc_setEntryUsed(i, true);
+    }
+    if(0 != gpSensorList[i].serialNr)
+    {
+      loc_hashInsert(i);
+    }
+  }
+}/* loc_rebuildIndex */
+
 /*****************************************************************************/
 /*                         API FUNCTIONS                                     */
 /*****************************************************************************/
@@ -99,44 +378,55 @@ sf_sensor_t* sf_deviceMgmt_getSensorList(void)
 ------------------------------------------------------------------------------*/
 E_SF_RETURN_t sf_deviceMgmt_getFreeAddress(uint16_t *pShortAddress, uint32_t serial)
 {
-  E_SF_RETURN_t returnValue = E_SF_ERROR;
-  uint8_t sensorListIndex = 0;
-  uint8_t firstEmptyIndex = 0xFF;
+  sf_sensor_t* sensorListEntry;
 
-  /* Search for empty field */
-  for(sensorListIndex = 0; sensorListIndex < SF_DEVICEMGMT_SENSOR_CNT_MAX;
-      sensorListIndex++)
+  /* Check if serial is already in sensor list. If yes return the same entry. */
+  sensorListEntry = sf_deviceMgmt_getDeviceBySerial(serial);
+  if(NULL != sensorListEntry)
   {
-    /* Found empty sensor list entry */
-    if((firstEmptyIndex == 0xFF) &&
-       (linkaddr_cmp(&gpSensorList[sensorListIndex].shortAddress, &linkaddr_null)))
-    {
-      firstEmptyIndex = sensorListIndex;
-      returnValue = E_SF_SUCCESS;
-    }
+    LOG_INFO("Sensor (SerialNo: %ld) is already registered with addr: ", serial);
+    LOG_INFO_LLADDR(&sensorListEntry->shortAddress);
+    LOG_INFO_("\n");
 
-    /* Check if serial is already in sensor list. If yes return the same entry. */
-    if(gpSensorList[sensorListIndex].serialNr == serial)
+    *pShortAddress = (uint16_t)(sensorListEntry - gpSensorList) + 1U;
+    return E_SF_SUCCESS;
+  }
+
+  /* Take the first empty and not reserved entry of the used entry bitmap */
+  for(uint16_t i = 0; i < SF_DEVICEMGMT_USED_MAP_WORDS; i++)
+  {
+    uint32_t takenMap = gUsedMap[i] | gReservedMap[i];
+
+    if(0xFFFFFFFFUL != takenMap)
     {
-      LOG_INFO("Sensor (SerialNo: %ld) is already registered with addr: ", serial);
-      LOG_INFO_LLADDR(&gpSensorList[sensorListIndex].shortAddress);
-      LOG_INFO_("\n");
+      uint16_t listIndex = (i * 32U) + __builtin_ctz(~takenMap);
 
-      firstEmptyIndex = sensorListIndex;
-      returnValue = E_SF_SUCCESS;
-      break;
+      if(listIndex < SF_DEVICEMGMT_SENSOR_CNT_MAX)
+      {
+        /* If the list entry is an empty entry, return the list index + 1
+           as new link address. */
+        gReservedMap[i] |= (1UL << (listIndex % 32U));
+        *pShortAddress = listIndex + 1U;
+        return E_SF_SUCCESS;
+      }
     }
   }
 
-  if(returnValue == E_SF_SUCCESS && firstEmptyIndex != 0xFF)
+  return E_SF_ERROR;
+} /* sf_deviceMgmt_getFreeAddress() */
+
+/*------------------------------------------------------------------------------
+  sf_deviceMgmt_releaseAddress()
+------------------------------------------------------------------------------*/
+void sf_deviceMgmt_releaseAddress(linkaddr_t shortAddress)
+{
+  uint16_t listIndex = loc_addrToIndex(&shortAddress);
+
+  if(listIndex < SF_DEVICEMGMT_SENSOR_CNT_MAX)
   {
-    /* If the list entry is an empty entry, return the list index + 1
-       as new link address. */
-    *pShortAddress = firstEmptyIndex + 1;
+    gReservedMap[listIndex / 32U] &= ~(1UL << (listIndex % 32U));
   }
-
-  return returnValue;
-} /* sf_deviceMgmt_getFreeAddress() */
+} /* sf_deviceMgmt_releaseAddress() */
 
 /*------------------------------------------------------------------------------
   sf_deviceMgmt_addDevice()
@@ -156,7 +446,7 @@ E_SF_RETURN_t sf_deviceMgmt_addDevice(linkaddr_t shortAddress, uint32_t serial)
   }
   else
   {
-    sensorListEntry = sf_deviceMgmt_getDeviceByIndex(shortAddress.u16 - 1);
+    sensorListEntry = sf_deviceMgmt_getDeviceByIndex(loc_addrToIndex(&shortAddress));
     if(sensorListEntry)
     {
       /* If device is not in the list check if sensor list entry is still empty. */
@@ -171,6 +461,12 @@ E_SF_RETURN_t sf_deviceMgmt_addDevice(linkaddr_t shortAddress, uint32_t serial)
   {
     linkaddr_copy(&sensorListEntry->shortAddress, &shortAddress);
     sensorListEntry->serialNr = serial;
+    loc_setEntryUsed(sensorListEntry - gpSensorList, true);
+    sf_deviceMgmt_releaseAddress(shortAddress);
+    if(0 != serial)
+    {
+      loc_hashInsert(sensorListEntry - gpSensorList);
+    }
 
     if(!alreadyInList)
     {
@@ -179,7 +475,7 @@ E_SF_RETURN_t sf_deviceMgmt_addDevice(linkaddr_t shortAddress, uint32_t serial)
     }
 
     LOG_INFO("-- New Sensor List --\n");
-    for(uint8_t listIndex=0; listIndex < SF_DEVICEMGMT_SENSOR_CNT_MAX; listIndex++)
+    for(uint16_t listIndex=0; listIndex < SF_DEVICEMGMT_SENSOR_CNT_MAX; listIndex++)
     {
       uint32_t serial = (uint32_t)gpSensorList[listIndex].serialNr;
 
@@ -188,8 +484,9 @@ E_SF_RETURN_t sf_deviceMgmt_addDevice(linkaddr_t shortAddress, uint32_t serial)
       LOG_INFO_("; \n");
     }
 
-    /* Stores the new sensor list into the NVM */
-    returnValue = loc_writeSensorList();
+    /* Stores the new sensor list entry into the NVM later, so joins in
+       quick succession do not stall on the flash. */
+    loc_setEntryDirty(sensorListEntry - gpSensorList);
   }
 
   return returnValue;
@@ -201,30 +498,30 @@ E_SF_RETURN_t sf_deviceMgmt_addDevice(linkaddr_t shortAddress, uint32_t serial)
 E_SF_RETURN_t sf_deviceMgmt_removeDevice(linkaddr_t shortAddr)
 {
   E_SF_RETURN_t returnValue = E_SF_ERROR;
-  uint8_t sensorListIndex = 0;
+  sf_sensor_t* sensorListEntry = sf_deviceMgmt_getDevice(shortAddr);
+  uint16_t sensorListIndex = 0;
 
-  if(gRegisteredDevicesCnt > 0)
+  if(NULL != sensorListEntry)
   {
-    for(sensorListIndex = 0; sensorListIndex < SF_DEVICEMGMT_SENSOR_CNT_MAX;
-        sensorListIndex++)
+    if(0 != sensorListEntry->serialNr)
     {
-      if(linkaddr_cmp(&shortAddr, &gpSensorList[sensorListIndex].shortAddress))
-      {
-        /* Remove entry at sensor list index of listIdx */
-        memset(&gpSensorList[sensorListIndex], 0U, sizeof(gpSensorList[sensorListIndex]));
+      loc_hashRemove(sensorListEntry->serialNr);
+    }
 
-        gRegisteredDevicesCnt--;
+    /* Remove entry at sensor list index of listIdx */
+    memset(sensorListEntry, 0U, sizeof(*sensorListEntry));
+    sensorListIndex = sensorListEntry - gpSensorList;
+    loc_setEntryUsed(sensorListIndex, false);
 
-        returnValue = E_SF_SUCCESS;
-        break;
-      }
-    }
+    gRegisteredDevicesCnt--;
+
+    returnValue = E_SF_SUCCESS;
   }
 
   if(E_SF_SUCCESS == returnValue)
   {
-    /* Stores the new sensor list into the NVM */
-    returnValue = loc_writeSensorList();
+    /* Stores the removed sensor list entry into the NVM later */
+    loc_setEntryDirty(sensorListIndex);
   }
 
   return returnValue;
@@ -235,29 +532,24 @@ E_SF_RETURN_t sf_deviceMgmt_removeDevice(linkaddr_t shortAddr)
 ------------------------------------------------------------------------------*/
 sf_sensor_t* sf_deviceMgmt_getDevice(linkaddr_t shortAddress)
 {
-  sf_sensor_t* sensorListEntry = NULL;
-  uint8_t sensorListIndex = 0;
+  uint16_t sensorListIndex = loc_addrToIndex(&shortAddress);
 
-  if(0 != gRegisteredDevicesCnt)
+  /* A sensor is always stored at the list index its address was assigned
+     from, so the entry can be accessed directly. */
+  if((0 != gRegisteredDevicesCnt) &&
+     (sensorListIndex < SF_DEVICEMGMT_SENSOR_CNT_MAX) &&
+     linkaddr_cmp(&shortAddress, &gpSensorList[sensorListIndex].shortAddress))
   {
-    for(sensorListIndex = 0; sensorListIndex < SF_DEVICEMGMT_SENSOR_CNT_MAX;
-        sensorListIndex++)
-    {
-      if(linkaddr_cmp(&shortAddress, &gpSensorList[sensorListIndex].shortAddress))
-      {
-        sensorListEntry = &gpSensorList[sensorListIndex];
-        break;
-      }
-    }
+    return &gpSensorList[sensorListIndex];
   }
 
-  return sensorListEntry;
+  return NULL;
 } /* sf_deviceMgmt_getDevice() */
 
 /*------------------------------------------------------------------------------
   sf_deviceMgmt_getDeviceByIndex()
 ------------------------------------------------------------------------------*/
-sf_sensor_t* sf_deviceMgmt_getDeviceByIndex(uint8_t index)
+sf_sensor_t* sf_deviceMgmt_getDeviceByIndex(uint16_t index)
 {
   if(index < SF_DEVICEMGMT_SENSOR_CNT_MAX)
   {
@@ -272,29 +564,26 @@ sf_sensor_t* sf_deviceMgmt_getDeviceByIndex(uint8_t index)
 ------------------------------------------------------------------------------*/
 sf_sensor_t* sf_deviceMgmt_getDeviceBySerial(uint32_t serial)
 {
-  sf_sensor_t* sensorListEntry = NULL;
-  uint8_t sensorListIndex = 0;
+  uint16_t slot;
 
-  for(sensorListIndex = 0; sensorListIndex < SF_DEVICEMGMT_SENSOR_CNT_MAX;
-      sensorListIndex++)
+  if(0 == serial)
   {
-    if(0 != gpSensorList[sensorListIndex].serialNr)
-    {
-      if(serial == gpSensorList[sensorListIndex].serialNr)
-      {
-        sensorListEntry = &gpSensorList[sensorListIndex];
-        break;
-      }
-    }
+    return NULL;
   }
 
-  return sensorListEntry;
+  slot = loc_findSerialSlot(serial);
+  if(SF_DEVICEMGMT_HASH_EMPTY != gSerialHash[slot])
+  {
+    return &gpSensorList[gSerialHash[slot] - 1U];
+  }
+
+  return NULL;
 } /* sf_deviceMgmt_getDeviceBySerial() */
 
 /*------------------------------------------------------------------------------
   sf_deviceMgmt_getRegisteredDeviceCount()
 ------------------------------------------------------------------------------*/
-uint8_t sf_deviceMgmt_getRegisteredDeviceCount(void)
+uint16_t sf_deviceMgmt_getRegisteredDeviceCount(void)
 {
   return gRegisteredDevicesCnt;
 } /* sf_deviceMgmt_getRegisteredDeviceCount() */
@@ -323,5 +612,9 @@ E_SF_RETURN_t sf_deviceMgmt_readSensorList(void)
     gRegisteredDevicesCnt = persistentSensorList.registeredSensorCnt;
   }
 
+  /* Index the list read from the NVM, or the empty list */
+  loc_rebuildIndex();
+  memset(gDirtyMap, 0x00, sizeof(gDirtyMap));
+
   return readValue;
 } /* sf_deviceMgmt_readSensorList() */
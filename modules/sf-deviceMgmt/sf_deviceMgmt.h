@@ -30,6 +30,7 @@
  *    |-------------------------------------------|-------------------------------------------------|
  *    | @ref sf_deviceMgmt_getSensorList()        | @copybrief sf_deviceMgmt_getSensorList()        |
  *    | @ref sf_deviceMgmt_getFreeAddress()       | @copybrief sf_deviceMgmt_getFreeAddress()       |
+ *    | @ref sf_deviceMgmt_releaseAddress()       | @copybrief sf_deviceMgmt_releaseAddress()       |
  *    | @ref sf_deviceMgmt_addDevice()            | @copybrief sf_deviceMgmt_addDevice()            |
  *    | @ref sf_deviceMgmt_removeDevice()         | @copybrief sf_deviceMgmt_removeDevice()         |
  *    | @ref sf_deviceMgmt_getDevice()            | @copybrief sf_deviceMgmt_getDevice()            |
@@ -59,6 +60,25 @@
 #define SF_DEVICEMGMT_SENSOR_CNT_MAX           SF_CONF_SENSOR_CNT_MAX
 #endif
 
+/* Size of the serial number hash table as power of two. The table needs at
+   least twice as many slots as sensors to keep the probe sequences short. */
+#ifdef SF_CONF_DEVICEMGMT_SERIAL_HASH_BITS
+#define SF_DEVICEMGMT_SERIAL_HASH_BITS         SF_CONF_DEVICEMGMT_SERIAL_HASH_BITS
+#elif SF_DEVICEMGMT_SENSOR_CNT_MAX <= 32
+#define SF_DEVICEMGMT_SERIAL_HASH_BITS         6
+#elif SF_DEVICEMGMT_SENSOR_CNT_MAX <= 128
+#define SF_DEVICEMGMT_SERIAL_HASH_BITS         8
+#elif SF_DEVICEMGMT_SENSOR_CNT_MAX <= 512
+#define SF_DEVICEMGMT_SERIAL_HASH_BITS         10
+#else
+#define SF_DEVICEMGMT_SERIAL_HASH_BITS         11
+#endif
+#define SF_DEVICEMGMT_SERIAL_HASH_SIZE         (1U << SF_DEVICEMGMT_SERIAL_HASH_BITS)
+
+#if (SF_DEVICEMGMT_SERIAL_HASH_SIZE < (2 * SF_DEVICEMGMT_SENSOR_CNT_MAX))
+#error "SF_DEVICEMGMT_SERIAL_HASH_BITS is too small for SF_CONF_SENSOR_CNT_MAX!"
+#endif
+
 /*****************************************************************************/
 /*                         STRUCTS                                           */
 /*****************************************************************************/
@@ -88,6 +108,11 @@ sf_sensor_t* sf_deviceMgmt_getSensorList(void);
  * @brief Returns a free short address or the assigned short address if
  *        the device is already registered.
  *
+ *        A free address is reserved until the device is added with
+ *        @ref sf_deviceMgmt_addDevice or the address is released with
+ *        @ref sf_deviceMgmt_releaseAddress, so concurrent joins get
+ *        different addresses.
+ *
  * @param  pShortAddress    Pointer to SC short address
  * @param  serial           SC serial number
  *
@@ -96,6 +121,16 @@ sf_sensor_t* sf_deviceMgmt_getSensorList(void);
 /*============================================================================*/
 E_SF_RETURN_t sf_deviceMgmt_getFreeAddress(uint16_t *pShortAddress, uint32_t serial);
 
+/*============================================================================*/
+/**
+ * @brief Releases a short address reserved by
+ *        @ref sf_deviceMgmt_getFreeAddress if the join was not completed.
+ *
+ * @param  shortAddress    SC short address
+ */
+/*============================================================================*/
+void sf_deviceMgmt_releaseAddress(linkaddr_t shortAddress);
+
 /*============================================================================*/
 /**
  * @brief Adds new sensor entry to the sensor list.
@@ -122,6 +157,8 @@ E_SF_RETURN_t sf_deviceMgmt_removeDevice(linkaddr_t shortAddr);
 /*============================================================================*/
 /**
  * @brief Searches a sensor list entry with matching short address.
+ *        The entry is accessed directly, as short addresses are assigned
+ *        as list index + 1.
  *
  * @param  shortAddress    SC Short address
  *
@@ -139,11 +176,12 @@ sf_sensor_t* sf_deviceMgmt_getDevice(linkaddr_t shortAddress);
  * @return Pointer to sensor list entry.
  */
 /*============================================================================*/
-sf_sensor_t* sf_deviceMgmt_getDeviceByIndex(uint8_t index);
+sf_sensor_t* sf_deviceMgmt_getDeviceByIndex(uint16_t index);
 
 /*============================================================================*/
 /**
  * @brief Searches sensor list entry with matching device serial number.
+ *        Uses a hash table of the registered serial numbers.
  *
  * @param  serial         SC Serial address
  *
@@ -159,7 +197,7 @@ sf_sensor_t* sf_deviceMgmt_getDeviceBySerial(uint32_t serial);
  * @return Registered devices count
  */
 /*============================================================================*/
-uint8_t sf_deviceMgmt_getRegisteredDeviceCount(void);
+uint16_t sf_deviceMgmt_getRegisteredDeviceCount(void);
 
 /*============================================================================*/
 /**
@@ -49,6 +49,21 @@ extern "C" {
 /* Define frame maximum length. */
 #define SF_JOIN_FRAME_LENGTH_MAX                           (40U)
 
+/* Binary log records, see LOG_CONF_BINARY. The module is
+   E_SF_LOG_BIN_MODULE_JOIN. */
+enum
+{
+  LOG_ID_JOIN_REQ_RX = 0x0801,         /*! "Received join request message from %A : %B" */
+  LOG_ID_JOIN_REQ_PARSE_FAIL = 0x0802, /*! "Failed to parse the received join request message from %A !" */
+  LOG_ID_JOIN_RESP_RX = 0x0803,        /*! "Rx join response frame : %B" */
+  LOG_ID_JOIN_RESP_PARSE_FAIL = 0x0804,/*! "!Fail to parse join response" */
+  LOG_ID_JOIN_SUCC_RX = 0x0805,        /*! "Received JoinSuccessful message from %A : %B !" */
+  LOG_ID_JOIN_REQ_TX = 0x0806,         /*! "Tx JoinReq to %A : %B" */
+  LOG_ID_JOIN_RESP_TX = 0x0807,        /*! "Send JoinResponse message to %A : %B" */
+  LOG_ID_JOIN_SUCC_TX = 0x0808,        /*! "Tx JoinSuc to %A : %B" */
+  LOG_ID_JOIN_FRAME_INVALID = 0x0809,  /*! "Received invalid join frame;" */
+};
+
 /*==============================================================================
                              STRUCTS
 ==============================================================================*/
@@ -71,10 +86,12 @@ static uint8_t gFrameLen = 0;
 /**
  * \brief Hand the frame over to TSCH to be sent at the corresponding slot.
  *
- * \param pAddr            Destination address.
+ * \param pAddr                 Destination address.
+ * \param pCallbackHandlerCtxt  Output callback context.
  */
 /*============================================================================*/
-static void loc_sendFrame(linkaddr_t *pAddr);
+static void loc_sendFrame(linkaddr_t *pAddr,
+                          sf_callbackHandlerCtxt_t *pCallbackHandlerCtxt);
 
 /*============================================================================*/
 /**
@@ -122,13 +139,14 @@ static E_SF_RETURN_t loc_handleSuccessful(uint8_t *pSuccFrame, uint16_t length,
 /*----------------------------------------------------------------------------*/
 /*! loc_sendFrame */
 /*----------------------------------------------------------------------------*/
-static void loc_sendFrame(linkaddr_t *pAddr)
+static void loc_sendFrame(linkaddr_t *pAddr,
+                          sf_callbackHandlerCtxt_t *pCallbackHandlerCtxt)
 {
   nullnet_buf = gpFrameBuffer;
   nullnet_len = gFrameLen;
 
   /* Hand the frame over to the lower layer */
-  NETSTACK_NETWORK.output(pAddr, (void*) &gJoinCallbackHandlerCtxt,
+  NETSTACK_NETWORK.output(pAddr, (void*) pCallbackHandlerCtxt,
                           FRAME802154_JOINFRAME);
 }/* loc_sendFrame() */
 
@@ -146,11 +164,13 @@ static E_SF_RETURN_t loc_handleRequest(uint8_t *pReqFrame, uint16_t length,
     return E_SF_ERROR_INVALID_PARAM;
   }
 
-  LOG_INFO("Received join request message from ");
-  LOG_INFO_LLADDR(pSrcAddr);
-  LOG_INFO_(" : ");
-  LOG_INFO_BYTES(pReqFrame, length);
-  LOG_INFO_("\n");
+  LOG_BIN_OR_TEXT(LOG_BIN_INFO_BYTES(LOG_ID_JOIN_REQ_RX, pReqFrame, length,
+                                     LOG_BIN_LLADDR(pSrcAddr)),
+                  LOG_INFO("Received join request message from ");
+                  LOG_INFO_LLADDR(pSrcAddr);
+                  LOG_INFO_(" : ");
+                  LOG_INFO_BYTES(pReqFrame, length);
+                  LOG_INFO_("\n"));
 
   handleStatus = sf_joinFramer_parse_request(pReqFrame, length);
   if(E_SF_SUCCESS == handleStatus)
@@ -159,9 +179,10 @@ static E_SF_RETURN_t loc_handleRequest(uint8_t *pReqFrame, uint16_t length,
   }
   else
   {
-    LOG_INFO("Failed to parse the received join request message from ");
-    LOG_INFO_LLADDR(pSrcAddr);
-    LOG_INFO_(" !\n");
+    LOG_BIN_OR_TEXT(LOG_BIN_INFO(LOG_ID_JOIN_REQ_PARSE_FAIL, LOG_BIN_LLADDR(pSrcAddr)),
+                    LOG_INFO("Failed to parse the received join request message from ");
+                    LOG_INFO_LLADDR(pSrcAddr);
+                    LOG_INFO_(" !\n"));
   }
 
   return handleStatus;
@@ -181,10 +202,11 @@ static E_SF_RETURN_t loc_handleResponse(uint8_t *pRespFrame, uint16_t length)
     return E_SF_ERROR_INVALID_PARAM;
   }
 
-  LOG_INFO("Rx join response frame\n");
-  LOG_INFO_(" : ");
-  LOG_INFO_BYTES(pRespFrame, length);
-  LOG_INFO_(" \n");
+  LOG_BIN_OR_TEXT(LOG_BIN_INFO_BYTES(LOG_ID_JOIN_RESP_RX, pRespFrame, length),
+                  LOG_INFO("Rx join response frame\n");
+                  LOG_INFO_(" : ");
+                  LOG_INFO_BYTES(pRespFrame, length);
+                  LOG_INFO_(" \n"));
 
   handleStatus = sf_joinFramer_parse_response(pRespFrame, length);
   if(E_SF_SUCCESS == handleStatus)
@@ -193,7 +215,8 @@ static E_SF_RETURN_t loc_handleResponse(uint8_t *pRespFrame, uint16_t length)
   }
   else
   {
-    LOG_ERR("!Fail to parse join response \n");
+    LOG_BIN_OR_TEXT(LOG_BIN_ERR(LOG_ID_JOIN_RESP_PARSE_FAIL),
+                    LOG_ERR("!Fail to parse join response \n"));
   }
 
   return handleStatus;
@@ -210,11 +233,13 @@ static E_SF_RETURN_t loc_handleSuccessful(uint8_t *pSuccFrame, uint16_t length,
     return E_SF_ERROR_INVALID_PARAM;
   }
 
-  LOG_INFO("Received JoinSuccessful message from ");
-  LOG_INFO_LLADDR(pSrcAddr);
-  LOG_INFO_(" : ");
-  LOG_INFO_BYTES(pSuccFrame, length);
-  LOG_INFO_(" !\n");
+  LOG_BIN_OR_TEXT(LOG_BIN_INFO_BYTES(LOG_ID_JOIN_SUCC_RX, pSuccFrame, length,
+                                     LOG_BIN_LLADDR(pSrcAddr)),
+                  LOG_INFO("Received JoinSuccessful message from ");
+                  LOG_INFO_LLADDR(pSrcAddr);
+                  LOG_INFO_(" : ");
+                  LOG_INFO_BYTES(pSuccFrame, length);
+                  LOG_INFO_(" !\n"));
 
   sf_join_successful_receive(pSrcAddr);
 
@@ -243,15 +268,17 @@ E_SF_RETURN_t sf_join_request_send(linkaddr_t *pDestinationAddr)
   /* Send join request. */
   if(E_SF_SUCCESS == requestSent)
   {
-    LOG_INFO("Tx JoinReq to ");
-    LOG_INFO_LLADDR(pDestinationAddr);
-    LOG_INFO_(" : ");
-    LOG_INFO_BYTES(gpFrameBuffer, gFrameLen);
-    LOG_INFO_("\n");
+    LOG_BIN_OR_TEXT(LOG_BIN_INFO_BYTES(LOG_ID_JOIN_REQ_TX, gpFrameBuffer, gFrameLen,
+                                       LOG_BIN_LLADDR(pDestinationAddr)),
+                    LOG_INFO("Tx JoinReq to ");
+                    LOG_INFO_LLADDR(pDestinationAddr);
+                    LOG_INFO_(" : ");
+                    LOG_INFO_BYTES(gpFrameBuffer, gFrameLen);
+                    LOG_INFO_("\n"));
 
     /* Set the max number of transmissions, 8 = 1 transmission and 7 retry. */
     packetbuf_set_attr(PACKETBUF_ATTR_MAX_MAC_TRANSMISSIONS, 8U);
-    loc_sendFrame(pDestinationAddr);
+    loc_sendFrame(pDestinationAddr, &gJoinCallbackHandlerCtxt);
     /* Set the max number of transmissions, 1 = 1 transmission and 0 retry. */
     packetbuf_set_attr(PACKETBUF_ATTR_MAX_MAC_TRANSMISSIONS, 1U);
   }
@@ -263,7 +290,8 @@ E_SF_RETURN_t sf_join_request_send(linkaddr_t *pDestinationAddr)
 /*! sf_join_response_send */
 /*----------------------------------------------------------------------------*/
 E_SF_RETURN_t sf_join_response_send(linkaddr_t *pDestinationAddr,
-                                    linkaddr_t *pNewDeviceAddress)
+                                    linkaddr_t *pNewDeviceAddress,
+                                    sf_callbackHandlerCtxt_t *pCallbackHandlerCtxt)
 {
   /* Return value. */
   E_SF_RETURN_t responseSent = E_SF_SUCCESS;
@@ -278,13 +306,19 @@ E_SF_RETURN_t sf_join_response_send(linkaddr_t *pDestinationAddr,
 
   if(E_SF_SUCCESS == responseSent)
   {
-    LOG_INFO("Send JoinResponse message to ");
-    LOG_INFO_LLADDR(pDestinationAddr);
-    LOG_INFO_(" : ");
-    LOG_INFO_BYTES(gpFrameBuffer, SF_JOINFRAMER_RESPONSE_LENGTH);
-    LOG_INFO_("\n");
-
-    loc_sendFrame(pDestinationAddr);
+    LOG_BIN_OR_TEXT(LOG_BIN_INFO_BYTES(LOG_ID_JOIN_RESP_TX, gpFrameBuffer, SF_JOINFRAMER_RESPONSE_LENGTH,
+                                       LOG_BIN_LLADDR(pDestinationAddr)),
+                    LOG_INFO("Send JoinResponse message to ");
+                    LOG_INFO_LLADDR(pDestinationAddr);
+                    LOG_INFO_(" : ");
+                    LOG_INFO_BYTES(gpFrameBuffer, SF_JOINFRAMER_RESPONSE_LENGTH);
+                    LOG_INFO_("\n"));
+
+    if(NULL == pCallbackHandlerCtxt)
+    {
+      pCallbackHandlerCtxt = &gJoinCallbackHandlerCtxt;
+    }
+    loc_sendFrame(pDestinationAddr, pCallbackHandlerCtxt);
   }
 
   return responseSent;
@@ -308,15 +342,17 @@ E_SF_RETURN_t sf_join_successful_send(linkaddr_t *pDestinationAddr)
 
   if(E_SF_SUCCESS == successfulSent)
   {
-    LOG_INFO("Tx JoinSuc to ");
-    LOG_INFO_LLADDR(pDestinationAddr);
-    LOG_INFO_(" : ");
-    LOG_INFO_BYTES(gpFrameBuffer, gFrameLen);
-    LOG_INFO_("\n");
+    LOG_BIN_OR_TEXT(LOG_BIN_INFO_BYTES(LOG_ID_JOIN_SUCC_TX, gpFrameBuffer, gFrameLen,
+                                       LOG_BIN_LLADDR(pDestinationAddr)),
+                    LOG_INFO("Tx JoinSuc to ");
+                    LOG_INFO_LLADDR(pDestinationAddr);
+                    LOG_INFO_(" : ");
+                    LOG_INFO_BYTES(gpFrameBuffer, gFrameLen);
+                    LOG_INFO_("\n"));
 
     /* Set the max number of transmissions, 8 = 1 transmission and 7 retry. */
     packetbuf_set_attr(PACKETBUF_ATTR_MAX_MAC_TRANSMISSIONS, 8U);
-    loc_sendFrame(pDestinationAddr);
+    loc_sendFrame(pDestinationAddr, &gJoinCallbackHandlerCtxt);
     /* Set the max number of transmissions, 1 = 1 transmission and 0 retry. */
     packetbuf_set_attr(PACKETBUF_ATTR_MAX_MAC_TRANSMISSIONS, 1U);
   }
@@ -343,25 +379,27 @@ E_SF_RETURN_t sf_join_handleFrame(uint8_t* pInBuf, uint16_t length,
   handleStatus = sf_frameType_get(pInBuf, &frameType);
   if(E_SF_SUCCESS == handleStatus)
   {
+    /* In binary mode, the frame handlers log the received frames. */
     switch(frameType)
     {
       case E_FRAME_TYPE_REQUEST:
-        LOG_INFO("Received join request frame;\n ");
+        LOG_BIN_OR_TEXT(/* Logged by the handler */, LOG_INFO("Received join request frame;\n "));
         handleStatus = loc_handleRequest(pInBuf, length, pSrcAddr);
         break;
 
       case E_FRAME_TYPE_RESPONSE:
-        LOG_INFO("Received join response frame;\n ");
+        LOG_BIN_OR_TEXT(/* Logged by the handler */, LOG_INFO("Received join response frame;\n "));
         handleStatus = loc_handleResponse(pInBuf, length);
         break;
 
       case E_FRAME_TYPE_SUCCESSFUL:
-        LOG_INFO("Received join successful frame;\n ");
+        LOG_BIN_OR_TEXT(/* Logged by the handler */, LOG_INFO("Received join successful frame;\n "));
         handleStatus = loc_handleSuccessful(pInBuf, length, pSrcAddr);
         break;
 
       default:
-        LOG_ERR("Received invalid join frame;\n");
+        LOG_BIN_OR_TEXT(LOG_BIN_ERR(LOG_ID_JOIN_FRAME_INVALID),
+                        LOG_ERR("Received invalid join frame;\n"));
         break;
       }
   }
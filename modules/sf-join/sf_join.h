@@ -33,6 +33,7 @@ extern "C" {
 #include "sf_frameType.h"
 #include "sf_types.h"
 #include "sf_joinFramer.h"
+#include "sf_callbackHandler.h"
 
 /*==============================================================================
                             FUNCTION PROTOTYPES
@@ -54,12 +55,17 @@ E_SF_RETURN_t sf_join_request_send(linkaddr_t *pDestinationAddr);
  *
  * \param pDestinationAddr       Pointer to the destination address.
  * \param pNewDeviceAddress      Pointer to the assigned address.
+ * \param pCallbackHandlerCtxt   Output callback context passed to
+ *                               @ref sf_join_output_callback, NULL for the
+ *                               default context. Must stay valid until the
+ *                               callback.
  *
  * \return @ref E_SF_RETURN_t.
  */
 /*============================================================================*/
 E_SF_RETURN_t sf_join_response_send(linkaddr_t *pDestinationAddr,
-                                    linkaddr_t *pNewDeviceAddress);
+                                    linkaddr_t *pNewDeviceAddress,
+                                    sf_callbackHandlerCtxt_t *pCallbackHandlerCtxt);
 
 /*============================================================================*/
 /**
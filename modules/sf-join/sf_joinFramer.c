@@ -146,7 +146,7 @@ E_SF_RETURN_t sf_joinFramer_parse_request(uint8_t *pInBuf, uint16_t length)
 
   pInBuf += SF_FRAME_TYPE_LEN;
 
-  memcpy((uint8_t*)&gJoinReqParams, pInBuf, length);
+  memcpy((uint8_t*)&gJoinReqParams, pInBuf, length - SF_FRAME_TYPE_LEN);
 
   return E_SF_SUCCESS;
 }/* sf_joinFramer_parse_request() */
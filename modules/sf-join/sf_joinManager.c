@@ -37,6 +37,7 @@ extern "C" {
 #include "sf_stateManager.h"
 #include "sf_deviceMgmt.h"
 #include "sf_configMgmt.h"
+#include "sf_callbackHandler.h"
 #include "project-conf.h"
 /* Log configuration */
 #include "sys/log.h"
@@ -86,8 +87,43 @@ extern "C" {
 #endif
 /* Define the number of the states. */
 #define SF_JOIN_STATES_COUNT          (3U)
+/* Maximum number of joins processed at the same time. Each join uses its own
+   group of the join process slots. */
+#ifndef SF_JOIN_CONF_CONCURRENT_MAX
+#define SF_JOIN_CONCURRENT_MAX        (4U)
+#else
+#define SF_JOIN_CONCURRENT_MAX        SF_JOIN_CONF_CONCURRENT_MAX
+#endif
+#if (SF_JOIN_CONCURRENT_MAX < 1) || \
+    (SF_JOIN_CONCURRENT_MAX > APP_SLOTFRAME_SECTION_JOIN_PROCESS_SLOTS)
+#error "SF_JOIN_CONCURRENT_MAX must be between 1 and APP_SLOTFRAME_SECTION_JOIN_PROCESS_SLOTS"
+#endif
 /* Define maximum number of pending join requests. */
 #define SF_JOIN_PENDING_REQ_MAX       SF_JOIN_SENSOR_CNT_MAX
+#if SF_JOIN_PENDING_REQ_MAX > 254
+#error "The join request queue holds at most 254 requests!"
+#endif
+/* Process join requests of already registered serial numbers, e.g. sensors
+   rejoining after a reboot of the BMS-CC, before the ones of new sensors. */
+#ifndef SF_JOIN_CONF_PRIORITIZE_KNOWN
+#define SF_JOIN_PRIORITIZE_KNOWN      (1U)
+#else
+#define SF_JOIN_PRIORITIZE_KNOWN      SF_JOIN_CONF_PRIORITIZE_KNOWN
+#endif
+/* Number of bits of the join request address hash table. The table must be
+   at least twice as large as the queue. */
+#if SF_JOIN_PENDING_REQ_MAX <= 32
+#define SF_JOIN_QUEUE_HASH_BITS       (6U)
+#elif SF_JOIN_PENDING_REQ_MAX <= 64
+#define SF_JOIN_QUEUE_HASH_BITS       (7U)
+#elif SF_JOIN_PENDING_REQ_MAX <= 128
+#define SF_JOIN_QUEUE_HASH_BITS       (8U)
+#else
+#define SF_JOIN_QUEUE_HASH_BITS       (9U)
+#endif
+#define SF_JOIN_QUEUE_HASH_SIZE       (1U << SF_JOIN_QUEUE_HASH_BITS)
+/* Marks an empty slot of the join request address hash table */
+#define SF_JOIN_QUEUE_HASH_EMPTY      (0U)
 /* This macro defines the manual window open time */
 #ifndef SF_CONF_MANUAL_WINDOW_TIMEOUT
 #define SF_JOIN_MANUAL_WINDOW_TIMEOUT (180 * CLOCK_SECOND)
@@ -99,7 +135,6 @@ extern "C" {
                                 PROCESSES
 =============================================================================*/
 PROCESS(manual_window_process, "Manual window process");
-PROCESS(response_tx_process, "Send response process");
 
 /*=============================================================================
                                 ENUMS
@@ -115,6 +150,17 @@ typedef enum
   E_JOIN_STATE_SUCC_RX = 2
 } E_JOIN_MODE_STATE_t;
 
+/* Defines the FIFOs of the join request queue, in order of processing. */
+typedef enum
+{
+  /* Requests of already registered serial numbers. */
+  E_JOIN_QUEUE_KNOWN = 0,
+  /* Requests of new sensors. */
+  E_JOIN_QUEUE_NEW = 1,
+  /* Number of FIFOs. */
+  E_JOIN_QUEUE_CNT
+} E_JOIN_QUEUE_t;
+
 /*=============================================================================
                                 STRUCTS
 =============================================================================*/
@@ -129,54 +175,382 @@ typedef struct
   joinRequest_t joinRequest;
 } sf_pendingRequest_t;
 
+/* This struct defines a join in process. */
+typedef struct
+{
+  /* Stores the state manager context. */
+  stateManager_ctx_t stateCtx;
+  /* The join request in process, the first link address is null if the
+     context is free. */
+  sf_pendingRequest_t request;
+  /* Join response state's timeout. */
+  struct timer respTimer;
+  /* Join response retransmission timer. */
+  struct ctimer txTimer;
+  /* Join successful state's timer. */
+  struct ctimer succTimer;
+  /* Output callback context of the join response. */
+  sf_callbackHandlerCtxt_t callbackCtxt;
+  /* Join process slot group of this context. */
+  uint8_t slotGroup;
+  /* true if a join response is hanging in the mac. */
+  bool respActive;
+  /* Stores response Tx status. */
+  bool respTxFailed;
+} sf_joinCtx_t;
+
 /*=============================================================================
                                 GLOBAL VARIABLES
 =============================================================================*/
 /* Manual window timer's data. */
 static struct etimer gManualWindowTimer;
-/* Join response state's timer. */
-static struct etimer gJoinResponseTimer;
-/* Join successful state's timer. */
-static struct ctimer gJoinSuccessfulTimer;
-/* Stores the state manager context. */
-static stateManager_ctx_t gJoinStateCtx = {0};
-/* Stores the states parameters. */
+/* Stores the states parameters, shared by all join contexts. */
 static stateManager_state_t gpStates[SF_JOIN_STATES_COUNT];
-/* The ongoing join request parameters. */
-static sf_pendingRequest_t pendingRequest = {0};
+/* The joins in process. */
+static sf_joinCtx_t gpJoinCtx[SF_JOIN_CONCURRENT_MAX];
 /* Stores the pending join requests. */
 static sf_pendingRequest_t gpPendingRequests[SF_JOIN_PENDING_REQ_MAX];
 /* Stores the number of pending join requests. */
 static uint8_t gPendingRequestsCount = 0;
-/* false: to say no join response hanging in the mac.
-   true: to say there is join response ongoing and we are waiting for a callback
-         from the mac. */
-static bool gRespActive = false;
-/* Stores response Tx status. */
-static bool gRespTxFailed = false;
+/* Ring buffers of gpPendingRequests indexes, one FIFO per queue. */
+static uint8_t gpQueueRing[E_JOIN_QUEUE_CNT][SF_JOIN_PENDING_REQ_MAX];
+/* Oldest entry of each ring buffer. */
+static uint8_t gpQueueHead[E_JOIN_QUEUE_CNT];
+/* Number of entries of each ring buffer. */
+static uint8_t gpQueueCount[E_JOIN_QUEUE_CNT];
+/* Stack of the free gpPendingRequests indexes. */
+static uint8_t gpQueueFree[SF_JOIN_PENDING_REQ_MAX];
+/* Open addressing hash table of the requesting addresses. Holds the
+   gpPendingRequests index + 1 of each queued request, 0 for an empty slot. */
+static uint8_t gpQueueHash[SF_JOIN_QUEUE_HASH_SIZE];
 
 /*=============================================================================
                           LOCAL FUNCTION IMPLEMENTATION
 =============================================================================*/
+/*------------------------------------------------------------------------------
+  loc_queueHash()
+------------------------------------------------------------------------------*/
+static uint16_t loc_queueHash(const linkaddr_t *pAddr)
+{
+  uint32_t key = 0;
+
+  for(uint8_t i = 0; i < LINKADDR_SIZE; i++)
+  {
+    key = (key * 31U) + pAddr->u8[i];
+  }
+
+  /* Multiplicative (Fibonacci) hashing, keeps the upper bits */
+  return (uint16_t)((uint32_t)(key * 2654435761UL) >>
+                    (32U - SF_JOIN_QUEUE_HASH_BITS));
+} /* loc_queueHash() */
+
+/*------------------------------------------------------------------------------
+  loc_queueFindSlot()
+------------------------------------------------------------------------------*/
+static uint16_t loc_queueFindSlot(const linkaddr_t *pAddr)
+{
+  uint16_t slot = loc_queueHash(pAddr);
+
+  /* The table is at least twice as large as the queue,
+     so there is always an empty slot to stop at. */
+  while((SF_JOIN_QUEUE_HASH_EMPTY != gpQueueHash[slot]) &&
+        !linkaddr_cmp(&gpPendingRequests[gpQueueHash[slot] - 1U].firstLinkaddr, pAddr))
+  {
+    slot = (slot + 1U) & (SF_JOIN_QUEUE_HASH_SIZE - 1U);
+  }
+
+  return slot;
+} /* loc_queueFindSlot() */
+
+/*------------------------------------------------------------------------------
+  loc_queueHashRemove()
+------------------------------------------------------------------------------*/
+static void loc_queueHashRemove(const linkaddr_t *pAddr)
+{
+  uint16_t slot = loc_queueFindSlot(pAddr);
+  uint16_t next = slot;
+  uint16_t home;
+
+  if(SF_JOIN_QUEUE_HASH_EMPTY == gpQueueHash[slot])
+  {
+    return;
+  }
+
+  /* Backward shift deletion: move following entries of the probe
+     sequence into the gap, so no tombstones are needed. */
+  while(true)
+  {
+    gpQueueHash[slot] = SF_JOIN_QUEUE_HASH_EMPTY;
+    do
+    {
+      next = (next + 1U) & (SF_JOIN_QUEUE_HASH_SIZE - 1U);
+      if(SF_JOIN_QUEUE_HASH_EMPTY == gpQueueHash[next])
+      {
+        return;
+      }
+      home = loc_queueHash(&gpPendingRequests[gpQueueHash[next] - 1U].firstLinkaddr);
+      /* Keep the entry if its home slot lies cyclically in (slot, next] */
+    } while((slot < next) ? ((slot < home) && (home <= next)) :
+                            ((slot < home) || (home <= next)));
+
+    gpQueueHash[slot] = gpQueueHash[next];
+    slot = next;
+  }
+} /* loc_queueHashRemove() */
+
+/*------------------------------------------------------------------------------
+  loc_queueClear()
+------------------------------------------------------------------------------*/
+static void loc_queueClear(void)
+{
+  memset(gpPendingRequests, 0U, sizeof(gpPendingRequests));
+  memset(gpQueueHead, 0U, sizeof(gpQueueHead));
+  memset(gpQueueCount, 0U, sizeof(gpQueueCount));
+  memset(gpQueueHash, 0U, sizeof(gpQueueHash));
+  for(uint8_t i = 0; i < SF_JOIN_PENDING_REQ_MAX; i++)
+  {
+    gpQueueFree[i] = i;
+  }
+  gPendingRequestsCount = 0x00;
+} /* loc_queueClear() */
+
+/*------------------------------------------------------------------------------
+  loc_queuePush()
+------------------------------------------------------------------------------*/
+static bool loc_queuePush(const linkaddr_t *pSrc, const joinRequest_t *pJoinRequest,
+                          E_JOIN_QUEUE_t queue)
+{
+  uint16_t slot = loc_queueFindSlot(pSrc);
+  uint8_t reqIdx;
+
+  if(SF_JOIN_QUEUE_HASH_EMPTY != gpQueueHash[slot])
+  {
+    /* The device is queued already, keep its position and take the
+       latest request data. */
+    reqIdx = gpQueueHash[slot] - 1U;
+    memcpy(&gpPendingRequests[reqIdx].joinRequest, pJoinRequest,
+           sizeof(joinRequest_t));
+
+    LOG_INFO("!Join request exists already in the queue; The old request \
+              is overwritten; Device address; ");
+    LOG_INFO_LLADDR(pSrc);
+    LOG_INFO_("\n");
+    return true;
+  }
+
+  if(SF_JOIN_PENDING_REQ_MAX <= gPendingRequestsCount)
+  {
+    LOG_INFO("Join request queue is full; src; ");
+    LOG_INFO_LLADDR(pSrc);
+    LOG_INFO_("\n");
+    return false;
+  }
+
+  /* The free stack holds SF_JOIN_PENDING_REQ_MAX - count entries. */
+  reqIdx = gpQueueFree[SF_JOIN_PENDING_REQ_MAX - 1U - gPendingRequestsCount];
+  linkaddr_copy(&gpPendingRequests[reqIdx].firstLinkaddr, pSrc);
+  linkaddr_copy(&gpPendingRequests[reqIdx].newLinkaddr, &linkaddr_null);
+  memcpy(&gpPendingRequests[reqIdx].joinRequest, pJoinRequest,
+         sizeof(joinRequest_t));
+
+  gpQueueRing[queue][(gpQueueHead[queue] + gpQueueCount[queue]) %
+                     SF_JOIN_PENDING_REQ_MAX] = reqIdx;
+  gpQueueCount[queue] += 1;
+  gpQueueHash[slot] = reqIdx + 1U;
+  gPendingRequestsCount += 1;
+
+  LOG_INFO("Added received join request to the queue (pending: %d; src; ",
+           gPendingRequestsCount);
+  LOG_INFO_LLADDR(pSrc);
+  LOG_INFO_("\n");
+
+  return true;
+} /* loc_queuePush() */
+
+/*------------------------------------------------------------------------------
+  loc_queuePop()
+------------------------------------------------------------------------------*/
+static bool loc_queuePop(sf_pendingRequest_t *pRequest)
+{
+  uint8_t reqIdx;
+
+  for(uint8_t queue = 0; queue < E_JOIN_QUEUE_CNT; queue++)
+  {
+    if(0U == gpQueueCount[queue])
+    {
+      continue;
+    }
+
+    /* Take the oldest request of the queue. */
+    reqIdx = gpQueueRing[queue][gpQueueHead[queue]];
+    gpQueueHead[queue] = (gpQueueHead[queue] + 1U) % SF_JOIN_PENDING_REQ_MAX;
+    gpQueueCount[queue] -= 1;
+
+    memcpy(pRequest, &gpPendingRequests[reqIdx], sizeof(sf_pendingRequest_t));
+    loc_queueHashRemove(&gpPendingRequests[reqIdx].firstLinkaddr);
+
+    gPendingRequestsCount -= 1;
+    gpQueueFree[SF_JOIN_PENDING_REQ_MAX - 1U - gPendingRequestsCount] = reqIdx;
+
+    return true;
+  }
+
+  return false;
+} /* loc_queuePop() */
+
+/*------------------------------------------------------------------------------
+  loc_execState()
+------------------------------------------------------------------------------*/
+static void loc_execState(sf_joinCtx_t *pCtx, E_JOIN_MODE_STATE_t state)
+{
+  sf_stateManager_setState(&pCtx->stateCtx, (uint8_t)state);
+  sf_stateManager_execState(&pCtx->stateCtx, pCtx);
+} /* loc_execState() */
+
+/*------------------------------------------------------------------------------
+  loc_getCtx()
+------------------------------------------------------------------------------*/
+static sf_joinCtx_t* loc_getCtx(const linkaddr_t *pFirstAddr,
+                                const linkaddr_t *pNewAddr, uint32_t serial)
+{
+  for(uint8_t i = 0; i < SF_JOIN_CONCURRENT_MAX; i++)
+  {
+    sf_joinCtx_t *pCtx = &gpJoinCtx[i];
+
+    if(linkaddr_cmp(&linkaddr_null, &pCtx->request.firstLinkaddr))
+    {
+      continue;
+    }
+
+    if(((NULL != pFirstAddr) &&
+        linkaddr_cmp(&pCtx->request.firstLinkaddr, pFirstAddr)) ||
+       ((NULL != pNewAddr) &&
+        linkaddr_cmp(&pCtx->request.newLinkaddr, pNewAddr)) ||
+       ((0U != serial) && (pCtx->request.joinRequest.serialNumber == serial)))
+    {
+      return pCtx;
+    }
+  }
+
+  return NULL;
+} /* loc_getCtx() */
+
+/*------------------------------------------------------------------------------
+  loc_startJoins()
+------------------------------------------------------------------------------*/
+static void loc_startJoins(void)
+{
+  /* Pull pending requests into the free join contexts. */
+  for(uint8_t i = 0; (i < SF_JOIN_CONCURRENT_MAX) && (0 < gPendingRequestsCount); i++)
+  {
+    if(linkaddr_cmp(&linkaddr_null, &gpJoinCtx[i].request.firstLinkaddr))
+    {
+      loc_execState(&gpJoinCtx[i], E_JOIN_STATE_REQ_RX);
+    }
+  }
+} /* loc_startJoins() */
+
+/*------------------------------------------------------------------------------
+  loc_releaseCtx()
+------------------------------------------------------------------------------*/
+static void loc_releaseCtx(sf_joinCtx_t *pCtx)
+{
+  ctimer_stop(&pCtx->txTimer);
+  ctimer_stop(&pCtx->succTimer);
+
+  /* Clear request handler. */
+  memset(&pCtx->request, 0x00, sizeof(sf_pendingRequest_t));
+  pCtx->respActive = false;
+  pCtx->respTxFailed = false;
+
+  sf_stateManager_setState(&pCtx->stateCtx, (uint8_t)E_JOIN_STATE_REQ_RX);
+} /* loc_releaseCtx() */
+
 /*------------------------------------------------------------------------------
   join_timeout_callback()
 ------------------------------------------------------------------------------*/
 static void loc_join_timeout_callback(void * ptr)
 {
-  LOG_INFO("Join state timeout expired. Cancel current join process and\
-            reset state machine.\n");
+  sf_joinCtx_t *pCtx = (sf_joinCtx_t*)ptr;
+  linkaddr_t newAddr;
+
+  LOG_INFO("Join state timeout expired. Cancel join process of ");
+  LOG_INFO_LLADDR(&pCtx->request.firstLinkaddr);
+  LOG_INFO_(".\n");
 
   /* Delete the join process slots. */
-  sf_tsch_schedule_delete_jproc_slots(NULL);
+  sf_tsch_schedule_delete_jproc_slot_group(&pCtx->request.firstLinkaddr,
+                                           pCtx->slotGroup,
+                                           SF_JOIN_CONCURRENT_MAX);
+
+  /* Free the address reserved for the device. */
+  linkaddr_copy(&newAddr, &pCtx->request.newLinkaddr);
+#if CONTIKI_TARGET_COOJA
+  newAddr.u16 -= 1;
+#endif
+  sf_deviceMgmt_releaseAddress(newAddr);
 
-  /* Clear current request handler. */
-  memset(&pendingRequest, 0x00, sizeof(sf_pendingRequest_t));
+  loc_releaseCtx(pCtx);
 
-  /* Proceed with the next join request. */
-  sf_stateManager_setState(&gJoinStateCtx, (uint8_t)E_JOIN_STATE_REQ_RX);
-  sf_stateManager_execState(&gJoinStateCtx);
+  /* Proceed with the next join requests. */
+  loc_startJoins();
 } /* join_timeout_callback() */
 
+/*------------------------------------------------------------------------------
+  loc_txTimerCallback()
+------------------------------------------------------------------------------*/
+static void loc_txTimerCallback(void *ptr)
+{
+  sf_joinCtx_t *pCtx = (sf_joinCtx_t*)ptr;
+  E_SF_RETURN_t ret = E_SF_ERROR;
+
+  if(E_JOIN_STATE_RESP_TX != (E_JOIN_MODE_STATE_t)sf_stateManager_getState(&pCtx->stateCtx))
+  {
+    return;
+  }
+
+  /* Check if the state timeout is already expired */
+  if(timer_expired(&pCtx->respTimer) && false == pCtx->respActive)
+  {
+    loc_join_timeout_callback(pCtx);
+    return;
+  }
+
+  if(false == pCtx->respActive)
+  {
+    pCtx->respActive = true;
+    pCtx->respTxFailed = false;
+    ret = sf_join_response_send(&pCtx->request.firstLinkaddr,
+                                &pCtx->request.newLinkaddr,
+                                &pCtx->callbackCtxt);
+    if(E_SF_SUCCESS != ret)
+    {
+      pCtx->respActive = false;
+
+      LOG_ERR("!Fail to send join response. Retry until the state timeout \
+               expires\n");
+    }
+  }
+  else
+  {
+    LOG_INFO("!Can not send new join response. There is an active \
+              join response in the lower layer. \n");
+  }
+
+  LOG_INFO("Wait until Tx timeout (%lu second) expires.\n",
+           (long unsigned)(SF_JOIN_RETRY_TX_TIME / CLOCK_SECOND));
+  ctimer_reset(&pCtx->txTimer);
+} /* loc_txTimerCallback() */
+
+/*------------------------------------------------------------------------------
+  loc_handleFrame()
+------------------------------------------------------------------------------*/
+static void loc_handleFrame(uint8_t *pInBuf, uint16_t length, linkaddr_t *pSrc)
+{
+  /* Passes the received join frames to the join module. */
+  sf_join_handleFrame(pInBuf, length, pSrc);
+} /* loc_handleFrame() */
+
 /*------------------------------------------------------------------------------
   sf_joinManger_openManualWindow()
 ------------------------------------------------------------------------------*/
@@ -194,8 +568,9 @@ static void loc_closeWindow(void)
 /*------------------------------------------------------------------------------
   loc_rxRequest()
 ------------------------------------------------------------------------------*/
-static void loc_rxRequest(void)
+static void loc_rxRequest(void *pData)
 {
+  sf_joinCtx_t *pCtx = (sf_joinCtx_t*)pData;
   /* True if a join request from already registered sensor is received,
      false if it is a new sensor. */
   bool oldSensor = false;
@@ -206,13 +581,10 @@ static void loc_rxRequest(void)
   {
     do
     {
-      /* Get next pending join request. */
-      memcpy(&pendingRequest, &gpPendingRequests[gPendingRequestsCount - 1],
-             sizeof(sf_pendingRequest_t));
-      gPendingRequestsCount -= 1;
-
-      if((!linkaddr_cmp(&linkaddr_null, &pendingRequest.firstLinkaddr)) &&
-         (pendingRequest.joinRequest.serialNumber > 0))
+      /* Get the next pending join request, oldest first. */
+      if((true == loc_queuePop(&pCtx->request)) &&
+         (!linkaddr_cmp(&linkaddr_null, &pCtx->request.firstLinkaddr)) &&
+         (pCtx->request.joinRequest.serialNumber > 0))
       {
         requestPulled = true;
       }
@@ -221,31 +593,29 @@ static void loc_rxRequest(void)
     if(true == requestPulled)
     {
       /* Check if it is an old or new sensor. */
-      if(NULL != sf_deviceMgmt_getDeviceBySerial(pendingRequest.joinRequest.serialNumber))
+      if(NULL != sf_deviceMgmt_getDeviceBySerial(pCtx->request.joinRequest.serialNumber))
       {
         oldSensor = true;
       }
 
-      if((SF_JOIN_SENSOR_CNT_MAX > sf_deviceMgmt_getRegisteredDeviceCount()) ||
-        (true == oldSensor))
+      if(((SF_JOIN_SENSOR_CNT_MAX > sf_deviceMgmt_getRegisteredDeviceCount()) ||
+          (true == oldSensor)) &&
+         (E_SF_SUCCESS == sf_deviceMgmt_getFreeAddress(&pCtx->request.newLinkaddr.u16,
+                                                       pCtx->request.joinRequest.serialNumber)))
       {
         LOG_INFO("A join request is pulled from the queue; pending join request; %d src; ",
                   gPendingRequestsCount);
-        LOG_INFO_LLADDR(&pendingRequest.firstLinkaddr);
-        LOG_INFO_(" SerialNo: %ld\n", pendingRequest.joinRequest.serialNumber);
+        LOG_INFO_LLADDR(&pCtx->request.firstLinkaddr);
+        LOG_INFO_(" SerialNo: %ld\n", pCtx->request.joinRequest.serialNumber);
 
-        /* Assign new address to be used for regular communication  */
-        sf_deviceMgmt_getFreeAddress(&pendingRequest.newLinkaddr.u16,
-                                     pendingRequest.joinRequest.serialNumber);
 #if CONTIKI_TARGET_COOJA
         /* In case of COOJA, address 0x0001 is reserved to the gateway.
            Therefore offset of 1 is added to the assigned address */
-        pendingRequest.newLinkaddr.u16 += 1;
+        pCtx->request.newLinkaddr.u16 += 1;
 #endif
 
         /* Set next state to E_JOIN_STATE_RESP_TX */
-        sf_stateManager_setState(&gJoinStateCtx, (uint8_t)E_JOIN_STATE_RESP_TX);
-        sf_stateManager_execState(&gJoinStateCtx);
+        loc_execState(pCtx, E_JOIN_STATE_RESP_TX);
       }
       else
       {
@@ -254,15 +624,17 @@ static void loc_rxRequest(void)
                   sf_deviceMgmt_getRegisteredDeviceCount(), gPendingRequestsCount);
 
         /* Remove all pending requests. */
-        gPendingRequestsCount = 0x00;
+        loc_queueClear();
 
         /* Clear current request. */
-        memset(&pendingRequest, 0x00, sizeof(sf_pendingRequest_t));
+        memset(&pCtx->request, 0x00, sizeof(sf_pendingRequest_t));
       }
     }
     else
     {
       LOG_ERR("!No valid join request pulled from queue!");
+
+      memset(&pCtx->request, 0x00, sizeof(sf_pendingRequest_t));
     }
   }
   else
@@ -274,34 +646,38 @@ static void loc_rxRequest(void)
 /*------------------------------------------------------------------------------
   loc_txResponse()
 ------------------------------------------------------------------------------*/
-static void loc_txResponse(void)
+static void loc_txResponse(void *pData)
 {
-  /* Start state timeout. */
-  etimer_set(&gJoinResponseTimer, SF_JOIN_RESP_STATE_TIMEOUT);
+  sf_joinCtx_t *pCtx = (sf_joinCtx_t*)pData;
 
-  /* Schedule join process slots. */
-  sf_tsch_schedule_add_jproc_slots((const linkaddr_t*)&pendingRequest.firstLinkaddr);
-
-  /* Start response transmission process. */
-  if(process_is_running(&response_tx_process))
-  {
-    process_exit(&response_tx_process);
-  }
-
-  process_start(&response_tx_process, NULL);
+  /* Start state timeout. */
+  timer_set(&pCtx->respTimer, SF_JOIN_RESP_STATE_TIMEOUT);
+
+  /* Schedule the join process slots of this context. */
+  sf_tsch_schedule_add_jproc_slot_group((const linkaddr_t*)&pCtx->request.firstLinkaddr,
+                                        pCtx->slotGroup, SF_JOIN_CONCURRENT_MAX);
+
+  /* Start response transmission. */
+  pCtx->respActive = false;
+  LOG_INFO("Wait until Tx timeout (%lu second) expires.\n",
+           (long unsigned)(SF_JOIN_RETRY_TX_TIME / CLOCK_SECOND));
+  ctimer_set(&pCtx->txTimer, (clock_time_t)SF_JOIN_RETRY_TX_TIME,
+             loc_txTimerCallback, pCtx);
 } /* loc_txResponse() */
 
 /*------------------------------------------------------------------------------
   loc_rxSuccessful()
 ------------------------------------------------------------------------------*/
-static void loc_rxSuccessful(void)
+static void loc_rxSuccessful(void *pData)
 {
+  sf_joinCtx_t *pCtx = (sf_joinCtx_t*)pData;
+
   /* Start state timeout. */
-  ctimer_set(&gJoinSuccessfulTimer, SF_JOIN_SUCC_STATE_TIMEOUT,
-             loc_join_timeout_callback, NULL);
+  ctimer_set(&pCtx->succTimer, SF_JOIN_SUCC_STATE_TIMEOUT,
+             loc_join_timeout_callback, pCtx);
 
   LOG_INFO("Waiting for successful Rx from; ");
-  LOG_INFO_LLADDR(&pendingRequest.newLinkaddr);
+  LOG_INFO_LLADDR(&pCtx->request.newLinkaddr);
   LOG_INFO_("\n");
 } /* loc_rxSuccessful() */
 
@@ -330,66 +706,6 @@ PROCESS_THREAD(manual_window_process, ev, data)
   PROCESS_END();
 } /* manual_window_process() */
 
-/*------------------------------------------------------------------------------
-  response_tx_process()
-------------------------------------------------------------------------------*/
-PROCESS_THREAD(response_tx_process, ev, data)
-{
-  /* Tx timeout timer handler. */
-  static struct etimer txTimer;
-  E_SF_RETURN_t ret = E_SF_ERROR;
-
-  PROCESS_BEGIN();
-
-  while(1)
-  {
-    LOG_INFO("Wait until Tx timeout (%lu second) expires.\n",
-             (long unsigned)(SF_JOIN_RETRY_TX_TIME / CLOCK_SECOND));
-    /* Set Tx timeout. */
-    etimer_set(&txTimer, (clock_time_t)SF_JOIN_RETRY_TX_TIME);
-    PROCESS_WAIT_EVENT_UNTIL(etimer_expired(&txTimer));
-
-    if(E_JOIN_STATE_RESP_TX == (E_JOIN_MODE_STATE_t)sf_stateManager_getState(&gJoinStateCtx))
-    {
-      /* Check if the state timeout is already expired */
-      if(etimer_expired(&gJoinResponseTimer) && false == gRespActive)
-      {
-        loc_join_timeout_callback(NULL);
-
-        break;
-      }
-
-      if(false == gRespActive)
-      {
-        gRespActive = true;
-        gRespTxFailed = false;
-        ret = sf_join_response_send(&pendingRequest.firstLinkaddr,
-                                    &pendingRequest.newLinkaddr);
-        if(E_SF_SUCCESS != ret)
-        {
-          gRespActive = false;
-
-          LOG_ERR("!Fail to send join response. Waiting for state timeout \
-                   to expire to pursue\n");
-
-          PROCESS_EXIT();
-        }
-      }
-      else
-      {
-        LOG_INFO("!Can not send new join response. There is an active \
-                  join response in the lower layer. \n");
-      }
-    }
-    else
-    {
-      PROCESS_EXIT();
-    }
-  }
-
-  PROCESS_END();
-} /* response_tx_process() */
-
 /*=============================================================================
                           API IMPLEMENTATION
 =============================================================================*/
@@ -442,11 +758,25 @@ void sf_joinManger_start()
   gpStates[1].stateFct =&loc_txResponse;
   gpStates[2].state = (uint8_t)E_JOIN_STATE_SUCC_RX;
   gpStates[2].stateFct = &loc_rxSuccessful;
-  sf_stateManager_init(&gJoinStateCtx, gpStates, SF_JOIN_STATES_COUNT);
+
+  /* Initialize the join contexts, each one using its own slot group. */
+  memset(gpJoinCtx, 0U, sizeof(gpJoinCtx));
+  for(uint8_t i = 0; i < SF_JOIN_CONCURRENT_MAX; i++)
+  {
+    sf_stateManager_init(&gpJoinCtx[i].stateCtx, gpStates, SF_JOIN_STATES_COUNT);
+    sf_stateManager_setState(&gpJoinCtx[i].stateCtx, (uint8_t)E_JOIN_STATE_REQ_RX);
+    gpJoinCtx[i].callbackCtxt.callbackFctPointer = sf_join_output_callback;
+    gpJoinCtx[i].callbackCtxt.callbackFctDataPointer = &gpJoinCtx[i];
+    gpJoinCtx[i].slotGroup = i;
+  }
 
   /* Initialize join request queue. */
-  memset(gpPendingRequests, 0U, sizeof(gpPendingRequests));
-  gPendingRequestsCount = 0x00;
+  loc_queueClear();
+
+  /* Register the handler of the join frames */
+  sf_callbackHandler_registerInput(E_FRAME_TYPE_REQUEST, loc_handleFrame);
+  sf_callbackHandler_registerInput(E_FRAME_TYPE_RESPONSE, loc_handleFrame);
+  sf_callbackHandler_registerInput(E_FRAME_TYPE_SUCCESSFUL, loc_handleFrame);
 
   /* Add join request slots */
   sf_tsch_schedule_add_jreq_slots();
@@ -463,44 +793,44 @@ void sf_joinManger_start()
 ------------------------------------------------------------------------------*/
 void sf_join_output_callback(void *ptr, nullnet_tx_status_t status)
 {
-  if(E_JOIN_STATE_RESP_TX == (E_JOIN_MODE_STATE_t)sf_stateManager_getState(&gJoinStateCtx))
+  sf_joinCtx_t *pCtx = (sf_joinCtx_t*)ptr;
+
+  if((NULL != pCtx) &&
+     (E_JOIN_STATE_RESP_TX == (E_JOIN_MODE_STATE_t)sf_stateManager_getState(&pCtx->stateCtx)))
   {
 
     if((NULLNET_TX_OK != status) && (NULLNET_TX_BUSY != status))
     {
       /* A response fragment not successfully transmitted. */
       LOG_INFO("Response frag not successfully sent \n");
-      gRespTxFailed = true;
+      pCtx->respTxFailed = true;
     }
 
-    if(false == gRespTxFailed)
+    /* If reach Here, then we are sure that no active join response
+        exists in the mac. */
+    pCtx->respActive = false;
+
+    if(false == pCtx->respTxFailed)
     {
       LOG_INFO("Join response is sent successfully to: %ld, firstAddr:",
-               pendingRequest.joinRequest.serialNumber);
-      LOG_INFO_LLADDR(&pendingRequest.firstLinkaddr);
+               pCtx->request.joinRequest.serialNumber);
+      LOG_INFO_LLADDR(&pCtx->request.firstLinkaddr);
       LOG_INFO_("; New device address: ");
-      LOG_INFO_LLADDR(&pendingRequest.newLinkaddr);
+      LOG_INFO_LLADDR(&pCtx->request.newLinkaddr);
       LOG_INFO_("\n");
 
-      etimer_stop(&gJoinResponseTimer);
+      ctimer_stop(&pCtx->txTimer);
 
       /* Set next state to E_JOIN_STATE_SUCC_RX */
-      sf_stateManager_setState(&gJoinStateCtx, (uint8_t)E_JOIN_STATE_SUCC_RX);
-      sf_stateManager_execState(&gJoinStateCtx);
+      loc_execState(pCtx, E_JOIN_STATE_SUCC_RX);
     }
     else
     {
-      if(etimer_expired(&gJoinResponseTimer))
+      if(timer_expired(&pCtx->respTimer))
       {
-        process_exit(&response_tx_process);
-
-        loc_join_timeout_callback(NULL);
+        loc_join_timeout_callback(pCtx);
       }
     }
-
-    /* If reach Here, then we are sure that no active join response
-        exists in the mac. */
-    gRespActive = false;
   }
 } /* sf_join_output_callback() */
 
@@ -514,8 +844,6 @@ void sf_join_request_receive(linkaddr_t *src)
 {
   /* Join request frame params. */
   joinRequest_t joinReqParams = {0};
-  /* Pending request index. */
-  uint8_t reqIdx = 0x00;
   /* True if a join request from already registEred sensor is received,
      false otherwise. */
   bool oldSensor = false;
@@ -533,6 +861,12 @@ void sf_join_request_receive(linkaddr_t *src)
     return;
   }
 
+  if(NULL != loc_getCtx(src, NULL, joinReqParams.serialNumber))
+  {
+    LOG_INFO("Device is already in join process; request ignored\n");
+    return;
+  }
+
   /* Check if it is an old or new device. */
   if(NULL != sf_deviceMgmt_getDeviceBySerial(joinReqParams.serialNumber))
   {
@@ -542,53 +876,13 @@ void sf_join_request_receive(linkaddr_t *src)
   if((SF_JOIN_SENSOR_CNT_MAX > sf_deviceMgmt_getRegisteredDeviceCount()) ||
      (true == oldSensor))
   {
-    while((reqIdx < gPendingRequestsCount) &&
-          !linkaddr_cmp(&gpPendingRequests[reqIdx].firstLinkaddr, src))
-    {
-      reqIdx += 0x01;
-    }
-
-    if(reqIdx == gPendingRequestsCount)
-    {
-      if(SF_JOIN_PENDING_REQ_MAX > gPendingRequestsCount)
-      {
-        gpPendingRequests[gPendingRequestsCount].firstLinkaddr = *src;
-        memcpy(&gpPendingRequests[gPendingRequestsCount].joinRequest, &joinReqParams,
-               sizeof(joinRequest_t));
-
-        gPendingRequestsCount += 1;
-
-        LOG_INFO("Added received join request to the queue (index: %d; src; ",
-                 gPendingRequestsCount);
-        LOG_INFO_LLADDR(src);
-        LOG_INFO_("\n");
-      }
-      else
-      {
-        LOG_INFO("Join request queue is full; src; ");
-        LOG_INFO_LLADDR(src);
-        LOG_INFO_("\n");
-      }
-    }
-    else
-    {
-      gpPendingRequests[reqIdx].firstLinkaddr = *src;
-      memcpy(&gpPendingRequests[reqIdx].joinRequest, &joinReqParams,
-             sizeof(joinRequest_t));
+    /* Queue the request, requests of known sensors are processed first. */
+    loc_queuePush(src, &joinReqParams,
+                  ((SF_JOIN_PRIORITIZE_KNOWN) && (true == oldSensor)) ?
+                  E_JOIN_QUEUE_KNOWN : E_JOIN_QUEUE_NEW);
 
-      LOG_INFO("!Join request exists already in the queue; The old request \
-                is overwritten; Device address; ");
-      LOG_INFO_LLADDR(src);
-      LOG_INFO_("\n");
-    }
-
-    /* If no device is in join process handle, start join process. */
-    if(linkaddr_cmp(&linkaddr_null, &pendingRequest.firstLinkaddr))
-    {
-      /* Process the requests. */
-      sf_stateManager_setState(&gJoinStateCtx, (uint8_t)E_JOIN_STATE_REQ_RX);
-      sf_stateManager_execState(&gJoinStateCtx);
-    }
+    /* Start the join process if a join context is free. */
+    loc_startJoins();
   }
   else
   {
@@ -604,45 +898,53 @@ void sf_join_request_receive(linkaddr_t *src)
 void sf_join_successful_receive(linkaddr_t *src)
 {
   E_SF_RETURN_t ret = E_SF_ERROR;
-  /* Stores current state. */
-  E_JOIN_MODE_STATE_t currentState = 0;
+  /* Join context waiting for the successful frame of the device. */
+  sf_joinCtx_t *pCtx = loc_getCtx(NULL, src, 0U);
 
-  currentState = (E_JOIN_MODE_STATE_t)sf_stateManager_getState(&gJoinStateCtx);
-
-  if((E_JOIN_STATE_SUCC_RX == currentState) &&
-     (linkaddr_cmp(&pendingRequest.newLinkaddr, src)))
+  if((NULL != pCtx) &&
+     (E_JOIN_STATE_SUCC_RX == (E_JOIN_MODE_STATE_t)sf_stateManager_getState(&pCtx->stateCtx)))
   {
     LOG_INFO("Received join successful from: ");
     LOG_INFO_LLADDR(src);
     LOG_INFO_(" SerialNo: %ld old addr was: ",
-              pendingRequest.joinRequest.serialNumber);
-    LOG_INFO_LLADDR(&pendingRequest.firstLinkaddr);
+              pCtx->request.joinRequest.serialNumber);
+    LOG_INFO_LLADDR(&pCtx->request.firstLinkaddr);
     LOG_INFO_("\n");
 
     /* Stop join timeout timer. */
-    ctimer_stop(&gJoinSuccessfulTimer);
+    ctimer_stop(&pCtx->succTimer);
 
     /* Delete the join process slots from the schedule. */
-    sf_tsch_schedule_delete_jproc_slots(NULL);
+    sf_tsch_schedule_delete_jproc_slot_group(&pCtx->request.firstLinkaddr,
+                                             pCtx->slotGroup,
+                                             SF_JOIN_CONCURRENT_MAX);
 
 #if CONTIKI_TARGET_COOJA
     /* Removed added offset to add the new sensor to the correct list entry. */
     linkaddr_t tmpLinkaddr;
-    linkaddr_copy(&tmpLinkaddr, &pendingRequest.newLinkaddr);
+    linkaddr_copy(&tmpLinkaddr, &pCtx->request.newLinkaddr);
     tmpLinkaddr.u16 -= 1;
     /* Add joined device to the sensor list. */
     ret = sf_deviceMgmt_addDevice(tmpLinkaddr,
-                                  pendingRequest.joinRequest.serialNumber);
+                                  pCtx->request.joinRequest.serialNumber);
+    if(E_SF_SUCCESS != ret)
+    {
+      sf_deviceMgmt_releaseAddress(tmpLinkaddr);
+    }
 #else
     /* Add joined device to the sensor list. */
-    ret = sf_deviceMgmt_addDevice(pendingRequest.newLinkaddr,
-                                  pendingRequest.joinRequest.serialNumber);
+    ret = sf_deviceMgmt_addDevice(pCtx->request.newLinkaddr,
+                                  pCtx->request.joinRequest.serialNumber);
+    if(E_SF_SUCCESS != ret)
+    {
+      sf_deviceMgmt_releaseAddress(pCtx->request.newLinkaddr);
+    }
 #endif
 
     if(E_SF_SUCCESS != ret)
     {
       LOG_INFO("!Can not add sensor with shortAddr ");
-      LOG_INFO_LLADDR(&pendingRequest.newLinkaddr);
+      LOG_INFO_LLADDR(&pCtx->request.newLinkaddr);
       LOG_INFO_(". Join request rejected!\n");
     }
     else
@@ -654,12 +956,12 @@ void sf_join_successful_receive(linkaddr_t *src)
       }
 
       /* Schedule data slots for the joined device using the assigned device address. */
-      sf_tsch_schedule_add_data_slots((const linkaddr_t*)&pendingRequest.newLinkaddr,
+      sf_tsch_schedule_add_data_slots((const linkaddr_t*)&pCtx->request.newLinkaddr,
                                       E_SF_TSCH_SCHEDULE_DATA_SLOTS_ALL);
     }
 
-    /* Reset pending request handler. */
-    memset(&pendingRequest, 0x00, sizeof(sf_pendingRequest_t));
+    /* Reset the join context. */
+    loc_releaseCtx(pCtx);
 
     /* Check if manual window timeout has not expired. */
     if(!etimer_expired(&gManualWindowTimer))
@@ -669,10 +971,8 @@ void sf_join_successful_receive(linkaddr_t *src)
       sf_joinManger_openManualWindow();
     }
 
-    /* Set next state to E_JOIN_STATE_REQ_RX.
-      New device join can be processed. */
-    sf_stateManager_setState(&gJoinStateCtx, (uint8_t)E_JOIN_STATE_REQ_RX);
-    sf_stateManager_execState(&gJoinStateCtx);
+    /* New device joins can be processed. */
+    loc_startJoins();
   }
 } /* sf_join_successful_receive() */
 
@@ -20,7 +20,7 @@ extern "C" {
 #include <stdint.h>
 #include <stdbool.h>
 
-#if !CONTIKI_TARGET_COOJA
+#if !CONTIKI_TARGET_COOJA && !CONTIKI_TARGET_NATIVE
 #include "dot-15-4g.h"
 #endif
 #include "net/mac/tsch/tsch.h"
@@ -47,7 +47,7 @@ const uint8_t eu_tsch_hopping_sequence_size = sizeof(EU_TSCH_CONF_DEFAULT_HOPPIN
 const uint8_t eu_tsch_hopping_sequence_adv[] = EU_TSCH_CONF_JOIN_HOPPING_SEQUENCE;
 const uint8_t eu_tsch_hopping_sequence_adv_size = sizeof(EU_TSCH_CONF_JOIN_HOPPING_SEQUENCE);
 
-#if !CONTIKI_TARGET_COOJA
+#if !CONTIKI_TARGET_COOJA && !CONTIKI_TARGET_NATIVE
 const dot_15_4g_radioConf_t eu_dot_15_4g_radioConf = {
   DOT_15_4G_EU_CHAN_MIN,
   DOT_15_4G_EU_CHAN_MAX,
@@ -66,7 +66,7 @@ const uint8_t us_tsch_hopping_sequence_size = sizeof(US_TSCH_CONF_DEFAULT_HOPPIN
 const uint8_t us_tsch_hopping_sequence_adv[] = US_TSCH_CONF_JOIN_HOPPING_SEQUENCE;
 const uint8_t us_tsch_hopping_sequence_adv_size = sizeof(US_TSCH_CONF_JOIN_HOPPING_SEQUENCE);
 
-#if !CONTIKI_TARGET_COOJA
+#if !CONTIKI_TARGET_COOJA && !CONTIKI_TARGET_NATIVE
 const dot_15_4g_radioConf_t us_dot_15_4g_radioConf = {
   DOT_15_4G_US_CHAN_MIN,
   DOT_15_4G_US_CHAN_MAX,
@@ -85,7 +85,7 @@ const uint8_t chn_tsch_hopping_sequence_size = sizeof(CHN_TSCH_CONF_DEFAULT_HOPP
 const uint8_t chn_tsch_hopping_sequence_adv[] = CHN_TSCH_CONF_JOIN_HOPPING_SEQUENCE;
 const uint8_t chn_tsch_hopping_sequence_adv_size = sizeof(CHN_TSCH_CONF_JOIN_HOPPING_SEQUENCE);
 
-#if !CONTIKI_TARGET_COOJA
+#if !CONTIKI_TARGET_COOJA && !CONTIKI_TARGET_NATIVE
 const dot_15_4g_radioConf_t chn_dot_15_4g_radioConf = {
   DOT_15_4G_CHN_CHAN_MIN,
   DOT_15_4G_CHN_CHAN_MAX,
@@ -104,7 +104,7 @@ const uint8_t jp_tsch_hopping_sequence_size = sizeof(JP_TSCH_CONF_DEFAULT_HOPPIN
 const uint8_t jp_tsch_hopping_sequence_adv[] = JP_TSCH_CONF_JOIN_HOPPING_SEQUENCE;
 const uint8_t jp_tsch_hopping_sequence_adv_size = sizeof(JP_TSCH_CONF_JOIN_HOPPING_SEQUENCE);
 
-#if !CONTIKI_TARGET_COOJA
+#if !CONTIKI_TARGET_COOJA && !CONTIKI_TARGET_NATIVE
 const dot_15_4g_radioConf_t jp_dot_15_4g_radioConf = {
   DOT_15_4G_JP_CHAN_MIN,
   DOT_15_4G_JP_CHAN_MAX,
@@ -123,7 +123,7 @@ const uint8_t sk_tsch_hopping_sequence_size = sizeof(SK_TSCH_CONF_DEFAULT_HOPPIN
 const uint8_t sk_tsch_hopping_sequence_adv[] = SK_TSCH_CONF_JOIN_HOPPING_SEQUENCE;
 const uint8_t sk_tsch_hopping_sequence_adv_size = sizeof(SK_TSCH_CONF_JOIN_HOPPING_SEQUENCE);
 
-#if !CONTIKI_TARGET_COOJA
+#if !CONTIKI_TARGET_COOJA && !CONTIKI_TARGET_NATIVE
 const dot_15_4g_radioConf_t sk_dot_15_4g_radioConf = {
   DOT_15_4G_SK_CHAN_MIN,
   DOT_15_4G_SK_CHAN_MAX,
@@ -142,7 +142,7 @@ const uint8_t in_tsch_hopping_sequence_size = sizeof(IN_TSCH_CONF_DEFAULT_HOPPIN
 const uint8_t in_tsch_hopping_sequence_adv[] = IN_TSCH_CONF_JOIN_HOPPING_SEQUENCE;
 const uint8_t in_tsch_hopping_sequence_adv_size = sizeof(IN_TSCH_CONF_JOIN_HOPPING_SEQUENCE);
 
-#if !CONTIKI_TARGET_COOJA
+#if !CONTIKI_TARGET_COOJA && !CONTIKI_TARGET_NATIVE
 const dot_15_4g_radioConf_t in_dot_15_4g_radioConf = {
   DOT_15_4G_IN_CHAN_MIN,
   DOT_15_4G_IN_CHAN_MAX,
@@ -161,7 +161,7 @@ const uint8_t glob2g4_tsch_hopping_sequence_size = sizeof(GLOB2G4_TSCH_CONF_DEFA
 const uint8_t glob2g4_tsch_hopping_sequence_adv[] = GLOB2G4_TSCH_CONF_JOIN_HOPPING_SEQUENCE;
 const uint8_t glob2g4_tsch_hopping_sequence_adv_size = sizeof(GLOB2G4_TSCH_CONF_JOIN_HOPPING_SEQUENCE);
 
-#if !CONTIKI_TARGET_COOJA
+#if !CONTIKI_TARGET_COOJA && !CONTIKI_TARGET_NATIVE
 const dot_15_4g_radioConf_t glob2g4_dot_15_4g_radioConf = {
   DOT_15_4G_GLOB2G4_CHAN_MIN,
   DOT_15_4G_GLOB2G4_CHAN_MAX,
@@ -193,7 +193,7 @@ bool sf_rf_selectRegion(sf_rf_region_t region)
       tsch_set_hopping_sequence(us_tsch_hopping_sequence, us_tsch_hopping_sequence_size);
       tsch_set_hopping_sequence_adv(us_tsch_hopping_sequence_adv, us_tsch_hopping_sequence_adv_size);
 
-      #if !CONTIKI_TARGET_COOJA
+      #if !CONTIKI_TARGET_COOJA && !CONTIKI_TARGET_NATIVE
       gDot_15_4g_radioConf = &us_dot_15_4g_radioConf;
       #endif
 
@@ -219,7 +219,7 @@ bool sf_rf_selectRegion(sf_rf_region_t region)
       tsch_set_hopping_sequence(eu_tsch_hopping_sequence, eu_tsch_hopping_sequence_size);
       tsch_set_hopping_sequence_adv(eu_tsch_hopping_sequence_adv, eu_tsch_hopping_sequence_adv_size);
 
-      #if !CONTIKI_TARGET_COOJA
+      #if !CONTIKI_TARGET_COOJA && !CONTIKI_TARGET_NATIVE
       gDot_15_4g_radioConf = &eu_dot_15_4g_radioConf;
       #endif
 
@@ -245,7 +245,7 @@ bool sf_rf_selectRegion(sf_rf_region_t region)
       tsch_set_hopping_sequence(chn_tsch_hopping_sequence, chn_tsch_hopping_sequence_size);
       tsch_set_hopping_sequence_adv(chn_tsch_hopping_sequence_adv, chn_tsch_hopping_sequence_adv_size);
 
-      #if !CONTIKI_TARGET_COOJA
+      #if !CONTIKI_TARGET_COOJA && !CONTIKI_TARGET_NATIVE
       gDot_15_4g_radioConf = &chn_dot_15_4g_radioConf;
       #endif
 
@@ -271,7 +271,7 @@ bool sf_rf_selectRegion(sf_rf_region_t region)
       tsch_set_hopping_sequence(jp_tsch_hopping_sequence, jp_tsch_hopping_sequence_size);
       tsch_set_hopping_sequence_adv(jp_tsch_hopping_sequence_adv, jp_tsch_hopping_sequence_adv_size);
 
-      #if !CONTIKI_TARGET_COOJA
+      #if !CONTIKI_TARGET_COOJA && !CONTIKI_TARGET_NATIVE
       gDot_15_4g_radioConf = &jp_dot_15_4g_radioConf;
       #endif
 
@@ -297,7 +297,7 @@ bool sf_rf_selectRegion(sf_rf_region_t region)
       tsch_set_hopping_sequence(sk_tsch_hopping_sequence, sk_tsch_hopping_sequence_size);
       tsch_set_hopping_sequence_adv(sk_tsch_hopping_sequence_adv, sk_tsch_hopping_sequence_adv_size);
 
-      #if !CONTIKI_TARGET_COOJA
+      #if !CONTIKI_TARGET_COOJA && !CONTIKI_TARGET_NATIVE
       gDot_15_4g_radioConf = &sk_dot_15_4g_radioConf;
       #endif
 
@@ -323,7 +323,7 @@ bool sf_rf_selectRegion(sf_rf_region_t region)
       tsch_set_hopping_sequence(in_tsch_hopping_sequence, in_tsch_hopping_sequence_size);
       tsch_set_hopping_sequence_adv(in_tsch_hopping_sequence_adv, in_tsch_hopping_sequence_adv_size);
 
-      #if !CONTIKI_TARGET_COOJA
+      #if !CONTIKI_TARGET_COOJA && !CONTIKI_TARGET_NATIVE
       gDot_15_4g_radioConf = &in_dot_15_4g_radioConf;
       #endif
 
@@ -349,7 +349,7 @@ bool sf_rf_selectRegion(sf_rf_region_t region)
       tsch_set_hopping_sequence(glob2g4_tsch_hopping_sequence, glob2g4_tsch_hopping_sequence_size);
       tsch_set_hopping_sequence_adv(glob2g4_tsch_hopping_sequence_adv, glob2g4_tsch_hopping_sequence_adv_size);
 
-      #if !CONTIKI_TARGET_COOJA
+      #if !CONTIKI_TARGET_COOJA && !CONTIKI_TARGET_NATIVE
       gDot_15_4g_radioConf = &glob2g4_dot_15_4g_radioConf;
       #endif
 
@@ -264,7 +264,7 @@
 /** Join Hopping Sequence. */
 #define GLOB2G4_TSCH_CONF_JOIN_HOPPING_SEQUENCE (uint8_t[]){ 18, 11, 22 }
 
-#if !CONTIKI_TARGET_COOJA
+#if !CONTIKI_TARGET_COOJA && !CONTIKI_TARGET_NATIVE
 /** Default hopping sequence */
 #define TSCH_CONF_DEFAULT_HOPPING_SEQUENCE EU_TSCH_CONF_DEFAULT_HOPPING_SEQUENCE
 /** Default join hopping sequence */
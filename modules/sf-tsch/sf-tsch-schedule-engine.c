@@ -0,0 +1,298 @@
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ @code
+  ___ _____ _   ___ _  _____ ___  ___  ___ ___
+ / __|_   _/_\ / __| |/ / __/ _ \| _ \/ __| __|
+ \__ \ | |/ _ \ (__| ' <| _| (_) |   / (__| _|
+ |___/ |_/_/ \_\___|_|\_\_| \___/|_|_\\___|___|
+ embedded.connectivity.solutions.==============
+ @endcode
+
+ @file
+ @copyright  STACKFORCE GmbH, Germany, www.stackforce.de
+ @author     STACKFORCE
+ @brief      Implementation of the schedule engines.
+*/
+
+#include "sf-tsch-schedule-engine.h"
+
+#define RX_SLOTS_PER_POSITION SF_TSCH_SCHEDULE_RX_SLOTS_PER_POSITION
+
+/*---------------------------------------------------------------------------*/
+/* Slots shared by the layouts: each section starts with the beacon slots,
+ * the join request slots and the join process slots. */
+static uint16_t get_beacon_slot( uint8_t section )
+{
+    return section * APP_SLOTFRAME_SECTION_SIZE;
+}
+
+/*---------------------------------------------------------------------------*/
+static uint16_t get_jreq_slot( uint8_t section )
+{
+    return get_beacon_slot(section) + APP_SLOTFRAME_SECTION_BEACON_SLOTS;
+}
+
+/*---------------------------------------------------------------------------*/
+static uint16_t get_jproc_slot( uint8_t section )
+{
+    return get_jreq_slot(section) + APP_SLOTFRAME_SECTION_JOIN_REQUEST_SLOTS;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Returns the timeslot of the first data slot of a section. */
+static uint16_t get_data_offset( uint8_t section )
+{
+    return get_beacon_slot(section) + APP_SLOTFRAME_SECTION_BEACON_SLOTS +
+            APP_SLOTFRAME_SECTION_JOIN_SLOTS;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Returns the kind of a timeslot in a layout whose sections start with the
+ * RX slots of the devices, followed by the shared retry slots. */
+static uint8_t get_uplink_slot_kind( uint16_t timeslot, uint16_t retry_slot_offset )
+{
+    uint16_t rx_slot_offset;
+
+    if( timeslot >= APP_SLOTFRAME_SIZE )
+        return SF_TSCH_SCHEDULE_SLOT_OTHER;
+
+    rx_slot_offset = get_data_offset(timeslot / APP_SLOTFRAME_SECTION_SIZE);
+    if( timeslot < rx_slot_offset )
+        return SF_TSCH_SCHEDULE_SLOT_OTHER;
+    if( timeslot < retry_slot_offset )
+        return (((timeslot - rx_slot_offset) % RX_SLOTS_PER_POSITION) == 0) ?
+                SF_TSCH_SCHEDULE_SLOT_RX : SF_TSCH_SCHEDULE_SLOT_RETRY;
+    if( timeslot < retry_slot_offset + APP_SLOTFRAME_SECTION_RETRY_SLOTS )
+        return SF_TSCH_SCHEDULE_SLOT_RETRY;
+
+    return SF_TSCH_SCHEDULE_SLOT_OTHER;
+}
+
+/*---------------------------------------------------------------------------*/
+/* SCHEDULE_A: the compact layout packs the RX slots, the retry slots and the
+ * TX slots of the positions of the slotframe without gaps. */
+#define A_TX_SLOTS_HALF ((APP_SLOTFRAME_SECTION_DEVICE_RX_SLOTS + 1) / 2)
+
+static uint16_t a_retry_slot( uint8_t section, uint16_t positions )
+{
+#if APP_SLOTFRAME_COMPACT
+    (void)section;
+    return get_data_offset(0) + (positions * RX_SLOTS_PER_POSITION);
+#else
+    (void)positions;
+    return get_data_offset(section) +
+            (APP_SLOTFRAME_SECTION_DEVICE_TX_SLOTS * RX_SLOTS_PER_POSITION);
+#endif /* #if APP_SLOTFRAME_COMPACT */
+}
+
+/*---------------------------------------------------------------------------*/
+static uint16_t a_tx_slot( uint8_t section, uint16_t positions )
+{
+    return a_retry_slot(section, positions) + APP_SLOTFRAME_SECTION_RETRY_SLOTS;
+}
+
+/*---------------------------------------------------------------------------*/
+static uint16_t a_broadcast_slot( uint8_t section, uint16_t positions )
+{
+#if APP_SLOTFRAME_COMPACT
+    return a_tx_slot(section, positions) + positions;
+#else
+    return a_tx_slot(section, positions) + APP_SLOTFRAME_SECTION_DEVICE_RX_SLOTS;
+#endif /* #if APP_SLOTFRAME_COMPACT */
+}
+
+/*---------------------------------------------------------------------------*/
+static void a_data_slot( uint16_t devid, uint8_t rx, uint16_t positions,
+                         uint16_t* slot_offset, uint16_t* channel_offset )
+{
+    uint16_t pos = devid / APP_SLOTFRAME_CHANNEL_OFFSETS;
+#if !APP_SLOTFRAME_COMPACT
+    uint8_t section;
+    uint16_t slot;
+#endif /* #if !APP_SLOTFRAME_COMPACT */
+
+    *channel_offset = devid % APP_SLOTFRAME_CHANNEL_OFFSETS;
+#if APP_SLOTFRAME_COMPACT
+    if( rx )
+        *slot_offset = get_data_offset(0) + (pos * RX_SLOTS_PER_POSITION);
+    else
+        *slot_offset = a_tx_slot(0, positions) + pos;
+#else
+    if( rx )
+    {
+        section = pos / APP_SLOTFRAME_SECTION_DEVICE_TX_SLOTS;
+        slot = (pos % APP_SLOTFRAME_SECTION_DEVICE_TX_SLOTS) * RX_SLOTS_PER_POSITION;
+        *slot_offset = get_data_offset(section) + slot;
+    }
+    else
+    {
+        /* every second TX slot for the first half of the positions, the
+           slots in between for the second half */
+        section = pos / APP_SLOTFRAME_SECTION_DEVICE_RX_SLOTS;
+        slot = pos % APP_SLOTFRAME_SECTION_DEVICE_RX_SLOTS;
+        if( slot < A_TX_SLOTS_HALF )
+            slot = slot * 2;
+        else
+            slot = ((slot - A_TX_SLOTS_HALF) * 2) + 1;
+        *slot_offset = a_tx_slot(section, positions) + slot;
+    }
+#endif /* #if APP_SLOTFRAME_COMPACT */
+}
+
+/*---------------------------------------------------------------------------*/
+static uint8_t a_uplink_slot_kind( uint16_t timeslot, uint16_t positions )
+{
+    return get_uplink_slot_kind(timeslot,
+            a_retry_slot(timeslot / APP_SLOTFRAME_SECTION_SIZE, positions));
+}
+
+/*---------------------------------------------------------------------------*/
+const struct sf_tsch_schedule_engine sf_tsch_schedule_engine_a =
+{
+    "A",
+    get_beacon_slot,
+    get_jreq_slot,
+    get_jproc_slot,
+    a_data_slot,
+    a_retry_slot,
+    a_broadcast_slot,
+    a_uplink_slot_kind
+};
+
+/*---------------------------------------------------------------------------*/
+/* SCHEDULE_B: the RX slot, the dedicated retry slot and the TX slot of a
+ * device position are consecutive. */
+#define B_SLOTS_PER_POSITION (RX_SLOTS_PER_POSITION + 1)
+
+static uint16_t b_retry_slot( uint8_t section, uint16_t positions )
+{
+    (void)positions;
+    return get_data_offset(section) +
+            (APP_SLOTFRAME_SECTION_DEVICE_TX_SLOTS * B_SLOTS_PER_POSITION);
+}
+
+/*---------------------------------------------------------------------------*/
+static uint16_t b_broadcast_slot( uint8_t section, uint16_t positions )
+{
+    return b_retry_slot(section, positions) + APP_SLOTFRAME_SECTION_RETRY_SLOTS;
+}
+
+/*---------------------------------------------------------------------------*/
+static void b_data_slot( uint16_t devid, uint8_t rx, uint16_t positions,
+                         uint16_t* slot_offset, uint16_t* channel_offset )
+{
+    uint16_t pos = devid / APP_SLOTFRAME_CHANNEL_OFFSETS;
+    uint8_t section = pos / APP_SLOTFRAME_SECTION_DEVICE_TX_SLOTS;
+
+    (void)positions;
+    *channel_offset = devid % APP_SLOTFRAME_CHANNEL_OFFSETS;
+    *slot_offset = get_data_offset(section) +
+            ((pos % APP_SLOTFRAME_SECTION_DEVICE_TX_SLOTS) * B_SLOTS_PER_POSITION);
+    if( !rx )
+        *slot_offset += RX_SLOTS_PER_POSITION;
+}
+
+/*---------------------------------------------------------------------------*/
+static uint8_t b_uplink_slot_kind( uint16_t timeslot, uint16_t positions )
+{
+    uint16_t data_offset;
+    uint16_t retry_slot_offset;
+    uint16_t slot;
+
+    if( timeslot >= APP_SLOTFRAME_SIZE )
+        return SF_TSCH_SCHEDULE_SLOT_OTHER;
+
+    data_offset = get_data_offset(timeslot / APP_SLOTFRAME_SECTION_SIZE);
+    retry_slot_offset = b_retry_slot(timeslot / APP_SLOTFRAME_SECTION_SIZE, positions);
+    if( timeslot < data_offset )
+        return SF_TSCH_SCHEDULE_SLOT_OTHER;
+    if( timeslot < retry_slot_offset )
+    {
+        slot = (timeslot - data_offset) % B_SLOTS_PER_POSITION;
+        if( slot == 0 )
+            return SF_TSCH_SCHEDULE_SLOT_RX;
+        return (slot < RX_SLOTS_PER_POSITION) ?
+                SF_TSCH_SCHEDULE_SLOT_RETRY : SF_TSCH_SCHEDULE_SLOT_OTHER;
+    }
+    if( timeslot < retry_slot_offset + APP_SLOTFRAME_SECTION_RETRY_SLOTS )
+        return SF_TSCH_SCHEDULE_SLOT_RETRY;
+
+    return SF_TSCH_SCHEDULE_SLOT_OTHER;
+}
+
+/*---------------------------------------------------------------------------*/
+const struct sf_tsch_schedule_engine sf_tsch_schedule_engine_b =
+{
+    "B",
+    get_beacon_slot,
+    get_jreq_slot,
+    get_jproc_slot,
+    b_data_slot,
+    b_retry_slot,
+    b_broadcast_slot,
+    b_uplink_slot_kind
+};
+
+/*---------------------------------------------------------------------------*/
+/* SCHEDULE_C: device position p is in section p % APP_SLOTFRAME_SECTION_NUM
+ * at index p / APP_SLOTFRAME_SECTION_NUM. */
+static uint16_t c_retry_slot( uint8_t section, uint16_t positions )
+{
+    (void)positions;
+    return get_data_offset(section) +
+            (APP_SLOTFRAME_SECTION_DEVICE_TX_SLOTS * RX_SLOTS_PER_POSITION);
+}
+
+/*---------------------------------------------------------------------------*/
+static uint16_t c_tx_slot( uint8_t section, uint16_t positions )
+{
+    return c_retry_slot(section, positions) + APP_SLOTFRAME_SECTION_RETRY_SLOTS;
+}
+
+/*---------------------------------------------------------------------------*/
+static uint16_t c_broadcast_slot( uint8_t section, uint16_t positions )
+{
+    return c_tx_slot(section, positions) + APP_SLOTFRAME_SECTION_DEVICE_RX_SLOTS;
+}
+
+/*---------------------------------------------------------------------------*/
+static void c_data_slot( uint16_t devid, uint8_t rx, uint16_t positions,
+                         uint16_t* slot_offset, uint16_t* channel_offset )
+{
+    uint16_t pos = devid / APP_SLOTFRAME_CHANNEL_OFFSETS;
+    uint8_t section = pos % APP_SLOTFRAME_SECTION_NUM;
+    uint16_t index = pos / APP_SLOTFRAME_SECTION_NUM;
+
+    *channel_offset = devid % APP_SLOTFRAME_CHANNEL_OFFSETS;
+    if( rx )
+        *slot_offset = get_data_offset(section) + (index * RX_SLOTS_PER_POSITION);
+    else
+        *slot_offset = c_tx_slot(section, positions) + index;
+}
+
+/*---------------------------------------------------------------------------*/
+static uint8_t c_uplink_slot_kind( uint16_t timeslot, uint16_t positions )
+{
+    return get_uplink_slot_kind(timeslot,
+            c_retry_slot(timeslot / APP_SLOTFRAME_SECTION_SIZE, positions));
+}
+
+/*---------------------------------------------------------------------------*/
+const struct sf_tsch_schedule_engine sf_tsch_schedule_engine_c =
+{
+    "C",
+    get_beacon_slot,
+    get_jreq_slot,
+    get_jproc_slot,
+    c_data_slot,
+    c_retry_slot,
+    c_broadcast_slot,
+    c_uplink_slot_kind
+};
+
+#ifdef __cplusplus
+}
+#endif
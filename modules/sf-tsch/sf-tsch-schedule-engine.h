@@ -0,0 +1,138 @@
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ @code
+  ___ _____ _   ___ _  _____ ___  ___  ___ ___
+ / __|_   _/_\ / __| |/ / __/ _ \| _ \/ __| __|
+ \__ \ | |/ _ \ (__| ' <| _| (_) |   / (__| _|
+ |___/ |_/_/ \_\___|_|\_\_| \___/|_|_\\___|___|
+ embedded.connectivity.solutions.==============
+ @endcode
+
+ @file
+ @copyright  STACKFORCE GmbH, Germany, www.stackforce.de
+ @author     STACKFORCE
+ @brief      This header contains the schedule engine interface.
+*/
+
+#ifndef TSCH_SCHEDULE_ENGINE_H_
+#define TSCH_SCHEDULE_ENGINE_H_
+
+#include <stdint.h>
+#include "contiki.h"
+
+/* the slotframe keeps its size unless the compaction is enabled */
+#ifndef APP_SLOTFRAME_COMPACT
+#define APP_SLOTFRAME_COMPACT 0
+#endif
+
+/* every device has a retransmission slot behind its RX slot unless disabled */
+#ifndef APP_SLOTFRAME_DEDICATED_RETRY_SLOT
+#define APP_SLOTFRAME_DEDICATED_RETRY_SLOT 1
+#endif
+
+/* no shared retry slots unless configured */
+#ifndef APP_SLOTFRAME_SECTION_RETRY_SLOTS
+#define APP_SLOTFRAME_SECTION_RETRY_SLOTS 0
+#endif
+
+/* RX slots of a device position, the RX slot and the dedicated retry slot */
+#define SF_TSCH_SCHEDULE_RX_SLOTS_PER_POSITION (1 + APP_SLOTFRAME_DEDICATED_RETRY_SLOT)
+
+/* devices the sections of the slotframe hold */
+#define SF_TSCH_SCHEDULE_MAX_DEVICES (APP_SLOTFRAME_SECTION_NUM * \
+                                      APP_SLOTFRAME_SECTION_DEVICE_TX_SLOTS * \
+                                      APP_SLOTFRAME_CHANNEL_OFFSETS)
+
+/**
+ * @brief   Uplink slot kinds, see uplink_slot_kind.
+ */
+#define SF_TSCH_SCHEDULE_SLOT_OTHER 0
+#define SF_TSCH_SCHEDULE_SLOT_RX    1
+#define SF_TSCH_SCHEDULE_SLOT_RETRY 2
+
+/**
+ * @brief   Schedule engine.
+ *
+ *          A schedule engine is the layout of the slotframe: it places the
+ *          beacon, join, data, retry and broadcast slots of each section.
+ *          The schedule installs and removes the links at the places the
+ *          engine returns. Device ids are the short address - 1. Consecutive
+ *          devices share a timeslot on APP_SLOTFRAME_CHANNEL_OFFSETS channel
+ *          offsets, a device position is such a timeslot. The number of
+ *          device positions of the slotframe only matters for the compact
+ *          layout (APP_SLOTFRAME_COMPACT), other layouts ignore it.
+ */
+struct sf_tsch_schedule_engine
+{
+    /* name of the layout */
+    const char* name;
+    /* timeslot of the beacon slot of a section */
+    uint16_t (* beacon_slot)( uint8_t section );
+    /* timeslot of the first join request slot of a section */
+    uint16_t (* jreq_slot)( uint8_t section );
+    /* timeslot of the first join process slot of a section */
+    uint16_t (* jproc_slot)( uint8_t section );
+    /* timeslot and channel offset of the RX slot of a device (rx != 0),
+     * followed by the dedicated retry slot if enabled, or of its TX slot */
+    void (* data_slot)( uint16_t devid, uint8_t rx, uint16_t positions,
+                        uint16_t* slot_offset, uint16_t* channel_offset );
+    /* timeslot of the first shared retry slot of a section */
+    uint16_t (* retry_slot)( uint8_t section, uint16_t positions );
+    /* timeslot of the first broadcast slot of a section */
+    uint16_t (* broadcast_slot)( uint8_t section, uint16_t positions );
+    /* SF_TSCH_SCHEDULE_SLOT_RX for the RX slot of a device,
+     * SF_TSCH_SCHEDULE_SLOT_RETRY for a dedicated or shared retry slot and
+     * SF_TSCH_SCHEDULE_SLOT_OTHER for any other timeslot */
+    uint8_t (* uplink_slot_kind)( uint16_t timeslot, uint16_t positions );
+};
+
+/**
+ * @brief   Layout of SCHEDULE_A.
+ *
+ *          Per section the beacon and join slots, the RX slots of the
+ *          devices, the shared retry slots, every second timeslot of the
+ *          TX slots of the devices, then the broadcast slots. Fills the
+ *          first section first. The only layout with APP_SLOTFRAME_COMPACT.
+ */
+extern const struct sf_tsch_schedule_engine sf_tsch_schedule_engine_a;
+
+/**
+ * @brief   Layout of SCHEDULE_B.
+ *
+ *          Per section the beacon and join slots, then for each device
+ *          position its RX slot, its dedicated retry slot and its TX slot,
+ *          then the shared retry slots and the broadcast slots. A command
+ *          queued within a timeslot after the measurement of a device is
+ *          sent in the same slotframe.
+ */
+extern const struct sf_tsch_schedule_engine sf_tsch_schedule_engine_b;
+
+/**
+ * @brief   Layout of SCHEDULE_C.
+ *
+ *          Like SCHEDULE_A without gaps, but the device positions are dealt
+ *          out to the APP_SLOTFRAME_SECTION_NUM sections in turn. The
+ *          sections are short, so the beacon and join slots come around
+ *          more often.
+ */
+extern const struct sf_tsch_schedule_engine sf_tsch_schedule_engine_c;
+
+/* the engine of the selected schedule */
+#ifdef SF_TSCH_SCHEDULE_CONF_ENGINE
+#define SF_TSCH_SCHEDULE_ENGINE SF_TSCH_SCHEDULE_CONF_ENGINE
+#elif SCHEDULE_B
+#define SF_TSCH_SCHEDULE_ENGINE sf_tsch_schedule_engine_b
+#elif SCHEDULE_C
+#define SF_TSCH_SCHEDULE_ENGINE sf_tsch_schedule_engine_c
+#else
+#define SF_TSCH_SCHEDULE_ENGINE sf_tsch_schedule_engine_a
+#endif /* #ifdef SF_TSCH_SCHEDULE_CONF_ENGINE */
+
+#endif /* TSCH_SCHEDULE_ENGINE_H_ */
+
+#ifdef __cplusplus
+}
+#endif
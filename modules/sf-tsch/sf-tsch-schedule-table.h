@@ -0,0 +1,85 @@
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ @code
+  ___ _____ _   ___ _  _____ ___  ___  ___ ___
+ / __|_   _/_\ / __| |/ / __/ _ \| _ \/ __| __|
+ \__ \ | |/ _ \ (__| ' <| _| (_) |   / (__| _|
+ |___/ |_/_/ \_\___|_|\_\_| \___/|_|_\\___|___|
+ embedded.connectivity.solutions.==============
+ @endcode
+
+ @file
+ @copyright  STACKFORCE GmbH, Germany, www.stackforce.de
+ @author     STACKFORCE
+ @brief      This header contains the static schedule table.
+*/
+
+#ifndef TSCH_SCHEDULE_TABLE_H_
+#define TSCH_SCHEDULE_TABLE_H_
+
+#include <stdint.h>
+#include "contiki.h"
+#include "net/mac/tsch/tsch.h"
+#include "sf-tsch-schedule-engine.h"
+
+/**
+ * @brief   Link groups of the schedule table.
+ *
+ *          The links of the table are switched on and off by group: the
+ *          beacon, broadcast, shared retry and join request slots of all
+ *          sections, and the RX slots (with the dedicated retry slot) and
+ *          the TX slot of each device id below APP_MAX_DEVICE_SLOTS, the
+ *          addresses the device management hands out.
+ */
+#define SF_TSCH_SCHEDULE_TABLE_BEACON           0
+#define SF_TSCH_SCHEDULE_TABLE_BROADCAST        1
+#define SF_TSCH_SCHEDULE_TABLE_RETRY            2
+#define SF_TSCH_SCHEDULE_TABLE_JREQ             3
+#define SF_TSCH_SCHEDULE_TABLE_DEVICE_RX(devid) (4 + (2 * (devid)))
+#define SF_TSCH_SCHEDULE_TABLE_DEVICE_TX(devid) (5 + (2 * (devid)))
+#define SF_TSCH_SCHEDULE_TABLE_GROUPS           SF_TSCH_SCHEDULE_TABLE_DEVICE_RX(APP_MAX_DEVICE_SLOTS)
+
+/* links of the table at most, the generated table is checked against it */
+#define SF_TSCH_SCHEDULE_TABLE_MAX_LINKS (APP_SLOTFRAME_SECTION_NUM * \
+                                          (APP_SLOTFRAME_SECTION_BEACON_SLOTS + \
+                                           APP_SLOTFRAME_SECTION_JOIN_REQUEST_SLOTS + \
+                                           APP_SLOTFRAME_SECTION_BROADCAST_SLOTS + \
+                                           APP_SLOTFRAME_SECTION_RETRY_SLOTS) + \
+                                          (APP_MAX_DEVICE_SLOTS * \
+                                           (SF_TSCH_SCHEDULE_RX_SLOTS_PER_POSITION + 1)))
+
+/* handle of the first link of the table, the handles of the link pool
+ * count up from 0 */
+#define SF_TSCH_SCHEDULE_TABLE_HANDLE 0x8000
+
+/**
+ * @brief   Links of the slotframe, sorted by timeslot.
+ *
+ *          Generated at build time by tools/schedule-table-gen.c from the
+ *          slotframe configuration, see APP_SLOTFRAME_STATIC.
+ */
+extern const struct tsch_link sf_tsch_schedule_table_links[];
+
+/**
+ * @brief   Number of links of sf_tsch_schedule_table_links.
+ */
+extern const uint16_t sf_tsch_schedule_table_links_count;
+
+/**
+ * @brief   Links of the groups.
+ *
+ *          The indexes in sf_tsch_schedule_table_links of the links of group
+ *          g are sf_tsch_schedule_table_group_links[first[g]] up to,
+ *          excluding, sf_tsch_schedule_table_group_links[first[g + 1]].
+ */
+extern const uint16_t sf_tsch_schedule_table_group_first[SF_TSCH_SCHEDULE_TABLE_GROUPS + 1];
+extern const uint16_t sf_tsch_schedule_table_group_links[];
+
+#endif /* TSCH_SCHEDULE_TABLE_H_ */
+
+#ifdef __cplusplus
+}
+#endif
@@ -18,8 +18,14 @@ extern "C" {
 */
 
 #include "sf-tsch-schedule.h"
+#include "sf-tsch-schedule-engine.h"
+#if APP_SLOTFRAME_STATIC
+#include "sf-tsch-schedule-table.h"
+#endif /* #if APP_SLOTFRAME_STATIC */
 #include "net/mac/tsch/tsch-schedule.h"
 #include "watchdog.h"
+#include "sys/ctimer.h"
+#include <string.h>
 
 /* Log configuration */
 #include "sys/log.h"
@@ -31,24 +37,586 @@ extern "C" {
   #define LOG_LEVEL     LOG_CONF_APP
 #endif
 
+/* RX slots of a device position, the RX slot and the dedicated retry slot */
+#define RX_SLOTS_PER_POSITION SF_TSCH_SCHEDULE_RX_SLOTS_PER_POSITION
+/* data slot links of a device, its RX slots and its TX slot */
+#define DATA_LINKS_PER_DEVICE (RX_SLOTS_PER_POSITION + 1)
+
+#if APP_SLOTFRAME_COMPACT
+/* the active slotframe and the one replacing it after a resize */
+#define SCHEDULE_LAYOUTS 2
+/* first timeslot of the data slots */
+#define COMPACT_DATA_OFFSET (APP_SLOTFRAME_SECTION_BEACON_SLOTS + APP_SLOTFRAME_SECTION_JOIN_SLOTS)
+/* device positions that fit into a slotframe of at most APP_SLOTFRAME_SIZE */
+#define COMPACT_MAX_POSITIONS ((APP_SLOTFRAME_SIZE - COMPACT_DATA_OFFSET - \
+                                APP_SLOTFRAME_SECTION_RETRY_SLOTS - \
+                                APP_SLOTFRAME_SECTION_BROADCAST_SLOTS) / \
+                               (RX_SLOTS_PER_POSITION + 1))
+#define COMPACT_MAX_DEVICES (COMPACT_MAX_POSITIONS * APP_SLOTFRAME_CHANNEL_OFFSETS)
+#else
+#define SCHEDULE_LAYOUTS 1
+#endif /* #if APP_SLOTFRAME_COMPACT */
+
 /* check whether the module has already been initialized */
 static int initialized = 0;
 
+/* layout of the slotframe */
+static const struct sf_tsch_schedule_engine* const engine = &SF_TSCH_SCHEDULE_ENGINE;
+
+#if APP_SLOTFRAME_STATIC
+/* enabled links of the schedule table, one bit per link */
+static uint32_t table_enabled[(SF_TSCH_SCHEDULE_TABLE_MAX_LINKS + 31) / 32];
+/* table indexes of the links of a bulk add or delete of data slots */
+static uint16_t bulk_indexes[APP_MAX_DEVICE_SLOTS * DATA_LINKS_PER_DEVICE];
+#else
+/* link descriptions of a bulk add or delete of data slots */
+static struct tsch_link_desc bulk_links[APP_MAX_DEVICE_SLOTS * DATA_LINKS_PER_DEVICE];
+#endif /* #if APP_SLOTFRAME_STATIC */
+
+/* slotframe handle and number of device positions of each layout */
+#if APP_SLOTFRAME_COMPACT
+static const uint16_t layout_handle[SCHEDULE_LAYOUTS] = { APP_SLOTFRAME_HANDLE,
+                                                          APP_SLOTFRAME_COMPACT_HANDLE };
+#else
+static const uint16_t layout_handle[SCHEDULE_LAYOUTS] = { APP_SLOTFRAME_HANDLE };
+#endif /* #if APP_SLOTFRAME_COMPACT */
+static uint16_t layout_positions[SCHEDULE_LAYOUTS];
+/* layout of the active slotframe */
+static uint8_t active_layout;
+/* frames received in the device RX slots and in the retry slots */
+static sf_tsch_schedule_retry_stats_t retry_stats;
+
+#if APP_SLOTFRAME_COMPACT
+/* address of each device with data slots, indexed by device id */
+static linkaddr_t device_addr[COMPACT_MAX_DEVICES];
+/* devices with RX and TX data slots, one bit per device id */
+static uint8_t rx_devices[(COMPACT_MAX_DEVICES + 7) / 8];
+static uint8_t tx_devices[(COMPACT_MAX_DEVICES + 7) / 8];
+/* a resized slotframe waits for its activation ASN */
+static uint8_t switch_pending;
+/* the devices changed again while the switch was pending */
+static uint8_t relayout_pending;
+/* completes a pending switch */
+static struct ctimer switch_timer;
+/* schedule descriptor announced in the EBs */
+static struct tsch_schedule_desc schedule_desc;
+#endif /* #if APP_SLOTFRAME_COMPACT */
+
+/*---------------------------------------------------------------------------*/
+/* Returns the device id of an address, -1 for an invalid address. */
+static int32_t get_devid( const linkaddr_t* addr )
+{
+#if LINKADDR_SIZE == 2
+    uint16_t devid = addr->u16 - 1;
+#else
+    uint16_t devid = addr->u16[0] - 1;
+#endif /* #if LINKADDR_SIZE == 2 */
+
+    if( (int16_t)devid < 0 )
+        return -1;
+
+#if APP_SLOTFRAME_COMPACT
+    if( devid >= COMPACT_MAX_DEVICES )
+        return -1;
+#else
+    if( devid >= SF_TSCH_SCHEDULE_MAX_DEVICES )
+        return -1;
+#endif /* #if APP_SLOTFRAME_COMPACT */
+
+    return devid;
+}
+
+#if !APP_SLOTFRAME_STATIC
+/*---------------------------------------------------------------------------*/
+/* Returns 1 if the data slots of a device fit into the slotframe of a
+ * layout. A slotframe that is too small for a new device is replaced by a
+ * larger one, the slots of the device are added to the larger one only. */
+static int data_slot_fits( uint16_t devid, uint8_t layout )
+{
+#if APP_SLOTFRAME_COMPACT
+    return (devid / APP_SLOTFRAME_CHANNEL_OFFSETS) < layout_positions[layout];
+#else
+    (void)devid;
+    (void)layout;
+    return 1;
+#endif /* #if APP_SLOTFRAME_COMPACT */
+}
+
+/*---------------------------------------------------------------------------*/
+/* Fills in the data slot links of a device for a slotframe with the given
+ * number of device positions. Returns the number of links, 0 in case of an
+ * invalid address. */
+static uint8_t get_data_slot_links( const linkaddr_t* addr,
+                                    e_sf_tsch_schedule_data_slot_types_t dataSlotType,
+                                    uint16_t positions, struct tsch_link_desc* links )
+{
+    uint8_t cnt = 0;
+    uint16_t slot_offset;
+    uint16_t channel_offset;
+    int32_t devid = get_devid(addr);
+
+    if( devid < 0 )
+        return 0;
+
+    if( (E_SF_TSCH_SCHEDULE_DATA_SLOTS_ALL == dataSlotType) ||
+        (E_SF_TSCH_SCHEDULE_DATA_SLOTS_RX == dataSlotType) )
+    {
+        /* the RX slot and the slot only for retransmissions */
+        engine->data_slot(devid, 1, positions, &slot_offset, &channel_offset);
+        for( uint8_t i = 0; i < RX_SLOTS_PER_POSITION; i++ )
+        {
+            linkaddr_copy(&links[cnt].addr, &tsch_broadcast_address);
+            links[cnt].timeslot = slot_offset + i;
+            links[cnt].channel_offset = channel_offset;
+            links[cnt].link_options = LINK_OPTION_RX;
+            links[cnt].link_type = LINK_TYPE_NORMAL;
+            cnt++;
+        }
+    }
+
+    if( (E_SF_TSCH_SCHEDULE_DATA_SLOTS_ALL == dataSlotType) ||
+        (E_SF_TSCH_SCHEDULE_DATA_SLOTS_TX == dataSlotType) )
+    {
+        /* the TX slot */
+        engine->data_slot(devid, 0, positions, &slot_offset, &channel_offset);
+        linkaddr_copy(&links[cnt].addr, addr);
+        links[cnt].timeslot = slot_offset;
+        links[cnt].channel_offset = channel_offset;
+        links[cnt].link_options = LINK_OPTION_TX;
+        links[cnt].link_type = LINK_TYPE_NORMAL;
+        cnt++;
+    }
+
+    return cnt;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Fills bulk_links with the data slot links of all devices that fit into
+ * the slotframe of a layout. Returns the number of links, -1 in case of an
+ * invalid address. */
+static int get_bulk_data_slot_links( const linkaddr_t* addrs, uint8_t cnt,
+                                     e_sf_tsch_schedule_data_slot_types_t dataSlotType,
+                                     uint8_t layout )
+{
+    int links_cnt = 0;
+    uint8_t dev_links_cnt;
+    int32_t devid;
+
+    if( (addrs == NULL) || (cnt > APP_MAX_DEVICE_SLOTS) )
+        return -1;
+
+    for( uint8_t i = 0; i < cnt; i++ )
+    {
+        devid = get_devid(&addrs[i]);
+        if( devid < 0 )
+            return -1;
+        if( !data_slot_fits(devid, layout) )
+            continue;
+        dev_links_cnt = get_data_slot_links(&addrs[i], dataSlotType,
+                                            layout_positions[layout], &bulk_links[links_cnt]);
+        if( dev_links_cnt == 0 )
+            return -1;
+        links_cnt += dev_links_cnt;
+    }
+
+    return links_cnt;
+}
+#endif /* #if !APP_SLOTFRAME_STATIC */
+
+/*---------------------------------------------------------------------------*/
+/* Returns the slotframe of a layout, NULL if the layout is not in use. */
+static struct tsch_slotframe* get_layout_slotframe( uint8_t layout )
+{
+    return tsch_schedule_get_slotframe_by_handle( layout_handle[layout] );
+}
+
+/*---------------------------------------------------------------------------*/
+/* Returns 1 if the schedule is initialized and has an active slotframe. */
+static int schedule_ready( void )
+{
+    return initialized && (get_layout_slotframe(active_layout) != NULL);
+}
+
+#if APP_SLOTFRAME_STATIC
+/*---------------------------------------------------------------------------*/
+/* Enables or disables links of the schedule table. Returns 0 on success. */
+static int enable_table_links( const uint16_t* indexes, uint16_t cnt, int enable )
+{
+    if( !schedule_ready() )
+        return -1;
+
+    return tsch_schedule_enable_static_links(get_layout_slotframe(active_layout),
+                                             indexes, cnt, enable) ? 0 : -1;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Enables or disables the links of a group of the schedule table. Returns 0
+ * on success. */
+static int enable_table_group( uint16_t group, int enable )
+{
+    uint16_t first = sf_tsch_schedule_table_group_first[group];
+
+    return enable_table_links(&sf_tsch_schedule_table_group_links[first],
+                              sf_tsch_schedule_table_group_first[group + 1] - first, enable);
+}
+
+/*---------------------------------------------------------------------------*/
+/* Appends the table indexes of the links of a group to indexes. Returns the
+ * new number of indexes. */
+static int get_table_group_links( uint16_t group, uint16_t* indexes, int cnt )
+{
+    for( uint16_t i = sf_tsch_schedule_table_group_first[group];
+         i < sf_tsch_schedule_table_group_first[group + 1]; i++ )
+        indexes[cnt++] = sf_tsch_schedule_table_group_links[i];
+
+    return cnt;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Appends the table indexes of the data slot links of a device to indexes.
+ * Returns the new number of indexes, -1 in case of an invalid address, a
+ * device id without links in the table or an address other than the one the
+ * table was generated for. */
+static int get_table_data_slot_links( const linkaddr_t* addr,
+                                      e_sf_tsch_schedule_data_slot_types_t dataSlotType,
+                                      uint16_t* indexes, int cnt )
+{
+    uint16_t tx_link;
+    int32_t devid = get_devid(addr);
+
+    if( (devid < 0) || (devid >= APP_MAX_DEVICE_SLOTS) )
+        return -1;
+
+    if( (E_SF_TSCH_SCHEDULE_DATA_SLOTS_ALL == dataSlotType) ||
+        (E_SF_TSCH_SCHEDULE_DATA_SLOTS_RX == dataSlotType) )
+        cnt = get_table_group_links(SF_TSCH_SCHEDULE_TABLE_DEVICE_RX(devid), indexes, cnt);
+
+    if( (E_SF_TSCH_SCHEDULE_DATA_SLOTS_ALL == dataSlotType) ||
+        (E_SF_TSCH_SCHEDULE_DATA_SLOTS_TX == dataSlotType) )
+    {
+        /* the TX slot is addressed to the device */
+        tx_link = sf_tsch_schedule_table_group_first[SF_TSCH_SCHEDULE_TABLE_DEVICE_TX(devid)];
+        tx_link = sf_tsch_schedule_table_group_links[tx_link];
+        if( !linkaddr_cmp(&sf_tsch_schedule_table_links[tx_link].addr, addr) )
+            return -1;
+        cnt = get_table_group_links(SF_TSCH_SCHEDULE_TABLE_DEVICE_TX(devid), indexes, cnt);
+    }
+
+    return cnt;
+}
+#endif /* #if APP_SLOTFRAME_STATIC */
+
+#if APP_SLOTFRAME_COMPACT
+/*---------------------------------------------------------------------------*/
+/* Size of a compact slotframe with the given number of device positions. */
+static uint16_t get_compact_size( uint16_t positions )
+{
+    return engine->broadcast_slot(0, positions) + APP_SLOTFRAME_SECTION_BROADCAST_SLOTS;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Records the data slots of a device (add != 0) or their removal. */
+static void set_device( const linkaddr_t* addr, uint16_t devid,
+                        e_sf_tsch_schedule_data_slot_types_t dataSlotType, uint8_t add )
+{
+    uint8_t mask = 1U << (devid % 8);
+
+    linkaddr_copy(&device_addr[devid], addr);
+    if( (E_SF_TSCH_SCHEDULE_DATA_SLOTS_ALL == dataSlotType) ||
+        (E_SF_TSCH_SCHEDULE_DATA_SLOTS_RX == dataSlotType) )
+    {
+        if( add )
+            rx_devices[devid / 8] |= mask;
+        else
+            rx_devices[devid / 8] &= ~mask;
+    }
+    if( (E_SF_TSCH_SCHEDULE_DATA_SLOTS_ALL == dataSlotType) ||
+        (E_SF_TSCH_SCHEDULE_DATA_SLOTS_TX == dataSlotType) )
+    {
+        if( add )
+            tx_devices[devid / 8] |= mask;
+        else
+            tx_devices[devid / 8] &= ~mask;
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+/* Number of device positions the devices with data slots need. Positions
+ * are allocated in steps of APP_SLOTFRAME_COMPACT_STEP. Device ids are the
+ * sensor list indexes, which are reused lowest first. */
+static uint16_t get_needed_positions( void )
+{
+    uint16_t positions = 0;
+
+    /* the highest device id with data slots */
+    for( int32_t devid = COMPACT_MAX_DEVICES - 1; devid >= 0; devid-- )
+    {
+        if( (rx_devices[devid / 8] | tx_devices[devid / 8]) & (1U << (devid % 8)) )
+        {
+            positions = (devid / APP_SLOTFRAME_CHANNEL_OFFSETS) + 1;
+            break;
+        }
+    }
+
+    positions = ((positions + APP_SLOTFRAME_COMPACT_STEP - 1) / APP_SLOTFRAME_COMPACT_STEP) *
+                APP_SLOTFRAME_COMPACT_STEP;
+    if( positions == 0 )
+        positions = APP_SLOTFRAME_COMPACT_STEP;
+    if( positions > COMPACT_MAX_POSITIONS )
+        positions = COMPACT_MAX_POSITIONS;
+
+    return positions;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Announces the active or pending slotframe in the EBs. */
+static void update_desc( uint16_t positions, const struct tsch_asn_t* activation_asn )
+{
+    /* version 0 means no descriptor */
+    schedule_desc.version = (schedule_desc.version == 0xff) ? 1 : schedule_desc.version + 1;
+    schedule_desc.slotframe_size = get_compact_size(positions);
+    schedule_desc.data_slots = positions;
+    schedule_desc.activation_asn = *activation_asn;
+    tsch_set_schedule_desc(&schedule_desc);
+
+    LOG_INFO("Schedule version %u: %u timeslots, %u device positions from ASN %lu\n",
+             schedule_desc.version, schedule_desc.slotframe_size,
+             schedule_desc.data_slots, (unsigned long)activation_asn->ls4b);
+}
+
+static int start_switch( uint16_t positions );
+
+/*---------------------------------------------------------------------------*/
+/* Arms the switch timer to expire shortly after the activation ASN. */
+static void set_switch_timer( void (*callback)(void*) )
+{
+    int32_t slots = (int32_t)TSCH_ASN_DIFF(schedule_desc.activation_asn, tsch_current_asn);
+    clock_time_t ticks = 1;
+
+    if( slots > 0 )
+        ticks += (clock_time_t)(((uint64_t)slots * tsch_timing_us[tsch_ts_timeslot_length] *
+                                 CLOCK_SECOND) / 1000000UL);
+    ctimer_set(&switch_timer, ticks, callback, NULL);
+}
+
+/*---------------------------------------------------------------------------*/
+/* Removes the replaced slotframe once the new one is active. */
+static void complete_switch( void* ptr )
+{
+    uint8_t next = active_layout ^ 1;
+
+    (void)ptr;
+    if( ((int32_t)TSCH_ASN_DIFF(tsch_current_asn, schedule_desc.activation_asn) < 0) ||
+        (tsch_schedule_remove_slotframe(get_layout_slotframe(active_layout)) == 0) )
+    {
+        /* too early or the schedule is locked, try again */
+        set_switch_timer(complete_switch);
+        return;
+    }
+
+    tsch_schedule_set_slotframe_window(get_layout_slotframe(next), NULL, NULL);
+    active_layout = next;
+    switch_pending = 0;
+    LOG_INFO("Schedule version %u active\n", schedule_desc.version);
+
+    if( relayout_pending )
+    {
+        relayout_pending = 0;
+        if( get_needed_positions() != layout_positions[active_layout] )
+            start_switch(get_needed_positions());
+    }
+}
+
+/*---------------------------------------------------------------------------*/
+/* Fills the slotframe of the next layout with the links of the active one,
+ * moved to the positions of the next layout. */
+static int build_slotframe( struct tsch_slotframe* sf_active, struct tsch_slotframe* sf_next,
+                            uint8_t next )
+{
+    uint16_t positions = layout_positions[next];
+    struct tsch_link* link;
+    int links_cnt = 0;
+
+    /* the beacon, join request and join process slots keep their timeslots */
+    for( link = list_head(sf_active->links_list); link != NULL; link = list_item_next(link) )
+    {
+        if( link->timeslot >= COMPACT_DATA_OFFSET )
+            continue;
+        watchdog_periodic();
+        if( tsch_schedule_add_link(sf_next, link->link_options, link->link_type, &link->addr,
+                                   link->timeslot, link->channel_offset, true) == NULL )
+            return -1;
+    }
+
+    /* the retry slots move behind the RX slots */
+    if( (APP_SLOTFRAME_SECTION_RETRY_SLOTS > 0) &&
+        (tsch_schedule_get_link_by_timeslot(sf_active,
+            engine->retry_slot(0, layout_positions[active_layout]), 0) != NULL) )
+    {
+        for( int j = 0; j < APP_SLOTFRAME_SECTION_RETRY_SLOTS; j++ )
+        {
+            if( tsch_schedule_add_link(sf_next, LINK_OPTION_RX, LINK_TYPE_NORMAL,
+                                       &tsch_broadcast_address,
+                                       engine->retry_slot(0, positions) + j, 0,
+                                       true) == NULL )
+                return -1;
+        }
+    }
+
+    /* the broadcast slots move behind the data slots */
+    if( tsch_schedule_get_link_by_timeslot(sf_active,
+            engine->broadcast_slot(0, layout_positions[active_layout]), 0) != NULL )
+    {
+        for( int j = 0; j < APP_SLOTFRAME_SECTION_BROADCAST_SLOTS; j++ )
+        {
+            if( tsch_schedule_add_link(sf_next, LINK_OPTION_TX, LINK_TYPE_NORMAL,
+                                       &tsch_broadcast_address,
+                                       engine->broadcast_slot(0, positions) + j, 0,
+                                       true) == NULL )
+                return -1;
+        }
+    }
+
+    /* the data slots of all devices */
+    for( uint16_t devid = 0; devid < COMPACT_MAX_DEVICES; devid++ )
+    {
+        uint8_t mask = 1U << (devid % 8);
+        uint8_t rx = rx_devices[devid / 8] & mask;
+        uint8_t tx = tx_devices[devid / 8] & mask;
+
+        if( (!rx && !tx) || !data_slot_fits(devid, next) )
+            continue;
+        if( links_cnt + DATA_LINKS_PER_DEVICE > (int)(sizeof(bulk_links) / sizeof(bulk_links[0])) )
+            return -1;
+        links_cnt += get_data_slot_links(&device_addr[devid],
+                (rx && tx) ? E_SF_TSCH_SCHEDULE_DATA_SLOTS_ALL :
+                rx ? E_SF_TSCH_SCHEDULE_DATA_SLOTS_RX : E_SF_TSCH_SCHEDULE_DATA_SLOTS_TX,
+                positions, &bulk_links[links_cnt]);
+    }
+    if( (links_cnt > 0) && (tsch_schedule_add_links(sf_next, bulk_links, links_cnt) == 0) )
+        return -1;
+
+    return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+/* Builds the slotframe for the given number of device positions and lets it
+ * replace the active one APP_SLOTFRAME_COMPACT_LEAD slotframes ahead, at the
+ * start of a slotframe. Without a running TSCH it replaces it at once. */
+static int start_switch( uint16_t positions )
+{
+    uint8_t next = active_layout ^ 1;
+    struct tsch_slotframe* sf_active = get_layout_slotframe(active_layout);
+    struct tsch_slotframe* sf_next;
+    struct tsch_asn_t activation_asn;
+
+    if( sf_active == NULL )
+        return -1;
+
+    sf_next = tsch_schedule_add_slotframe(layout_handle[next], get_compact_size(positions));
+    if( sf_next == NULL )
+        return -1;
+    layout_positions[next] = positions;
+
+    LOG_INFO("Resize slotframe from %u to %u device positions\n",
+             layout_positions[active_layout], positions);
+
+    if( build_slotframe(sf_active, sf_next, next) != 0 )
+    {
+        LOG_ERR("Slotframe with %u device positions not built\n", positions);
+        tsch_schedule_remove_slotframe(sf_next);
+        return -1;
+    }
+
+    activation_asn = tsch_current_asn;
+    if( tsch_is_associated )
+    {
+        /* both sides switch at the start of a slotframe of the old size */
+        uint16_t timeslot = TSCH_ASN_MOD(activation_asn, sf_active->size);
+        TSCH_ASN_DEC(activation_asn, timeslot);
+        TSCH_ASN_INC(activation_asn, (uint32_t)APP_SLOTFRAME_COMPACT_LEAD * sf_active->size.val);
+
+        tsch_schedule_set_slotframe_window(sf_active, NULL, &activation_asn);
+        tsch_schedule_set_slotframe_window(sf_next, &activation_asn, NULL);
+        update_desc(positions, &activation_asn);
+        switch_pending = 1;
+        set_switch_timer(complete_switch);
+    }
+    else
+    {
+        tsch_schedule_remove_slotframe(sf_active);
+        active_layout = next;
+        update_desc(positions, &activation_asn);
+    }
+
+    return 0;
+}
+#endif /* #if APP_SLOTFRAME_COMPACT */
+
+#if !APP_SLOTFRAME_STATIC
+/*---------------------------------------------------------------------------*/
+/* Resizes the slotframe if the devices with data slots need a different
+ * number of device positions. */
+static int update_layout( void )
+{
+#if APP_SLOTFRAME_COMPACT
+    uint16_t positions = get_needed_positions();
+
+    if( positions == layout_positions[active_layout] )
+        return 0;
+
+    if( switch_pending )
+    {
+        /* resized again once the pending switch is complete */
+        relayout_pending = 1;
+        return 0;
+    }
+
+    return start_switch(positions);
+#else
+    return 0;
+#endif /* #if APP_SLOTFRAME_COMPACT */
+}
+#endif /* #if !APP_SLOTFRAME_STATIC */
+
 /*---------------------------------------------------------------------------*/
 int sf_tsch_schedule_init( void )
 {
     struct tsch_slotframe *sf_common;
+    uint16_t size = APP_SLOTFRAME_SIZE;
 
     /* remove all slotframes */
     tsch_schedule_remove_all_slotframes();
 
+    active_layout = 0;
+#if APP_SLOTFRAME_COMPACT
+    ctimer_stop(&switch_timer);
+    memset(rx_devices, 0, sizeof(rx_devices));
+    memset(tx_devices, 0, sizeof(tx_devices));
+    switch_pending = 0;
+    relayout_pending = 0;
+    /* the slotframe grows with the devices */
+    layout_positions[active_layout] = APP_SLOTFRAME_COMPACT_STEP;
+    size = get_compact_size(layout_positions[active_layout]);
+#endif /* #if APP_SLOTFRAME_COMPACT */
+
     /* create a new slotframe */
-    sf_common = tsch_schedule_add_slotframe(APP_SLOTFRAME_HANDLE, APP_SLOTFRAME_SIZE);
+    sf_common = tsch_schedule_add_slotframe(layout_handle[active_layout], size);
 
     if( sf_common == NULL )
         return -1;
     else
     {
+#if APP_SLOTFRAME_COMPACT
+        update_desc(layout_positions[active_layout], &tsch_current_asn);
+#endif /* #if APP_SLOTFRAME_COMPACT */
+#if APP_SLOTFRAME_STATIC
+        /* the links are in flash, all disabled until their slots are added */
+        if( !tsch_schedule_set_static_links(sf_common, sf_tsch_schedule_table_links,
+                                            sf_tsch_schedule_table_links_count,
+                                            table_enabled) )
+            return -1;
+#endif /* #if APP_SLOTFRAME_STATIC */
         initialized = 1;
         return 0;
     }
@@ -59,171 +627,417 @@ int sf_tsch_schedule_init( void )
 /*---------------------------------------------------------------------------*/
 int sf_tsch_schedule_add_beacon_slots( void )
 {
+#if APP_SLOTFRAME_STATIC
+    return enable_table_group(SF_TSCH_SCHEDULE_TABLE_BEACON, 1);
+#else
     struct tsch_link* link;
     uint16_t slot_offset;
     uint16_t channel_offset;
     struct tsch_slotframe *sf_common;
 
-    sf_common = tsch_schedule_get_slotframe_by_handle( APP_SLOTFRAME_HANDLE );
-    if( (sf_common == NULL) || (!initialized))
+    if( !schedule_ready() )
         return -1;
 
     LOG_INFO("Add beacon slots\n");
 
-    /* schedule the beacon slots */
-    for( int i = 0; i < APP_SLOTFRAME_SECTION_NUM; i++ )
+    for( uint8_t l = 0; l < SCHEDULE_LAYOUTS; l++ )
     {
-      slot_offset = i * APP_SLOTFRAME_SECTION_SIZE;
-      channel_offset = 0;
+        sf_common = get_layout_slotframe(l);
+        if( sf_common == NULL )
+            continue;
+
+        /* schedule the beacon slots */
+        for( int i = 0; i < APP_SLOTFRAME_SECTION_NUM; i++ )
+        {
+          slot_offset = engine->beacon_slot(i);
+          channel_offset = 0;
 
-      watchdog_periodic();
-      link = tsch_schedule_add_link(sf_common,
-            LINK_OPTION_TX,
-            LINK_TYPE_ADVERTISING_ONLY, &tsch_broadcast_address,
-            slot_offset, channel_offset, true);
+          watchdog_periodic();
+          link = tsch_schedule_add_link(sf_common,
+                LINK_OPTION_TX,
+                LINK_TYPE_ADVERTISING_ONLY, &tsch_broadcast_address,
+                slot_offset, channel_offset, true);
 
-      if( link == NULL )
-          /* an error occurred that should not. */
-          return -1;
+          if( link == NULL )
+              /* an error occurred that should not. */
+              return -1;
+        }
     }
 
     return 0;
+#endif /* #if APP_SLOTFRAME_STATIC */
 }
 
 
 /*---------------------------------------------------------------------------*/
 int sf_tsch_schedule_delete_beacon_slots( void )
 {
+#if APP_SLOTFRAME_STATIC
+    return enable_table_group(SF_TSCH_SCHEDULE_TABLE_BEACON, 0);
+#else
     uint16_t slot_offset;
     uint16_t channel_offset;
     struct tsch_slotframe *sf_common;
 
-    sf_common = tsch_schedule_get_slotframe_by_handle( APP_SLOTFRAME_HANDLE );
-    if( (sf_common == NULL) || (!initialized))
+    if( !schedule_ready() )
         return -1;
 
     LOG_INFO("Delete beacon slots\n");
 
-    /* schedule the beacon slots */
-    for( int i = 0; i < APP_SLOTFRAME_SECTION_NUM; i++ )
+    for( uint8_t l = 0; l < SCHEDULE_LAYOUTS; l++ )
+    {
+        sf_common = get_layout_slotframe(l);
+        if( sf_common == NULL )
+            continue;
+
+        /* schedule the beacon slots */
+        for( int i = 0; i < APP_SLOTFRAME_SECTION_NUM; i++ )
+        {
+          slot_offset = engine->beacon_slot(i);
+          channel_offset = 0;
+
+          watchdog_periodic();
+          if( tsch_schedule_remove_link_by_timeslot(sf_common, slot_offset, channel_offset) == 0)
+              /* an error occurred that should not. */
+              return -1;
+        }
+    }
+
+    return 0;
+#endif /* #if APP_SLOTFRAME_STATIC */
+}
+
+
+/*---------------------------------------------------------------------------*/
+int sf_tsch_schedule_add_broadcast_slots( void )
+{
+#if APP_SLOTFRAME_STATIC
+    return enable_table_group(SF_TSCH_SCHEDULE_TABLE_BROADCAST, 1);
+#else
+    struct tsch_link* link;
+    uint16_t slot_offset;
+    uint16_t channel_offset;
+    struct tsch_slotframe *sf_common;
+
+    if( !schedule_ready() )
+        return -1;
+
+    LOG_INFO("Add broadcast slots\n");
+
+    for( uint8_t l = 0; l < SCHEDULE_LAYOUTS; l++ )
+    {
+        sf_common = get_layout_slotframe(l);
+        if( sf_common == NULL )
+            continue;
+
+        /* schedule the broadcast slots after the device rx slots */
+        for( int i = 0; i < APP_SLOTFRAME_SECTION_NUM; i++ )
+        {
+          slot_offset = engine->broadcast_slot(i, layout_positions[l]);
+          channel_offset = 0;
+
+          for( int j = 0; j < APP_SLOTFRAME_SECTION_BROADCAST_SLOTS; j++ )
+          {
+              watchdog_periodic();
+              link = tsch_schedule_add_link(sf_common,
+                    LINK_OPTION_TX,
+                    LINK_TYPE_NORMAL, &tsch_broadcast_address,
+                    slot_offset+j, channel_offset, true);
+
+              if( link == NULL )
+                  /* an error occurred that should not. */
+                  return -1;
+          }
+        }
+    }
+
+    return 0;
+#endif /* #if APP_SLOTFRAME_STATIC */
+}
+
+
+/*---------------------------------------------------------------------------*/
+int sf_tsch_schedule_delete_broadcast_slots( void )
+{
+#if APP_SLOTFRAME_STATIC
+    return enable_table_group(SF_TSCH_SCHEDULE_TABLE_BROADCAST, 0);
+#else
+    uint16_t slot_offset;
+    uint16_t channel_offset;
+    struct tsch_slotframe *sf_common;
+
+    if( !schedule_ready() )
+        return -1;
+
+    LOG_INFO("Delete broadcast slots\n");
+
+    for( uint8_t l = 0; l < SCHEDULE_LAYOUTS; l++ )
+    {
+        sf_common = get_layout_slotframe(l);
+        if( sf_common == NULL )
+            continue;
+
+        /* delete the broadcast slots */
+        for( int i = 0; i < APP_SLOTFRAME_SECTION_NUM; i++ )
+        {
+          slot_offset = engine->broadcast_slot(i, layout_positions[l]);
+          channel_offset = 0;
+
+          for( int j = 0; j < APP_SLOTFRAME_SECTION_BROADCAST_SLOTS; j++ )
+          {
+              watchdog_periodic();
+              if( tsch_schedule_remove_link_by_timeslot(sf_common, slot_offset+j, channel_offset) == 0)
+                  /* an error occurred that should not. */
+                  return -1;
+          }
+        }
+    }
+
+    return 0;
+#endif /* #if APP_SLOTFRAME_STATIC */
+}
+
+
+/*---------------------------------------------------------------------------*/
+int sf_tsch_schedule_add_retry_slots( void )
+{
+#if APP_SLOTFRAME_STATIC
+    return enable_table_group(SF_TSCH_SCHEDULE_TABLE_RETRY, 1);
+#else
+    struct tsch_link* link;
+    uint16_t slot_offset;
+    uint16_t channel_offset;
+    struct tsch_slotframe *sf_common;
+
+    if( !schedule_ready() )
+        return -1;
+
+    if( APP_SLOTFRAME_SECTION_RETRY_SLOTS == 0 )
+        return 0;
+
+    LOG_INFO("Add retry slots\n");
+
+    for( uint8_t l = 0; l < SCHEDULE_LAYOUTS; l++ )
+    {
+        sf_common = get_layout_slotframe(l);
+        if( sf_common == NULL )
+            continue;
+
+        /* schedule the retry slots after the device rx slots, shared by all devices */
+        for( int i = 0; i < APP_SLOTFRAME_SECTION_NUM; i++ )
+        {
+          slot_offset = engine->retry_slot(i, layout_positions[l]);
+          channel_offset = 0;
+
+          for( int j = 0; j < APP_SLOTFRAME_SECTION_RETRY_SLOTS; j++ )
+          {
+              watchdog_periodic();
+              link = tsch_schedule_add_link(sf_common,
+                    LINK_OPTION_RX,
+                    LINK_TYPE_NORMAL, &tsch_broadcast_address,
+                    slot_offset+j, channel_offset, true);
+
+              if( link == NULL )
+                  /* an error occurred that should not. */
+                  return -1;
+          }
+        }
+    }
+
+    return 0;
+#endif /* #if APP_SLOTFRAME_STATIC */
+}
+
+
+/*---------------------------------------------------------------------------*/
+int sf_tsch_schedule_delete_retry_slots( void )
+{
+#if APP_SLOTFRAME_STATIC
+    return enable_table_group(SF_TSCH_SCHEDULE_TABLE_RETRY, 0);
+#else
+    uint16_t slot_offset;
+    uint16_t channel_offset;
+    struct tsch_slotframe *sf_common;
+
+    if( !schedule_ready() )
+        return -1;
+
+    if( APP_SLOTFRAME_SECTION_RETRY_SLOTS == 0 )
+        return 0;
+
+    LOG_INFO("Delete retry slots\n");
+
+    for( uint8_t l = 0; l < SCHEDULE_LAYOUTS; l++ )
     {
-      slot_offset = i * APP_SLOTFRAME_SECTION_SIZE;
-      channel_offset = 0;
+        sf_common = get_layout_slotframe(l);
+        if( sf_common == NULL )
+            continue;
 
-      watchdog_periodic();
-      if( tsch_schedule_remove_link_by_timeslot(sf_common, slot_offset, channel_offset) == 0)
-          /* an error occurred that should not. */
-          return -1;
+        /* delete the retry slots */
+        for( int i = 0; i < APP_SLOTFRAME_SECTION_NUM; i++ )
+        {
+          slot_offset = engine->retry_slot(i, layout_positions[l]);
+          channel_offset = 0;
+
+          for( int j = 0; j < APP_SLOTFRAME_SECTION_RETRY_SLOTS; j++ )
+          {
+              watchdog_periodic();
+              if( tsch_schedule_remove_link_by_timeslot(sf_common, slot_offset+j, channel_offset) == 0)
+                  /* an error occurred that should not. */
+                  return -1;
+          }
+        }
     }
 
     return 0;
+#endif /* #if APP_SLOTFRAME_STATIC */
 }
 
 
 /*---------------------------------------------------------------------------*/
 int sf_tsch_schedule_add_jreq_slots( void )
 {
+#if APP_SLOTFRAME_STATIC
+    return enable_table_group(SF_TSCH_SCHEDULE_TABLE_JREQ, 1);
+#else
     struct tsch_link* link;
     uint16_t slot_offset;
     uint16_t channel_offset;
     struct tsch_slotframe *sf_common;
 
-    sf_common = tsch_schedule_get_slotframe_by_handle( APP_SLOTFRAME_HANDLE );
-    if( (sf_common == NULL) || (!initialized))
+    if( !schedule_ready() )
         return -1;
 
     LOG_INFO("Add join request slots\n");
 
-    /* schedule the join request slots */
-    for( int i = 0; i < APP_SLOTFRAME_SECTION_NUM; i++ )
+    for( uint8_t l = 0; l < SCHEDULE_LAYOUTS; l++ )
     {
-      slot_offset = (i * APP_SLOTFRAME_SECTION_SIZE) + APP_SLOTFRAME_SECTION_BEACON_SLOTS;
-      channel_offset = 0;
-
-      for( int j = 0; j < APP_SLOTFRAME_SECTION_JOIN_REQUEST_SLOTS; j++ )
-      {
-          watchdog_periodic();
-          link = tsch_schedule_add_link(sf_common,
-                LINK_OPTION_RX ,
-                LINK_TYPE_NORMAL, &tsch_broadcast_address,
-                slot_offset+j, channel_offset, true);
+        sf_common = get_layout_slotframe(l);
+        if( sf_common == NULL )
+            continue;
 
-          if( link == NULL )
-              /* an error occurred that should not. */
-              return -1;
-      }
+        /* schedule the join request slots */
+        for( int i = 0; i < APP_SLOTFRAME_SECTION_NUM; i++ )
+        {
+          slot_offset = engine->jreq_slot(i);
+          channel_offset = 0;
+
+          for( int j = 0; j < APP_SLOTFRAME_SECTION_JOIN_REQUEST_SLOTS; j++ )
+          {
+              watchdog_periodic();
+              link = tsch_schedule_add_link(sf_common,
+                    LINK_OPTION_RX ,
+                    LINK_TYPE_NORMAL, &tsch_broadcast_address,
+                    slot_offset+j, channel_offset, true);
+
+              if( link == NULL )
+                  /* an error occurred that should not. */
+                  return -1;
+          }
+        }
     }
 
     return 0;
+#endif /* #if APP_SLOTFRAME_STATIC */
 }
 
 
 /*---------------------------------------------------------------------------*/
 int sf_tsch_schedule_delete_jreq_slots( void )
 {
+#if APP_SLOTFRAME_STATIC
+    return enable_table_group(SF_TSCH_SCHEDULE_TABLE_JREQ, 0);
+#else
     uint16_t slot_offset;
     uint16_t channel_offset;
     struct tsch_slotframe *sf_common;
 
-    sf_common = tsch_schedule_get_slotframe_by_handle( APP_SLOTFRAME_HANDLE );
-    if( (sf_common == NULL) || (!initialized))
+    if( !schedule_ready() )
         return -1;
 
     LOG_INFO("Delete join request slots\n");
 
-    /* delete the join request slots */
-    for( int i = 0; i < APP_SLOTFRAME_SECTION_NUM; i++ )
+    for( uint8_t l = 0; l < SCHEDULE_LAYOUTS; l++ )
     {
-        slot_offset = (i * APP_SLOTFRAME_SECTION_SIZE) + APP_SLOTFRAME_SECTION_BEACON_SLOTS;
-        channel_offset = 0;
+        sf_common = get_layout_slotframe(l);
+        if( sf_common == NULL )
+            continue;
 
-	    for( int j = 0; j < APP_SLOTFRAME_SECTION_JOIN_REQUEST_SLOTS; j++ )
-	    {
-	        watchdog_periodic();
-            if( tsch_schedule_remove_link_by_timeslot(sf_common, slot_offset+j, channel_offset) == 0)
-                /* an error occurred that should not. */
-              return -1;
+        /* delete the join request slots */
+        for( int i = 0; i < APP_SLOTFRAME_SECTION_NUM; i++ )
+        {
+            slot_offset = engine->jreq_slot(i);
+            channel_offset = 0;
+
+            for( int j = 0; j < APP_SLOTFRAME_SECTION_JOIN_REQUEST_SLOTS; j++ )
+            {
+                watchdog_periodic();
+                if( tsch_schedule_remove_link_by_timeslot(sf_common, slot_offset+j, channel_offset) == 0)
+                    /* an error occurred that should not. */
+                    return -1;
+            }
         }
     }
 
     return 0;
+#endif /* #if APP_SLOTFRAME_STATIC */
 }
 
 
 /*---------------------------------------------------------------------------*/
 int sf_tsch_schedule_add_jproc_slots( const linkaddr_t* addr )
+{
+    return sf_tsch_schedule_add_jproc_slot_group(addr, 0, 1);
+}
+
+
+/*---------------------------------------------------------------------------*/
+int sf_tsch_schedule_delete_jproc_slots( const linkaddr_t* addr )
+{
+    return sf_tsch_schedule_delete_jproc_slot_group(addr, 0, 1);
+}
+
+
+/*---------------------------------------------------------------------------*/
+int sf_tsch_schedule_add_jproc_slot_group( const linkaddr_t* addr,
+                                           uint8_t group, uint8_t group_cnt )
 {
     struct tsch_link* link;
     uint16_t slot_offset;
     uint16_t channel_offset;
     struct tsch_slotframe *sf_common;
 
-    sf_common = tsch_schedule_get_slotframe_by_handle( APP_SLOTFRAME_HANDLE );
-    if( (sf_common == NULL) || (!initialized))
+    if( !schedule_ready() || (group >= group_cnt) )
         return -1;
 
-    LOG_INFO("Add join process slots for device ");
+    LOG_INFO("Add join process slots (group %u/%u) for device ", group, group_cnt);
     LOG_INFO_LLADDR(addr);
     LOG_INFO_("\n");
 
-    /* schedule the join process slots */
-    for( int i = 0; i < APP_SLOTFRAME_SECTION_NUM; i++ )
+    for( uint8_t l = 0; l < SCHEDULE_LAYOUTS; l++ )
     {
-        slot_offset = (i * APP_SLOTFRAME_SECTION_SIZE) + APP_SLOTFRAME_SECTION_BEACON_SLOTS +
-              APP_SLOTFRAME_SECTION_JOIN_REQUEST_SLOTS;
-        channel_offset = 0;
+        sf_common = get_layout_slotframe(l);
+        if( sf_common == NULL )
+            continue;
 
-        for( int j = 0; j < APP_SLOTFRAME_SECTION_JOIN_PROCESS_SLOTS; j++ )
+        /* schedule every group_cnt-th join process slot, starting at the group */
+        for( int i = 0; i < APP_SLOTFRAME_SECTION_NUM; i++ )
         {
-            watchdog_periodic();
-            link = tsch_schedule_add_link(sf_common,
-                LINK_OPTION_RX | LINK_OPTION_TX,
-                LINK_TYPE_NORMAL, addr,
-                slot_offset+j, channel_offset, true);
-
-            if( link == NULL )
-                /* an error occurred that should not. */
-                return -1;
+            slot_offset = engine->jproc_slot(i);
+            channel_offset = 0;
+
+            for( int j = group; j < APP_SLOTFRAME_SECTION_JOIN_PROCESS_SLOTS; j += group_cnt )
+            {
+                watchdog_periodic();
+                link = tsch_schedule_add_link(sf_common,
+                    LINK_OPTION_RX | LINK_OPTION_TX,
+                    LINK_TYPE_NORMAL, addr,
+                    slot_offset+j, channel_offset, true);
+
+                if( link == NULL )
+                    /* an error occurred that should not. */
+                    return -1;
+            }
         }
     }
 
@@ -232,33 +1046,39 @@ int sf_tsch_schedule_add_jproc_slots( const linkaddr_t* addr )
 
 
 /*---------------------------------------------------------------------------*/
-int sf_tsch_schedule_delete_jproc_slots( const linkaddr_t* addr )
+int sf_tsch_schedule_delete_jproc_slot_group( const linkaddr_t* addr,
+                                              uint8_t group, uint8_t group_cnt )
 {
     uint16_t slot_offset;
     uint16_t channel_offset;
     struct tsch_slotframe *sf_common;
 
-    sf_common = tsch_schedule_get_slotframe_by_handle( APP_SLOTFRAME_HANDLE );
-    if( (sf_common == NULL) || (!initialized))
+    if( !schedule_ready() || (group >= group_cnt) )
         return -1;
 
-    LOG_INFO("Delete join process slots for device ");
+    LOG_INFO("Delete join process slots (group %u/%u) for device ", group, group_cnt);
     LOG_INFO_LLADDR(addr);
     LOG_INFO_("\n");
 
-    /* delete the join process slots */
-    for( int i = 0; i < APP_SLOTFRAME_SECTION_NUM; i++ )
+    for( uint8_t l = 0; l < SCHEDULE_LAYOUTS; l++ )
     {
-        slot_offset = (i * APP_SLOTFRAME_SECTION_SIZE) + APP_SLOTFRAME_SECTION_BEACON_SLOTS +
-                APP_SLOTFRAME_SECTION_JOIN_REQUEST_SLOTS;
-        channel_offset = 0;
+        sf_common = get_layout_slotframe(l);
+        if( sf_common == NULL )
+            continue;
 
-	    for( int j = 0; j < APP_SLOTFRAME_SECTION_JOIN_PROCESS_SLOTS; j++ )
-	    {
-	        watchdog_periodic();
-            if( tsch_schedule_remove_link_by_timeslot(sf_common, slot_offset+j, channel_offset) == 0)
-            /* an error occurred that should not. */
-            return -1;
+        /* delete the join process slots of the group */
+        for( int i = 0; i < APP_SLOTFRAME_SECTION_NUM; i++ )
+        {
+            slot_offset = engine->jproc_slot(i);
+            channel_offset = 0;
+
+            for( int j = group; j < APP_SLOTFRAME_SECTION_JOIN_PROCESS_SLOTS; j += group_cnt )
+            {
+                watchdog_periodic();
+                if( tsch_schedule_remove_link_by_timeslot(sf_common, slot_offset+j, channel_offset) == 0)
+                    /* an error occurred that should not. */
+                    return -1;
+            }
         }
     }
 
@@ -269,90 +1089,94 @@ int sf_tsch_schedule_delete_jproc_slots( const linkaddr_t* addr )
 int sf_tsch_schedule_add_data_slots( const linkaddr_t* addr,
                                      e_sf_tsch_schedule_data_slot_types_t dataSlotType)
 {
+#if APP_SLOTFRAME_STATIC
+    int indexes_cnt = get_table_data_slot_links(addr, dataSlotType, bulk_indexes, 0);
+
+    if( indexes_cnt < 0 )
+        return -1;
+
+    LOG_INFO("Add data slots for device ");
+    LOG_INFO_LLADDR(addr);
+    LOG_INFO_("\n");
+
+    return enable_table_links(bulk_indexes, indexes_cnt, 1);
+#else
     struct tsch_link* link;
     uint16_t slot_offset;
     uint16_t channel_offset;
-    uint8_t section = 0;
-    uint16_t slot = 0;
     struct tsch_slotframe *sf_common;
-#if LINKADDR_SIZE == 2
-    uint16_t devid = addr->u16 - 1;
-#else
-    uint16_t devid = addr->u16[0] - 1;
-#endif /* #if LINKADDR_SIZE == 2 */
+    int32_t devid = get_devid(addr);
 
-    sf_common = tsch_schedule_get_slotframe_by_handle( APP_SLOTFRAME_HANDLE );
-    if( (sf_common == NULL) || (!initialized))
+    if( !schedule_ready() )
         return -1;
 
-    if( (int16_t)devid < 0 )
+    if( devid < 0 )
         return -1;
 
-
-    if( (E_SF_TSCH_SCHEDULE_DATA_SLOTS_ALL == dataSlotType) ||
-        (E_SF_TSCH_SCHEDULE_DATA_SLOTS_RX == dataSlotType) )
+    for( uint8_t l = 0; l < SCHEDULE_LAYOUTS; l++ )
     {
-        LOG_INFO("Add RX data slots for device ");
-        LOG_INFO_LLADDR(addr);
-        LOG_INFO_("\n");
-
-#if SCHEDULE_A
-        /* schedule the RX slot */
-        section = devid / APP_SLOTFRAME_SECTION_DEVICE_TX_SLOTS;
-        slot = ((devid - 0) * 2) % APP_SLOTFRAME_SECTION_DEVICE_TX_SLOTS;
-        slot_offset = (section * APP_SLOTFRAME_SECTION_SIZE) +
-                APP_SLOTFRAME_SECTION_BEACON_SLOTS + APP_SLOTFRAME_SECTION_JOIN_SLOTS +
-                slot;
-        channel_offset = 0;
-        link = tsch_schedule_add_link(sf_common,
-              LINK_OPTION_RX,
-              LINK_TYPE_NORMAL, &tsch_broadcast_address,
-              slot_offset, channel_offset, true);
-
-        if( link == NULL )
-            /* an error occurred that should not. */
-            return -1;
-        #endif /* #if SCHEDULE_A */
+        sf_common = get_layout_slotframe(l);
+        if( (sf_common == NULL) || !data_slot_fits(devid, l) )
+            continue;
 
-    /* Add slot only for retransmissions */
-    slot_offset = slot_offset + 1;
-    link = tsch_schedule_add_link(sf_common,
-          LINK_OPTION_RX,
-          LINK_TYPE_NORMAL, &tsch_broadcast_address,
-          slot_offset, channel_offset, true);
+        if( (E_SF_TSCH_SCHEDULE_DATA_SLOTS_ALL == dataSlotType) ||
+            (E_SF_TSCH_SCHEDULE_DATA_SLOTS_RX == dataSlotType) )
+        {
+            LOG_INFO("Add RX data slots for device ");
+            LOG_INFO_LLADDR(addr);
+            LOG_INFO_("\n");
 
-    if( link == NULL )
-        /* an error occurred that should not. */
-        return -1;
-    }
+            /* schedule the RX slot */
+            engine->data_slot(devid, 1, layout_positions[l], &slot_offset, &channel_offset);
+            link = tsch_schedule_add_link(sf_common,
+                  LINK_OPTION_RX,
+                  LINK_TYPE_NORMAL, &tsch_broadcast_address,
+                  slot_offset, channel_offset, true);
 
-    if( (E_SF_TSCH_SCHEDULE_DATA_SLOTS_ALL == dataSlotType) ||
-        (E_SF_TSCH_SCHEDULE_DATA_SLOTS_TX == dataSlotType) )
-    {
-        LOG_INFO("Add TX data slots for device ");
-        LOG_INFO_LLADDR(addr);
-        LOG_INFO_("\n");
-
-#if SCHEDULE_A
-        /* schedule the TX slot */
-        section = devid / APP_SLOTFRAME_SECTION_DEVICE_RX_SLOTS;
-        slot = ((devid - 0) * 2) % APP_SLOTFRAME_SECTION_DEVICE_RX_SLOTS;
-        slot_offset = (section * APP_SLOTFRAME_SECTION_SIZE) +
-                APP_SLOTFRAME_SECTION_BEACON_SLOTS + APP_SLOTFRAME_SECTION_JOIN_SLOTS + (APP_SLOTFRAME_SECTION_DEVICE_TX_SLOTS * 2) +
-                slot;
-        channel_offset = 0;
-        link = tsch_schedule_add_link(sf_common,
-              LINK_OPTION_TX,
-              LINK_TYPE_NORMAL, addr,
-              slot_offset, channel_offset, true);
-
-        if( link == NULL )
-            /* an error occurred that should not. */
-            return -1;
-#endif /* #if SCHEDULE_A */
+            if( link == NULL )
+                /* an error occurred that should not. */
+                return -1;
+
+#if APP_SLOTFRAME_DEDICATED_RETRY_SLOT
+            /* Add slot only for retransmissions */
+            slot_offset = slot_offset + 1;
+            link = tsch_schedule_add_link(sf_common,
+                  LINK_OPTION_RX,
+                  LINK_TYPE_NORMAL, &tsch_broadcast_address,
+                  slot_offset, channel_offset, true);
+
+            if( link == NULL )
+                /* an error occurred that should not. */
+                return -1;
+#endif /* #if APP_SLOTFRAME_DEDICATED_RETRY_SLOT */
+        }
+
+        if( (E_SF_TSCH_SCHEDULE_DATA_SLOTS_ALL == dataSlotType) ||
+            (E_SF_TSCH_SCHEDULE_DATA_SLOTS_TX == dataSlotType) )
+        {
+            LOG_INFO("Add TX data slots for device ");
+            LOG_INFO_LLADDR(addr);
+            LOG_INFO_("\n");
+
+            /* schedule the TX slot */
+            engine->data_slot(devid, 0, layout_positions[l], &slot_offset, &channel_offset);
+            link = tsch_schedule_add_link(sf_common,
+                  LINK_OPTION_TX,
+                  LINK_TYPE_NORMAL, addr,
+                  slot_offset, channel_offset, true);
+
+            if( link == NULL )
+                /* an error occurred that should not. */
+                return -1;
+        }
     }
 
-    return 0;
+#if APP_SLOTFRAME_COMPACT
+    set_device(addr, devid, dataSlotType, 1);
+#endif /* #if APP_SLOTFRAME_COMPACT */
+
+    return update_layout();
+#endif /* #if APP_SLOTFRAME_STATIC */
 }
 
 
@@ -360,74 +1184,222 @@ int sf_tsch_schedule_add_data_slots( const linkaddr_t* addr,
 int sf_tsch_schedule_delete_data_slots( const linkaddr_t* addr,
                                         e_sf_tsch_schedule_data_slot_types_t dataSlotType )
 {
+#if APP_SLOTFRAME_STATIC
+    int indexes_cnt = get_table_data_slot_links(addr, dataSlotType, bulk_indexes, 0);
+
+    if( indexes_cnt < 0 )
+        return -1;
+
+    LOG_INFO("Delete data slots for device ");
+    LOG_INFO_LLADDR(addr);
+    LOG_INFO_("\n");
+
+    return enable_table_links(bulk_indexes, indexes_cnt, 0);
+#else
     uint16_t slot_offset;
     uint16_t channel_offset;
-    uint8_t section = 0;
-    uint16_t slot = 0;
     struct tsch_slotframe *sf_common;
-#if LINKADDR_SIZE == 2
-    uint16_t devid = addr->u16 - 1;
+    int32_t devid = get_devid(addr);
+
+    if( !schedule_ready() )
+        return -1;
+
+    if( devid < 0 )
+        return -1;
+
+    for( uint8_t l = 0; l < SCHEDULE_LAYOUTS; l++ )
+    {
+        sf_common = get_layout_slotframe(l);
+        if( (sf_common == NULL) || !data_slot_fits(devid, l) )
+            continue;
+
+        if( (E_SF_TSCH_SCHEDULE_DATA_SLOTS_ALL == dataSlotType) ||
+            (E_SF_TSCH_SCHEDULE_DATA_SLOTS_RX == dataSlotType) )
+        {
+            LOG_INFO("Delete RX data slots for device ");
+            LOG_INFO_LLADDR(addr);
+            LOG_INFO_("\n");
+
+            /* remove the RX slot */
+            engine->data_slot(devid, 1, layout_positions[l], &slot_offset, &channel_offset);
+            if( tsch_schedule_remove_link_by_timeslot(sf_common, slot_offset, channel_offset) == 0)
+               /* an error occurred that should not. */
+               return -1;
+
+#if APP_SLOTFRAME_DEDICATED_RETRY_SLOT
+            /* Remove slot only for retransmissions */
+            slot_offset = slot_offset + 1;
+            if( tsch_schedule_remove_link_by_timeslot(sf_common, slot_offset, channel_offset) == 0)
+               /* an error occurred that should not. */
+               return -1;
+#endif /* #if APP_SLOTFRAME_DEDICATED_RETRY_SLOT */
+        }
+
+        if( (E_SF_TSCH_SCHEDULE_DATA_SLOTS_ALL == dataSlotType) ||
+            (E_SF_TSCH_SCHEDULE_DATA_SLOTS_TX == dataSlotType) )
+        {
+            LOG_INFO("Delete TX data slots for device ");
+            LOG_INFO_LLADDR(addr);
+            LOG_INFO_("\n");
+
+            /* remove the TX slot */
+            engine->data_slot(devid, 0, layout_positions[l], &slot_offset, &channel_offset);
+            if( tsch_schedule_remove_link_by_timeslot(sf_common, slot_offset, channel_offset) == 0)
+               /* an error occurred that should not. */
+               return -1;
+        }
+    }
+
+#if APP_SLOTFRAME_COMPACT
+    set_device(addr, devid, dataSlotType, 0);
+#endif /* #if APP_SLOTFRAME_COMPACT */
+
+    return update_layout();
+#endif /* #if APP_SLOTFRAME_STATIC */
+}
+
+/*---------------------------------------------------------------------------*/
+int sf_tsch_schedule_add_data_slots_bulk( const linkaddr_t* addrs, uint8_t cnt,
+                                          e_sf_tsch_schedule_data_slot_types_t dataSlotType )
+{
+#if APP_SLOTFRAME_STATIC
+    int indexes_cnt = 0;
+
+    if( (addrs == NULL) || (cnt > APP_MAX_DEVICE_SLOTS) )
+        return -1;
+
+    LOG_INFO("Add data slots for %u devices\n", cnt);
+
+    for( uint8_t i = 0; i < cnt; i++ )
+    {
+        indexes_cnt = get_table_data_slot_links(&addrs[i], dataSlotType,
+                                                bulk_indexes, indexes_cnt);
+        if( indexes_cnt < 0 )
+            return -1;
+    }
+
+    return enable_table_links(bulk_indexes, indexes_cnt, 1);
 #else
-    uint16_t devid = addr->u16[0] - 1;
-#endif /* #if LINKADDR_SIZE == 2 */
+    int links_cnt;
+    struct tsch_slotframe *sf_common;
 
-    sf_common = tsch_schedule_get_slotframe_by_handle( APP_SLOTFRAME_HANDLE );
-    if( (sf_common == NULL) || (!initialized))
+    if( !schedule_ready() )
         return -1;
 
-    if( (int16_t)devid < 0 )
+    LOG_INFO("Add data slots for %u devices\n", cnt);
+
+    for( uint8_t l = 0; l < SCHEDULE_LAYOUTS; l++ )
+    {
+        sf_common = get_layout_slotframe(l);
+        if( sf_common == NULL )
+            continue;
+
+        links_cnt = get_bulk_data_slot_links(addrs, cnt, dataSlotType, l);
+        if( links_cnt < 0 )
+            return -1;
+
+        if( (links_cnt > 0) && (tsch_schedule_add_links(sf_common, bulk_links, links_cnt) == 0) )
+            /* an error occurred that should not. */
+            return -1;
+    }
+
+#if APP_SLOTFRAME_COMPACT
+    for( uint8_t i = 0; i < cnt; i++ )
+        set_device(&addrs[i], get_devid(&addrs[i]), dataSlotType, 1);
+#endif /* #if APP_SLOTFRAME_COMPACT */
+
+    return update_layout();
+#endif /* #if APP_SLOTFRAME_STATIC */
+}
+
+/*---------------------------------------------------------------------------*/
+int sf_tsch_schedule_delete_data_slots_bulk( const linkaddr_t* addrs, uint8_t cnt,
+                                             e_sf_tsch_schedule_data_slot_types_t dataSlotType )
+{
+#if APP_SLOTFRAME_STATIC
+    int indexes_cnt = 0;
+
+    if( (addrs == NULL) || (cnt > APP_MAX_DEVICE_SLOTS) )
         return -1;
 
+    LOG_INFO("Delete data slots for %u devices\n", cnt);
 
-    if( (E_SF_TSCH_SCHEDULE_DATA_SLOTS_ALL == dataSlotType) ||
-        (E_SF_TSCH_SCHEDULE_DATA_SLOTS_RX == dataSlotType) )
+    for( uint8_t i = 0; i < cnt; i++ )
     {
-        LOG_INFO("Delete RX data slots for device ");
-        LOG_INFO_LLADDR(addr);
-        LOG_INFO_("\n");
-
-#if SCHEDULE_A
-        /* remove the RX slot */
-        section = devid / APP_SLOTFRAME_SECTION_DEVICE_TX_SLOTS;
-        slot = ((devid - 0) * 2) % APP_SLOTFRAME_SECTION_DEVICE_TX_SLOTS;
-        slot_offset = (section * APP_SLOTFRAME_SECTION_SIZE) +
-                APP_SLOTFRAME_SECTION_BEACON_SLOTS + APP_SLOTFRAME_SECTION_JOIN_SLOTS +
-                slot;
-        channel_offset = 0;
-        if( tsch_schedule_remove_link_by_timeslot(sf_common, slot_offset, channel_offset) == 0)
-           /* an error occurred that should not. */
-           return -1;
-
-        /* Remove slot only for retransmissions */
-        slot_offset = slot_offset + 1;
-        if( tsch_schedule_remove_link_by_timeslot(sf_common, slot_offset, channel_offset) == 0)
-           /* an error occurred that should not. */
-           return -1;
-#endif /* #if SCHEDULE_A */
+        indexes_cnt = get_table_data_slot_links(&addrs[i], dataSlotType,
+                                                bulk_indexes, indexes_cnt);
+        if( indexes_cnt < 0 )
+            return -1;
     }
 
-    if( (E_SF_TSCH_SCHEDULE_DATA_SLOTS_ALL == dataSlotType) ||
-        (E_SF_TSCH_SCHEDULE_DATA_SLOTS_TX == dataSlotType) )
+    return enable_table_links(bulk_indexes, indexes_cnt, 0);
+#else
+    int links_cnt;
+    struct tsch_slotframe *sf_common;
+
+    if( !schedule_ready() )
+        return -1;
+
+    LOG_INFO("Delete data slots for %u devices\n", cnt);
+
+    for( uint8_t l = 0; l < SCHEDULE_LAYOUTS; l++ )
     {
-        LOG_INFO("Delete TX data slots for device ");
-        LOG_INFO_LLADDR(addr);
-        LOG_INFO_("\n");
+        sf_common = get_layout_slotframe(l);
+        if( sf_common == NULL )
+            continue;
+
+        links_cnt = get_bulk_data_slot_links(addrs, cnt, dataSlotType, l);
+        if( links_cnt < 0 )
+            return -1;
 
-#if SCHEDULE_A
-        /* remove the TX slot */
-        section = devid / APP_SLOTFRAME_SECTION_DEVICE_RX_SLOTS;
-        slot = ((devid - 0) * 2) % APP_SLOTFRAME_SECTION_DEVICE_RX_SLOTS;
-        slot_offset = (section * APP_SLOTFRAME_SECTION_SIZE) +
-                APP_SLOTFRAME_SECTION_BEACON_SLOTS + APP_SLOTFRAME_SECTION_JOIN_SLOTS + (APP_SLOTFRAME_SECTION_DEVICE_TX_SLOTS * 2) +
-                slot;
-        channel_offset = 0;
-        if( tsch_schedule_remove_link_by_timeslot(sf_common, slot_offset, channel_offset) == 0)
-           /* an error occurred that should not. */
-           return -1;
-#endif /* #if SCHEDULE_A */
+        if( (links_cnt > 0) && (tsch_schedule_remove_links(sf_common, bulk_links, links_cnt) == 0) )
+            /* an error occurred that should not. */
+            return -1;
     }
 
-    return 0;
+#if APP_SLOTFRAME_COMPACT
+    for( uint8_t i = 0; i < cnt; i++ )
+        set_device(&addrs[i], get_devid(&addrs[i]), dataSlotType, 0);
+#endif /* #if APP_SLOTFRAME_COMPACT */
+
+    return update_layout();
+#endif /* #if APP_SLOTFRAME_STATIC */
+}
+
+/*---------------------------------------------------------------------------*/
+uint16_t sf_tsch_schedule_get_slotframe_size( void )
+{
+    struct tsch_slotframe *sf_common = get_layout_slotframe(active_layout);
+
+    return (sf_common != NULL) ? sf_common->size.val : 0;
+}
+
+/*---------------------------------------------------------------------------*/
+void sf_tsch_schedule_count_rx( uint32_t len )
+{
+    uint8_t kind = SF_TSCH_SCHEDULE_SLOT_OTHER;
+
+    /* called by TSCH in the RX slot for a valid frame */
+    if( (len == 0) || (current_link == NULL) || !(current_link->link_options & LINK_OPTION_RX) )
+        return;
+
+    for( uint8_t l = 0; l < SCHEDULE_LAYOUTS; l++ )
+    {
+        if( current_link->slotframe_handle == layout_handle[l] )
+            kind = engine->uplink_slot_kind(current_link->timeslot, layout_positions[l]);
+    }
+
+    if( kind == SF_TSCH_SCHEDULE_SLOT_RX )
+        retry_stats.first++;
+    else if( kind == SF_TSCH_SCHEDULE_SLOT_RETRY )
+        retry_stats.retry++;
+}
+
+/*---------------------------------------------------------------------------*/
+void sf_tsch_schedule_get_retry_stats( sf_tsch_schedule_retry_stats_t* stats )
+{
+    if( stats != NULL )
+        *stats = retry_stats;
 }
 
 #ifdef __cplusplus
@@ -35,6 +35,21 @@ typedef enum
     E_SF_TSCH_SCHEDULE_DATA_SLOTS_TX
 } e_sf_tsch_schedule_data_slot_types_t;
 
+/**
+ * @brief   Uplink frames received in the data slots of the devices.
+ *
+ *          Frames received in a retry slot were lost in the first
+ *          attempt, so retry / (first + retry) estimates the uplink loss
+ *          the shared retry slots are sized from.
+ */
+typedef struct
+{
+    /* frames received in the RX slots of the devices */
+    uint32_t first;
+    /* frames received in the dedicated or shared retry slots */
+    uint32_t retry;
+} sf_tsch_schedule_retry_stats_t;
+
 /**
  * @brief   Initialize the schedule.
  *
@@ -67,6 +82,45 @@ int sf_tsch_schedule_add_beacon_slots( void );
 int sf_tsch_schedule_delete_beacon_slots( void );
 
 
+/**
+ * @brief	Add the Broadcast Slots.
+ *
+ *			Add the broadcast slots to the schedule. The gateway sends the
+ *			frames to several devices in these slots, all devices listen.
+ *
+ * @return	0 on success.
+ */
+int sf_tsch_schedule_add_broadcast_slots( void );
+
+
+/**
+ * @brief	Remove the Broadcast Slots.
+ *
+ * @return	0 on success.
+ */
+int sf_tsch_schedule_delete_broadcast_slots( void );
+
+
+/**
+ * @brief	Add the Retry Slots.
+ *
+ *			Add the shared retry slots to the schedule, APP_SLOTFRAME_SECTION_RETRY_SLOTS
+ *			per section behind the device RX slots. All devices retransmit
+ *			in these slots with the TSCH backoff, the gateway listens.
+ *
+ * @return	0 on success, also if no retry slots are configured.
+ */
+int sf_tsch_schedule_add_retry_slots( void );
+
+
+/**
+ * @brief	Remove the Retry Slots.
+ *
+ * @return	0 on success.
+ */
+int sf_tsch_schedule_delete_retry_slots( void );
+
+
 /**
  * @brief	Add the Join-Request Slots.
  *
@@ -122,6 +176,36 @@ int sf_tsch_schedule_add_jproc_slots( const linkaddr_t* addr );
 int sf_tsch_schedule_delete_jproc_slots( const linkaddr_t* addr );
 
 
+/**
+ * @brief	Add a group of Join-Process Slots.
+ *
+ *			The join process slots are split into group_cnt interleaved
+ *			groups, so several devices can join at the same time. Group g
+ *			holds every group_cnt-th join process slot starting at slot g.
+ *
+ * @param	addr 		Address to open the join process for.
+ * @param	group 		Group of the slots, below group_cnt.
+ * @param	group_cnt	Number of groups.
+ *
+ * @return	0 on success.
+ */
+int sf_tsch_schedule_add_jproc_slot_group( const linkaddr_t* addr,
+                                           uint8_t group, uint8_t group_cnt );
+
+
+/**
+ * @brief	Remove a group of Join-Process Slots.
+ *
+ * @param	addr 		Address the join process was opened for.
+ * @param	group 		Group of the slots, below group_cnt.
+ * @param	group_cnt	Number of groups.
+ *
+ * @return	0 on success.
+ */
+int sf_tsch_schedule_delete_jproc_slot_group( const linkaddr_t* addr,
+                                              uint8_t group, uint8_t group_cnt );
+
+
 /**
  * @brief	Add Data-Slots.
  *
@@ -155,6 +239,79 @@ int sf_tsch_schedule_add_data_slots( const linkaddr_t* addr,
 int sf_tsch_schedule_delete_data_slots( const linkaddr_t* addr,
                                         e_sf_tsch_schedule_data_slot_types_t dataSlotType );
 
+/**
+ * @brief	Add Data-Slots of several devices.
+ *
+ *			Same as @ref sf_tsch_schedule_add_data_slots for a list of
+ *			devices, but all slots are installed while the schedule is
+ *			locked only once. Used to restore the devices after a reboot.
+ *
+ * @param	addrs         List of addresses to add data slots for.
+ * @param cnt           Number of addresses (at most APP_MAX_DEVICE_SLOTS).
+ * @param dataSlotType  Type of data slot to add.
+ *
+ * @return	0 on success.
+ */
+int sf_tsch_schedule_add_data_slots_bulk( const linkaddr_t* addrs, uint8_t cnt,
+                                          e_sf_tsch_schedule_data_slot_types_t dataSlotType );
+
+
+/**
+ * @brief	Remove Data-Slots of several devices.
+ *
+ *			Same as @ref sf_tsch_schedule_delete_data_slots for a list of
+ *			devices, but all slots are removed while the schedule is
+ *			locked only once.
+ *
+ * @param addrs         List of addresses to delete data slots for.
+ * @param cnt           Number of addresses (at most APP_MAX_DEVICE_SLOTS).
+ * @param dataSlotType  Type of data slot to delete.
+ *
+ * @return	0 on success.
+ */
+int sf_tsch_schedule_delete_data_slots_bulk( const linkaddr_t* addrs, uint8_t cnt,
+                                             e_sf_tsch_schedule_data_slot_types_t dataSlotType );
+
+
+/**
+ * @brief	Get the size of the active slotframe.
+ *
+ *			The size is APP_SLOTFRAME_SIZE unless APP_SLOTFRAME_COMPACT is
+ *			enabled. Then the slotframe is resized to the devices with data
+ *			slots: it holds the RX slots (with the dedicated retry slots),
+ *			the shared retry slots, then the TX slots of its device
+ *			positions, then the broadcast slots. A new size is
+ *			announced in the schedule descriptor of the EBs and becomes
+ *			active APP_SLOTFRAME_COMPACT_LEAD slotframes later.
+ *
+ * @return	Number of timeslots, 0 if the schedule is not initialized.
+ */
+uint16_t sf_tsch_schedule_get_slotframe_size( void );
+
+
+/**
+ * @brief	Count a received frame.
+ *
+ *			Called by TSCH for each valid frame addressed to this node
+ *			(TSCH_CALLBACK_RX_VALID_FRAME). Frames with a failed parse or
+ *			authentication are not counted. Frames received in the data
+ *			slots of the devices are counted in the retry statistics.
+ *
+ * @param	len 	Length of the received frame.
+ */
+void sf_tsch_schedule_count_rx( uint32_t len );
+
+
+/**
+ * @brief	Get the retry statistics.
+ *
+ *			The counts are kept since the start and measure the uplink
+ *			loss to size APP_SLOTFRAME_SECTION_RETRY_SLOTS.
+ *
+ * @param	stats 	Frames received in the RX slots and in the retry slots.
+ */
+void sf_tsch_schedule_get_retry_stats( sf_tsch_schedule_retry_stats_t* stats );
+
 #endif /* TSCH_SCHEDULE_H_ */
 
 #ifdef __cplusplus
@@ -50,6 +50,12 @@ void sf_tsch_init(void)
 
   /* Add beacon slots */
   sf_tsch_schedule_add_beacon_slots();
+
+  /* Add broadcast slots */
+  sf_tsch_schedule_add_broadcast_slots();
+
+  /* Add the retry slots shared by all SCs */
+  sf_tsch_schedule_add_retry_slots();
 }/* sf_tsch_init() */
 
 /*----------------------------------------------------------------------------*/
@@ -166,12 +172,64 @@ E_SF_RETURN_t sf_tsch_deleteDataSlots(const linkaddr_t* pAddr)
   return E_SF_ERROR;
 }/* sf_tsch_deleteDataSlots() */
 
+/*----------------------------------------------------------------------------*/
+/*! sf_tsch_addDataSlotsBulk */
+/*----------------------------------------------------------------------------*/
+E_SF_RETURN_t sf_tsch_addDataSlotsBulk(const linkaddr_t* pAddrList, uint8_t addrCnt)
+{
+  if(!pAddrList)
+  {
+    return E_SF_ERROR_NPE;
+  }
+
+  /* Add data slots of all sensors. */
+  if(!sf_tsch_schedule_add_data_slots_bulk(pAddrList, addrCnt,
+                                           E_SF_TSCH_SCHEDULE_DATA_SLOTS_ALL))
+  {
+    return E_SF_SUCCESS;
+  }
+
+  return E_SF_ERROR;
+}/* sf_tsch_addDataSlotsBulk() */
+
+/*----------------------------------------------------------------------------*/
+/*! sf_tsch_deleteDataSlotsBulk */
+/*----------------------------------------------------------------------------*/
+E_SF_RETURN_t sf_tsch_deleteDataSlotsBulk(const linkaddr_t* pAddrList, uint8_t addrCnt)
+{
+  if(!pAddrList)
+  {
+    return E_SF_ERROR_NPE;
+  }
+
+  /* Delete data slots of all sensors. */
+  if(!sf_tsch_schedule_delete_data_slots_bulk(pAddrList, addrCnt,
+                                              E_SF_TSCH_SCHEDULE_DATA_SLOTS_ALL))
+  {
+    return E_SF_SUCCESS;
+  }
+
+  return E_SF_ERROR;
+}/* sf_tsch_deleteDataSlotsBulk() */
+
 /*----------------------------------------------------------------------------*/
 /*! sf_tsch_send */
 /*----------------------------------------------------------------------------*/
 E_SF_RETURN_t sf_tsch_send(uint8_t* pFrame, uint8_t frameLen,
                            linkaddr_t* pDestAddr,
                            sf_callbackHandlerCtxt_t* pCallbackHandlerCtx)
+{
+  return sf_tsch_sendCoalesced(pFrame, frameLen, pDestAddr,
+                               pCallbackHandlerCtx, 0);
+} /* sf_tsch_send() */
+
+/*----------------------------------------------------------------------------*/
+/*! sf_tsch_sendCoalesced */
+/*----------------------------------------------------------------------------*/
+E_SF_RETURN_t sf_tsch_sendCoalesced(uint8_t* pFrame, uint8_t frameLen,
+                                    linkaddr_t* pDestAddr,
+                                    sf_callbackHandlerCtxt_t* pCallbackHandlerCtx,
+                                    uint16_t coalesceKey)
 {
   if(!pFrame || !pDestAddr || !pCallbackHandlerCtx)
   {
@@ -181,13 +239,18 @@ E_SF_RETURN_t sf_tsch_send(uint8_t* pFrame, uint8_t frameLen,
   /* Fill out nullnet buffer. */
   nullnet_buf = pFrame;
   nullnet_len = frameLen;
+#if TSCH_WITH_QUEUE_COALESCING
+  nullnet_coalesce_key = coalesceKey;
+#else
+  (void)coalesceKey;
+#endif
 
   /* Transmit payload to the destination address */
   NETSTACK_NETWORK.output(pDestAddr, (void*) pCallbackHandlerCtx,
                           FRAME802154_DATAFRAME);
 
   return E_SF_SUCCESS;
-} /* sf_tsch_send() */
+} /* sf_tsch_sendCoalesced() */
 
 #ifdef __cplusplus
 }
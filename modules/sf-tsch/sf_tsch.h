@@ -37,7 +37,10 @@ extern "C" {
  *    | @ref sf_tsch_getPanId()                   | @copybrief sf_tsch_getPanId()                   |
  *    | @ref sf_tsch_addDataSlots()               | @copybrief sf_tsch_addDataSlots()               |
  *    | @ref sf_tsch_deleteDataSlots()            | @copybrief sf_tsch_deleteDataSlots()            |
+ *    | @ref sf_tsch_addDataSlotsBulk()           | @copybrief sf_tsch_addDataSlotsBulk()           |
+ *    | @ref sf_tsch_deleteDataSlotsBulk()        | @copybrief sf_tsch_deleteDataSlotsBulk()        |
  *    | @ref sf_tsch_send()                       | @copybrief sf_tsch_send()                       |
+ *    | @ref sf_tsch_sendCoalesced()              | @copybrief sf_tsch_sendCoalesced()              |
  *  @{
  */
 
@@ -131,6 +134,32 @@ E_SF_RETURN_t sf_tsch_addDataSlots(const linkaddr_t* pAddr);
 /*============================================================================*/
 E_SF_RETURN_t sf_tsch_deleteDataSlots(const linkaddr_t* pAddr);
 
+/*============================================================================*/
+/**
+ * \brief Add data time-slots of several sensors to the schedule at once.
+ *        The schedule is locked only once for all slots.
+ *
+ * \param pAddrList  List of sensor link addresses.
+ * \param addrCnt    Number of addresses in the list.
+ *
+ * \return @ref E_SF_RETURN_t
+ */
+/*============================================================================*/
+E_SF_RETURN_t sf_tsch_addDataSlotsBulk(const linkaddr_t* pAddrList, uint8_t addrCnt);
+
+/*============================================================================*/
+/**
+ * \brief Delete data time-slots of several sensors from the schedule at once.
+ *        The schedule is locked only once for all slots.
+ *
+ * \param pAddrList  List of sensor link addresses.
+ * \param addrCnt    Number of addresses in the list.
+ *
+ * \return @ref E_SF_RETURN_t
+ */
+/*============================================================================*/
+E_SF_RETURN_t sf_tsch_deleteDataSlotsBulk(const linkaddr_t* pAddrList, uint8_t addrCnt);
+
 /*============================================================================*/
 /**
  * \brief Schedule frame transmission to the destination address.
@@ -150,6 +179,28 @@ E_SF_RETURN_t sf_tsch_send(uint8_t* pFrame, uint8_t frameLen,
                            linkaddr_t* pDestAddr,
                            sf_callbackHandlerCtxt_t* pCallbackHandlerCtx);
 
+/*============================================================================*/
+/**
+ * \brief Schedule frame transmission to the destination address, replacing
+ *        a frame with the same coalescing key that is still queued for this
+ *        destination and has not been transmitted yet. The callback of the
+ *        replaced frame is not raised. Without TSCH_CONF_WITH_QUEUE_COALESCING
+ *        this is the same as @ref sf_tsch_send().
+ *
+ * \param pFrame               Pointer to the frame storage.
+ * \param frameLen             Frame length
+ * \param pDestAddr            Pointer to the destination link address.
+ * \param pCallbackHandlerCtx  Pointer to the callback handler context
+ * \param coalesceKey          Coalescing key, 0 to never replace a frame.
+ *
+ * \return @ref E_SF_RETURN_t
+ */
+/*============================================================================*/
+E_SF_RETURN_t sf_tsch_sendCoalesced(uint8_t* pFrame, uint8_t frameLen,
+                                    linkaddr_t* pDestAddr,
+                                    sf_callbackHandlerCtxt_t* pCallbackHandlerCtx,
+                                    uint16_t coalesceKey);
+
 /*! @} */
 
 #endif /* __SF_TSCH_H__ */
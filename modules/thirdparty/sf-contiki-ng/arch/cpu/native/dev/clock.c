@@ -0,0 +1,78 @@
+/**
+ * @code
+ *  ___ _____ _   ___ _  _____ ___  ___  ___ ___
+ * / __|_   _/_\ / __| |/ / __/ _ \| _ \/ __| __|
+ * \__ \ | |/ _ \ (__| ' <| _| (_) |   / (__| _|
+ * |___/ |_/_/ \_\___|_|\_\_| \___/|_|_\\___|___|
+ * embedded.connectivity.solutions.==============
+ * @endcode
+ *
+ * @copyright  STACKFORCE GmbH, Germany, www.stackforce.de
+ * @author     STACKFORCE
+ * @brief      Clock driver of the native (Linux host) CPU.
+ */
+/*---------------------------------------------------------------------------*/
+#include "contiki.h"
+#include "sys/clock.h"
+#include "sys/rtimer.h"
+/*---------------------------------------------------------------------------*/
+#include <time.h>
+/*---------------------------------------------------------------------------*/
+/* Host time at clock_init() in rtimer ticks */
+static rtimer_clock_t clock_start;
+/* Offset applied by clock_set_seconds() */
+static long seconds_offset;
+/*---------------------------------------------------------------------------*/
+void
+clock_init(void)
+{
+  clock_start = rtimer_arch_now();
+  seconds_offset = 0;
+}
+/*---------------------------------------------------------------------------*/
+clock_time_t
+clock_time(void)
+{
+  return (clock_time_t)((rtimer_arch_now() - clock_start) /
+                        (RTIMER_SECOND / CLOCK_SECOND));
+}
+/*---------------------------------------------------------------------------*/
+unsigned long
+clock_seconds(void)
+{
+  return (unsigned long)((rtimer_arch_now() - clock_start) / RTIMER_SECOND) +
+         seconds_offset;
+}
+/*---------------------------------------------------------------------------*/
+void
+clock_set_seconds(unsigned long sec)
+{
+  seconds_offset = (long)sec - (long)((rtimer_arch_now() - clock_start) /
+                                      RTIMER_SECOND);
+}
+/*---------------------------------------------------------------------------*/
+void
+clock_wait(clock_time_t t)
+{
+  struct timespec ts;
+
+  ts.tv_sec = t / CLOCK_SECOND;
+  ts.tv_nsec = (t % CLOCK_SECOND) * (1000000000 / CLOCK_SECOND);
+  nanosleep(&ts, NULL);
+}
+/*---------------------------------------------------------------------------*/
+void
+clock_delay_usec(uint32_t dt)
+{
+  rtimer_clock_t end = rtimer_arch_now() + US_TO_RTIMERTICKS(dt);
+
+  /* Busy-wait, like the embedded targets do */
+  while(RTIMER_CLOCK_LT(rtimer_arch_now(), end));
+}
+/*---------------------------------------------------------------------------*/
+void
+clock_delay(unsigned int delay)
+{
+  clock_delay_usec(delay);
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,155 @@
+/**
+ * @code
+ *  ___ _____ _   ___ _  _____ ___  ___  ___ ___
+ * / __|_   _/_\ / __| |/ / __/ _ \| _ \/ __| __|
+ * \__ \ | |/ _ \ (__| ' <| _| (_) |   / (__| _|
+ * |___/ |_/_/ \_\___|_|\_\_| \___/|_|_\\___|___|
+ * embedded.connectivity.solutions.==============
+ * @endcode
+ *
+ * @copyright  STACKFORCE GmbH, Germany, www.stackforce.de
+ * @author     STACKFORCE
+ * @brief      GPIO HAL of the native (Linux host) CPU.
+ */
+/*---------------------------------------------------------------------------*/
+#include "contiki.h"
+#include "dev/gpio-hal.h"
+/*---------------------------------------------------------------------------*/
+#include <stdint.h>
+/*---------------------------------------------------------------------------*/
+/* Level of each virtual pin */
+static gpio_hal_pin_mask_t pin_levels;
+/* Pins configured as output */
+static gpio_hal_pin_mask_t pin_outputs;
+/* Pins with an enabled interrupt */
+static gpio_hal_pin_mask_t pin_interrupts;
+/* Configuration of each virtual pin */
+static gpio_hal_pin_cfg_t pin_cfg[GPIO_HAL_PIN_COUNT];
+/*---------------------------------------------------------------------------*/
+void
+gpio_hal_arch_init(void)
+{
+  pin_levels = 0;
+  pin_outputs = 0;
+  pin_interrupts = 0;
+}
+/*---------------------------------------------------------------------------*/
+void
+gpio_hal_arch_native_drive_pin(gpio_hal_pin_t pin, uint8_t value)
+{
+  gpio_hal_pin_mask_t mask = gpio_hal_pin_to_mask(pin);
+  gpio_hal_pin_mask_t old = pin_levels;
+
+  if(pin >= GPIO_HAL_PIN_COUNT) {
+    return;
+  }
+
+  pin_levels = value ? (pin_levels | mask) : (pin_levels & ~mask);
+
+  if((old ^ pin_levels) & mask & pin_interrupts) {
+    gpio_hal_event_handler(mask);
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+gpio_hal_arch_no_port_interrupt_enable(gpio_hal_pin_t pin)
+{
+  pin_interrupts |= gpio_hal_pin_to_mask(pin);
+}
+/*---------------------------------------------------------------------------*/
+void
+gpio_hal_arch_no_port_interrupt_disable(gpio_hal_pin_t pin)
+{
+  pin_interrupts &= ~gpio_hal_pin_to_mask(pin);
+}
+/*---------------------------------------------------------------------------*/
+void
+gpio_hal_arch_no_port_pin_cfg_set(gpio_hal_pin_t pin, gpio_hal_pin_cfg_t cfg)
+{
+  if(pin >= GPIO_HAL_PIN_COUNT) {
+    return;
+  }
+  pin_cfg[pin] = cfg;
+
+  /* A pull-up gives a high idle level on an undriven input */
+  if(cfg & GPIO_HAL_PIN_CFG_PULL_UP) {
+    pin_levels |= gpio_hal_pin_to_mask(pin);
+  } else if(cfg & GPIO_HAL_PIN_CFG_PULL_DOWN) {
+    pin_levels &= ~gpio_hal_pin_to_mask(pin);
+  }
+}
+/*---------------------------------------------------------------------------*/
+gpio_hal_pin_cfg_t
+gpio_hal_arch_no_port_pin_cfg_get(gpio_hal_pin_t pin)
+{
+  if(pin >= GPIO_HAL_PIN_COUNT) {
+    return 0;
+  }
+  return pin_cfg[pin];
+}
+/*---------------------------------------------------------------------------*/
+void
+gpio_hal_arch_no_port_pin_set_input(gpio_hal_pin_t pin)
+{
+  pin_outputs &= ~gpio_hal_pin_to_mask(pin);
+}
+/*---------------------------------------------------------------------------*/
+void
+gpio_hal_arch_no_port_pin_set_output(gpio_hal_pin_t pin)
+{
+  pin_outputs |= gpio_hal_pin_to_mask(pin);
+}
+/*---------------------------------------------------------------------------*/
+void
+gpio_hal_arch_no_port_set_pin(gpio_hal_pin_t pin)
+{
+  pin_levels |= gpio_hal_pin_to_mask(pin);
+}
+/*---------------------------------------------------------------------------*/
+void
+gpio_hal_arch_no_port_clear_pin(gpio_hal_pin_t pin)
+{
+  pin_levels &= ~gpio_hal_pin_to_mask(pin);
+}
+/*---------------------------------------------------------------------------*/
+uint8_t
+gpio_hal_arch_no_port_read_pin(gpio_hal_pin_t pin)
+{
+  return (pin_levels & gpio_hal_pin_to_mask(pin)) ? 1 : 0;
+}
+/*---------------------------------------------------------------------------*/
+void
+gpio_hal_arch_no_port_write_pin(gpio_hal_pin_t pin, uint8_t value)
+{
+  if(value) {
+    gpio_hal_arch_no_port_set_pin(pin);
+  } else {
+    gpio_hal_arch_no_port_clear_pin(pin);
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+gpio_hal_arch_no_port_set_pins(gpio_hal_pin_mask_t pins)
+{
+  pin_levels |= pins;
+}
+/*---------------------------------------------------------------------------*/
+void
+gpio_hal_arch_no_port_clear_pins(gpio_hal_pin_mask_t pins)
+{
+  pin_levels &= ~pins;
+}
+/*---------------------------------------------------------------------------*/
+gpio_hal_pin_mask_t
+gpio_hal_arch_no_port_read_pins(gpio_hal_pin_mask_t pins)
+{
+  return pin_levels & pins;
+}
+/*---------------------------------------------------------------------------*/
+void
+gpio_hal_arch_no_port_write_pins(gpio_hal_pin_mask_t pins,
+                                 gpio_hal_pin_mask_t value)
+{
+  pin_levels = (pin_levels & ~pins) | (value & pins);
+}
+/*---------------------------------------------------------------------------*/
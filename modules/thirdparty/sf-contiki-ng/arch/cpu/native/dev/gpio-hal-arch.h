@@ -0,0 +1,34 @@
+/**
+ * @code
+ *  ___ _____ _   ___ _  _____ ___  ___  ___ ___
+ * / __|_   _/_\ / __| |/ / __/ _ \| _ \/ __| __|
+ * \__ \ | |/ _ \ (__| ' <| _| (_) |   / (__| _|
+ * |___/ |_/_/ \_\___|_|\_\_| \___/|_|_\\___|___|
+ * embedded.connectivity.solutions.==============
+ * @endcode
+ *
+ * @copyright  STACKFORCE GmbH, Germany, www.stackforce.de
+ * @author     STACKFORCE
+ * @brief      GPIO HAL of the native (Linux host) CPU.
+ *
+ * The pins are virtual: outputs are kept in a register and inputs can be
+ * driven by the platform, e.g. to simulate a button press.
+ */
+/*---------------------------------------------------------------------------*/
+#ifndef GPIO_HAL_ARCH_H_
+#define GPIO_HAL_ARCH_H_
+/*---------------------------------------------------------------------------*/
+#include "contiki.h"
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief Drive a virtual input pin from outside of the stack.
+ * \param pin   The pin to drive
+ * \param value 0 for low, any other value for high
+ *
+ * If the pin level changes and the pin interrupt is enabled, the GPIO HAL
+ * event handler is called. Do not call this from a signal handler.
+ */
+void gpio_hal_arch_native_drive_pin(gpio_hal_pin_t pin, uint8_t value);
+/*---------------------------------------------------------------------------*/
+#endif /* GPIO_HAL_ARCH_H_ */
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,68 @@
+/**
+ * @code
+ *  ___ _____ _   ___ _  _____ ___  ___  ___ ___
+ * / __|_   _/_\ / __| |/ / __/ _ \| _ \/ __| __|
+ * \__ \ | |/ _ \ (__| ' <| _| (_) |   / (__| _|
+ * |___/ |_/_/ \_\___|_|\_\_| \___/|_|_\\___|___|
+ * embedded.connectivity.solutions.==============
+ * @endcode
+ *
+ * @copyright  STACKFORCE GmbH, Germany, www.stackforce.de
+ * @author     STACKFORCE
+ * @brief      Master interrupt manipulation of the native (Linux host) CPU.
+ *
+ * The rtimer interrupt is the SIGALRM signal, see rtimer-arch.c. Disabling
+ * interrupts blocks it.
+ */
+/*---------------------------------------------------------------------------*/
+#include "contiki.h"
+#include "sys/int-master.h"
+/*---------------------------------------------------------------------------*/
+#include <signal.h>
+#include <stdbool.h>
+/*---------------------------------------------------------------------------*/
+static sigset_t
+irq_set(void)
+{
+  sigset_t set;
+
+  sigemptyset(&set);
+  sigaddset(&set, SIGALRM);
+  return set;
+}
+/*---------------------------------------------------------------------------*/
+void
+int_master_enable(void)
+{
+  sigset_t set = irq_set();
+
+  sigprocmask(SIG_UNBLOCK, &set, NULL);
+}
+/*---------------------------------------------------------------------------*/
+int_master_status_t
+int_master_read_and_disable(void)
+{
+  sigset_t set = irq_set();
+  sigset_t old;
+
+  sigprocmask(SIG_BLOCK, &set, &old);
+  return !sigismember(&old, SIGALRM);
+}
+/*---------------------------------------------------------------------------*/
+void
+int_master_status_set(int_master_status_t status)
+{
+  if(status) {
+    int_master_enable();
+  }
+}
+/*---------------------------------------------------------------------------*/
+bool
+int_master_is_enabled(void)
+{
+  sigset_t cur;
+
+  sigprocmask(SIG_BLOCK, NULL, &cur);
+  return !sigismember(&cur, SIGALRM);
+}
+/*---------------------------------------------------------------------------*/
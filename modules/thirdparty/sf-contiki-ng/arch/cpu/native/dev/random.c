@@ -0,0 +1,36 @@
+/**
+ * @code
+ *  ___ _____ _   ___ _  _____ ___  ___  ___ ___
+ * / __|_   _/_\ / __| |/ / __/ _ \| _ \/ __| __|
+ * \__ \ | |/ _ \ (__| ' <| _| (_) |   / (__| _|
+ * |___/ |_/_/ \_\___|_|\_\_| \___/|_|_\\___|___|
+ * embedded.connectivity.solutions.==============
+ * @endcode
+ *
+ * @copyright  STACKFORCE GmbH, Germany, www.stackforce.de
+ * @author     STACKFORCE
+ * @brief      Pseudo random number generator of the native (Linux host) CPU.
+ *
+ * This file overrides os/lib/random.c, like the simplelink CPU does.
+ */
+/*---------------------------------------------------------------------------*/
+#include "contiki.h"
+#include "lib/random.h"
+/*---------------------------------------------------------------------------*/
+#include <stdlib.h>
+/*---------------------------------------------------------------------------*/
+/* Per process PRNG state, so that nodes do not share one sequence */
+static unsigned int seed_state = 1;
+/*---------------------------------------------------------------------------*/
+unsigned short
+random_rand(void)
+{
+  return (unsigned short)(rand_r(&seed_state) & RANDOM_RAND_MAX);
+}
+/*---------------------------------------------------------------------------*/
+void
+random_init(unsigned short seed)
+{
+  seed_state = seed;
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,119 @@
+/**
+ * @code
+ *  ___ _____ _   ___ _  _____ ___  ___  ___ ___
+ * / __|_   _/_\ / __| |/ / __/ _ \| _ \/ __| __|
+ * \__ \ | |/ _ \ (__| ' <| _| (_) |   / (__| _|
+ * |___/ |_/_/ \_\___|_|\_\_| \___/|_|_\\___|___|
+ * embedded.connectivity.solutions.==============
+ * @endcode
+ *
+ * @copyright  STACKFORCE GmbH, Germany, www.stackforce.de
+ * @author     STACKFORCE
+ * @brief      rtimer driver of the native (Linux host) CPU.
+ *
+ * A POSIX timer on CLOCK_MONOTONIC raises SIGALRM shortly before the
+ * rtimer is due. The handler spins until the exact time and runs the
+ * rtimer, which preempts the processes like the timer interrupt of the
+ * MCU targets.
+ */
+/*---------------------------------------------------------------------------*/
+#include "contiki.h"
+#include "sys/rtimer.h"
+/*---------------------------------------------------------------------------*/
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+/*---------------------------------------------------------------------------*/
+/*
+ * The signal is raised this early and the remaining time is spun away,
+ * to hide the wake-up latency of the host.
+ */
+#define RTIMER_ARCH_WAKEUP_MARGIN  US_TO_RTIMERTICKS(300)
+/*---------------------------------------------------------------------------*/
+static timer_t timer;
+/* Expiration time of the scheduled rtimer */
+static volatile rtimer_clock_t next_rtimer;
+/* Set while an rtimer is scheduled */
+static volatile int rtimer_pending;
+/*---------------------------------------------------------------------------*/
+static void
+rtimer_isr(int sig)
+{
+  (void)sig;
+
+  if(!rtimer_pending) {
+    return;
+  }
+  while(RTIMER_CLOCK_LT(rtimer_arch_now(), next_rtimer));
+
+  /* rtimer_run_next() re-arms through rtimer_arch_schedule() */
+  rtimer_pending = 0;
+  rtimer_run_next();
+}
+/*---------------------------------------------------------------------------*/
+void
+rtimer_arch_init(void)
+{
+  struct sigaction sa;
+  struct sigevent sev;
+
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = rtimer_isr;
+  /* Do not nest, like an interrupt of the same priority */
+  sigemptyset(&sa.sa_mask);
+  sa.sa_flags = SA_RESTART;
+  sigaction(SIGALRM, &sa, NULL);
+
+  memset(&sev, 0, sizeof(sev));
+  sev.sigev_notify = SIGEV_SIGNAL;
+  sev.sigev_signo = SIGALRM;
+  if(timer_create(CLOCK_MONOTONIC, &sev, &timer) != 0) {
+    perror("rtimer: timer_create");
+    exit(EXIT_FAILURE);
+  }
+
+  rtimer_pending = 0;
+}
+/*---------------------------------------------------------------------------*/
+rtimer_clock_t
+rtimer_arch_now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (rtimer_clock_t)ts.tv_sec * RTIMER_ARCH_SECOND +
+         (rtimer_clock_t)ts.tv_nsec / (1000000000 / RTIMER_ARCH_SECOND);
+}
+/*---------------------------------------------------------------------------*/
+void
+rtimer_arch_schedule(rtimer_clock_t t)
+{
+  struct itimerspec its;
+  rtimer_clock_t wakeup = t - RTIMER_ARCH_WAKEUP_MARGIN;
+
+  next_rtimer = t;
+  rtimer_pending = 1;
+
+  /* An expiration in the past raises the signal right away */
+  memset(&its, 0, sizeof(its));
+  its.it_value.tv_sec = wakeup / RTIMER_ARCH_SECOND;
+  its.it_value.tv_nsec = (wakeup % RTIMER_ARCH_SECOND) *
+                         (1000000000 / RTIMER_ARCH_SECOND);
+  if(its.it_value.tv_sec == 0 && its.it_value.tv_nsec == 0) {
+    its.it_value.tv_nsec = 1;
+  }
+  timer_settime(timer, TIMER_ABSTIME, &its, NULL);
+}
+/*---------------------------------------------------------------------------*/
+void
+rtimer_arch_disable(void)
+{
+  struct itimerspec its;
+
+  rtimer_pending = 0;
+  memset(&its, 0, sizeof(its));
+  timer_settime(timer, 0, &its, NULL);
+}
+/*---------------------------------------------------------------------------*/
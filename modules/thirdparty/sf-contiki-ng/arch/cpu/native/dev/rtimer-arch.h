@@ -0,0 +1,50 @@
+/**
+ * @code
+ *  ___ _____ _   ___ _  _____ ___  ___  ___ ___
+ * / __|_   _/_\ / __| |/ / __/ _ \| _ \/ __| __|
+ * \__ \ | |/ _ \ (__| ' <| _| (_) |   / (__| _|
+ * |___/ |_/_/ \_\___|_|\_\_| \___/|_|_\\___|___|
+ * embedded.connectivity.solutions.==============
+ * @endcode
+ *
+ * @copyright  STACKFORCE GmbH, Germany, www.stackforce.de
+ * @author     STACKFORCE
+ * @brief      rtimer driver of the native (Linux host) CPU.
+ *
+ * The rtimer interrupt is emulated with SIGALRM, see rtimer-arch.c.
+ * RTIMER_ARCH_SECOND is defined in native-def.h.
+ */
+/*---------------------------------------------------------------------------*/
+#ifndef RTIMER_ARCH_H_
+#define RTIMER_ARCH_H_
+/*---------------------------------------------------------------------------*/
+#include "contiki.h"
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief  Current host time in rtimer ticks (CLOCK_MONOTONIC microseconds).
+ *
+ *         The value is not relative to the process start, so timestamps of
+ *         different native processes on the same host can be compared.
+ */
+rtimer_clock_t rtimer_arch_now(void);
+/*---------------------------------------------------------------------------*/
+/* One rtimer tick is one microsecond, the conversions only round. */
+#define US_TO_RTIMERTICKS(us)   ( \
+  ((us) >= 0) \
+    ? (((int64_t)(us) * RTIMER_ARCH_SECOND + 500000) / 1000000L) \
+    : (((int64_t)(us) * RTIMER_ARCH_SECOND - 500000) / 1000000L) \
+  )
+
+#define RTIMERTICKS_TO_US(rt)   ( \
+  ((rt) >= 0) \
+    ? (((int64_t)(rt) * 1000000L + (RTIMER_ARCH_SECOND / 2)) / RTIMER_ARCH_SECOND) \
+    : (((int64_t)(rt) * 1000000L - (RTIMER_ARCH_SECOND / 2)) / RTIMER_ARCH_SECOND) \
+  )
+
+#define RTIMERTICKS_TO_US_64(rt)  ( \
+  (uint32_t)( \
+    ((uint64_t)(rt) * 1000000 + (RTIMER_ARCH_SECOND / 2)) / RTIMER_ARCH_SECOND \
+  ))
+/*---------------------------------------------------------------------------*/
+#endif /* RTIMER_ARCH_H_ */
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,49 @@
+/**
+ * @code
+ *  ___ _____ _   ___ _  _____ ___  ___  ___ ___
+ * / __|_   _/_\ / __| |/ / __/ _ \| _ \/ __| __|
+ * \__ \ | |/ _ \ (__| ' <| _| (_) |   / (__| _|
+ * |___/ |_/_/ \_\___|_|\_\_| \___/|_|_\\___|___|
+ * embedded.connectivity.solutions.==============
+ * @endcode
+ *
+ * @copyright  STACKFORCE GmbH, Germany, www.stackforce.de
+ * @author     STACKFORCE
+ * @brief      Watchdog driver of the native (Linux host) CPU.
+ *
+ * There is no watchdog on the host. A reboot terminates the process.
+ */
+/*---------------------------------------------------------------------------*/
+#include "contiki.h"
+#include "dev/watchdog.h"
+/*---------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+/*---------------------------------------------------------------------------*/
+void
+watchdog_init(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+void
+watchdog_start(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+void
+watchdog_periodic(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+void
+watchdog_stop(void)
+{
+}
+/*---------------------------------------------------------------------------*/
+void
+watchdog_reboot(void)
+{
+  fprintf(stderr, "Watchdog reboot requested, exiting\n");
+  exit(EXIT_FAILURE);
+}
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,96 @@
+/**
+ * @code
+ *  ___ _____ _   ___ _  _____ ___  ___  ___ ___
+ * / __|_   _/_\ / __| |/ / __/ _ \| _ \/ __| __|
+ * \__ \ | |/ _ \ (__| ' <| _| (_) |   / (__| _|
+ * |___/ |_/_/ \_\___|_|\_\_| \___/|_|_\\___|___|
+ * embedded.connectivity.solutions.==============
+ * @endcode
+ *
+ * @copyright  STACKFORCE GmbH, Germany, www.stackforce.de
+ * @author     STACKFORCE
+ * @brief      Compiler and CPU definitions of the native (Linux host) CPU.
+ *
+ * The native CPU runs the stack as a normal host process. Both the clock and
+ * the rtimer are derived from CLOCK_MONOTONIC, so all processes on the same
+ * host share one time base. The radio related timings mirror the CC26xx
+ * 2.4 GHz IEEE mode so that TSCH timeslot templates can be reused unchanged.
+ */
+/*---------------------------------------------------------------------------*/
+#ifndef NATIVE_DEF_H_
+#define NATIVE_DEF_H_
+/*---------------------------------------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+/*---------------------------------------------------------------------------*/
+#define CLOCK_CONF_SECOND                1000
+/* 64-bit microsecond rtimer */
+#define RTIMER_ARCH_SECOND               1000000
+#define RTIMER_CONF_CLOCK_SIZE           8
+
+typedef unsigned long clock_time_t;
+typedef uint32_t uip_stats_t;
+
+#define INT_MASTER_CONF_STATUS_DATATYPE  uintptr_t
+/*---------------------------------------------------------------------------*/
+/* TSCH related defines */
+
+/* 1 len byte, 2 bytes CRC */
+#define RADIO_PHY_OVERHEAD           3
+/* 4 bytes preamble, 1 byte sync */
+#define RADIO_PHY_HEADER_LEN         5
+/* The fixed data rate is 250 kbps */
+#define RADIO_BIT_RATE               250000
+
+#define RADIO_BYTE_AIR_TIME  (1000000 / (RADIO_BIT_RATE / 8))
+
+/* Delay between GO signal and SFD */
+#define RADIO_DELAY_BEFORE_TX       ((unsigned)US_TO_RTIMERTICKS(0))
+/* Delay between GO signal and start listening */
+#define RADIO_DELAY_BEFORE_RX       ((unsigned)US_TO_RTIMERTICKS(0))
+/* Delay between the SFD finishes arriving and it is detected in software. */
+#define RADIO_DELAY_BEFORE_DETECT   ((unsigned)US_TO_RTIMERTICKS(0))
+
+/* Keep the simulated radio on for the whole timeslot */
+#define TSCH_CONF_RADIO_ON_DURING_TIMESLOT 1
+
+/* Disable TSCH frame filtering */
+#define TSCH_CONF_HW_FRAME_FILTERING  0
+
+/* The simulated radio reports exact SFD timestamps */
+#ifndef TSCH_CONF_RESYNC_WITH_SFD_TIMESTAMPS
+#define TSCH_CONF_RESYNC_WITH_SFD_TIMESTAMPS 1
+#define TSCH_CONF_TIMESYNC_REMOVE_JITTER 0
+#endif
+
+#ifndef TSCH_CONF_RADIO_WAKE_UP_TIME
+#define TSCH_CONF_RADIO_WAKE_UP_TIME (0)
+#endif /* #ifndef TSCH_CONF_RADIO_WAKE_UP_TIME */
+
+/* All nodes share the host clock, hence there is no drift */
+#ifndef TSCH_CONF_BASE_DRIFT_PPM
+#define TSCH_CONF_BASE_DRIFT_PPM 0
+#endif /* TSCH_CONF_BASE_DRIFT_PPM */
+
+/* 10 times per second */
+#ifndef TSCH_CONF_CHANNEL_SCAN_DURATION
+#define TSCH_CONF_CHANNEL_SCAN_DURATION (CLOCK_SECOND / 10)
+#endif
+
+#ifndef TSCH_CONF_ASSOCIATION_POLL_FREQUENCY
+#define TSCH_CONF_ASSOCIATION_POLL_FREQUENCY 10
+#endif
+
+/* Same guard time as the simplelink platform */
+#ifndef TSCH_CONF_RX_WAIT
+#define TSCH_CONF_RX_WAIT 1500
+#endif
+/*---------------------------------------------------------------------------*/
+/* GPIO HAL configuration: virtual pins without port numbering */
+#define GPIO_HAL_CONF_ARCH_SW_TOGGLE        1
+#define GPIO_HAL_CONF_PORT_PIN_NUMBERING    0
+#define GPIO_HAL_CONF_PIN_COUNT             32
+#define GPIO_HAL_CONF_ARCH_HDR_PATH         "dev/gpio-hal-arch.h"
+/*---------------------------------------------------------------------------*/
+#endif /* NATIVE_DEF_H_ */
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,52 @@
+/**
+ * @code
+ *  ___ _____ _   ___ _  _____ ___  ___  ___ ___
+ * / __|_   _/_\ / __| |/ / __/ _ \| _ \/ __| __|
+ * \__ \ | |/ _ \ (__| ' <| _| (_) |   / (__| _|
+ * |___/ |_/_/ \_\___|_|\_\_| \___/|_|_\\___|___|
+ * embedded.connectivity.solutions.==============
+ * @endcode
+ *
+ * @copyright  STACKFORCE GmbH, Germany, www.stackforce.de
+ * @author     STACKFORCE
+ * @brief      Configuration of the native (Linux host) platform.
+ *
+ * The stack runs as a normal process. The radio medium is shared by all
+ * native processes of the host, see dev/udp-radio.h.
+ */
+/*---------------------------------------------------------------------------*/
+#ifndef CONTIKI_CONF_H_
+#define CONTIKI_CONF_H_
+/*---------------------------------------------------------------------------*/
+/* Include project-specific configurations */
+#ifdef PROJECT_CONF_PATH
+#include PROJECT_CONF_PATH
+#endif
+/*---------------------------------------------------------------------------*/
+/* Include CPU-related configurations */
+#include "native-def.h"
+/*---------------------------------------------------------------------------*/
+/* The main loop waits on the radio socket and the timers */
+#define PLATFORM_CONF_PROVIDES_MAIN_LOOP  1
+#define PLATFORM_CONF_MAIN_ACCEPTS_ARGS   1
+/*---------------------------------------------------------------------------*/
+#ifndef NETSTACK_CONF_RADIO
+#define NETSTACK_CONF_RADIO               udp_radio_driver
+#endif
+/*---------------------------------------------------------------------------*/
+/* Virtual pins of the native GPIO HAL */
+#define NATIVE_PIN_LED_RED                0
+#define NATIVE_PIN_LED_GREEN              1
+#define NATIVE_PIN_USER_BUTTON            2
+
+#define LEDS_CONF_COUNT                   2
+#define LEDS_CONF_RED                     0
+#define LEDS_CONF_GREEN                   1
+#define LEDS_CONF_ALL                     ((1 << LEDS_CONF_COUNT) - 1)
+/*---------------------------------------------------------------------------*/
+#ifdef LOG_CONF_LEVEL_FRAMER
+#undef LOG_CONF_LEVEL_FRAMER
+#endif
+/*---------------------------------------------------------------------------*/
+#endif /* CONTIKI_CONF_H_ */
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,30 @@
+/**
+ * @code
+ *  ___ _____ _   ___ _  _____ ___  ___  ___ ___
+ * / __|_   _/_\ / __| |/ / __/ _ \| _ \/ __| __|
+ * \__ \ | |/ _ \ (__| ' <| _| (_) |   / (__| _|
+ * |___/ |_/_/ \_\___|_|\_\_| \___/|_|_\\___|___|
+ * embedded.connectivity.solutions.==============
+ * @endcode
+ *
+ * @copyright  STACKFORCE GmbH, Germany, www.stackforce.de
+ * @author     STACKFORCE
+ * @brief      Button HAL definitions of the native platform. The user button is a
+ *             virtual pin, pressed by sending SIGUSR1 to the process.
+ */
+/*---------------------------------------------------------------------------*/
+#include "contiki.h"
+#include "dev/button-hal.h"
+/*---------------------------------------------------------------------------*/
+#include <stdbool.h>
+/*---------------------------------------------------------------------------*/
+BUTTON_HAL_BUTTON(
+  user_button,                  /**< Name */
+  "User Button",                /**< Description */
+  NATIVE_PIN_USER_BUTTON,       /**< Virtual PIN */
+  GPIO_HAL_PIN_CFG_PULL_UP,     /**< Pull configuration */
+  BUTTON_HAL_ID_USER_BUTTON,    /**< Unique ID */
+  true);                        /**< Negative logic */
+/*---------------------------------------------------------------------------*/
+BUTTON_HAL_BUTTONS(&user_button);
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,27 @@
+/**
+ * @code
+ *  ___ _____ _   ___ _  _____ ___  ___  ___ ___
+ * / __|_   _/_\ / __| |/ / __/ _ \| _ \/ __| __|
+ * \__ \ | |/ _ \ (__| ' <| _| (_) |   / (__| _|
+ * |___/ |_/_/ \_\___|_|\_\_| \___/|_|_\\___|___|
+ * embedded.connectivity.solutions.==============
+ * @endcode
+ *
+ * @copyright  STACKFORCE GmbH, Germany, www.stackforce.de
+ * @author     STACKFORCE
+ * @brief      LED HAL definitions of the native platform. The LEDs are virtual
+ *             pins of the native GPIO HAL.
+ */
+/*---------------------------------------------------------------------------*/
+#include "contiki.h"
+#include "dev/leds.h"
+/*---------------------------------------------------------------------------*/
+#include <stdbool.h>
+/*---------------------------------------------------------------------------*/
+const leds_t leds_arch_leds[] = {
+  /* Red LED */
+  { .pin = NATIVE_PIN_LED_RED, .negative_logic = false },
+  /* Green LED */
+  { .pin = NATIVE_PIN_LED_GREEN, .negative_logic = false },
+};
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,578 @@
+/**
+ * @code
+ *  ___ _____ _   ___ _  _____ ___  ___  ___ ___
+ * / __|_   _/_\ / __| |/ / __/ _ \| _ \/ __| __|
+ * \__ \ | |/ _ \ (__| ' <| _| (_) |   / (__| _|
+ * |___/ |_/_/ \_\___|_|\_\_| \___/|_|_\\___|___|
+ * embedded.connectivity.solutions.==============
+ * @endcode
+ *
+ * @copyright  STACKFORCE GmbH, Germany, www.stackforce.de
+ * @author     STACKFORCE
+ * @brief      Simulated IEEE 802.15.4 radio of the native platform.
+ */
+/*---------------------------------------------------------------------------*/
+#include "contiki.h"
+#include "net/packetbuf.h"
+#include "net/netstack.h"
+#include "net/mac/framer/frame802154.h"
+#include "dev/udp-radio.h"
+/*---------------------------------------------------------------------------*/
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+/*---------------------------------------------------------------------------*/
+/* Log configuration */
+#include "sys/log.h"
+#define LOG_MODULE "Radio"
+#define LOG_LEVEL LOG_LEVEL_RADIO
+/*---------------------------------------------------------------------------*/
+#define UDP_RADIO_MAX_FRAME_LEN      127
+/* The FCS is not part of the payload */
+#define UDP_RADIO_MAX_PAYLOAD_LEN    (UDP_RADIO_MAX_FRAME_LEN - 2)
+
+#define UDP_RADIO_CHANNEL_MIN        11
+#define UDP_RADIO_CHANNEL_MAX        26
+#define UDP_RADIO_TXPOWER_MIN        (-21)
+#define UDP_RADIO_TXPOWER_MAX        5
+/* Reported by RADIO_PARAM_RSSI while the channel is idle */
+#define UDP_RADIO_NOISE_FLOOR        (-100)
+#define UDP_RADIO_LQI                0xFF
+
+/* Air time of a frame from the SFD to the last byte */
+#define UDP_RADIO_AIR_TIME(len) \
+  US_TO_RTIMERTICKS(RADIO_BYTE_AIR_TIME * ((len) + RADIO_PHY_OVERHEAD))
+/*---------------------------------------------------------------------------*/
+/* Header of each datagram on the medium */
+typedef struct __attribute__((packed)) {
+  /* Identifies the sending process, used to drop own frames */
+  uint32_t sender;
+  /* SFD time of the frame in rtimer ticks of the host clock */
+  uint64_t sfd;
+  uint8_t channel;
+  uint8_t len;
+} udp_radio_hdr_t;
+
+typedef struct {
+  udp_radio_hdr_t hdr;
+  uint8_t payload[UDP_RADIO_MAX_FRAME_LEN];
+} udp_radio_frame_t;
+
+/* Single frame receive buffer */
+typedef struct {
+  uint8_t buf[UDP_RADIO_MAX_FRAME_LEN];
+  uint8_t len;
+  rtimer_clock_t sfd;
+  rtimer_clock_t end;
+  bool valid;
+  bool corrupt;
+} udp_radio_rx_t;
+/*---------------------------------------------------------------------------*/
+static const char *medium_group = UDP_RADIO_GROUP;
+static uint16_t medium_port = UDP_RADIO_PORT;
+static struct sockaddr_in medium_addr;
+static int sock = -1;
+static uint32_t sender_id;
+
+static bool radio_on;
+static bool poll_mode;
+static bool send_on_cca;
+static uint8_t channel = IEEE802154_DEFAULT_CHANNEL;
+static radio_value_t txpower = UDP_RADIO_TXPOWER_MAX;
+static radio_value_t cca_threshold = -90;
+static uint16_t pan_id = IEEE802154_PANID;
+static uint16_t short_addr;
+static uint8_t ext_addr[8];
+
+static udp_radio_frame_t tx_frame;
+/* End of the last own transmission, the radio is deaf until then */
+static rtimer_clock_t tx_end;
+static udp_radio_rx_t rx;
+
+static int16_t last_rssi = UDP_RADIO_NOISE_FLOOR;
+static uint8_t last_lqi;
+static rtimer_clock_t last_timestamp;
+/*---------------------------------------------------------------------------*/
+PROCESS(udp_radio_process, "UDP radio driver");
+/*---------------------------------------------------------------------------*/
+static void
+handle_frame(const udp_radio_frame_t *frame, ssize_t size)
+{
+  rtimer_clock_t end;
+
+  if(size < (ssize_t)sizeof(udp_radio_hdr_t) ||
+     size != (ssize_t)sizeof(udp_radio_hdr_t) + frame->hdr.len ||
+     frame->hdr.len > UDP_RADIO_MAX_FRAME_LEN) {
+    return;
+  }
+
+  if(frame->hdr.sender == sender_id || !radio_on ||
+     frame->hdr.channel != channel ||
+     RTIMER_CLOCK_LT(frame->hdr.sfd, tx_end)) {
+    return;
+  }
+
+  end = frame->hdr.sfd + UDP_RADIO_AIR_TIME(frame->hdr.len);
+
+  if(rx.valid && RTIMER_CLOCK_LT(frame->hdr.sfd, rx.end)) {
+    /* Overlapping frames on the same channel collide */
+    rx.corrupt = true;
+    if(RTIMER_CLOCK_LT(rx.end, end)) {
+      rx.end = end;
+    }
+    LOG_DBG("collision on channel %u\n", channel);
+    return;
+  }
+
+  memcpy(rx.buf, frame->payload, frame->hdr.len);
+  rx.len = frame->hdr.len;
+  rx.sfd = frame->hdr.sfd;
+  /* Without poll mode the frame is passed up as soon as it is seen */
+  rx.end = poll_mode ? end : frame->hdr.sfd;
+  rx.valid = true;
+  rx.corrupt = false;
+}
+/*---------------------------------------------------------------------------*/
+static void
+poll_medium(void)
+{
+  udp_radio_frame_t frame;
+  ssize_t size;
+
+  if(sock < 0) {
+    return;
+  }
+
+  while((size = recv(sock, &frame, sizeof(frame), MSG_DONTWAIT)) >= 0) {
+    handle_frame(&frame, size);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+flush_medium(void)
+{
+  uint8_t dummy[sizeof(udp_radio_frame_t)];
+
+  if(sock < 0) {
+    return;
+  }
+
+  while(recv(sock, dummy, sizeof(dummy), MSG_DONTWAIT) >= 0);
+}
+/*---------------------------------------------------------------------------*/
+static int
+open_medium(void)
+{
+  struct ip_mreq mreq;
+  struct in_addr loopback;
+  int one = 1;
+  unsigned char ttl = 0;
+
+  sock = socket(AF_INET, SOCK_DGRAM, 0);
+  if(sock < 0) {
+    perror("udp-radio: socket");
+    return 0;
+  }
+
+  setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+#ifdef SO_REUSEPORT
+  setsockopt(sock, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one));
+#endif
+
+  memset(&medium_addr, 0, sizeof(medium_addr));
+  medium_addr.sin_family = AF_INET;
+  medium_addr.sin_port = htons(medium_port);
+  medium_addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  if(bind(sock, (struct sockaddr *)&medium_addr, sizeof(medium_addr)) < 0) {
+    perror("udp-radio: bind");
+    goto fail;
+  }
+
+  /* Keep the medium on the loopback interface of the host */
+  loopback.s_addr = htonl(INADDR_LOOPBACK);
+  mreq.imr_interface = loopback;
+  if(inet_pton(AF_INET, medium_group, &mreq.imr_multiaddr) != 1) {
+    fprintf(stderr, "udp-radio: invalid group %s\n", medium_group);
+    goto fail;
+  }
+  if(setsockopt(sock, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0 ||
+     setsockopt(sock, IPPROTO_IP, IP_MULTICAST_IF, &loopback, sizeof(loopback)) < 0 ||
+     setsockopt(sock, IPPROTO_IP, IP_MULTICAST_LOOP, &one, sizeof(one)) < 0 ||
+     setsockopt(sock, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) < 0) {
+    perror("udp-radio: multicast");
+    goto fail;
+  }
+  medium_addr.sin_addr = mreq.imr_multiaddr;
+
+  sender_id = (uint32_t)getpid();
+  return 1;
+
+fail:
+  close(sock);
+  sock = -1;
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+void
+udp_radio_set_medium(const char *group, uint16_t port)
+{
+  if(group != NULL) {
+    medium_group = group;
+  }
+  if(port != 0) {
+    medium_port = port;
+  }
+}
+/*---------------------------------------------------------------------------*/
+int
+udp_radio_fd(void)
+{
+  return sock;
+}
+/*---------------------------------------------------------------------------*/
+void
+udp_radio_poll(void)
+{
+  poll_medium();
+  if(!poll_mode && rx.valid) {
+    process_poll(&udp_radio_process);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static int
+init(void)
+{
+  /* The RF region selection re-initialises the radio */
+  if(sock < 0 && !open_medium()) {
+    return 0;
+  }
+
+  rx.valid = false;
+  process_start(&udp_radio_process, NULL);
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+prepare(const void *payload, unsigned short payload_len)
+{
+  if(payload_len > UDP_RADIO_MAX_PAYLOAD_LEN) {
+    return RADIO_TX_ERR;
+  }
+  memcpy(tx_frame.payload, payload, payload_len);
+  tx_frame.hdr.len = payload_len;
+  return RADIO_TX_OK;
+}
+/*---------------------------------------------------------------------------*/
+static int
+channel_clear(void)
+{
+  poll_medium();
+  return !(rx.valid && RTIMER_CLOCK_LT(RTIMER_NOW(), rx.end));
+}
+/*---------------------------------------------------------------------------*/
+static int
+transmit(unsigned short transmit_len)
+{
+  rtimer_clock_t now;
+
+  if(sock < 0 || transmit_len != tx_frame.hdr.len) {
+    return RADIO_TX_ERR;
+  }
+
+  if(send_on_cca && !channel_clear()) {
+    return RADIO_TX_COLLISION;
+  }
+
+  now = RTIMER_NOW();
+  tx_frame.hdr.sender = sender_id;
+  tx_frame.hdr.sfd = now + RADIO_DELAY_BEFORE_TX;
+  tx_frame.hdr.channel = channel;
+  tx_end = tx_frame.hdr.sfd + UDP_RADIO_AIR_TIME(transmit_len);
+
+  if(sendto(sock, &tx_frame, sizeof(udp_radio_hdr_t) + transmit_len, 0,
+            (struct sockaddr *)&medium_addr, sizeof(medium_addr)) < 0) {
+    LOG_ERR("sendto failed: %s\n", strerror(errno));
+    return RADIO_TX_ERR;
+  }
+
+  /* The radio is busy until the frame is on air */
+  RTIMER_BUSYWAIT_UNTIL_ABS(0, now, tx_end - now);
+
+  /* A frame received before the transmission is overwritten */
+  rx.valid = false;
+  return RADIO_TX_OK;
+}
+/*---------------------------------------------------------------------------*/
+static int
+send_packet(const void *payload, unsigned short payload_len)
+{
+  prepare(payload, payload_len);
+  return transmit(payload_len);
+}
+/*---------------------------------------------------------------------------*/
+static int
+read_packet(void *buf, unsigned short buf_len)
+{
+  int len;
+
+  poll_medium();
+  if(!rx.valid || RTIMER_CLOCK_LT(RTIMER_NOW(), rx.end)) {
+    return 0;
+  }
+  rx.valid = false;
+  if(rx.corrupt) {
+    return 0;
+  }
+
+  len = MIN(rx.len, buf_len);
+  memcpy(buf, rx.buf, len);
+
+  last_rssi = UDP_RADIO_RSSI;
+  last_lqi = UDP_RADIO_LQI;
+  last_timestamp = rx.sfd;
+  packetbuf_set_attr(PACKETBUF_ATTR_RSSI, last_rssi);
+  packetbuf_set_attr(PACKETBUF_ATTR_LINK_QUALITY, last_lqi);
+
+  return len;
+}
+/*---------------------------------------------------------------------------*/
+static int
+receiving_packet(void)
+{
+  poll_medium();
+  return rx.valid && RTIMER_CLOCK_LT(RTIMER_NOW(), rx.end);
+}
+/*---------------------------------------------------------------------------*/
+static int
+pending_packet(void)
+{
+  poll_medium();
+  return rx.valid && !RTIMER_CLOCK_LT(RTIMER_NOW(), rx.end);
+}
+/*---------------------------------------------------------------------------*/
+static int
+on(void)
+{
+  if(!radio_on) {
+    /* Frames sent while the radio was off are lost */
+    flush_medium();
+    rx.valid = false;
+    radio_on = true;
+  }
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+off(void)
+{
+  radio_on = false;
+  rx.valid = false;
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+static int
+soft_off(void)
+{
+  /* There is no power saving state to keep the radio warm in */
+  return off();
+}
+/*---------------------------------------------------------------------------*/
+static radio_result_t
+get_value(radio_param_t param, radio_value_t *value)
+{
+  if(value == NULL) {
+    return RADIO_RESULT_INVALID_VALUE;
+  }
+
+  switch(param) {
+  case RADIO_PARAM_POWER_MODE:
+    *value = radio_on ? RADIO_POWER_MODE_ON : RADIO_POWER_MODE_OFF;
+    return RADIO_RESULT_OK;
+  case RADIO_PARAM_CHANNEL:
+    *value = channel;
+    return RADIO_RESULT_OK;
+  case RADIO_PARAM_PAN_ID:
+    *value = pan_id;
+    return RADIO_RESULT_OK;
+  case RADIO_PARAM_16BIT_ADDR:
+    *value = short_addr;
+    return RADIO_RESULT_OK;
+  case RADIO_PARAM_RX_MODE:
+    *value = poll_mode ? RADIO_RX_MODE_POLL_MODE : 0;
+    return RADIO_RESULT_OK;
+  case RADIO_PARAM_TX_MODE:
+    *value = send_on_cca ? RADIO_TX_MODE_SEND_ON_CCA : 0;
+    return RADIO_RESULT_OK;
+  case RADIO_PARAM_TXPOWER:
+    *value = txpower;
+    return RADIO_RESULT_OK;
+  case RADIO_PARAM_CCA_THRESHOLD:
+    *value = cca_threshold;
+    return RADIO_RESULT_OK;
+  case RADIO_PARAM_RSSI:
+    *value = channel_clear() ? UDP_RADIO_NOISE_FLOOR : UDP_RADIO_RSSI;
+    return RADIO_RESULT_OK;
+  case RADIO_PARAM_LAST_RSSI:
+    *value = last_rssi;
+    return RADIO_RESULT_OK;
+  case RADIO_PARAM_LAST_LINK_QUALITY:
+    *value = last_lqi;
+    return RADIO_RESULT_OK;
+  case RADIO_CONST_CHANNEL_MIN:
+    *value = UDP_RADIO_CHANNEL_MIN;
+    return RADIO_RESULT_OK;
+  case RADIO_CONST_CHANNEL_MAX:
+    *value = UDP_RADIO_CHANNEL_MAX;
+    return RADIO_RESULT_OK;
+  case RADIO_CONST_TXPOWER_MIN:
+    *value = UDP_RADIO_TXPOWER_MIN;
+    return RADIO_RESULT_OK;
+  case RADIO_CONST_TXPOWER_MAX:
+    *value = UDP_RADIO_TXPOWER_MAX;
+    return RADIO_RESULT_OK;
+  case RADIO_CONST_MAX_PAYLOAD_LEN:
+    *value = UDP_RADIO_MAX_PAYLOAD_LEN;
+    return RADIO_RESULT_OK;
+  default:
+    return RADIO_RESULT_NOT_SUPPORTED;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static radio_result_t
+set_value(radio_param_t param, radio_value_t value)
+{
+  switch(param) {
+  case RADIO_PARAM_POWER_MODE:
+    if(value == RADIO_POWER_MODE_ON) {
+      on();
+    } else if(value == RADIO_POWER_MODE_OFF) {
+      off();
+    } else {
+      return RADIO_RESULT_INVALID_VALUE;
+    }
+    return RADIO_RESULT_OK;
+  case RADIO_PARAM_CHANNEL:
+    if(value < UDP_RADIO_CHANNEL_MIN || value > UDP_RADIO_CHANNEL_MAX) {
+      return RADIO_RESULT_INVALID_VALUE;
+    }
+    if(channel != value) {
+      /* A frame on the old channel is not received any further */
+      rx.valid = false;
+      channel = value;
+    }
+    return RADIO_RESULT_OK;
+  case RADIO_PARAM_PAN_ID:
+    pan_id = value & 0xFFFF;
+    return RADIO_RESULT_OK;
+  case RADIO_PARAM_16BIT_ADDR:
+    short_addr = value & 0xFFFF;
+    return RADIO_RESULT_OK;
+  case RADIO_PARAM_RX_MODE:
+    if(value & ~(RADIO_RX_MODE_ADDRESS_FILTER | RADIO_RX_MODE_AUTOACK |
+                 RADIO_RX_MODE_POLL_MODE)) {
+      return RADIO_RESULT_INVALID_VALUE;
+    }
+    /* Neither frame filtering nor auto-ACK is simulated */
+    poll_mode = (value & RADIO_RX_MODE_POLL_MODE) != 0;
+    return RADIO_RESULT_OK;
+  case RADIO_PARAM_TX_MODE:
+    if(value & ~RADIO_TX_MODE_SEND_ON_CCA) {
+      return RADIO_RESULT_INVALID_VALUE;
+    }
+    send_on_cca = (value & RADIO_TX_MODE_SEND_ON_CCA) != 0;
+    return RADIO_RESULT_OK;
+  case RADIO_PARAM_TXPOWER:
+    if(value < UDP_RADIO_TXPOWER_MIN || value > UDP_RADIO_TXPOWER_MAX) {
+      return RADIO_RESULT_INVALID_VALUE;
+    }
+    txpower = value;
+    return RADIO_RESULT_OK;
+  case RADIO_PARAM_CCA_THRESHOLD:
+    cca_threshold = value;
+    return RADIO_RESULT_OK;
+  default:
+    return RADIO_RESULT_NOT_SUPPORTED;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static radio_result_t
+get_object(radio_param_t param, void *dest, size_t size)
+{
+  if(dest == NULL) {
+    return RADIO_RESULT_INVALID_VALUE;
+  }
+
+  switch(param) {
+  case RADIO_PARAM_LAST_PACKET_TIMESTAMP:
+    if(size != sizeof(rtimer_clock_t)) {
+      return RADIO_RESULT_INVALID_VALUE;
+    }
+    *(rtimer_clock_t *)dest = last_timestamp;
+    return RADIO_RESULT_OK;
+  case RADIO_PARAM_64BIT_ADDR:
+    if(size != sizeof(ext_addr)) {
+      return RADIO_RESULT_INVALID_VALUE;
+    }
+    memcpy(dest, ext_addr, sizeof(ext_addr));
+    return RADIO_RESULT_OK;
+  default:
+    return RADIO_RESULT_NOT_SUPPORTED;
+  }
+}
+/*---------------------------------------------------------------------------*/
+static radio_result_t
+set_object(radio_param_t param, const void *src, size_t size)
+{
+  if(param == RADIO_PARAM_64BIT_ADDR && src != NULL &&
+     size == sizeof(ext_addr)) {
+    memcpy(ext_addr, src, sizeof(ext_addr));
+    return RADIO_RESULT_OK;
+  }
+  return RADIO_RESULT_NOT_SUPPORTED;
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(udp_radio_process, ev, data)
+{
+  int len;
+
+  PROCESS_BEGIN();
+
+  while(1) {
+    PROCESS_YIELD_UNTIL(ev == PROCESS_EVENT_POLL);
+
+    if(!poll_mode && pending_packet()) {
+      packetbuf_clear();
+      len = read_packet(packetbuf_dataptr(), PACKETBUF_SIZE);
+      if(len > 0) {
+        packetbuf_set_datalen(len);
+        NETSTACK_MAC.input();
+      }
+    }
+  }
+
+  PROCESS_END();
+}
+/*---------------------------------------------------------------------------*/
+const struct radio_driver udp_radio_driver = {
+  init,
+  prepare,
+  transmit,
+  send_packet,
+  read_packet,
+  channel_clear,
+  receiving_packet,
+  pending_packet,
+  on,
+  off,
+  soft_off,
+  get_value,
+  set_value,
+  get_object,
+  set_object
+};
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,71 @@
+/**
+ * @code
+ *  ___ _____ _   ___ _  _____ ___  ___  ___ ___
+ * / __|_   _/_\ / __| |/ / __/ _ \| _ \/ __| __|
+ * \__ \ | |/ _ \ (__| ' <| _| (_) |   / (__| _|
+ * |___/ |_/_/ \_\___|_|\_\_| \___/|_|_\\___|___|
+ * embedded.connectivity.solutions.==============
+ * @endcode
+ *
+ * @copyright  STACKFORCE GmbH, Germany, www.stackforce.de
+ * @author     STACKFORCE
+ * @brief      Simulated IEEE 802.15.4 radio of the native platform.
+ *
+ * All native nodes on a host share one UDP multicast group as the medium.
+ * Each datagram carries the channel and the SFD timestamp of the frame, so
+ * a receiver can model the air time, drop frames on other channels and
+ * detect collisions of overlapping frames.
+ */
+/*---------------------------------------------------------------------------*/
+#ifndef UDP_RADIO_H_
+#define UDP_RADIO_H_
+/*---------------------------------------------------------------------------*/
+#include "contiki.h"
+#include "dev/radio.h"
+/*---------------------------------------------------------------------------*/
+/* Multicast group used as the radio medium */
+#ifdef UDP_RADIO_CONF_GROUP
+#define UDP_RADIO_GROUP   UDP_RADIO_CONF_GROUP
+#else
+#define UDP_RADIO_GROUP   "239.255.21.54"
+#endif
+
+/* UDP port of the radio medium */
+#ifdef UDP_RADIO_CONF_PORT
+#define UDP_RADIO_PORT    UDP_RADIO_CONF_PORT
+#else
+#define UDP_RADIO_PORT    15454
+#endif
+
+/* RSSI reported for every received frame */
+#ifdef UDP_RADIO_CONF_RSSI
+#define UDP_RADIO_RSSI    UDP_RADIO_CONF_RSSI
+#else
+#define UDP_RADIO_RSSI    (-50)
+#endif
+/*---------------------------------------------------------------------------*/
+extern const struct radio_driver udp_radio_driver;
+/*---------------------------------------------------------------------------*/
+/**
+ * \brief Set the medium before the radio is initialised.
+ * \param group Multicast group, NULL to keep UDP_RADIO_GROUP
+ * \param port  UDP port, 0 to keep UDP_RADIO_PORT
+ */
+void udp_radio_set_medium(const char *group, uint16_t port);
+
+/**
+ * \brief  Socket of the medium, to wait for frames in the main loop.
+ * \return The file descriptor or -1 if the radio is not initialised.
+ */
+int udp_radio_fd(void);
+
+/**
+ * \brief Fetch the frames received by the host.
+ *
+ * Called by the main loop when udp_radio_fd() is readable. In non-poll mode
+ * a complete frame is handed to the MAC layer.
+ */
+void udp_radio_poll(void);
+/*---------------------------------------------------------------------------*/
+#endif /* UDP_RADIO_H_ */
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,253 @@
+/**
+ * @code
+ *  ___ _____ _   ___ _  _____ ___  ___  ___ ___
+ * / __|_   _/_\ / __| |/ / __/ _ \| _ \/ __| __|
+ * \__ \ | |/ _ \ (__| ' <| _| (_) |   / (__| _|
+ * |___/ |_/_/ \_\___|_|\_\_| \___/|_|_\\___|___|
+ * embedded.connectivity.solutions.==============
+ * @endcode
+ *
+ * @copyright  STACKFORCE GmbH, Germany, www.stackforce.de
+ * @author     STACKFORCE
+ * @brief      Native (Linux host) platform.
+ *
+ * Usage: <app>.native [--node-id ID] [--flash FILE] [--group ADDR]
+ *                     [--port PORT]
+ *
+ * The node ID gives the link address. SIGUSR1 presses and SIGUSR2
+ * releases the user button, e.g. to open the manual join window.
+ */
+/*---------------------------------------------------------------------------*/
+#include "contiki.h"
+#include "sys/clock.h"
+#include "sys/rtimer.h"
+#include "sys/etimer.h"
+#include "sys/node-id.h"
+#include "sys/platform.h"
+#include "dev/button-hal.h"
+#include "dev/gpio-hal.h"
+#include "dev/leds.h"
+#include "dev/watchdog.h"
+#include "sys/int-master.h"
+#include "net/linkaddr.h"
+#include "net/netstack.h"
+#include "net/mac/framer/frame802154.h"
+#include "lib/random.h"
+/*---------------------------------------------------------------------------*/
+#include "dev/udp-radio.h"
+/*---------------------------------------------------------------------------*/
+#include <getopt.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/select.h>
+/*---------------------------------------------------------------------------*/
+/* Log configuration */
+#include "sys/log.h"
+#define LOG_MODULE "Native"
+#define LOG_LEVEL LOG_LEVEL_MAIN
+/*---------------------------------------------------------------------------*/
+#ifndef NATIVE_CONF_DEFAULT_NODE_ID
+#define NATIVE_DEFAULT_NODE_ID    0xCC00
+#else
+#define NATIVE_DEFAULT_NODE_ID    NATIVE_CONF_DEFAULT_NODE_ID
+#endif
+
+/*---------------------------------------------------------------------------*/
+static uint16_t native_node_id = NATIVE_DEFAULT_NODE_ID;
+static volatile sig_atomic_t button_request = -1;
+/*---------------------------------------------------------------------------*/
+static void
+usage(const char *prog)
+{
+  fprintf(stderr,
+          "Usage: %s [--node-id ID] [--flash FILE] [--group ADDR] [--port PORT]\n",
+          prog);
+}
+/*---------------------------------------------------------------------------*/
+static void
+button_signal(int sig)
+{
+  /* The button is low-active */
+  button_request = (sig == SIGUSR1) ? 0 : 1;
+}
+/*---------------------------------------------------------------------------*/
+void
+platform_process_args(int argc, char **argv)
+{
+  static const struct option options[] = {
+    { "node-id", required_argument, NULL, 'n' },
+    { "flash", required_argument, NULL, 'f' },
+    { "group", required_argument, NULL, 'g' },
+    { "port", required_argument, NULL, 'p' },
+    { "help", no_argument, NULL, 'h' },
+    { NULL, 0, NULL, 0 }
+  };
+  int opt;
+
+  while((opt = getopt_long(argc, argv, "n:f:g:p:h", options, NULL)) != -1) {
+    switch(opt) {
+    case 'n':
+      native_node_id = (uint16_t)strtoul(optarg, NULL, 0);
+      break;
+    case 'f':
+      /* Picked up by the flash interface on first access */
+      setenv("FLASH_INTERFACE_NATIVE_FILE", optarg, 1);
+      break;
+    case 'g':
+      udp_radio_set_medium(optarg, 0);
+      break;
+    case 'p':
+      udp_radio_set_medium(NULL, (uint16_t)strtoul(optarg, NULL, 0));
+      break;
+    default:
+      usage(argv[0]);
+      exit(opt == 'h' ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+set_rf_params(void)
+{
+  uint8_t ext_addr[8];
+  uint16_t short_addr;
+
+  memset(ext_addr, 0x0, sizeof(ext_addr));
+  ext_addr[6] = native_node_id >> 8;
+  ext_addr[7] = native_node_id & 0xFF;
+  short_addr = native_node_id;
+
+  NETSTACK_RADIO.set_value(RADIO_PARAM_PAN_ID, IEEE802154_PANID);
+  NETSTACK_RADIO.set_value(RADIO_PARAM_16BIT_ADDR, short_addr);
+  NETSTACK_RADIO.set_object(RADIO_PARAM_64BIT_ADDR, ext_addr, sizeof(ext_addr));
+}
+/*---------------------------------------------------------------------------*/
+void
+platform_init_stage_one(void)
+{
+  struct sigaction sa;
+
+  /* Keep the log order when stdout is redirected */
+  setvbuf(stdout, NULL, _IOLBF, 0);
+
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = button_signal;
+  sigaction(SIGUSR1, &sa, NULL);
+  sigaction(SIGUSR2, &sa, NULL);
+
+  gpio_hal_init();
+  leds_init();
+}
+/*---------------------------------------------------------------------------*/
+void
+platform_init_stage_two(void)
+{
+  random_init((unsigned short)(native_node_id ^ getpid()));
+
+  /* Populate linkaddr_node_addr, the node ID is in the last two bytes */
+  memset(&linkaddr_node_addr, 0, sizeof(linkaddr_node_addr));
+  linkaddr_node_addr.u8[LINKADDR_SIZE - 2] = native_node_id >> 8;
+  linkaddr_node_addr.u8[LINKADDR_SIZE - 1] = native_node_id & 0xFF;
+
+  button_hal_init();
+}
+/*---------------------------------------------------------------------------*/
+void
+platform_init_stage_three(void)
+{
+  radio_value_t chan = 0;
+
+  set_rf_params();
+
+  NETSTACK_RADIO.get_value(RADIO_PARAM_CHANNEL, &chan);
+  LOG_INFO("RF: Channel %d, PANID 0x%04X\n", chan, IEEE802154_PANID);
+  LOG_INFO("Node ID: %d, PID %d\n", node_id, (int)getpid());
+}
+/*---------------------------------------------------------------------------*/
+static void
+handle_button_request(void)
+{
+  int level = button_request;
+
+  if(level >= 0) {
+    button_request = -1;
+    gpio_hal_arch_native_drive_pin(NATIVE_PIN_USER_BUTTON, level);
+  }
+}
+/*---------------------------------------------------------------------------*/
+static void
+wait_for_event(void)
+{
+  struct timespec ts;
+  sigset_t block;
+  sigset_t old;
+  fd_set fds;
+  int fd = udp_radio_fd();
+  clock_time_t now;
+  clock_time_t next;
+  bool sleep = true;
+  bool timeout = false;
+
+  /* Signals only wake up the pselect() below, not the checks before it */
+  sigemptyset(&block);
+  sigaddset(&block, SIGALRM);
+  sigaddset(&block, SIGUSR1);
+  sigaddset(&block, SIGUSR2);
+  sigprocmask(SIG_BLOCK, &block, &old);
+
+  if(process_nevents() > 0 || button_request >= 0) {
+    sleep = false;
+  } else if(etimer_pending()) {
+    now = clock_time();
+    next = etimer_next_expiration_time();
+    if(now >= next) {
+      etimer_request_poll();
+      sleep = false;
+    } else {
+      ts.tv_sec = (next - now) / CLOCK_SECOND;
+      ts.tv_nsec = ((next - now) % CLOCK_SECOND) * (1000000000L / CLOCK_SECOND);
+      timeout = true;
+    }
+  }
+
+  if(sleep) {
+    FD_ZERO(&fds);
+    if(fd >= 0) {
+      FD_SET(fd, &fds);
+    }
+    pselect(fd + 1, &fds, NULL, NULL, timeout ? &ts : NULL, &old);
+  }
+
+  sigprocmask(SIG_SETMASK, &old, NULL);
+}
+/*---------------------------------------------------------------------------*/
+void
+platform_main_loop(void)
+{
+  int_master_status_t status;
+
+  while(1) {
+    handle_button_request();
+
+    /* The rtimer interrupt uses the same radio state */
+    status = int_master_read_and_disable();
+    udp_radio_poll();
+    int_master_status_set(status);
+
+    while(process_run() > 0);
+    watchdog_periodic();
+
+    wait_for_event();
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+platform_idle(void)
+{
+  /* Not used, the main loop is provided by the platform */
+}
+/*---------------------------------------------------------------------------*/
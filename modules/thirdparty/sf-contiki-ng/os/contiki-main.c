@@ -104,6 +104,10 @@ main(void)
 
   energest_init();
 
+#if LOG_BINARY
+  log_bin_init();
+#endif /* LOG_BINARY */
+
 #if STACK_CHECK_ENABLED
   stack_check_init();
 #endif
@@ -499,6 +499,53 @@ frame802154_parse_fcf(uint8_t *data, frame802154_fcf_t *pfcf)
   memcpy(pfcf, &fcf, sizeof(frame802154_fcf_t));
 }
 /*----------------------------------------------------------------------------*/
+/* FCF bits that select the layout of frame802154_parse_fast() */
+#define FAST_PARSE_FCF0_MASK  0x48 /* security, PAN ID compression */
+#define FAST_PARSE_FCF0       0x40
+#define FAST_PARSE_FCF1_MASK  0xcd /* seqno suppression, address modes */
+#define FAST_PARSE_FCF1       ((FRAME802154_SHORTADDRMODE << 6) | \
+                               (FRAME802154_SHORTADDRMODE << 2))
+/* FCF, seqno, destination PAN ID, destination and source address */
+#define FAST_PARSE_HDR_LEN    9
+/**
+ *   \brief Parses an input frame of the layout used for data frames:
+ *   sequence number, short destination and source addresses, compressed
+ *   PAN ID and no security. The result is the same as the one of
+ *   frame802154_parse(), without the generic field length computation.
+ *
+ *   \param data The input data from the radio chip.
+ *   \param len The size of the input data
+ *   \param pf The frame802154_t struct to store the parsed frame information.
+ *   \return The header length, 0 if the frame has another layout
+ */
+int
+frame802154_parse_fast(uint8_t *data, int len, frame802154_t *pf)
+{
+  if(len < FAST_PARSE_HDR_LEN
+     || (data[0] & FAST_PARSE_FCF0_MASK) != FAST_PARSE_FCF0
+     || (data[1] & FAST_PARSE_FCF1_MASK) != FAST_PARSE_FCF1
+     || (data[0] & 7) == FRAME802154_ACKFRAME) {
+    return 0;
+  }
+
+  frame802154_parse_fcf(data, &pf->fcf);
+  pf->seq = data[2];
+  /* The source PAN ID is compressed in all frame versions */
+  pf->dest_pid = data[3] + (data[4] << 8);
+  pf->src_pid = pf->dest_pid;
+  linkaddr_copy((linkaddr_t *)&(pf->dest_addr), &linkaddr_null);
+  pf->dest_addr[0] = data[6];
+  pf->dest_addr[1] = data[5];
+  linkaddr_copy((linkaddr_t *)&(pf->src_addr), &linkaddr_null);
+  pf->src_addr[0] = data[8];
+  pf->src_addr[1] = data[7];
+
+  pf->payload_len = len - FAST_PARSE_HDR_LEN;
+  pf->payload = data + FAST_PARSE_HDR_LEN;
+
+  return FAST_PARSE_HDR_LEN;
+}
+/*----------------------------------------------------------------------------*/
 /**
  *   \brief Parses an input frame.  Scans the input frame to find each
  *   section, and stores the information of each section in a
@@ -520,6 +567,13 @@ frame802154_parse(uint8_t *data, int len, frame802154_t *pf)
   uint8_t key_id_mode;
 #endif /* LLSEC802154_USES_AUX_HEADER && LLSEC802154_USES_EXPLICIT_KEYS */
 
+#if FRAME802154_FAST_PARSE
+  c = frame802154_parse_fast(data, len, pf);
+  if(c > 0) {
+    return c;
+  }
+#endif /* FRAME802154_FAST_PARSE */
+
   if(len < 2) {
     return 0;
   }
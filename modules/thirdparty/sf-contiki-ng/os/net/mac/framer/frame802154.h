@@ -92,6 +92,13 @@ frame-filtering-friendly on some platforms) */
 #define FRAME802154_SUPPR_SEQNO 0
 #endif /* FRAME802154_CONF_SUPPR_SEQNO */
 
+/* Let frame802154_parse() try frame802154_parse_fast() first */
+#ifdef FRAME802154_CONF_FAST_PARSE
+#define FRAME802154_FAST_PARSE FRAME802154_CONF_FAST_PARSE
+#else /* FRAME802154_CONF_FAST_PARSE */
+#define FRAME802154_FAST_PARSE 1
+#endif /* FRAME802154_CONF_FAST_PARSE */
+
 /* Macros & Defines */
 
 /** \brief These are some definitions of values used in the FCF.  See the 802.15.4 spec for details.
@@ -221,6 +228,9 @@ int frame802154_hdrlen(frame802154_t *p);
 void frame802154_create_fcf(frame802154_fcf_t *fcf, uint8_t *buf);
 int frame802154_create(frame802154_t *p, uint8_t *buf);
 int frame802154_parse(uint8_t *data, int length, frame802154_t *pf);
+/* Parse a frame with sequence number, short addresses, compressed PAN ID
+ * and no security. Returns 0 if the frame has another layout */
+int frame802154_parse_fast(uint8_t *data, int length, frame802154_t *pf);
 void frame802154_parse_fcf(uint8_t *data, frame802154_fcf_t *pfcf);
 
 /* Get current PAN ID */
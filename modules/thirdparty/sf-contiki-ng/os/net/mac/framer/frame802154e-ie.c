@@ -81,6 +81,7 @@ enum ieee802154e_mlme_short_subie_id {
 enum ieee802154e_mlme_long_subie_id {
   MLME_LONG_IE_TSCH_CHANNEL_HOPPING_SEQUENCE = 0x9,
   MLME_LONG_IE_TSCH_ABSOLUTE_TIME_AND_JOIN_MODE,
+  MLME_LONG_IE_TSCH_SCHEDULE_DESC,
 };
 
 #include <net/mac/tsch/sixtop/sixtop.h>
@@ -367,6 +368,26 @@ int frame80215e_create_ie_tsch_absolute_time_and_join_mode(uint8_t *buf, int len
   return 2 + ie_len;
 }
 
+/* MLME sub-IE. Schedule descriptor: version, slotframe size, number of data
+ * slots and activation ASN. Used in EBs */
+int frame80215e_create_ie_tsch_schedule_desc(uint8_t *buf, int len,
+    struct ieee802154_ies *ies)
+{
+  int ie_len;
+  if((ies == NULL) || (len < 12)) {
+    return -1;
+  }
+
+  ie_len = 10;
+  buf[2] = ies->ie_schedule_desc.version;
+  WRITE16(buf + 3, ies->ie_schedule_desc.slotframe_size);
+  WRITE16(buf + 5, ies->ie_schedule_desc.data_slots);
+  WRITE32(buf + 7, ies->ie_schedule_desc.activation_asn.ls4b);
+  buf[11] = ies->ie_schedule_desc.activation_asn.ms1b;
+  create_mlme_long_ie_descriptor(buf, MLME_LONG_IE_TSCH_SCHEDULE_DESC, ie_len);
+  return 2 + ie_len;
+}
+
 
 /* Parse a header IE */
 static int
@@ -501,6 +522,19 @@ frame802154e_parse_mlme_long_ie(const uint8_t *buf, int len,
           return len;
         }
         break;
+
+    case MLME_LONG_IE_TSCH_SCHEDULE_DESC:
+        if(len == 10) {
+          if(ies != NULL) {
+            ies->ie_schedule_desc.version = buf[0];
+            READ16(buf+1, ies->ie_schedule_desc.slotframe_size);
+            READ16(buf+3, ies->ie_schedule_desc.data_slots);
+            READ32(buf+5, ies->ie_schedule_desc.activation_asn.ls4b);
+            ies->ie_schedule_desc.activation_asn.ms1b = buf[9];
+          }
+          return len;
+        }
+        break;
   }
   return -1;
 }
@@ -90,6 +90,8 @@ struct ieee802154_ies {
   uint32_t ie_absolute_time;
   /* Join mode */
   uint32_t ie_join_mode;
+  /* Schedule descriptor, version 0 if not present */
+  struct tsch_schedule_desc ie_schedule_desc;
 #if TSCH_WITH_SIXTOP
   /* Payload Sixtop IE */
   const uint8_t *sixtop_ie_content_ptr;
@@ -137,6 +139,10 @@ int frame80215e_create_ie_tsch_channel_hopping_sequence(uint8_t *buf, int len,
 int frame80215e_create_ie_tsch_absolute_time_and_join_mode(uint8_t *buf, int len,
     struct ieee802154_ies *ies);
 
+/* MLME sub-IE. TSCH schedule descriptor. Used in EBs */
+int frame80215e_create_ie_tsch_schedule_desc(uint8_t *buf, int len,
+    struct ieee802154_ies *ies);
+
 /* Parse all Information Elements of a frame */
 int frame802154e_parse_information_elements(const uint8_t *buf, uint8_t buf_size,
     struct ieee802154_ies *ies);
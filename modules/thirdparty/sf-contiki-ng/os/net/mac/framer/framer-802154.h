@@ -47,6 +47,11 @@ void framer_802154_setup_params(packetbuf_attr_t (*get_attr)(uint8_t type),
                                 uint8_t dest_is_broadcast,
                                 frame802154_t *params);
 
+/* Apply a frame that has been parsed with frame802154_parse() to the
+ * packetbuf: remove the header and set the addresses and attributes.
+ * Returns the header length or FRAMER_FAILED */
+int framer_802154_parse_frame(frame802154_t *frame, int hdr_len);
+
 extern const struct framer framer_802154;
 
 #endif /* FRAMER_802154_H_ */
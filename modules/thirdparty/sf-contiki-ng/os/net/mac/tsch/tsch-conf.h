@@ -263,6 +263,15 @@
 #define TSCH_PACKET_EB_WITH_SLOTFRAME_AND_LINK 0
 #endif
 
+/* TSCH EB: include the schedule descriptor Information Element? The
+ * descriptor (version, slotframe size, activation ASN) is set by the upper
+ * layer with tsch_set_schedule_desc() and announces schedule changes. */
+#ifdef TSCH_PACKET_CONF_EB_WITH_SCHEDULE_DESC
+#define TSCH_PACKET_EB_WITH_SCHEDULE_DESC TSCH_PACKET_CONF_EB_WITH_SCHEDULE_DESC
+#else
+#define TSCH_PACKET_EB_WITH_SCHEDULE_DESC 0
+#endif
+
 /******** Configuration: queues  *******/
 
 /* Size of the ring buffer storing dequeued outgoing packets (only an array of pointers).
@@ -297,6 +306,15 @@
 #define TSCH_MAX_INCOMING_PACKETS 4
 #endif
 
+/* Pass incoming data frames to the upper layers without copying them to
+ * the packetbuf. The packetbuf references the incoming packet slot, which
+ * is released once the upper layers returned */
+#ifdef TSCH_CONF_RX_ZERO_COPY
+#define TSCH_RX_ZERO_COPY TSCH_CONF_RX_ZERO_COPY
+#else
+#define TSCH_RX_ZERO_COPY 0
+#endif
+
 /* The maximum number of outgoing packets towards each neighbor
  * Must be power of two to enable atomic ringbuf operations.
  * Note: the total number of outgoing packets in the system (for
@@ -370,6 +388,59 @@
 #define TSCH_SCHEDULE_MAX_LINKS 32
 #endif
 
+/* Keep a per-slotframe timeslot index (occupancy bitmap plus a table of
+ * links per timeslot), so that tsch_schedule_get_next_active_link() does not
+ * walk all links on every timeslot. Costs one bit and one link index per
+ * timeslot of TSCH_SCHEDULE_SLOT_INDEX_MAX_LENGTH, for each slotframe. */
+#ifdef TSCH_SCHEDULE_CONF_WITH_SLOT_INDEX
+#define TSCH_SCHEDULE_WITH_SLOT_INDEX TSCH_SCHEDULE_CONF_WITH_SLOT_INDEX
+#else
+#define TSCH_SCHEDULE_WITH_SLOT_INDEX 0
+#endif
+
+/* Let slotframes be active only within an ASN window, see
+ * tsch_schedule_set_slotframe_window(). Used to replace a slotframe by one
+ * of a different size at an ASN known to all nodes. */
+#ifdef TSCH_SCHEDULE_CONF_WITH_ACTIVATION
+#define TSCH_SCHEDULE_WITH_ACTIVATION TSCH_SCHEDULE_CONF_WITH_ACTIVATION
+#else
+#define TSCH_SCHEDULE_WITH_ACTIVATION 0
+#endif
+
+/* Let slotframes hold a table of links in flash besides the links of the
+ * link pool, see tsch_schedule_set_static_links(). The links of the table
+ * are switched on and off with one bit each. Needs the timeslot index. */
+#ifdef TSCH_SCHEDULE_CONF_WITH_STATIC_LINKS
+#define TSCH_SCHEDULE_WITH_STATIC_LINKS TSCH_SCHEDULE_CONF_WITH_STATIC_LINKS
+#else
+#define TSCH_SCHEDULE_WITH_STATIC_LINKS 0
+#endif
+
+/* Largest slotframe size supported by the timeslot index. Slotframes with
+ * more timeslots are rejected by tsch_schedule_add_slotframe() */
+#ifdef TSCH_SCHEDULE_CONF_SLOT_INDEX_MAX_LENGTH
+#define TSCH_SCHEDULE_SLOT_INDEX_MAX_LENGTH TSCH_SCHEDULE_CONF_SLOT_INDEX_MAX_LENGTH
+#else
+#define TSCH_SCHEDULE_SLOT_INDEX_MAX_LENGTH TSCH_SCHEDULE_DEFAULT_LENGTH
+#endif
+
+/* Record the timing of each slot operation (slot start, Tx/Rx start, ACK,
+ * slot end) and aggregate it per link type, see tsch_slot_timing_get().
+ * Costs a few rtimer reads per slot. */
+#ifdef TSCH_CONF_WITH_SLOT_TIMING
+#define TSCH_WITH_SLOT_TIMING TSCH_CONF_WITH_SLOT_TIMING
+#else
+#define TSCH_WITH_SLOT_TIMING 0
+#endif
+
+/* Number of bins of the slot duration histogram. The bins split the timeslot
+ * length, the last bin counts slots running past the timeslot length. */
+#ifdef TSCH_CONF_SLOT_TIMING_HIST_BINS
+#define TSCH_SLOT_TIMING_HIST_BINS TSCH_CONF_SLOT_TIMING_HIST_BINS
+#else
+#define TSCH_SLOT_TIMING_HIST_BINS 8
+#endif
+
 /* To include Sixtop Implementation */
 #ifdef TSCH_CONF_WITH_SIXTOP
 #define TSCH_WITH_SIXTOP TSCH_CONF_WITH_SIXTOP
@@ -385,6 +456,16 @@
 #define TSCH_WITH_LINK_SELECTOR (BUILD_WITH_ORCHESTRA)
 #endif /* TSCH_CONF_WITH_LINK_SELECTOR */
 
+/* Replace a packet that is queued for the same neighbor with the same
+ * non-zero PACKETBUF_ATTR_TSCH_COALESCE_KEY and has not been transmitted
+ * yet, instead of queuing another packet. The callback of the replaced
+ * packet is not called. Disabled by default */
+#ifdef TSCH_CONF_WITH_QUEUE_COALESCING
+#define TSCH_WITH_QUEUE_COALESCING TSCH_CONF_WITH_QUEUE_COALESCING
+#else /* TSCH_CONF_WITH_QUEUE_COALESCING */
+#define TSCH_WITH_QUEUE_COALESCING 0
+#endif /* TSCH_CONF_WITH_QUEUE_COALESCING */
+
 /* Configurable link comparator in case multiple links are scheduled at the same slot */
 #ifdef TSCH_CONF_LINK_COMPARATOR
 #define TSCH_LINK_COMPARATOR TSCH_CONF_LINK_COMPARATOR
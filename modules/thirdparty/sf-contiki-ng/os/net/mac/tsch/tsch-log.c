@@ -47,12 +47,24 @@
 
 #include "contiki.h"
 #include <stdio.h>
+#include <string.h>
 #include "net/mac/tsch/tsch.h"
 #include "lib/ringbufindex.h"
 #include "sys/log.h"
 
 #if TSCH_LOG_PER_SLOT
 
+/* Per-slot logs are enabled with TSCH_LOG_PER_SLOT, not by the log level */
+#define LOG_LEVEL LOG_LEVEL_INFO
+
+/* Binary log records, see LOG_CONF_BINARY */
+enum {
+  LOG_ID_TSCH_DROPPED = 0x0101, /*! "logs dropped %u" */
+  LOG_ID_TSCH_TX = 0x0102, /*! "{asn %02x.%08lx link %2u %3u %3u %2u %2u ch %2u} %{bc|uc}-%u-%u tx %A->%A, len %3u, seq %3u, st %d (%d/%d) (%d/%d) %2d, dr %3d" */
+  LOG_ID_TSCH_RX = 0x0103, /*! "{asn %02x.%08lx link %2u %3u %3u %2u %2u ch %2u} %{bc|uc}-%u-%u rx %A->%A, app ack %2u, len %3u, seq %3u, edr %3d, dr %3d" */
+  LOG_ID_TSCH_MESSAGE = 0x0104, /*! "{asn %02x.%08lx link %2u %3u %3u %2u %2u ch %2u} %S" */
+};
+
 PROCESS_NAME(tsch_pending_events_process);
 
 /* Check if TSCH_LOG_QUEUE_LEN is a power of two */
@@ -64,6 +76,57 @@ static struct tsch_log_t log_array[TSCH_LOG_QUEUE_LEN];
 static int log_dropped = 0;
 static int log_active = 0;
 
+/*---------------------------------------------------------------------------*/
+#if LOG_BINARY
+/* Add a pending log message to the binary log */
+static void
+tsch_log_bin(const struct tsch_log_t *log)
+{
+  struct tsch_slotframe *sf = NULL;
+  uint32_t slot[8] = { log->asn.ms1b, log->asn.ls4b };
+
+  if(log->link != NULL) {
+    sf = tsch_schedule_get_slotframe_by_handle(log->link->slotframe_handle);
+    slot[2] = log->link->slotframe_handle;
+    slot[3] = sf ? sf->size.val : 0;
+    slot[4] = log->burst_count;
+    slot[5] = log->link->timeslot + log->burst_count;
+    slot[6] = log->channel_offset;
+    slot[7] = log->channel;
+  }
+
+  switch(log->type) {
+    case tsch_log_tx:
+      LOG_BIN_INFO(LOG_ID_TSCH_TX, slot[0], slot[1], slot[2], slot[3],
+                   slot[4], slot[5], slot[6], slot[7],
+                   !linkaddr_cmp(&log->tx.dest, &linkaddr_null),
+                   log->tx.is_data, log->tx.sec_level,
+                   LOG_BIN_LLADDR(&linkaddr_node_addr),
+                   LOG_BIN_LLADDR(&log->tx.dest),
+                   log->tx.datalen, log->tx.seqno, log->tx.mac_tx_status,
+                   log->tx.radio_prop_err, log->tx.radio_sched_err,
+                   log->tx.pendingTxCounter, log->tx.pendingTxCounterReset,
+                   log->tx.num_tx, log->tx.drift_used ? log->tx.drift : 0);
+      break;
+    case tsch_log_rx:
+      LOG_BIN_INFO(LOG_ID_TSCH_RX, slot[0], slot[1], slot[2], slot[3],
+                   slot[4], slot[5], slot[6], slot[7],
+                   log->rx.is_unicast != 0, log->rx.is_data,
+                   log->rx.sec_level, LOG_BIN_LLADDR(&log->rx.src),
+                   log->rx.is_unicast ? LOG_BIN_LLADDR(&linkaddr_node_addr) : 0,
+                   log->rx.ack_data, log->rx.datalen, log->rx.seqno,
+                   log->rx.estimated_drift,
+                   log->rx.drift_used ? log->rx.drift : 0);
+      break;
+    case tsch_log_message:
+      LOG_BIN_INFO_BYTES(LOG_ID_TSCH_MESSAGE, log->message,
+                         strnlen(log->message, sizeof(log->message)),
+                         slot[0], slot[1], slot[2], slot[3],
+                         slot[4], slot[5], slot[6], slot[7]);
+      break;
+  }
+}
+#endif /* LOG_BINARY */
 /*---------------------------------------------------------------------------*/
 /* Process pending log messages */
 void
@@ -73,11 +136,17 @@ tsch_log_process_pending(void)
   int16_t log_index;
   /* Loop on accessing (without removing) a pending input packet */
   if(log_dropped != last_log_dropped) {
-    printf("[WARN: TSCH-LOG  ] logs dropped %u\n", log_dropped);
+    LOG_BIN_OR_TEXT(LOG_BIN_WARN(LOG_ID_TSCH_DROPPED, log_dropped),
+                    printf("[WARN: TSCH-LOG  ] logs dropped %u\n", log_dropped));
     last_log_dropped = log_dropped;
   }
   while((log_index = ringbufindex_peek_get(&log_ringbuf)) != -1) {
     struct tsch_log_t *log = &log_array[log_index];
+#if LOG_BINARY
+    tsch_log_bin(log);
+    ringbufindex_get(&log_ringbuf);
+    continue;
+#endif /* LOG_BINARY */
     if(log->link == NULL) {
       printf("[INFO: TSCH-LOG  ] {asn %02x.%08lx link-NULL} ", log->asn.ms1b, log->asn.ls4b);
     } else {
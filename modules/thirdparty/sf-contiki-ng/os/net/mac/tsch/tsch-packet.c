@@ -311,6 +311,19 @@ tsch_packet_create_eb(uint8_t *hdr_len, uint8_t *tsch_sync_ie_offset)
   p += ie_len;
   packetbuf_set_datalen(packetbuf_datalen() + ie_len);
 
+#if TSCH_PACKET_EB_WITH_SCHEDULE_DESC
+  /* Placed after the absolute time, updated by tsch_packet_update_eb() */
+  ies.ie_schedule_desc = *tsch_get_schedule_desc();
+  ie_len = frame80215e_create_ie_tsch_schedule_desc(p,
+                                                    packetbuf_remaininglen(),
+                                                    &ies);
+  if(ie_len < 0) {
+    return -1;
+  }
+  p += ie_len;
+  packetbuf_set_datalen(packetbuf_datalen() + ie_len);
+#endif /* TSCH_PACKET_EB_WITH_SCHEDULE_DESC */
+
 #if 0
   ie_len = frame80215e_create_ie_tsch_timeslot(p,
                                                packetbuf_remaininglen(),
@@ -421,6 +434,14 @@ tsch_packet_update_eb(uint8_t *buf, int buf_size, uint8_t tsch_sync_ie_offset)
   if( frame80215e_create_ie_tsch_synchronization(buf+tsch_sync_ie_offset, buf_size-tsch_sync_ie_offset, &ies) == -1 )
       return 0;
 
+#if TSCH_PACKET_EB_WITH_SCHEDULE_DESC
+  /* Get current schedule descriptor */
+  ies.ie_schedule_desc = *tsch_get_schedule_desc();
+
+  if( frame80215e_create_ie_tsch_schedule_desc(buf+tsch_sync_ie_offset + 15, buf_size-(tsch_sync_ie_offset+15), &ies) == -1 )
+      return 0;
+#endif /* TSCH_PACKET_EB_WITH_SCHEDULE_DESC */
+
   return frame80215e_create_ie_tsch_absolute_time_and_join_mode(buf+tsch_sync_ie_offset + 8, buf_size-(tsch_sync_ie_offset+8), &ies) != -1;
 }
 /*---------------------------------------------------------------------------*/
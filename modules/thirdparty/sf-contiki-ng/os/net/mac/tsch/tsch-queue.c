@@ -224,6 +224,45 @@ tsch_queue_remove_nbr(struct tsch_neighbor *n)
   }
 }
 /*---------------------------------------------------------------------------*/
+#if TSCH_WITH_QUEUE_COALESCING
+/* Replace a queued packet of the neighbor with the same coalescing key by
+ * the packetbuf. Only packets that have not been transmitted yet are
+ * replaced. Returns the replaced packet, NULL if there is none */
+static struct tsch_packet *
+tsch_queue_coalesce_packet(struct tsch_neighbor *n, uint8_t max_transmissions,
+                           mac_callback_t sent, void *ptr)
+{
+  packetbuf_attr_t key = packetbuf_attr(PACKETBUF_ATTR_TSCH_COALESCE_KEY);
+  struct tsch_packet *p = NULL;
+  int elements;
+  int i;
+
+  if(key == 0 || n == NULL || !tsch_get_lock()) {
+    return NULL;
+  }
+  /* With the lock held, no packet is in transmission */
+  elements = ringbufindex_elements(&n->tx_ringbuf);
+  for(i = 0; i < elements; i++) {
+    p = n->tx_array[(n->tx_ringbuf.get_ptr + i) & n->tx_ringbuf.mask];
+    if(p->transmissions == 0
+       && queuebuf_attr(p->qb, PACKETBUF_ATTR_TSCH_COALESCE_KEY) == key) {
+      queuebuf_update_from_packetbuf(p->qb);
+      p->sent = sent;
+      p->ptr = ptr;
+      p->max_transmissions = max_transmissions;
+      break;
+    }
+    p = NULL;
+  }
+  tsch_release_lock();
+
+  if(p != NULL) {
+    LOG_DBG("packet %p replaced by a packet with coalescing key %u\n", p, key);
+  }
+  return p;
+}
+#endif /* TSCH_WITH_QUEUE_COALESCING */
+/*---------------------------------------------------------------------------*/
 /* Add packet to neighbor queue. Use same lockfree implementation as ringbuf.c (put is atomic) */
 struct tsch_packet *
 tsch_queue_add_packet(const linkaddr_t *addr, uint8_t max_transmissions,
@@ -244,6 +283,12 @@ tsch_queue_add_packet(const linkaddr_t *addr, uint8_t max_transmissions,
 
   if(!tsch_is_locked()) {
     n = tsch_queue_add_nbr(addr);
+#if TSCH_WITH_QUEUE_COALESCING
+    p = tsch_queue_coalesce_packet(n, max_transmissions, sent, ptr);
+    if(p != NULL) {
+      return p;
+    }
+#endif /* TSCH_WITH_QUEUE_COALESCING */
     if(n != NULL) {
       put_index = ringbufindex_peek_put(&n->tx_ringbuf);
       if(put_index != -1) {
@@ -79,6 +79,159 @@ MEMB(slotframe_memb, struct tsch_slotframe, TSCH_SCHEDULE_MAX_SLOTFRAMES);
 /* List of slotframes (each slotframe holds its own list of links) */
 LIST(slotframe_list);
 
+#if TSCH_SCHEDULE_WITH_STATIC_LINKS && !TSCH_SCHEDULE_WITH_SLOT_INDEX
+#error "TSCH_SCHEDULE_WITH_STATIC_LINKS needs TSCH_SCHEDULE_WITH_SLOT_INDEX"
+#endif
+
+#if TSCH_SCHEDULE_WITH_SLOT_INDEX
+/* The timeslot index refers to links by their position in link_memb */
+#define SLOT_INDEX_LINK(i) (&((struct tsch_link *)link_memb.mem)[(i)])
+#define SLOT_INDEX_OF(l) ((tsch_link_index_t)((l) - (struct tsch_link *)link_memb.mem))
+#if TSCH_SCHEDULE_WITH_STATIC_LINKS
+/* Static links are not in the timeslot index, the table is sorted by
+ * timeslot instead. The occupancy bitmap covers the enabled ones. */
+#define STATIC_LINK_ENABLED(sf, i) \
+  ((sf)->static_links_enabled[(i) / 32] & ((uint32_t)1 << ((i) % 32)))
+/*---------------------------------------------------------------------------*/
+/* Returns the index of the first static link at or after a timeslot */
+static uint16_t
+static_find(const struct tsch_slotframe *sf, uint16_t timeslot)
+{
+  uint16_t lo = 0;
+  uint16_t hi = sf->static_links_count;
+  while(lo < hi) {
+    uint16_t mid = lo + (hi - lo) / 2;
+    if(sf->static_links[mid].timeslot < timeslot) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+/*---------------------------------------------------------------------------*/
+/* Returns the enabled static link at a timeslot and channel offset, NULL if
+ * none. A channel offset of 0xffff matches any channel offset. */
+static struct tsch_link *
+static_lookup(const struct tsch_slotframe *sf, uint16_t timeslot, uint16_t channel_offset)
+{
+  uint16_t i;
+  for(i = static_find(sf, timeslot);
+      i < sf->static_links_count && sf->static_links[i].timeslot == timeslot; i++) {
+    if(STATIC_LINK_ENABLED(sf, i)
+       && (channel_offset == 0xffff || sf->static_links[i].channel_offset == channel_offset)) {
+      return (struct tsch_link *)&sf->static_links[i];
+    }
+  }
+  return NULL;
+}
+/*---------------------------------------------------------------------------*/
+/* Returns 1 if the link is one of the static links of the slotframe */
+static int
+static_contains(const struct tsch_slotframe *sf, const struct tsch_link *l)
+{
+  return sf->static_links != NULL
+         && l >= sf->static_links && l < sf->static_links + sf->static_links_count;
+}
+#endif /* TSCH_SCHEDULE_WITH_STATIC_LINKS */
+/*---------------------------------------------------------------------------*/
+/* Empties the timeslot index of a slotframe */
+static void
+slot_index_init(struct tsch_slotframe *sf)
+{
+  memset(sf->slot_bitmap, 0, sizeof(sf->slot_bitmap));
+  memset(sf->slot_head, 0xff, sizeof(sf->slot_head));
+}
+/*---------------------------------------------------------------------------*/
+/* Appends a link to the timeslot index. Links of a timeslot are kept in
+ * insertion order, i.e. the order of links_list. */
+static void
+slot_index_add(struct tsch_slotframe *sf, struct tsch_link *l)
+{
+  tsch_link_index_t *p = &sf->slot_head[l->timeslot];
+  while(*p != TSCH_LINK_INDEX_NONE) {
+    p = &SLOT_INDEX_LINK(*p)->slot_next;
+  }
+  l->slot_next = TSCH_LINK_INDEX_NONE;
+  *p = SLOT_INDEX_OF(l);
+  sf->slot_bitmap[l->timeslot / 32] |= (uint32_t)1 << (l->timeslot % 32);
+}
+/*---------------------------------------------------------------------------*/
+/* Removes a link from the timeslot index */
+static void
+slot_index_remove(struct tsch_slotframe *sf, struct tsch_link *l)
+{
+  tsch_link_index_t *p = &sf->slot_head[l->timeslot];
+  while(*p != TSCH_LINK_INDEX_NONE) {
+    if(*p == SLOT_INDEX_OF(l)) {
+      *p = l->slot_next;
+      break;
+    }
+    p = &SLOT_INDEX_LINK(*p)->slot_next;
+  }
+  if(sf->slot_head[l->timeslot] == TSCH_LINK_INDEX_NONE
+#if TSCH_SCHEDULE_WITH_STATIC_LINKS
+     && static_lookup(sf, l->timeslot, 0xffff) == NULL
+#endif /* TSCH_SCHEDULE_WITH_STATIC_LINKS */
+     ) {
+    sf->slot_bitmap[l->timeslot / 32] &= ~((uint32_t)1 << (l->timeslot % 32));
+  }
+}
+/*---------------------------------------------------------------------------*/
+/* Returns the first timeslot in [from, to) that has a link, -1 if none */
+static int
+slot_index_find(const struct tsch_slotframe *sf, uint16_t from, uint16_t to)
+{
+  while(from < to) {
+    uint32_t word = sf->slot_bitmap[from / 32] >> (from % 32);
+    if(word != 0) {
+      from += __builtin_ctz(word);
+      return from < to ? from : -1;
+    }
+    from = (from | 31) + 1;
+  }
+  return -1;
+}
+#endif /* TSCH_SCHEDULE_WITH_SLOT_INDEX */
+
+#if TSCH_SCHEDULE_WITH_ACTIVATION
+/*---------------------------------------------------------------------------*/
+/* Returns the number of timeslots between asn and the ASN before the first
+ * one the slotframe is active at, -1 if it is not active after asn or its
+ * window starts too far ahead to be reported in a 16-bit time offset. */
+static int32_t
+window_skip(const struct tsch_slotframe *sf, const struct tsch_asn_t *asn)
+{
+  int32_t diff;
+  if(sf->active_window & TSCH_SLOTFRAME_UNTIL) {
+    diff = (int32_t)TSCH_ASN_DIFF(sf->active_until, *asn);
+    if(diff <= 1) {
+      return -1;
+    }
+  }
+  if(sf->active_window & TSCH_SLOTFRAME_FROM) {
+    diff = (int32_t)TSCH_ASN_DIFF(sf->active_from, *asn);
+    if(diff > 1) {
+      return diff - 1 > 0x7fff ? -1 : diff - 1;
+    }
+  }
+  return 0;
+}
+/*---------------------------------------------------------------------------*/
+/* Returns 1 if the slotframe is still active time_offset timeslots after asn */
+static int
+window_contains(const struct tsch_slotframe *sf, const struct tsch_asn_t *asn,
+                uint32_t time_offset)
+{
+  return !(sf->active_window & TSCH_SLOTFRAME_UNTIL)
+         || time_offset < TSCH_ASN_DIFF(sf->active_until, *asn);
+}
+#endif /* TSCH_SCHEDULE_WITH_ACTIVATION */
+
+#if TSCH_SCHEDULE_WITH_STATIC_LINKS
+static void link_update_nbr(uint8_t link_options, const linkaddr_t *addr, int added);
+#endif /* TSCH_SCHEDULE_WITH_STATIC_LINKS */
+
 /* Adds and returns a slotframe (NULL if failure) */
 struct tsch_slotframe *
 tsch_schedule_add_slotframe(uint16_t handle, uint16_t size)
@@ -87,6 +240,14 @@ tsch_schedule_add_slotframe(uint16_t handle, uint16_t size)
     return NULL;
   }
 
+#if TSCH_SCHEDULE_WITH_SLOT_INDEX
+  if(size > TSCH_SCHEDULE_SLOT_INDEX_MAX_LENGTH) {
+    LOG_ERR("! add_slotframe size %u exceeds slot index length %u\n",
+            size, TSCH_SCHEDULE_SLOT_INDEX_MAX_LENGTH);
+    return NULL;
+  }
+#endif /* TSCH_SCHEDULE_WITH_SLOT_INDEX */
+
   if(tsch_schedule_get_slotframe_by_handle(handle)) {
     /* A slotframe with this handle already exists */
     return NULL;
@@ -99,6 +260,17 @@ tsch_schedule_add_slotframe(uint16_t handle, uint16_t size)
       sf->handle = handle;
       TSCH_ASN_DIVISOR_INIT(sf->size, size);
       LIST_STRUCT_INIT(sf, links_list);
+#if TSCH_SCHEDULE_WITH_SLOT_INDEX
+      slot_index_init(sf);
+#endif /* TSCH_SCHEDULE_WITH_SLOT_INDEX */
+#if TSCH_SCHEDULE_WITH_STATIC_LINKS
+      sf->static_links = NULL;
+      sf->static_links_count = 0;
+      sf->static_links_enabled = NULL;
+#endif /* TSCH_SCHEDULE_WITH_STATIC_LINKS */
+#if TSCH_SCHEDULE_WITH_ACTIVATION
+      sf->active_window = 0;
+#endif /* TSCH_SCHEDULE_WITH_ACTIVATION */
       /* Add the slotframe to the global list */
       list_add(slotframe_list, sf);
     }
@@ -133,10 +305,27 @@ tsch_schedule_remove_slotframe(struct tsch_slotframe *slotframe)
     while((l = list_head(slotframe->links_list))) {
       tsch_schedule_remove_link(slotframe, l);
     }
+#if TSCH_SCHEDULE_WITH_STATIC_LINKS
+    /* The enabled static links no longer count for their neighbors */
+    if(slotframe->static_links != NULL && !tsch_is_locked()) {
+      uint16_t i;
+      for(i = 0; i < slotframe->static_links_count; i++) {
+        if(STATIC_LINK_ENABLED(slotframe, i)) {
+          link_update_nbr(slotframe->static_links[i].link_options,
+                          &slotframe->static_links[i].addr, 0);
+        }
+      }
+    }
+#endif /* TSCH_SCHEDULE_WITH_STATIC_LINKS */
 
     /* Now that the slotframe has no links, remove it. */
     if(tsch_get_lock()) {
       LOG_INFO("remove slotframe %u %u\n", slotframe->handle, slotframe->size.val);
+#if TSCH_SCHEDULE_WITH_STATIC_LINKS
+      if(current_link != NULL && static_contains(slotframe, current_link)) {
+        current_link = NULL;
+      }
+#endif /* TSCH_SCHEDULE_WITH_STATIC_LINKS */
       memb_free(&slotframe_memb, slotframe);
       list_remove(slotframe_list, slotframe);
       tsch_release_lock();
@@ -145,6 +334,32 @@ tsch_schedule_remove_slotframe(struct tsch_slotframe *slotframe)
   }
   return 0;
 }
+#if TSCH_SCHEDULE_WITH_ACTIVATION
+/*---------------------------------------------------------------------------*/
+/* Limits a slotframe to an ASN window. Return 1 if success, 0 if failure */
+int
+tsch_schedule_set_slotframe_window(struct tsch_slotframe *slotframe,
+    const struct tsch_asn_t *from, const struct tsch_asn_t *until)
+{
+  if(slotframe != NULL && tsch_get_lock()) {
+    slotframe->active_window = 0;
+    if(from != NULL) {
+      slotframe->active_from = *from;
+      slotframe->active_window |= TSCH_SLOTFRAME_FROM;
+    }
+    if(until != NULL) {
+      slotframe->active_until = *until;
+      slotframe->active_window |= TSCH_SLOTFRAME_UNTIL;
+    }
+    LOG_INFO("slotframe %u active from %lu until %lu\n", slotframe->handle,
+             from != NULL ? (unsigned long)from->ls4b : 0UL,
+             until != NULL ? (unsigned long)until->ls4b : 0UL);
+    tsch_release_lock();
+    return 1;
+  }
+  return 0;
+}
+#endif /* TSCH_SCHEDULE_WITH_ACTIVATION */
 /*---------------------------------------------------------------------------*/
 /* Looks for a slotframe from a handle */
 struct tsch_slotframe *
@@ -224,6 +439,106 @@ print_link_type(uint16_t link_type)
   }
 }
 /*---------------------------------------------------------------------------*/
+/* Looks within a slotframe for a link at a given timeslot and channel offset.
+ * Does not check the lock: callers either hold it or have checked it. */
+static struct tsch_link *
+link_lookup(struct tsch_slotframe *slotframe,
+            uint16_t timeslot, uint16_t channel_offset)
+{
+#if TSCH_SCHEDULE_WITH_SLOT_INDEX
+  /* Only visit the links installed at this timeslot */
+  tsch_link_index_t i = timeslot < slotframe->size.val ?
+    slotframe->slot_head[timeslot] : TSCH_LINK_INDEX_NONE;
+  while(i != TSCH_LINK_INDEX_NONE) {
+    struct tsch_link *l = SLOT_INDEX_LINK(i);
+    if(l->channel_offset == channel_offset) {
+      return l;
+    }
+    i = l->slot_next;
+  }
+  return NULL;
+#else /* TSCH_SCHEDULE_WITH_SLOT_INDEX */
+  struct tsch_link *l = list_head(slotframe->links_list);
+  /* Loop over all items. Assume there is max one link per timeslot and channel_offset */
+  while(l != NULL) {
+    if(l->timeslot == timeslot && l->channel_offset == channel_offset) {
+      return l;
+    }
+    l = list_item_next(l);
+  }
+  return NULL;
+#endif /* TSCH_SCHEDULE_WITH_SLOT_INDEX */
+}
+/*---------------------------------------------------------------------------*/
+/* Initializes a newly allocated link and adds it to the slotframe.
+ * Must be called with the lock held. */
+static void
+link_insert(struct tsch_slotframe *slotframe, struct tsch_link *l,
+            uint8_t link_options, enum link_type link_type, const linkaddr_t *address,
+            uint16_t timeslot, uint16_t channel_offset)
+{
+  static int current_link_handle = 0;
+  /* Add the link to the slotframe */
+  list_add(slotframe->links_list, l);
+  /* Initialize link */
+  l->handle = current_link_handle++;
+  l->link_options = link_options;
+  l->link_type = link_type;
+  l->slotframe_handle = slotframe->handle;
+  l->timeslot = timeslot;
+  l->channel_offset = channel_offset;
+  l->data = NULL;
+  if(address == NULL) {
+    address = &linkaddr_null;
+  }
+  linkaddr_copy(&l->addr, address);
+#if TSCH_SCHEDULE_WITH_SLOT_INDEX
+  slot_index_add(slotframe, l);
+#endif /* TSCH_SCHEDULE_WITH_SLOT_INDEX */
+}
+/*---------------------------------------------------------------------------*/
+/* Removes a link from its slotframe and frees it.
+ * Must be called with the lock held. */
+static void
+link_release(struct tsch_slotframe *slotframe, struct tsch_link *l)
+{
+  /* The link to be removed is scheduled as next, set it to NULL
+   * to abort the next link operation */
+  if(l == current_link) {
+    current_link = NULL;
+  }
+#if TSCH_SCHEDULE_WITH_SLOT_INDEX
+  slot_index_remove(slotframe, l);
+#endif /* TSCH_SCHEDULE_WITH_SLOT_INDEX */
+  list_remove(slotframe->links_list, l);
+  memb_free(&link_memb, l);
+}
+/*---------------------------------------------------------------------------*/
+/* Updates the tx link counters of the neighbor of an added or removed link.
+ * Must be called without the lock, as adding a neighbor takes it. */
+static void
+link_update_nbr(uint8_t link_options, const linkaddr_t *addr, int added)
+{
+  struct tsch_neighbor *n;
+  if(!(link_options & LINK_OPTION_TX)) {
+    return;
+  }
+  n = added ? tsch_queue_add_nbr(addr) : tsch_queue_get_nbr(addr);
+  if(n != NULL) {
+    if(added) {
+      n->tx_links_count++;
+      if(!(link_options & LINK_OPTION_SHARED)) {
+        n->dedicated_tx_links_count++;
+      }
+    } else {
+      n->tx_links_count--;
+      if(!(link_options & LINK_OPTION_SHARED)) {
+        n->dedicated_tx_links_count--;
+      }
+    }
+  }
+}
+/*---------------------------------------------------------------------------*/
 /* Adds a link to a slotframe, return a pointer to it (NULL if failure) */
 struct tsch_link *
 tsch_schedule_add_link(struct tsch_slotframe *slotframe,
@@ -253,42 +568,19 @@ tsch_schedule_add_link(struct tsch_slotframe *slotframe,
         LOG_ERR("! add_link memb_alloc failed\n");
         tsch_release_lock();
       } else {
-        static int current_link_handle = 0;
-        struct tsch_neighbor *n;
-        /* Add the link to the slotframe */
-        list_add(slotframe->links_list, l);
-        /* Initialize link */
-        l->handle = current_link_handle++;
-        l->link_options = link_options;
-        l->link_type = link_type;
-        l->slotframe_handle = slotframe->handle;
-        l->timeslot = timeslot;
-        l->channel_offset = channel_offset;
-        l->data = NULL;
-        if(address == NULL) {
-          address = &linkaddr_null;
-        }
-        linkaddr_copy(&l->addr, address);
+        link_insert(slotframe, l, link_options, link_type, address,
+                    timeslot, channel_offset);
 
         LOG_INFO("add_link sf=%u opt=%s type=%s ts=%u ch=%u addr=",
                  slotframe->handle,
                  print_link_options(link_options),
                  print_link_type(link_type), timeslot, channel_offset);
-        LOG_INFO_LLADDR(address);
+        LOG_INFO_LLADDR(&l->addr);
         LOG_INFO_("\n");
         /* Release the lock before we update the neighbor (will take the lock) */
         tsch_release_lock();
 
-        if(l->link_options & LINK_OPTION_TX) {
-          n = tsch_queue_add_nbr(&l->addr);
-          /* We have a tx link to this neighbor, update counters */
-          if(n != NULL) {
-            n->tx_links_count++;
-            if(!(l->link_options & LINK_OPTION_SHARED)) {
-              n->dedicated_tx_links_count++;
-            }
-          }
-        }
+        link_update_nbr(l->link_options, &l->addr, 1);
       }
     }
   }
@@ -299,6 +591,12 @@ tsch_schedule_add_link(struct tsch_slotframe *slotframe,
 int
 tsch_schedule_remove_link(struct tsch_slotframe *slotframe, struct tsch_link *l)
 {
+#if TSCH_SCHEDULE_WITH_STATIC_LINKS
+  if(slotframe != NULL && static_contains(slotframe, l)) {
+    LOG_ERR("! remove_link static link, disable it instead\n");
+    return 0;
+  }
+#endif /* TSCH_SCHEDULE_WITH_STATIC_LINKS */
   if(slotframe != NULL && l != NULL && l->slotframe_handle == slotframe->handle) {
     if(tsch_get_lock()) {
       uint8_t link_options;
@@ -309,11 +607,6 @@ tsch_schedule_remove_link(struct tsch_slotframe *slotframe, struct tsch_link *l)
       link_options = l->link_options;
       linkaddr_copy(&addr, &l->addr);
 
-      /* The link to be removed is scheduled as next, set it to NULL
-       * to abort the next link operation */
-      if(l == current_link) {
-        current_link = NULL;
-      }
       LOG_INFO("remove_link sf=%u opt=%s type=%s ts=%u ch=%u addr=",
                slotframe->handle,
                print_link_options(l->link_options),
@@ -321,22 +614,13 @@ tsch_schedule_remove_link(struct tsch_slotframe *slotframe, struct tsch_link *l)
       LOG_INFO_LLADDR(&l->addr);
       LOG_INFO_("\n");
 
-      list_remove(slotframe->links_list, l);
-      memb_free(&link_memb, l);
+      link_release(slotframe, l);
 
       /* Release the lock before we update the neighbor (will take the lock) */
       tsch_release_lock();
 
       /* This was a tx link to this neighbor, update counters */
-      if(link_options & LINK_OPTION_TX) {
-        struct tsch_neighbor *n = tsch_queue_get_nbr(&addr);
-        if(n != NULL) {
-          n->tx_links_count--;
-          if(!(link_options & LINK_OPTION_SHARED)) {
-            n->dedicated_tx_links_count--;
-          }
-        }
-      }
+      link_update_nbr(link_options, &addr, 0);
 
       return 1;
     } else {
@@ -370,6 +654,235 @@ tsch_schedule_remove_link_by_timeslot(struct tsch_slotframe *slotframe,
   return ret;
 }
 /*---------------------------------------------------------------------------*/
+/* Adds a set of links to a slotframe, taking the lock only once. A link
+ * already installed at the same timeslot and channel offset is replaced.
+ * Return 1 if success, 0 if failure (the schedule is left unchanged) */
+int
+tsch_schedule_add_links(struct tsch_slotframe *slotframe,
+                        const struct tsch_link_desc *links, uint16_t count)
+{
+  uint16_t i;
+  uint16_t replaced = 0;
+
+  if(slotframe == NULL || links == NULL || tsch_is_locked()) {
+    return 0;
+  }
+
+  /* Validate all links and check for free memory before changing anything */
+  for(i = 0; i < count; i++) {
+    if(links[i].timeslot > (slotframe->size.val - 1)) {
+      LOG_ERR("! add_links invalid timeslot: %u\n", links[i].timeslot);
+      return 0;
+    }
+    if(link_lookup(slotframe, links[i].timeslot, links[i].channel_offset) != NULL) {
+      replaced++;
+    }
+  }
+  if(memb_numfree(&link_memb) + replaced < count) {
+    LOG_ERR("! add_links memb_alloc failed for %u links\n", count);
+    return 0;
+  }
+
+  /* The links to be replaced no longer count for their neighbors. This
+   * needs to be done before taking the lock. */
+  for(i = 0; i < count; i++) {
+    struct tsch_link *l = link_lookup(slotframe, links[i].timeslot, links[i].channel_offset);
+    if(l != NULL) {
+      link_update_nbr(l->link_options, &l->addr, 0);
+    }
+  }
+
+  if(!tsch_get_lock()) {
+    LOG_ERR("! add_links couldn't take lock\n");
+    for(i = 0; i < count; i++) {
+      struct tsch_link *l = link_lookup(slotframe, links[i].timeslot, links[i].channel_offset);
+      if(l != NULL) {
+        link_update_nbr(l->link_options, &l->addr, 1);
+      }
+    }
+    return 0;
+  }
+
+  for(i = 0; i < count; i++) {
+    struct tsch_link *l = link_lookup(slotframe, links[i].timeslot, links[i].channel_offset);
+    if(l != NULL) {
+      link_release(slotframe, l);
+    }
+    l = memb_alloc(&link_memb);
+    link_insert(slotframe, l, links[i].link_options, links[i].link_type,
+                &links[i].addr, links[i].timeslot, links[i].channel_offset);
+  }
+
+  tsch_release_lock();
+
+  for(i = 0; i < count; i++) {
+    link_update_nbr(links[i].link_options, &links[i].addr, 1);
+  }
+
+  LOG_INFO("add_links sf=%u count=%u replaced=%u\n",
+           slotframe->handle, count, replaced);
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Removes a set of links from a slotframe, taking the lock only once. Only
+ * timeslot and channel offset of the descriptions are used.
+ * Return 1 if all links were found and removed, 0 otherwise */
+int
+tsch_schedule_remove_links(struct tsch_slotframe *slotframe,
+                           const struct tsch_link_desc *links, uint16_t count)
+{
+  uint16_t i;
+  uint16_t removed = 0;
+
+  if(slotframe == NULL || links == NULL || tsch_is_locked()) {
+    return 0;
+  }
+
+  /* Update the neighbors before taking the lock */
+  for(i = 0; i < count; i++) {
+    struct tsch_link *l = link_lookup(slotframe, links[i].timeslot, links[i].channel_offset);
+    if(l != NULL) {
+      link_update_nbr(l->link_options, &l->addr, 0);
+    }
+  }
+
+  if(!tsch_get_lock()) {
+    LOG_ERR("! remove_links couldn't take lock\n");
+    for(i = 0; i < count; i++) {
+      struct tsch_link *l = link_lookup(slotframe, links[i].timeslot, links[i].channel_offset);
+      if(l != NULL) {
+        link_update_nbr(l->link_options, &l->addr, 1);
+      }
+    }
+    return 0;
+  }
+
+  for(i = 0; i < count; i++) {
+    struct tsch_link *l = link_lookup(slotframe, links[i].timeslot, links[i].channel_offset);
+    if(l != NULL) {
+      link_release(slotframe, l);
+      removed++;
+    }
+  }
+
+  tsch_release_lock();
+
+  LOG_INFO("remove_links sf=%u count=%u removed=%u\n",
+           slotframe->handle, count, removed);
+  return removed == count;
+}
+#if TSCH_SCHEDULE_WITH_STATIC_LINKS
+/*---------------------------------------------------------------------------*/
+/* Attaches a table of links to a slotframe, all disabled.
+ * Return 1 if success, 0 if failure */
+int
+tsch_schedule_set_static_links(struct tsch_slotframe *slotframe,
+                               const struct tsch_link *links, uint16_t count,
+                               uint32_t *enabled)
+{
+  uint16_t i;
+
+  if(slotframe == NULL || links == NULL || enabled == NULL
+     || slotframe->static_links != NULL) {
+    return 0;
+  }
+
+  /* The lookup relies on the order of the table */
+  for(i = 0; i < count; i++) {
+    if(links[i].timeslot > (slotframe->size.val - 1)
+       || links[i].slotframe_handle != slotframe->handle
+       || (i > 0 && links[i].timeslot < links[i - 1].timeslot)) {
+      LOG_ERR("! set_static_links invalid link %u\n", i);
+      return 0;
+    }
+  }
+
+  if(!tsch_get_lock()) {
+    LOG_ERR("! set_static_links couldn't take lock\n");
+    return 0;
+  }
+  memset(enabled, 0, ((count + 31) / 32) * sizeof(uint32_t));
+  slotframe->static_links_enabled = enabled;
+  slotframe->static_links_count = count;
+  slotframe->static_links = links;
+  tsch_release_lock();
+
+  LOG_INFO("set_static_links sf=%u count=%u\n", slotframe->handle, count);
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Enables or disables a set of static links, taking the lock only once.
+ * Return 1 if success, 0 if failure (the schedule is left unchanged) */
+int
+tsch_schedule_enable_static_links(struct tsch_slotframe *slotframe,
+                                  const uint16_t *indexes, uint16_t count,
+                                  int enable)
+{
+  uint16_t i;
+  uint16_t changed = 0;
+
+  if(slotframe == NULL || slotframe->static_links == NULL || indexes == NULL
+     || tsch_is_locked()) {
+    return 0;
+  }
+
+  for(i = 0; i < count; i++) {
+    if(indexes[i] >= slotframe->static_links_count) {
+      LOG_ERR("! enable_static_links invalid index: %u\n", indexes[i]);
+      return 0;
+    }
+  }
+
+  /* Update the neighbors of the links that change before taking the lock */
+  for(i = 0; i < count; i++) {
+    const struct tsch_link *l = &slotframe->static_links[indexes[i]];
+    if(!STATIC_LINK_ENABLED(slotframe, indexes[i]) != !enable) {
+      link_update_nbr(l->link_options, &l->addr, enable);
+    }
+  }
+
+  if(!tsch_get_lock()) {
+    LOG_ERR("! enable_static_links couldn't take lock\n");
+    for(i = 0; i < count; i++) {
+      const struct tsch_link *l = &slotframe->static_links[indexes[i]];
+      if(!STATIC_LINK_ENABLED(slotframe, indexes[i]) != !enable) {
+        link_update_nbr(l->link_options, &l->addr, !enable);
+      }
+    }
+    return 0;
+  }
+
+  for(i = 0; i < count; i++) {
+    const struct tsch_link *l = &slotframe->static_links[indexes[i]];
+    uint32_t bit = (uint32_t)1 << (indexes[i] % 32);
+    if(!STATIC_LINK_ENABLED(slotframe, indexes[i]) == !enable) {
+      continue;
+    }
+    changed++;
+    if(enable) {
+      slotframe->static_links_enabled[indexes[i] / 32] |= bit;
+      slotframe->slot_bitmap[l->timeslot / 32] |= (uint32_t)1 << (l->timeslot % 32);
+    } else {
+      slotframe->static_links_enabled[indexes[i] / 32] &= ~bit;
+      /* The link scheduled as next is aborted */
+      if(l == current_link) {
+        current_link = NULL;
+      }
+      if(slotframe->slot_head[l->timeslot] == TSCH_LINK_INDEX_NONE
+         && static_lookup(slotframe, l->timeslot, 0xffff) == NULL) {
+        slotframe->slot_bitmap[l->timeslot / 32] &= ~((uint32_t)1 << (l->timeslot % 32));
+      }
+    }
+  }
+
+  tsch_release_lock();
+
+  LOG_INFO("%s_static_links sf=%u count=%u changed=%u\n", enable ? "enable" : "disable",
+           slotframe->handle, count, changed);
+  return 1;
+}
+#endif /* TSCH_SCHEDULE_WITH_STATIC_LINKS */
+/*---------------------------------------------------------------------------*/
 /* Looks within a slotframe for a link with a given timeslot */
 struct tsch_link *
 tsch_schedule_get_link_by_timeslot(struct tsch_slotframe *slotframe,
@@ -377,15 +890,12 @@ tsch_schedule_get_link_by_timeslot(struct tsch_slotframe *slotframe,
 {
   if(!tsch_is_locked()) {
     if(slotframe != NULL) {
-      struct tsch_link *l = list_head(slotframe->links_list);
-      /* Loop over all items. Assume there is max one link per timeslot and channel_offset */
-      while(l != NULL) {
-        if(l->timeslot == timeslot && l->channel_offset == channel_offset) {
-          return l;
-        }
-        l = list_item_next(l);
-      }
-      return l;
+#if TSCH_SCHEDULE_WITH_STATIC_LINKS
+      struct tsch_link *l = link_lookup(slotframe, timeslot, channel_offset);
+      return l != NULL ? l : static_lookup(slotframe, timeslot, channel_offset);
+#else /* TSCH_SCHEDULE_WITH_STATIC_LINKS */
+      return link_lookup(slotframe, timeslot, channel_offset);
+#endif /* TSCH_SCHEDULE_WITH_STATIC_LINKS */
     }
   }
   return NULL;
@@ -413,6 +923,59 @@ default_tsch_link_comparator(struct tsch_link *a, struct tsch_link *b)
   return a;
 }
 
+/*---------------------------------------------------------------------------*/
+/* Compares a link occurring in time_to_timeslot slots against the current best
+ * link, and updates the best link and its backup link (with Rx flag) */
+static void
+select_link(struct tsch_link *l, uint16_t time_to_timeslot,
+    struct tsch_link **curr_best, uint16_t *time_to_curr_best,
+    struct tsch_link **curr_backup)
+{
+  if(*curr_best == NULL || time_to_timeslot < *time_to_curr_best) {
+    *time_to_curr_best = time_to_timeslot;
+    *curr_best = l;
+    *curr_backup = NULL;
+  } else if(time_to_timeslot == *time_to_curr_best) {
+    struct tsch_link *new_best = NULL;
+    /* Two links are overlapping, we need to select one of them.
+     * By standard: prioritize Tx links first, second by lowest handle */
+    if(((*curr_best)->link_options & LINK_OPTION_TX) == (l->link_options & LINK_OPTION_TX)) {
+      /* Both or neither links have Tx, select the one with lowest handle */
+      if(l->slotframe_handle != (*curr_best)->slotframe_handle) {
+        if(l->slotframe_handle < (*curr_best)->slotframe_handle) {
+          new_best = l;
+        }
+      } else {
+        /* compare the link against the current best link and return the newly selected one */
+        new_best = TSCH_LINK_COMPARATOR(*curr_best, l);
+      }
+    } else {
+      /* Select the link that has the Tx option */
+      if(l->link_options & LINK_OPTION_TX) {
+        new_best = l;
+      }
+    }
+
+    /* Maintain backup_link */
+    /* Check if 'l' best can be used as backup */
+    if(new_best != l && (l->link_options & LINK_OPTION_RX)) { /* Does 'l' have Rx flag? */
+      if(*curr_backup == NULL || l->slotframe_handle < (*curr_backup)->slotframe_handle) {
+        *curr_backup = l;
+      }
+    }
+    /* Check if curr_best can be used as backup */
+    if(new_best != *curr_best && ((*curr_best)->link_options & LINK_OPTION_RX)) { /* Does curr_best have Rx flag? */
+      if(*curr_backup == NULL || (*curr_best)->slotframe_handle < (*curr_backup)->slotframe_handle) {
+        *curr_backup = *curr_best;
+      }
+    }
+
+    /* Maintain curr_best */
+    if(new_best != NULL) {
+      *curr_best = new_best;
+    }
+  }
+}
 /*---------------------------------------------------------------------------*/
 /* Returns the next active link after a given ASN, and a backup link (for the same ASN, with Rx flag) */
 struct tsch_link *
@@ -429,61 +992,69 @@ tsch_schedule_get_next_active_link(struct tsch_asn_t *asn, uint16_t *time_offset
     struct tsch_slotframe *sf = list_head(slotframe_list);
     /* For each slotframe, look for the earliest occurring link */
     while(sf != NULL) {
+      /* The search starts skip timeslots after asn, at base */
+      struct tsch_asn_t base = *asn;
+      uint16_t skip = 0;
+#if TSCH_SCHEDULE_WITH_ACTIVATION
+      int32_t window = window_skip(sf, asn);
+      if(window < 0) {
+        sf = list_item_next(sf);
+        continue;
+      }
+      skip = (uint16_t)window;
+      TSCH_ASN_INC(base, skip);
+#endif /* TSCH_SCHEDULE_WITH_ACTIVATION */
       /* Get timeslot from ASN, given the slotframe length */
-      uint16_t timeslot = TSCH_ASN_MOD(*asn, sf->size);
+      uint16_t timeslot = TSCH_ASN_MOD(base, sf->size);
+#if TSCH_SCHEDULE_WITH_SLOT_INDEX
+      /* Only the links of the next occupied timeslot can be selected. A link
+       * at the current timeslot is a full slotframe away. */
+      uint16_t time_to_timeslot;
+      int next = slot_index_find(sf, timeslot + 1, sf->size.val);
+      if(next >= 0) {
+        time_to_timeslot = skip + next - timeslot;
+      } else {
+        next = slot_index_find(sf, 0, timeslot + 1);
+        time_to_timeslot = skip + sf->size.val + next - timeslot;
+      }
+#if TSCH_SCHEDULE_WITH_ACTIVATION
+      if(next >= 0 && !window_contains(sf, asn, time_to_timeslot)) {
+        next = -1;
+      }
+#endif /* TSCH_SCHEDULE_WITH_ACTIVATION */
+      if(next >= 0 &&
+         (curr_best == NULL || time_to_timeslot <= time_to_curr_best)) {
+        tsch_link_index_t i = sf->slot_head[next];
+        while(i != TSCH_LINK_INDEX_NONE) {
+          struct tsch_link *l = SLOT_INDEX_LINK(i);
+          select_link(l, time_to_timeslot, &curr_best, &time_to_curr_best, &curr_backup);
+          i = l->slot_next;
+        }
+#if TSCH_SCHEDULE_WITH_STATIC_LINKS
+        uint16_t s;
+        for(s = static_find(sf, next);
+            s < sf->static_links_count && sf->static_links[s].timeslot == next; s++) {
+          if(STATIC_LINK_ENABLED(sf, s)) {
+            select_link((struct tsch_link *)&sf->static_links[s], time_to_timeslot,
+                        &curr_best, &time_to_curr_best, &curr_backup);
+          }
+        }
+#endif /* TSCH_SCHEDULE_WITH_STATIC_LINKS */
+      }
+#else /* TSCH_SCHEDULE_WITH_SLOT_INDEX */
       struct tsch_link *l = list_head(sf->links_list);
       while(l != NULL) {
-        uint16_t time_to_timeslot =
+        uint16_t time_to_timeslot = skip + (
           l->timeslot > timeslot ?
           l->timeslot - timeslot :
-          sf->size.val + l->timeslot - timeslot;
-        if(curr_best == NULL || time_to_timeslot < time_to_curr_best) {
-          time_to_curr_best = time_to_timeslot;
-          curr_best = l;
-          curr_backup = NULL;
-        } else if(time_to_timeslot == time_to_curr_best) {
-          struct tsch_link *new_best = NULL;
-          /* Two links are overlapping, we need to select one of them.
-           * By standard: prioritize Tx links first, second by lowest handle */
-          if((curr_best->link_options & LINK_OPTION_TX) == (l->link_options & LINK_OPTION_TX)) {
-            /* Both or neither links have Tx, select the one with lowest handle */
-            if(l->slotframe_handle != curr_best->slotframe_handle) {
-              if(l->slotframe_handle < curr_best->slotframe_handle) {
-                new_best = l;
-              }
-            } else {
-              /* compare the link against the current best link and return the newly selected one */
-              new_best = TSCH_LINK_COMPARATOR(curr_best, l);
-            }
-          } else {
-            /* Select the link that has the Tx option */
-            if(l->link_options & LINK_OPTION_TX) {
-              new_best = l;
-            }
-          }
-
-          /* Maintain backup_link */
-          /* Check if 'l' best can be used as backup */
-          if(new_best != l && (l->link_options & LINK_OPTION_RX)) { /* Does 'l' have Rx flag? */
-            if(curr_backup == NULL || l->slotframe_handle < curr_backup->slotframe_handle) {
-              curr_backup = l;
-            }
-          }
-          /* Check if curr_best can be used as backup */
-          if(new_best != curr_best && (curr_best->link_options & LINK_OPTION_RX)) { /* Does curr_best have Rx flag? */
-            if(curr_backup == NULL || curr_best->slotframe_handle < curr_backup->slotframe_handle) {
-              curr_backup = curr_best;
-            }
-          }
-
-          /* Maintain curr_best */
-          if(new_best != NULL) {
-            curr_best = new_best;
-          }
-        }
-
+          sf->size.val + l->timeslot - timeslot);
+#if TSCH_SCHEDULE_WITH_ACTIVATION
+        if(window_contains(sf, asn, time_to_timeslot))
+#endif /* TSCH_SCHEDULE_WITH_ACTIVATION */
+        select_link(l, time_to_timeslot, &curr_best, &time_to_curr_best, &curr_backup);
         l = list_item_next(l);
       }
+#endif /* TSCH_SCHEDULE_WITH_SLOT_INDEX */
       sf = list_item_next(sf);
     }
     if(time_offset != NULL) {
@@ -567,6 +1138,21 @@ tsch_schedule_print(void)
 #endif /* #if LINKADDR_SIZE == 8 */
         l = list_item_next(l);
       }
+#if TSCH_SCHEDULE_WITH_STATIC_LINKS
+      uint16_t i;
+      for(i = 0; i < sf->static_links_count; i++) {
+        if(STATIC_LINK_ENABLED(sf, i)) {
+          l = (struct tsch_link *)&sf->static_links[i];
+          LOG_PRINT("* Static link options %02x, type %u, timeslot %u, channel offset %u, address %u\n",
+                 l->link_options, l->link_type, l->timeslot, l->channel_offset,
+#if LINKADDR_SIZE == 8
+                 l->addr.u8[7]);
+#else
+                 l->addr.u8[1]);
+#endif /* #if LINKADDR_SIZE == 8 */
+        }
+      }
+#endif /* TSCH_SCHEDULE_WITH_STATIC_LINKS */
 
       sf = list_item_next(sf);
     }
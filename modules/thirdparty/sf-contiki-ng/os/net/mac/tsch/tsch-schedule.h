@@ -90,6 +90,51 @@ int tsch_schedule_remove_slotframe(struct tsch_slotframe *slotframe);
  */
 int tsch_schedule_remove_all_slotframes(void);
 
+#if TSCH_SCHEDULE_WITH_ACTIVATION
+/**
+ * \brief Limits the links of a slotframe to an ASN window. Another slotframe
+ * can take over at the end of the window, e.g. one with a different size.
+ * \param slotframe The slotframe
+ * \param from The first ASN the slotframe is active, NULL for no lower bound
+ * \param until The ASN from which on the slotframe is no longer active, NULL
+ * for no upper bound
+ * \return 1 if success, 0 if failure
+ */
+int tsch_schedule_set_slotframe_window(struct tsch_slotframe *slotframe,
+    const struct tsch_asn_t *from, const struct tsch_asn_t *until);
+#endif /* TSCH_SCHEDULE_WITH_ACTIVATION */
+
+#if TSCH_SCHEDULE_WITH_STATIC_LINKS
+/**
+ * \brief Attaches a table of links to a slotframe. The links of the table are
+ * not taken from the link pool and may be const, e.g. in flash. They are
+ * disabled until enabled with tsch_schedule_enable_static_links().
+ * \param slotframe The slotframe, without static links
+ * \param links The links, sorted by timeslot, with the handle of the slotframe
+ * and TSCH_LINK_INDEX_NONE as slot_next. Must not be changed while attached
+ * \param count The number of links
+ * \param enabled One bit per link, cleared by the call. Must be kept by the
+ * caller as long as the slotframe exists
+ * \return 1 if success, 0 if failure
+ */
+int tsch_schedule_set_static_links(struct tsch_slotframe *slotframe,
+                                   const struct tsch_link *links, uint16_t count,
+                                   uint32_t *enabled);
+
+/**
+ * \brief Enables or disables static links of a slotframe, taking the schedule
+ * lock only once. Static links cannot be removed with tsch_schedule_remove_link().
+ * \param slotframe The slotframe the links belong to
+ * \param indexes The unique indexes of the links in the table of the slotframe
+ * \param count The number of links
+ * \param enable 1 to enable the links, 0 to disable them
+ * \return 1 if success, 0 if failure (the schedule is left unchanged)
+ */
+int tsch_schedule_enable_static_links(struct tsch_slotframe *slotframe,
+                                      const uint16_t *indexes, uint16_t count,
+                                      int enable);
+#endif /* TSCH_SCHEDULE_WITH_STATIC_LINKS */
+
 /**
  * \brief Adds a link to a slotframe
  * \param slotframe The slotframe that will contain the new link
@@ -104,6 +149,29 @@ int tsch_schedule_remove_all_slotframes(void);
 struct tsch_link *tsch_schedule_add_link(struct tsch_slotframe *slotframe,
                                          uint8_t link_options, enum link_type link_type, const linkaddr_t *address,
                                          uint16_t timeslot, uint16_t channel_offset, uint8_t do_remove);
+/**
+ * \brief Adds a set of links to a slotframe, taking the schedule lock only once.
+ * A link already installed at the same timeslot and channel offset is replaced.
+ * The timeslot and channel offset pairs within the set must be unique.
+ * \param slotframe The slotframe that will contain the new links
+ * \param links The descriptions of the links to add
+ * \param count The number of links
+ * \return 1 if success, 0 if failure (the schedule is left unchanged)
+ */
+int tsch_schedule_add_links(struct tsch_slotframe *slotframe,
+                            const struct tsch_link_desc *links, uint16_t count);
+
+/**
+ * \brief Removes a set of links from a slotframe, taking the schedule lock only once.
+ * Only the timeslot and channel offset of the descriptions are used.
+ * \param slotframe The slotframe the links belong to
+ * \param links The descriptions of the links to remove
+ * \param count The number of links
+ * \return 1 if all links were found and removed, 0 otherwise
+ */
+int tsch_schedule_remove_links(struct tsch_slotframe *slotframe,
+                               const struct tsch_link_desc *links, uint16_t count);
+
 /**
 * \brief Looks for a link from a handle
 * \param handle The target handle
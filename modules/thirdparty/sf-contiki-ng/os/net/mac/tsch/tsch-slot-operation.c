@@ -56,6 +56,10 @@
 #include "dev/gpio-hal.h"
 
 #include "sys/log.h"
+
+#include <stdio.h>
+#include <string.h>
+
 /* TSCH debug macros, i.e. to set LEDs or GPIOs on various TSCH
  * timeslot events */
 #ifndef TSCH_DEBUG_INIT
@@ -257,6 +261,34 @@ volatile int pendingTxCounterReset=0;
 
 static bool ccaEnabled = false;
 
+#if TSCH_WITH_SLOT_TIMING
+/* Number of aggregated slot classes: one per link type and direction */
+#define SLOT_TIMING_CLASSES ((LINK_TYPE_ADVERTISING_ONLY + 1) * 2)
+/* Aggregated timing, written from the slot operation only. Readers copy it
+ * while slot_timing_seq is even and unchanged (sequence lock). */
+static struct tsch_slot_timing slot_timing[SLOT_TIMING_CLASSES];
+static volatile uint32_t slot_timing_seq;
+/* Timing points of the current slot, in rtimer ticks after the slot start */
+static uint32_t slot_timing_mark[TSCH_SLOT_TIMING_POINT_COUNT];
+/* Bitmap of the timing points reached in the current slot */
+static uint8_t slot_timing_marked;
+/* Class of the current slot */
+static uint8_t slot_timing_class;
+
+#define SLOT_TIMING_CLASS(link_type, is_tx) ((uint8_t)(((link_type) * 2) + ((is_tx) ? 1 : 0)))
+#define SLOT_TIMING_MARK(point) slot_timing_set_mark(point)
+#define SLOT_TIMING_BEGIN(link_type, is_tx) do { \
+    slot_timing_marked = 0; \
+    slot_timing_class = SLOT_TIMING_CLASS(link_type, is_tx); \
+    slot_timing_set_mark(TSCH_SLOT_TIMING_START); \
+  } while(0)
+#define SLOT_TIMING_COMMIT() slot_timing_commit()
+#else /* TSCH_WITH_SLOT_TIMING */
+#define SLOT_TIMING_MARK(point)
+#define SLOT_TIMING_BEGIN(link_type, is_tx)
+#define SLOT_TIMING_COMMIT()
+#endif /* TSCH_WITH_SLOT_TIMING */
+
 /* Protothread for association */
 PT_THREAD(tsch_scan(struct pt *pt));
 /* Protothread for slot operation, called from rtimer interrupt
@@ -281,6 +313,123 @@ tsch_disable_cca(void)
   ccaEnabled = false;
 }
 
+/*---------------------------------------------------------------------------*/
+#if TSCH_WITH_SLOT_TIMING
+static void
+slot_timing_set_mark(enum tsch_slot_timing_point point)
+{
+  int64_t offset = (int64_t)RTIMER_CLOCK_DIFF(RTIMER_NOW(), current_slot_start);
+
+  slot_timing_mark[point] = offset > 0 ? (uint32_t)offset : 0;
+  slot_timing_marked |= (uint8_t)(1 << point);
+}
+/*---------------------------------------------------------------------------*/
+/* Aggregate the timing points of the slot that just ended */
+static void
+slot_timing_commit(void)
+{
+  struct tsch_slot_timing *timing = &slot_timing[slot_timing_class];
+  uint32_t bin;
+  int i;
+
+  if(!(slot_timing_marked & (1 << TSCH_SLOT_TIMING_START))) {
+    return;
+  }
+  SLOT_TIMING_MARK(TSCH_SLOT_TIMING_END);
+
+  slot_timing_seq++;
+  __sync_synchronize();
+
+  for(i = 0; i < TSCH_SLOT_TIMING_POINT_COUNT; i++) {
+    struct tsch_slot_timing_stats *stats = &timing->point[i];
+    if(slot_timing_marked & (1 << i)) {
+      if(stats->count == 0 || slot_timing_mark[i] < stats->min) {
+        stats->min = slot_timing_mark[i];
+      }
+      if(slot_timing_mark[i] > stats->max) {
+        stats->max = slot_timing_mark[i];
+      }
+      stats->sum += slot_timing_mark[i];
+      stats->count++;
+    }
+  }
+
+  bin = (uint32_t)(((uint64_t)slot_timing_mark[TSCH_SLOT_TIMING_END] * (TSCH_SLOT_TIMING_HIST_BINS - 1))
+                   / tsch_timing[tsch_ts_timeslot_length]);
+  timing->histogram[MIN(bin, TSCH_SLOT_TIMING_HIST_BINS - 1)]++;
+
+  __sync_synchronize();
+  slot_timing_seq++;
+  slot_timing_marked = 0;
+}
+/*---------------------------------------------------------------------------*/
+void
+tsch_slot_timing_get(enum link_type link_type, uint8_t is_tx,
+                     struct tsch_slot_timing *timing)
+{
+  uint32_t seq;
+  uint8_t class = SLOT_TIMING_CLASS(link_type, is_tx);
+
+  if(timing == NULL || class >= SLOT_TIMING_CLASSES) {
+    return;
+  }
+
+  /* Retry until the copy was not interrupted by a slot end */
+  do {
+    seq = slot_timing_seq;
+    __sync_synchronize();
+    memcpy(timing, &slot_timing[class], sizeof(*timing));
+    __sync_synchronize();
+  } while((seq & 1) || seq != slot_timing_seq);
+}
+/*---------------------------------------------------------------------------*/
+void
+tsch_slot_timing_reset(void)
+{
+  /* Keep the slot operation out while clearing */
+  if(tsch_get_lock()) {
+    memset(slot_timing, 0, sizeof(slot_timing));
+    tsch_release_lock();
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+tsch_slot_timing_print(void)
+{
+  static const char *link_type_str[] = { "normal", "rtx", "adv", "adv-only" };
+  static const char *point_str[] = { "start", "txrx", "ack", "end" };
+  struct tsch_slot_timing timing;
+  int type, is_tx, i;
+
+  for(type = 0; type <= LINK_TYPE_ADVERTISING_ONLY; type++) {
+    for(is_tx = 0; is_tx <= 1; is_tx++) {
+      tsch_slot_timing_get(type, is_tx, &timing);
+      if(timing.point[TSCH_SLOT_TIMING_START].count == 0) {
+        continue;
+      }
+      printf("slot timing %s %s: %lu slots, timeslot %lu us\n",
+             link_type_str[type], is_tx ? "tx" : "rx",
+             (unsigned long)timing.point[TSCH_SLOT_TIMING_START].count,
+             (unsigned long)tsch_timing_us[tsch_ts_timeslot_length]);
+      for(i = 0; i < TSCH_SLOT_TIMING_POINT_COUNT; i++) {
+        struct tsch_slot_timing_stats *stats = &timing.point[i];
+        if(stats->count == 0) {
+          continue;
+        }
+        printf("  %-5s min %lu avg %lu max %lu us\n", point_str[i],
+               (unsigned long)RTIMERTICKS_TO_US(stats->min),
+               (unsigned long)RTIMERTICKS_TO_US((uint32_t)(stats->sum / stats->count)),
+               (unsigned long)RTIMERTICKS_TO_US(stats->max));
+      }
+      printf("  end histogram:");
+      for(i = 0; i < TSCH_SLOT_TIMING_HIST_BINS; i++) {
+        printf(" %lu", (unsigned long)timing.histogram[i]);
+      }
+      printf("\n");
+    }
+  }
+}
+#endif /* TSCH_WITH_SLOT_TIMING */
 /*---------------------------------------------------------------------------*/
 /* TSCH locking system. TSCH is locked during slot operations */
 
@@ -754,6 +903,7 @@ PT_THREAD(tsch_tx_slot(struct pt *pt, struct rtimer *t))
           TSCH_DEBUG_TX_EVENT();
 
           TSCH_DEBUG_TX_SLOT_TX_START();
+          SLOT_TIMING_MARK(TSCH_SLOT_TIMING_TXRX);
 
           /* send packet already in radio tx buffer */
           mac_tx_status = NETSTACK_RADIO.transmit(packet_len);
@@ -812,6 +962,7 @@ PT_THREAD(tsch_tx_slot(struct pt *pt, struct rtimer *t))
                                  ack_start_time, tsch_timing[tsch_ts_max_ack]);
               TSCH_DEBUG_TX_EVENT();
               TSCH_DEBUG_TX_SLOT_ACK_WAIT_END();
+              SLOT_TIMING_MARK(TSCH_SLOT_TIMING_ACK);
 
               tsch_radio_off(TSCH_RADIO_CMD_OFF_WITHIN_TIMESLOT);
 
@@ -1003,6 +1154,7 @@ PT_THREAD(tsch_rx_slot(struct pt *pt, struct rtimer *t))
     TSCH_DEBUG_RX_EVENT();
 
     TSCH_DEBUG_RX_SLOT_RX_START();
+    SLOT_TIMING_MARK(TSCH_SLOT_TIMING_TXRX);
 
     /* Start radio for at least guard time */
     tsch_radio_on(TSCH_RADIO_CMD_ON_WITHIN_TIMESLOT);
@@ -1036,7 +1188,7 @@ PT_THREAD(tsch_rx_slot(struct pt *pt, struct rtimer *t))
       if(NETSTACK_RADIO.pending_packet()) {
         static int frame_valid;
         static int header_len;
-        static frame802154_t frame;
+        static frame802154_t *frame;
         radio_value_t radio_last_rssi;
         radio_value_t radio_last_lqi;
 
@@ -1046,10 +1198,13 @@ PT_THREAD(tsch_rx_slot(struct pt *pt, struct rtimer *t))
         current_input->rx_asn = tsch_current_asn;
         current_input->rssi = (signed)radio_last_rssi;
         current_input->channel = tsch_current_channel;
-        header_len = frame802154_parse((uint8_t *)current_input->payload, current_input->len, &frame);
+        /* Parse into the input packet, the result is reused by tsch.c */
+        frame = &current_input->frame;
+        header_len = frame802154_parse((uint8_t *)current_input->payload, current_input->len, frame);
+        current_input->hdr_len = header_len;
         frame_valid = header_len > 0 &&
-          frame802154_check_dest_panid(&frame) &&
-          frame802154_extract_linkaddr(&frame, &source_address, &destination_address);
+          frame802154_check_dest_panid(frame) &&
+          frame802154_extract_linkaddr(frame, &source_address, &destination_address);
 
 #if TSCH_RESYNC_WITH_SFD_TIMESTAMPS
         /* At the end of the reception, get an more accurate estimate of SFD arrival time */
@@ -1071,12 +1226,12 @@ PT_THREAD(tsch_rx_slot(struct pt *pt, struct rtimer *t))
         }
 
         if(frame_valid) {
-          if(frame.fcf.frame_type != FRAME802154_DATAFRAME
-            && frame.fcf.frame_type != FRAME802154_BEACONFRAME
-            && frame.fcf.frame_type != FRAME802154_JOINFRAME) {
+          if(frame->fcf.frame_type != FRAME802154_DATAFRAME
+            && frame->fcf.frame_type != FRAME802154_BEACONFRAME
+            && frame->fcf.frame_type != FRAME802154_JOINFRAME) {
               TSCH_LOG_ADD(tsch_log_message,
                   snprintf(log->message, sizeof(log->message),
-                  "!discarding frame with type %u, len %u", frame.fcf.frame_type, current_input->len));
+                  "!discarding frame with type %u, len %u", frame->fcf.frame_type, current_input->len));
               frame_valid = 0;
           }
         }
@@ -1085,14 +1240,15 @@ PT_THREAD(tsch_rx_slot(struct pt *pt, struct rtimer *t))
         /* Decrypt and verify incoming frame */
         if(frame_valid) {
           if(tsch_security_parse_frame(
-               current_input->payload, header_len, current_input->len - header_len - tsch_security_mic_len(&frame),
-               &frame, &source_address, &tsch_current_asn)) {
-            current_input->len -= tsch_security_mic_len(&frame);
+               current_input->payload, header_len, current_input->len - header_len - tsch_security_mic_len(frame),
+               frame, &source_address, &tsch_current_asn)) {
+            frame->payload_len -= tsch_security_mic_len(frame);
+            current_input->len -= tsch_security_mic_len(frame);
           } else {
             TSCH_LOG_ADD(tsch_log_message,
                 snprintf(log->message, sizeof(log->message),
                 "!failed to authenticate frame %u from 0x%02x%02x ", current_input->len,
-                frame.src_addr[0], frame.src_addr[1]));
+                frame->src_addr[0], frame->src_addr[1]));
             frame_valid = 0;
           }
         }
@@ -1108,6 +1264,9 @@ PT_THREAD(tsch_rx_slot(struct pt *pt, struct rtimer *t))
             int do_nack = 0;
             static uint8_t ack_app_data = 0;
             rx_count++;
+#ifdef TSCH_CALLBACK_RX_VALID_FRAME
+            TSCH_CALLBACK_RX_VALID_FRAME(current_input->len);
+#endif
             estimated_drift = RTIMER_CLOCK_DIFF(expected_rx_time, rx_start_time);
             tsch_stats_on_time_synchronization(estimated_drift);
 
@@ -1123,23 +1282,23 @@ PT_THREAD(tsch_rx_slot(struct pt *pt, struct rtimer *t))
 #endif
 
 #ifdef TSCH_CALLBACK_DO_NACK
-            if(frame.fcf.ack_required) {
+            if(frame->fcf.ack_required) {
               do_nack = TSCH_CALLBACK_DO_NACK(current_link,
                   &source_address, &destination_address);
             }
 #endif
 
-            if(frame.fcf.ack_required) {
+            if(frame->fcf.ack_required) {
               static uint8_t ack_buf[TSCH_PACKET_MAX_LEN];
               static int ack_len;
 
 #ifdef TSCH_CALLBACK_ACK_APP_IE_TX
-              ack_app_data = TSCH_CALLBACK_ACK_APP_IE_TX(&source_address, frame.payload);
+              ack_app_data = TSCH_CALLBACK_ACK_APP_IE_TX(&source_address, frame->payload, frame->payload_len);
 #endif
 
               /* Build ACK frame */
               ack_len = tsch_packet_create_eack(ack_buf, sizeof(ack_buf),
-                  &source_address, frame.seq, (int16_t)RTIMERTICKS_TO_US(estimated_drift), do_nack, ack_app_data);
+                  &source_address, frame->seq, (int16_t)RTIMERTICKS_TO_US(estimated_drift), do_nack, ack_app_data);
 
               if(ack_len > 0) {
 #if LLSEC802154_ENABLED
@@ -1162,6 +1321,7 @@ PT_THREAD(tsch_rx_slot(struct pt *pt, struct rtimer *t))
                 NETSTACK_RADIO.transmit(ack_len);
                 tsch_radio_off(TSCH_RADIO_CMD_OFF_WITHIN_TIMESLOT);
                 TSCH_DEBUG_RX_SLOT_ACK_SEND_END();
+                SLOT_TIMING_MARK(TSCH_SLOT_TIMING_ACK);
 
 #if FCF_FRAME_PENDING_ENABLE
                 /* Schedule a burst link iff the frame pending bit was set */
@@ -1185,7 +1345,8 @@ PT_THREAD(tsch_rx_slot(struct pt *pt, struct rtimer *t))
               tsch_schedule_keepalive(0);
             }
 #ifdef TSCH_CALLBACK_ACK_APP_IE_TX
-            if(ack_app_data)
+            /* Frames without ACK did not go through the callback */
+            if(ack_app_data || !frame->fcf.ack_required)
             {
               /* Add current input to ringbuf */
               ringbufindex_put(&input_ringbuf);
@@ -1203,15 +1364,15 @@ PT_THREAD(tsch_rx_slot(struct pt *pt, struct rtimer *t))
 
             /* Log every reception */
             TSCH_LOG_ADD(tsch_log_rx,
-              linkaddr_copy(&log->rx.src, (linkaddr_t *)&frame.src_addr);
-              log->rx.is_unicast = frame.fcf.ack_required;
+              linkaddr_copy(&log->rx.src, (linkaddr_t *)&frame->src_addr);
+              log->rx.is_unicast = frame->fcf.ack_required;
               log->rx.datalen = current_input->len;
               log->rx.drift = drift_correction;
               log->rx.drift_used = is_drift_correction_used;
-              log->rx.is_data = frame.fcf.frame_type == FRAME802154_DATAFRAME;
-              log->rx.sec_level = frame.aux_hdr.security_control.security_level;
+              log->rx.is_data = frame->fcf.frame_type == FRAME802154_DATAFRAME;
+              log->rx.sec_level = frame->aux_hdr.security_control.security_level;
               log->rx.estimated_drift = estimated_drift;
-              log->rx.seqno = frame.seq;
+              log->rx.seqno = frame->seq;
               log->rx.ack_data = ack_app_data;
             );
           }
@@ -1371,6 +1532,7 @@ PT_THREAD(tsch_slot_operation(struct rtimer *t, void *ptr))
         }
 
         TSCH_DEBUG_SLOT_START();
+        SLOT_TIMING_BEGIN(current_link->link_type, current_packet != NULL);
 
         /* Decide whether it is a TX/RX/IDLE or OFF slot */
         /* Actual slot operation */
@@ -1399,6 +1561,7 @@ PT_THREAD(tsch_slot_operation(struct rtimer *t, void *ptr))
       }
       TSCH_DEBUG_SLOT_END();
       TSCH_DEBUG_SLOT_SLOT_END();
+      SLOT_TIMING_COMMIT();
     }
 
     /* End of slot operation, schedule next slot or resynchronize */
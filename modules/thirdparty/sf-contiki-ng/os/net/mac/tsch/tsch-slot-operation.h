@@ -62,6 +62,32 @@ extern int tsch_current_burst_count;
 /* Are we currently inside a slot? Do not change this variable outside of TSCH. */
 extern volatile int tsch_in_slot_operation;
 
+#if TSCH_WITH_SLOT_TIMING
+/* Timing points of a slot operation */
+enum tsch_slot_timing_point {
+  TSCH_SLOT_TIMING_START,  /* Slot operation started */
+  TSCH_SLOT_TIMING_TXRX,   /* Tx started or Rx listening started */
+  TSCH_SLOT_TIMING_ACK,    /* ACK wait (Tx) or ACK transmission (Rx) done */
+  TSCH_SLOT_TIMING_END,    /* Slot operation done */
+  TSCH_SLOT_TIMING_POINT_COUNT
+};
+
+/* Statistics of one timing point, in rtimer ticks after the slot start */
+struct tsch_slot_timing_stats {
+  uint32_t count;
+  uint64_t sum; /* 64 bit: a 32-bit sum of slot offsets wraps within a day */
+  uint32_t min;
+  uint32_t max;
+};
+
+/* Aggregated timing of the slots of one link type and direction */
+struct tsch_slot_timing {
+  struct tsch_slot_timing_stats point[TSCH_SLOT_TIMING_POINT_COUNT];
+  /* Slot end histogram, see TSCH_SLOT_TIMING_HIST_BINS */
+  uint32_t histogram[TSCH_SLOT_TIMING_HIST_BINS];
+};
+#endif /* TSCH_WITH_SLOT_TIMING */
+
 /********** Functions *********/
 
 /**
@@ -119,6 +145,28 @@ void tsch_set_last_eb_timestamp(uint32_t timestamp);
 uint8_t app_calculate_channel(struct tsch_asn_t *asn, uint16_t channel_offset);
 #endif
 
+#if TSCH_WITH_SLOT_TIMING
+/**
+ * \brief Get a consistent copy of the recorded slot timing. Can be called
+ *        from outside of interrupts at any time, without taking the lock.
+ * \param link_type The link type of the slots
+ * \param is_tx 1 for Tx slots, 0 for Rx slots
+ * \param timing Where to copy the timing to
+ */
+void tsch_slot_timing_get(enum link_type link_type, uint8_t is_tx,
+                          struct tsch_slot_timing *timing);
+
+/**
+ * \brief Clear the recorded slot timing
+ */
+void tsch_slot_timing_reset(void);
+
+/**
+ * \brief Print the recorded slot timing of all link types, in microseconds
+ */
+void tsch_slot_timing_print(void);
+#endif /* TSCH_WITH_SLOT_TIMING */
+
 /**
  * \brief Enables listen before talk.
  */
@@ -47,9 +47,23 @@
 #include "net/mac/tsch/tsch-asn.h"
 #include "lib/list.h"
 #include "lib/ringbufindex.h"
+#include "net/mac/framer/frame802154.h"
 
 /********** Data types **********/
 
+#if TSCH_SCHEDULE_WITH_SLOT_INDEX
+/** \brief Index of a link in the link pool, used by the timeslot index */
+#if TSCH_SCHEDULE_MAX_LINKS < 0xff
+typedef uint8_t tsch_link_index_t;
+#define TSCH_LINK_INDEX_NONE 0xff
+#else
+typedef uint16_t tsch_link_index_t;
+#define TSCH_LINK_INDEX_NONE 0xffff
+#endif
+/** \brief Number of 32-bit words of the timeslot occupancy bitmap */
+#define TSCH_SCHEDULE_SLOT_INDEX_WORDS ((TSCH_SCHEDULE_SLOT_INDEX_MAX_LENGTH + 31) / 32)
+#endif /* TSCH_SCHEDULE_WITH_SLOT_INDEX */
+
 /** \brief 802.15.4e link types. LINK_TYPE_ADVERTISING_ONLY is an extra one: for EB-only links. */
 enum link_type { LINK_TYPE_NORMAL, LINK_TYPE_NORMAL_RTX, LINK_TYPE_ADVERTISING, LINK_TYPE_ADVERTISING_ONLY };
 
@@ -78,8 +92,32 @@ struct tsch_link {
   enum link_type link_type;
   /* Any other data for upper layers */
   void *data;
+#if TSCH_SCHEDULE_WITH_SLOT_INDEX
+  /* Next link of the same slotframe at the same timeslot */
+  tsch_link_index_t slot_next;
+#endif /* TSCH_SCHEDULE_WITH_SLOT_INDEX */
+};
+
+/** \brief Description of a link, used to add or remove links in bulk */
+struct tsch_link_desc {
+  /* MAC address of neighbor */
+  linkaddr_t addr;
+  /* Timeslot for this link */
+  uint16_t timeslot;
+  /* Channel offset for this link */
+  uint16_t channel_offset;
+  /* Link options, see struct tsch_link */
+  uint8_t link_options;
+  /* Type of link */
+  enum link_type link_type;
 };
 
+#if TSCH_SCHEDULE_WITH_ACTIVATION
+/** \brief Bounds of the activation window of a slotframe */
+#define TSCH_SLOTFRAME_FROM  0x01
+#define TSCH_SLOTFRAME_UNTIL 0x02
+#endif /* TSCH_SCHEDULE_WITH_ACTIVATION */
+
 /** \brief 802.15.4e slotframe (contains links) */
 struct tsch_slotframe {
   /* Slotframes are stored as a list: "next" must be the first field */
@@ -91,6 +129,37 @@ struct tsch_slotframe {
   struct tsch_asn_divisor_t size;
   /* List of links belonging to this slotframe */
   LIST_STRUCT(links_list);
+#if TSCH_SCHEDULE_WITH_SLOT_INDEX
+  /* One bit per timeslot that has at least one link */
+  uint32_t slot_bitmap[TSCH_SCHEDULE_SLOT_INDEX_WORDS];
+  /* First link of each timeslot, further links chained via slot_next */
+  tsch_link_index_t slot_head[TSCH_SCHEDULE_SLOT_INDEX_MAX_LENGTH];
+#endif /* TSCH_SCHEDULE_WITH_SLOT_INDEX */
+#if TSCH_SCHEDULE_WITH_STATIC_LINKS
+  /* Links in flash sorted by timeslot, see tsch_schedule_set_static_links() */
+  const struct tsch_link *static_links;
+  uint16_t static_links_count;
+  /* One bit per static link, set if the link is enabled */
+  uint32_t *static_links_enabled;
+#endif /* TSCH_SCHEDULE_WITH_STATIC_LINKS */
+#if TSCH_SCHEDULE_WITH_ACTIVATION
+  /* The slotframe is active from ASN active_from (if TSCH_SLOTFRAME_FROM is
+   * set in active_window) up to, excluding, ASN active_until (if
+   * TSCH_SLOTFRAME_UNTIL is set) */
+  struct tsch_asn_t active_from;
+  struct tsch_asn_t active_until;
+  uint8_t active_window;
+#endif /* TSCH_SCHEDULE_WITH_ACTIVATION */
+};
+
+/** \brief Schedule descriptor, announced by the coordinator in EBs. The
+ * slotframe of slotframe_size timeslots with data_slots device positions is
+ * used from activation_asn on. A version of 0 means no descriptor. */
+struct tsch_schedule_desc {
+  uint8_t version;
+  uint16_t slotframe_size;
+  uint16_t data_slots;
+  struct tsch_asn_t activation_asn;
 };
 
 /** \brief TSCH packet information */
@@ -153,6 +222,8 @@ struct input_packet {
   int len; /* Packet len */
   int16_t rssi; /* RSSI for this packet */
   uint8_t channel; /* Channel we received the packet on */
+  uint8_t hdr_len; /* MAC header length */
+  frame802154_t frame; /* Parse result of the MAC header, points into payload */
 };
 
 #endif /* __TSCH_CONF_H__ */
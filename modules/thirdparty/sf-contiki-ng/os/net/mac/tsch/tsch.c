@@ -158,6 +158,8 @@ uint32_t tsch_beacon_absolute_time;
 uint32_t tsch_internal_absolute_time;
 /* join mode */
 uint8_t tsch_join_mode;
+/* schedule descriptor */
+static struct tsch_schedule_desc tsch_schedule_desc;
 /* Beacon scan address for fixed beacon scan. */
 linkaddr_t beaconScan_addr;
 
@@ -188,6 +190,7 @@ PROCESS(tsch_pending_events_process, "pending events process");
 
 /* Other function prototypes */
 static void packet_input(void);
+static void packet_input_parsed(int frame_parsed);
 
 /* Getters and setters */
 
@@ -263,6 +266,18 @@ tsch_get_join_mode(void)
 }
 /*---------------------------------------------------------------------------*/
 void
+tsch_set_schedule_desc(const struct tsch_schedule_desc *desc)
+{
+  tsch_schedule_desc = *desc;
+}
+/*---------------------------------------------------------------------------*/
+const struct tsch_schedule_desc *
+tsch_get_schedule_desc(void)
+{
+  return &tsch_schedule_desc;
+}
+/*---------------------------------------------------------------------------*/
+void
 tsch_set_ka_timeout(uint32_t timeout)
 {
   tsch_current_ka_timeout = timeout;
@@ -564,6 +579,15 @@ eb_input(struct input_packet *current_input)
       }
     }
 
+    if(!tsch_is_coordinator && eb_ies.ie_schedule_desc.version != 0 &&
+       eb_ies.ie_schedule_desc.version != tsch_schedule_desc.version)
+    {
+      tsch_schedule_desc = eb_ies.ie_schedule_desc;
+#ifdef TSCH_CALLBACK_SCHEDULE_DESC
+      TSCH_CALLBACK_SCHEDULE_DESC(&tsch_schedule_desc);
+#endif
+    }
+
 #if TSCH_AUTOSELECT_TIME_SOURCE
     if(!tsch_is_coordinator) {
       /* Maintain EB received counter for every neighbor */
@@ -650,24 +674,40 @@ tsch_rx_process_pending()
   /* Loop on accessing (without removing) a pending input packet */
   while((input_index = ringbufindex_peek_get(&input_ringbuf)) != -1) {
     struct input_packet *current_input = &input_array[input_index];
-    frame802154_t frame;
-    uint8_t ret = frame802154_parse(current_input->payload, current_input->len, &frame);
-    int is_data = ret && ((frame.fcf.frame_type == FRAME802154_DATAFRAME) || (frame.fcf.frame_type == FRAME802154_JOINFRAME));
-    int is_eb = ret
-      && frame.fcf.frame_version == FRAME802154_IEEE802154_2015
-      && frame.fcf.frame_type == FRAME802154_BEACONFRAME;
+    /* The frame has been parsed in the slot operation already */
+    frame802154_t *frame = &current_input->frame;
+    int is_data = (frame->fcf.frame_type == FRAME802154_DATAFRAME) || (frame->fcf.frame_type == FRAME802154_JOINFRAME);
+    int is_eb = frame->fcf.frame_version == FRAME802154_IEEE802154_2015
+      && frame->fcf.frame_type == FRAME802154_BEACONFRAME;
 
     if(is_data) {
       /* Skip EBs and other control messages */
+#if TSCH_RX_ZERO_COPY
+      /* Lend the input packet to the packetbuf for processing */
+      packetbuf_reference(current_input->payload, current_input->len);
+#else /* TSCH_RX_ZERO_COPY */
       /* Copy to packetbuf for processing */
       packetbuf_copyfrom(current_input->payload, current_input->len);
+#endif /* TSCH_RX_ZERO_COPY */
       packetbuf_set_attr(PACKETBUF_ATTR_RSSI, current_input->rssi);
       packetbuf_set_attr(PACKETBUF_ATTR_CHANNEL, current_input->channel);
     }
 
     if(is_data) {
       /* Pass to upper layers */
+#ifdef NETSTACK_CONF_FRAMER
       packet_input();
+#else /* NETSTACK_CONF_FRAMER */
+      /* Default framer: reuse the parse result instead of parsing again */
+      packet_input_parsed(framer_802154_parse_frame(frame, current_input->hdr_len));
+#endif /* NETSTACK_CONF_FRAMER */
+#if TSCH_RX_ZERO_COPY
+      /* The input packet is released below, drop the reference if the
+       * upper layers did not reuse the packetbuf */
+      if(packetbuf_is_reference()) {
+        packetbuf_clear();
+      }
+#endif /* TSCH_RX_ZERO_COPY */
     } else if(is_eb) {
       eb_input(current_input);
     }
@@ -910,6 +950,9 @@ tsch_associate(const struct input_packet *input_eb, rtimer_clock_t timestamp)
       /* Start sending keep-alives now that tsch_is_associated is set */
       tsch_schedule_keepalive(0);
 
+      /* Schedule the coordinator announced, if any */
+      tsch_schedule_desc = ies.ie_schedule_desc;
+
 #ifdef TSCH_CALLBACK_JOINING_NETWORK
       TSCH_CALLBACK_JOINING_NETWORK();
 #endif
@@ -1370,10 +1413,13 @@ send_packet(mac_callback_t sent, void *ptr)
 static void
 packet_input(void)
 {
-  int frame_parsed = 1;
-
-  frame_parsed = NETSTACK_FRAMER.parse();
-
+  packet_input_parsed(NETSTACK_FRAMER.parse());
+}
+/*---------------------------------------------------------------------------*/
+/* Input a packet whose MAC header has been removed by the framer already */
+static void
+packet_input_parsed(int frame_parsed)
+{
   if(frame_parsed < 0) {
     LOG_ERR("! failed to parse %u\n", packetbuf_datalen());
   } else {
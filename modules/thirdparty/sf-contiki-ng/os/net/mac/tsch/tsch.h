@@ -106,9 +106,11 @@ frequency hopping for enhanced reliability.
 
 #endif /* BUILD_WITH_ORCHESTRA */
 
-/* Called by TSCH when get PAN ID */
+/* Called by TSCH when building the enhanced ACK of a received frame. Returns
+ * the application byte of the ACK, frames for which 0 is returned are not
+ * passed to the upper layers. Runs in the timeslot, within the ACK delay */
 #ifdef TSCH_CALLBACK_ACK_APP_IE_TX
-uint8_t TSCH_CALLBACK_ACK_APP_IE_TX( const linkaddr_t *dest_addr, const void *data );
+uint8_t TSCH_CALLBACK_ACK_APP_IE_TX( const linkaddr_t *dest_addr, const void *data, uint16_t len );
 #endif
 
 /* Called by TSCH when get PAN ID */
@@ -150,6 +152,12 @@ void TSCH_CALLBACK_INCREMENT_TX_OP_COUNTER(uint32_t sentPacketLength);
 void TSCH_CALLBACK_INCREMENT_RX_OP_COUNTER(uint32_t receivedPacketLength);
 #endif
 
+/* Called by TSCH from interrupt after receiving a valid frame for this node,
+ * i.e. parsed, authenticated and addressed to it */
+#ifdef TSCH_CALLBACK_RX_VALID_FRAME
+void TSCH_CALLBACK_RX_VALID_FRAME(uint32_t receivedPacketLength);
+#endif
+
 /* Called by TSCH before sending a EB */
 #ifdef TSCH_RPL_CHECK_DODAG_JOINED
 int TSCH_RPL_CHECK_DODAG_JOINED();
@@ -167,6 +175,12 @@ struct tsch_neighbor;
 void TSCH_CALLBACK_NEW_TIME_SOURCE(const struct tsch_neighbor *old, const struct tsch_neighbor *new);
 #endif
 
+/* Called by TSCH when an EB announces a new schedule descriptor. Not called
+ * on the coordinator */
+#ifdef TSCH_CALLBACK_SCHEDULE_DESC
+void TSCH_CALLBACK_SCHEDULE_DESC(const struct tsch_schedule_desc *desc);
+#endif
+
 /* Called by TSCH every time a packet is ready to be added to the send queue */
 #ifdef TSCH_CALLBACK_PACKET_READY
 int TSCH_CALLBACK_PACKET_READY(void);
@@ -272,6 +286,18 @@ void tsch_set_join_mode(uint8_t m);
  * Get the TSCH join mode (JM)
  */
 uint8_t tsch_get_join_mode(void);
+/**
+ * Set the schedule descriptor announced in EBs, see
+ * TSCH_PACKET_CONF_EB_WITH_SCHEDULE_DESC
+ *
+ * \param desc the new schedule descriptor
+ */
+void tsch_set_schedule_desc(const struct tsch_schedule_desc *desc);
+/**
+ * Get the schedule descriptor, the announced one on the coordinator, the
+ * last received one on other nodes
+ */
+const struct tsch_schedule_desc *tsch_get_schedule_desc(void);
 
 void tsch_set_hopping_sequence(const uint8_t hoppingSequence[], uint16_t length);
 
@@ -58,6 +58,9 @@
 
 uint8_t *nullnet_buf;
 uint16_t nullnet_len;
+#if TSCH_WITH_QUEUE_COALESCING
+uint16_t nullnet_coalesce_key;
+#endif /* TSCH_WITH_QUEUE_COALESCING */
 static nullnet_input_callback_t current_input_callback = NULL;
 static nullnet_output_callback_t current_output_callback = NULL;
 
@@ -197,6 +200,10 @@ output(const linkaddr_t *dest, void *ptr, const uint8_t frameType)
   packetbuf_set_addr(PACKETBUF_ADDR_SENDER, &linkaddr_node_addr);
 
   packetbuf_set_attr(PACKETBUF_ATTR_MAX_MAC_TRANSMISSIONS, transmissionsAttr);
+#if TSCH_WITH_QUEUE_COALESCING
+  packetbuf_set_attr(PACKETBUF_ATTR_TSCH_COALESCE_KEY, nullnet_coalesce_key);
+  nullnet_coalesce_key = 0;
+#endif /* TSCH_WITH_QUEUE_COALESCING */
 
   packetbuf_set_attr(PACKETBUF_ATTR_FRAME_TYPE, frameType);
 
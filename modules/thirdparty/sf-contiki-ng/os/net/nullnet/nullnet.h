@@ -51,12 +51,20 @@ for non-IPv6 scenarios.
 
 #include "contiki.h"
 #include "net/linkaddr.h"
+#include "net/packetbuf.h"
 
 /**
  * Buffer used by the output function
 */
 extern uint8_t *nullnet_buf;
 extern uint16_t nullnet_len;
+#if TSCH_WITH_QUEUE_COALESCING
+/**
+ * Coalescing key of the next output, see TSCH_CONF_WITH_QUEUE_COALESCING.
+ * Reset to 0 by the output function
+*/
+extern uint16_t nullnet_coalesce_key;
+#endif /* TSCH_WITH_QUEUE_COALESCING */
 
 /* Generic NULLNET return values. */
 typedef enum {
@@ -76,6 +76,7 @@ packetbuf_clear(void)
 {
   buflen = bufptr = 0;
   hdrlen = 0;
+  packetbuf = (uint8_t *)packetbuf_aligned;
 
   packetbuf_attr_clear();
 }
@@ -93,6 +94,21 @@ packetbuf_copyfrom(const void *from, uint16_t len)
 }
 /*---------------------------------------------------------------------------*/
 int
+packetbuf_reference(void *ptr, uint16_t len)
+{
+  packetbuf_clear();
+  packetbuf = ptr;
+  buflen = MIN(PACKETBUF_SIZE, len);
+  return buflen;
+}
+/*---------------------------------------------------------------------------*/
+int
+packetbuf_is_reference(void)
+{
+  return packetbuf != (uint8_t *)packetbuf_aligned;
+}
+/*---------------------------------------------------------------------------*/
+int
 packetbuf_copyto(void *to)
 {
   if(hdrlen + buflen > PACKETBUF_SIZE) {
@@ -112,6 +128,12 @@ packetbuf_hdralloc(int size)
     return 0;
   }
 
+  /* the external data has no room for the header */
+  if(packetbuf_is_reference()) {
+    memcpy(packetbuf_aligned, packetbuf, packetbuf_totlen());
+    packetbuf = (uint8_t *)packetbuf_aligned;
+  }
+
   /* shift data to the right */
   for(i = packetbuf_totlen() - 1; i >= 0; i--) {
     packetbuf[i + size] = packetbuf[i];
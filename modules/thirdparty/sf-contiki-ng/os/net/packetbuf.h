@@ -146,6 +146,27 @@ void packetbuf_set_datalen(uint16_t len);
  */
 int packetbuf_copyfrom(const void *from, uint16_t len);
 
+/**
+ * \brief      Point the packetbuf to external data instead of copying it
+ * \param ptr  A pointer to the data
+ * \param len  The size of the data
+ * \retval     The number of bytes that are referenced by the packetbuf
+ *
+ *             This function clears the packetbuf and lends the external
+ *             data to it. The data must stay valid until the reference is
+ *             dropped by packetbuf_clear() or packetbuf_copyfrom().
+ *             Allocating a header copies the data into the packetbuf
+ *             first, everything else reads and writes the external data.
+ *
+ */
+int packetbuf_reference(void *ptr, uint16_t len);
+
+/**
+ * \brief      Check if the packetbuf references external data
+ * \retval     Non-zero if the packetbuf references external data
+ */
+int packetbuf_is_reference(void);
+
 /**
  * \brief      Copy the entire packetbuf to an external buffer
  * \param to   A pointer to the buffer to which the data is to be copied
@@ -229,6 +250,9 @@ enum {
   PACKETBUF_ATTR_TSCH_TIMESLOT,
   PACKETBUF_ATTR_TSCH_CHANNEL_OFFSET,
 #endif /* TSCH_WITH_LINK_SELECTOR */
+#if TSCH_WITH_QUEUE_COALESCING
+  PACKETBUF_ATTR_TSCH_COALESCE_KEY,
+#endif /* TSCH_WITH_QUEUE_COALESCING */
 
   /* Scope 1 attributes: used between two neighbors only. */
   PACKETBUF_ATTR_FRAME_TYPE,
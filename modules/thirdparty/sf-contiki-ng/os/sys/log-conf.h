@@ -105,6 +105,55 @@
 #define LOG_OUTPUT_PREFIX(level, levelstr, module) LOG_OUTPUT("[%-4s: %-10s] ", levelstr, module)
 #endif /* LOG_CONF_OUTPUT_PREFIX */
 
+/* Binary logging. The LOG_BIN_* macros store a log ID plus the raw
+ * arguments in a ring buffer that is drained to LOG_BINARY_OUTPUT by a
+ * process; tools/log-decoder.py renders the text on the host.
+ * Disabled by default */
+#ifdef LOG_CONF_BINARY
+#define LOG_BINARY LOG_CONF_BINARY
+#else /* LOG_CONF_BINARY */
+#define LOG_BINARY 0
+#endif /* LOG_CONF_BINARY */
+
+/* Size of the binary log ring buffer in bytes, must be a power of two */
+#ifdef LOG_CONF_BINARY_BUF_LEN
+#define LOG_BINARY_BUF_LEN LOG_CONF_BINARY_BUF_LEN
+#else /* LOG_CONF_BINARY_BUF_LEN */
+#define LOG_BINARY_BUF_LEN 512
+#endif /* LOG_CONF_BINARY_BUF_LEN */
+
+/* Number of binary log modules (upper byte of a log ID) */
+#ifdef LOG_CONF_BINARY_MODULE_MAX
+#define LOG_BINARY_MODULE_MAX LOG_CONF_BINARY_MODULE_MAX
+#else /* LOG_CONF_BINARY_MODULE_MAX */
+#define LOG_BINARY_MODULE_MAX 16
+#endif /* LOG_CONF_BINARY_MODULE_MAX */
+
+/* Default maximum number of binary log records per module and second,
+ * 0 disables the rate limit */
+#ifdef LOG_CONF_BINARY_RATE
+#define LOG_BINARY_RATE LOG_CONF_BINARY_RATE
+#else /* LOG_CONF_BINARY_RATE */
+#define LOG_BINARY_RATE 32
+#endif /* LOG_CONF_BINARY_RATE */
+
+/* Number of bytes the drain process writes before it yields */
+#ifdef LOG_CONF_BINARY_CHUNK_LEN
+#define LOG_BINARY_CHUNK_LEN LOG_CONF_BINARY_CHUNK_LEN
+#else /* LOG_CONF_BINARY_CHUNK_LEN */
+#define LOG_BINARY_CHUNK_LEN 64
+#endif /* LOG_CONF_BINARY_CHUNK_LEN */
+
+/* Custom raw output function for binary logs -- default is stdout */
+#ifdef LOG_CONF_BINARY_OUTPUT
+#define LOG_BINARY_OUTPUT(data, len) LOG_CONF_BINARY_OUTPUT(data, len)
+#else /* LOG_CONF_BINARY_OUTPUT */
+#define LOG_BINARY_OUTPUT(data, len) do { \
+                                       fwrite((data), 1, (len), stdout); \
+                                       fflush(stdout); \
+                                     } while(0)
+#endif /* LOG_CONF_BINARY_OUTPUT */
+
 /******************************************************************************/
 /********************* A list of currently supported modules ******************/
 /******************************************************************************/
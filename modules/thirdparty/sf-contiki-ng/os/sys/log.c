@@ -50,6 +50,10 @@
 
 #include <string.h>
 #include "sys/log.h"
+#if LOG_BINARY
+#include "contiki.h"
+#include "sys/int-master.h"
+#endif /* LOG_BINARY */
 #if UIP_CONF_ENABLE
 #include "net/ipv6/ip64-addr.h"
 #include "net/ipv6/uiplib.h"
@@ -222,5 +226,230 @@ log_level_to_str(int level)
       return "N/A";
   }
 }
+/*---------------------------------------------------------------------------*/
+#if LOG_BINARY
+
+/* Check if LOG_BINARY_BUF_LEN is a power of two the 16-bit indexes can hold */
+#if (LOG_BINARY_BUF_LEN & (LOG_BINARY_BUF_LEN - 1)) != 0 || LOG_BINARY_BUF_LEN > 32768
+#error LOG_BINARY_BUF_LEN must be a power of two not above 32768
+#endif
+
+/* Records of the log itself */
+enum {
+  LOG_ID_LOG_DROPPED = 0x0001, /*! "%u records of module %u dropped" */
+};
+
+/* Rate limit of a module, counted in windows of one second */
+struct log_bin_limit {
+  clock_time_t window_start;
+  uint16_t rate;
+  uint16_t count;
+  uint16_t dropped;
+};
+
+PROCESS(log_bin_process, "Binary log");
+
+static uint8_t log_bin_buf[LOG_BINARY_BUF_LEN];
+/* Free-running ring buffer indexes, the head is only updated once a record
+   is complete */
+static volatile uint16_t log_bin_head;
+static volatile uint16_t log_bin_tail;
+static struct log_bin_limit log_bin_limits[LOG_BINARY_MODULE_MAX];
+/*---------------------------------------------------------------------------*/
+static uint8_t
+log_bin_varint_len(uint32_t value)
+{
+  uint8_t len = 1;
+  while(value >= 0x80) {
+    value >>= 7;
+    len++;
+  }
+  return len;
+}
+/*---------------------------------------------------------------------------*/
+static uint16_t
+log_bin_put(uint16_t index, const uint8_t *data, size_t length)
+{
+  while(length--) {
+    log_bin_buf[index++ & (LOG_BINARY_BUF_LEN - 1)] = *data++;
+  }
+  return index;
+}
+/*---------------------------------------------------------------------------*/
+static uint16_t
+log_bin_put_varint(uint16_t index, uint32_t value)
+{
+  while(value >= 0x80) {
+    log_bin_buf[index++ & (LOG_BINARY_BUF_LEN - 1)] = (value & 0x7f) | 0x80;
+    value >>= 7;
+  }
+  log_bin_buf[index++ & (LOG_BINARY_BUF_LEN - 1)] = value;
+  return index;
+}
+/*---------------------------------------------------------------------------*/
+/* Counts a record against the rate of its module.
+ * Returns 1 if the record may be logged, 0 otherwise */
+static int
+log_bin_limit_check(struct log_bin_limit *limit, clock_time_t now)
+{
+  if(limit->rate == 0) {
+    return 1;
+  }
+  if(now - limit->window_start >= CLOCK_SECOND) {
+    limit->window_start = now;
+    limit->count = 0;
+  }
+  if(limit->count >= limit->rate) {
+    return 0;
+  }
+  limit->count++;
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Adds a record to the ring buffer.
+ * Returns 1 if success, 0 if the record was dropped */
+static int
+log_bin_add(uint16_t id, uint8_t level, const uint32_t *args,
+            uint8_t argc, const void *data, size_t length)
+{
+  uint8_t header[2 + LOG_BIN_HEADER_LEN];
+  struct log_bin_limit *limit;
+  clock_time_t now = clock_time();
+  int_master_status_t status;
+  size_t args_len = 0;
+  size_t record_len;
+  uint16_t index;
+  uint8_t i;
+
+  limit = &log_bin_limits[MIN(id >> 8, LOG_BINARY_MODULE_MAX - 1)];
+
+  for(i = 0; i < argc; i++) {
+    uint8_t arg_len = log_bin_varint_len(args[i]);
+    if(LOG_BIN_HEADER_LEN + args_len + arg_len > LOG_BIN_RECORD_MAX) {
+      argc = i;
+      break;
+    }
+    args_len += arg_len;
+  }
+  if(data == NULL) {
+    length = 0;
+  }
+  length = MIN(length, LOG_BIN_RECORD_MAX - LOG_BIN_HEADER_LEN - args_len);
+  record_len = LOG_BIN_HEADER_LEN + args_len + length;
+
+  header[0] = LOG_BIN_SYNC;
+  header[1] = record_len;
+  header[2] = id & 0xff;
+  header[3] = id >> 8;
+  header[4] = level;
+  header[5] = (uint32_t)now & 0xff;
+  header[6] = ((uint32_t)now >> 8) & 0xff;
+  header[7] = ((uint32_t)now >> 16) & 0xff;
+  header[8] = ((uint32_t)now >> 24) & 0xff;
+  header[9] = argc;
+
+  status = int_master_read_and_disable();
+  if(!log_bin_limit_check(limit, now)
+     || (uint16_t)(log_bin_head - log_bin_tail) + 2 + record_len > LOG_BINARY_BUF_LEN) {
+    if(limit->dropped != 0xffff) {
+      limit->dropped++;
+    }
+    int_master_status_set(status);
+    process_poll(&log_bin_process);
+    return 0;
+  }
+  index = log_bin_put(log_bin_head, header, sizeof(header));
+  for(i = 0; i < argc; i++) {
+    index = log_bin_put_varint(index, args[i]);
+  }
+  index = log_bin_put(index, (const uint8_t *)data, length);
+  log_bin_head = index;
+  int_master_status_set(status);
+
+  process_poll(&log_bin_process);
+  return 1;
+}
+/*---------------------------------------------------------------------------*/
+/* Adds a record for each module that dropped records since the last report.
+ * Returns 1 if any module dropped records, 0 otherwise */
+static int
+log_bin_report_dropped(void)
+{
+  int reported = 0;
+  uint8_t module;
+  for(module = 0; module < LOG_BINARY_MODULE_MAX; module++) {
+    uint32_t args[2];
+    int_master_status_t status;
+    args[0] = log_bin_limits[module].dropped;
+    if(args[0] == 0) {
+      continue;
+    }
+    args[1] = module;
+    reported = 1;
+    if(log_bin_add(LOG_ID_LOG_DROPPED, LOG_LEVEL_WARN, args, 2, NULL, 0)) {
+      status = int_master_read_and_disable();
+      log_bin_limits[module].dropped -= args[0];
+      int_master_status_set(status);
+    }
+  }
+  return reported;
+}
+/*---------------------------------------------------------------------------*/
+void
+log_bin_write(uint16_t id, uint8_t level, const uint32_t *args,
+              uint8_t argc, const void *data, size_t length)
+{
+  log_bin_add(id, level, args, argc, data, length);
+}
+/*---------------------------------------------------------------------------*/
+void
+log_bin_set_rate(uint8_t module, uint16_t rate)
+{
+  if(module < LOG_BINARY_MODULE_MAX) {
+    log_bin_limits[module].rate = rate;
+  }
+}
+/*---------------------------------------------------------------------------*/
+void
+log_bin_init(void)
+{
+  uint8_t module;
+  /* The reports of the log itself are not limited */
+  for(module = 1; module < LOG_BINARY_MODULE_MAX; module++) {
+    log_bin_limits[module].rate = LOG_BINARY_RATE;
+  }
+  process_start(&log_bin_process, NULL);
+}
+/*---------------------------------------------------------------------------*/
+PROCESS_THREAD(log_bin_process, ev, data)
+{
+  static uint8_t chunk[LOG_BINARY_CHUNK_LEN];
+  static struct etimer report_timer;
+  static uint16_t len;
+  uint16_t i;
+
+  PROCESS_BEGIN();
+
+  while(1) {
+    PROCESS_WAIT_EVENT_UNTIL(ev == PROCESS_EVENT_POLL || ev == PROCESS_EVENT_TIMER);
+    /* Dropped records are reported at most once per second */
+    if(etimer_expired(&report_timer) && log_bin_report_dropped()) {
+      etimer_set(&report_timer, CLOCK_SECOND);
+    }
+    while(log_bin_head != log_bin_tail) {
+      len = MIN((uint16_t)(log_bin_head - log_bin_tail), sizeof(chunk));
+      for(i = 0; i < len; i++) {
+        chunk[i] = log_bin_buf[(log_bin_tail + i) & (LOG_BINARY_BUF_LEN - 1)];
+      }
+      LOG_BINARY_OUTPUT(chunk, len);
+      log_bin_tail += len;
+      /* Let pending events run between chunks */
+      PROCESS_PAUSE();
+    }
+  }
+
+  PROCESS_END();
+}
+#endif /* LOG_BINARY */
 /** @} */
 /** @} */
@@ -233,6 +233,110 @@ extern struct log_module all_modules[];
 #define LOG_INFO_ENABLED       ((LOG_LEVEL) >= LOG_LEVEL_INFO)
 #define LOG_DBG_ENABLED        ((LOG_LEVEL) >= LOG_LEVEL_DBG)
 
+/* Binary logging, see LOG_CONF_BINARY in log-conf.h.
+
+   A record on LOG_BINARY_OUTPUT is
+     LOG_BIN_SYNC | len | id (le16) | level | clock_time (le32) | argc |
+     argc * arg (unsigned LEB128) | data
+   where len counts the bytes after the len field. The arguments are
+   32-bit values, small values take a single byte on the output. The upper
+   byte of the ID is the module, the rate limit applies per module.
+   Module 0 is used by the log itself to report dropped records.
+
+   The ID of a record is bound to its format string in the source: an
+   enumerator LOG_ID_<name> = <value>, followed by a doxygen comment that
+   holds the quoted format string. tools/log-decoder.py collects these
+   definitions to render the logs and prefixes each line with the level
+   and the module name taken from the LOG_BIN_MODULE_<name> definitions.
+   Besides the printf conversions of the arguments, the format supports
+     %A      an argument packed with LOG_BIN_LLADDR()
+     %f      an argument holding the bit pattern of a float
+     %{a|b}  the option selected by the argument
+     %B, %S  the data as hex or as string
+
+   The macros are empty if LOG_BINARY is disabled. Callers that keep a
+   text log for that case select the backend with LOG_BIN_OR_TEXT(). */
+
+/* Binary log modules. Numbers from LOG_BIN_MODULE_USER up to
+   LOG_BINARY_MODULE_MAX - 1 are free for the application */
+#define LOG_BIN_MODULE_LOG     0x00
+#define LOG_BIN_MODULE_MAC     0x01
+#define LOG_BIN_MODULE_USER    0x08
+
+/* Start of a binary log record */
+#define LOG_BIN_SYNC           0xa5
+/* Length of id, level, timestamp and argc */
+#define LOG_BIN_HEADER_LEN     8
+/* Maximum value of the record length field */
+#define LOG_BIN_RECORD_MAX     255
+
+/* Packs the last two bytes of a link-layer address into one argument */
+#define LOG_BIN_LLADDR(lladdr) ((lladdr) == NULL ? 0UL : \
+                                (((uint32_t)(lladdr)->u8[LINKADDR_SIZE - 2] << 8) | \
+                                 (lladdr)->u8[LINKADDR_SIZE - 1]))
+
+/* Packs the bit pattern of a float into one argument, see %f */
+#define LOG_BIN_FLOAT(value)   log_bin_float(value)
+
+static inline uint32_t
+log_bin_float(float value)
+{
+  union {
+    float f;
+    uint32_t u;
+  } bits;
+
+  bits.f = value;
+  return bits.u;
+}
+
+/* The variadic parts of the macros below always hold at least one value
+   (the ID, or the length of the data), so that they remain valid C99 when
+   a record has no arguments: LOG_BIN_ERR(id) and
+   LOG_BIN_INFO_BYTES(id, data, length) need no GNU extension. */
+#if LOG_BINARY
+/* The argument list starts with the ID */
+#define LOG_BIN(level, data, length, ...) do {  \
+                            if(level <= (LOG_LEVEL)) { \
+                              const uint32_t log_bin_args[] = { __VA_ARGS__ }; \
+                              log_bin_write((uint16_t)log_bin_args[0], (level), log_bin_args + 1, \
+                                            sizeof(log_bin_args) / sizeof(uint32_t) - 1, \
+                                            (data), (length)); \
+                            } \
+                          } while (0)
+/* The argument list starts with the length of the data */
+#define LOG_BIN_BYTES(level, id, data, ...) do {  \
+                            if(level <= (LOG_LEVEL)) { \
+                              const uint32_t log_bin_args[] = { __VA_ARGS__ }; \
+                              log_bin_write((id), (level), log_bin_args + 1, \
+                                            sizeof(log_bin_args) / sizeof(uint32_t) - 1, \
+                                            (data), log_bin_args[0]); \
+                            } \
+                          } while (0)
+#else /* LOG_BINARY */
+#define LOG_BIN(level, data, length, ...)
+#define LOG_BIN_BYTES(level, id, data, ...)
+#endif /* LOG_BINARY */
+
+/* LOG_BIN_<level>(id, args...) */
+#define LOG_BIN_ERR(...)   LOG_BIN(LOG_LEVEL_ERR, NULL, 0, __VA_ARGS__)
+#define LOG_BIN_WARN(...)  LOG_BIN(LOG_LEVEL_WARN, NULL, 0, __VA_ARGS__)
+#define LOG_BIN_INFO(...)  LOG_BIN(LOG_LEVEL_INFO, NULL, 0, __VA_ARGS__)
+#define LOG_BIN_DBG(...)   LOG_BIN(LOG_LEVEL_DBG, NULL, 0, __VA_ARGS__)
+
+/* LOG_BIN_<level>_BYTES(id, data, length, args...) */
+#define LOG_BIN_ERR_BYTES(id, data, ...)   LOG_BIN_BYTES(LOG_LEVEL_ERR, id, data, __VA_ARGS__)
+#define LOG_BIN_WARN_BYTES(id, data, ...)  LOG_BIN_BYTES(LOG_LEVEL_WARN, id, data, __VA_ARGS__)
+#define LOG_BIN_INFO_BYTES(id, data, ...)  LOG_BIN_BYTES(LOG_LEVEL_INFO, id, data, __VA_ARGS__)
+#define LOG_BIN_DBG_BYTES(id, data, ...)   LOG_BIN_BYTES(LOG_LEVEL_DBG, id, data, __VA_ARGS__)
+
+/* Emits the binary record if LOG_BINARY is enabled and the text log
+   otherwise. Both arguments are statements, e.g.
+     LOG_BIN_OR_TEXT(LOG_BIN_ERR(LOG_ID_X), LOG_ERR("x failed\n")); */
+#define LOG_BIN_OR_TEXT(binary, text) do { \
+                            if(LOG_BINARY) { binary; } else { text; } \
+                          } while (0)
+
 #if NETSTACK_CONF_WITH_IPV6
 
 /**
@@ -302,6 +406,36 @@ int log_get_level(const char *module);
 */
 const char *log_level_to_str(int level);
 
+#if LOG_BINARY
+
+/**
+ * Initializes the binary log and starts its drain process
+*/
+void log_bin_init(void);
+
+/**
+ * Adds a binary log record, use the LOG_BIN_* macros instead.
+ * The record is dropped if the ring buffer is full or the module exceeded
+ * its rate; the drain process reports the number of dropped records.
+ * \param id The log ID, the upper byte is the module
+ * \param level The log level
+ * \param args The arguments
+ * \param argc The number of arguments
+ * \param data Trailing data, may be NULL. It is truncated to fit the record
+ * \param length The length of the trailing data
+*/
+void log_bin_write(uint16_t id, uint8_t level, const uint32_t *args,
+                   uint8_t argc, const void *data, size_t length);
+
+/**
+ * Sets the rate limit of a binary log module at run-time
+ * \param module The module, the upper byte of its log IDs
+ * \param rate The maximum number of records per second, 0 for no limit
+*/
+void log_bin_set_rate(uint8_t module, uint16_t rate);
+
+#endif /* LOG_BINARY */
+
 #endif /* __LOG_H__ */
 
 /** @} */
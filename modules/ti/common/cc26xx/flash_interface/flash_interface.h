@@ -127,8 +127,10 @@ extern "C"
 #include <stdbool.h>
 #include <stdint.h>
 
+#if !CONTIKI_TARGET_NATIVE
 #include <ti/devices/DeviceFamily.h>
 #include DeviceFamily_constructPath(driverlib/flash.h)
+#endif
 
 /*********************************************************************
  * CONSTANTS
@@ -159,7 +161,7 @@ extern "C"
     #define INTFLASH_PAGE_SIZE              0x1000
     #define MAX_ONCHIP_FLASH_PAGES          32
     #define MAX_OFFCHIP_METADATA_PAGES      MAX_ONCHIP_FLASH_PAGES
-#elif defined(DeviceFamily_CC26X2) || defined(DeviceFamily_CC13X2) || defined(DeviceFamily_CC26X2X7) || defined(DeviceFamily_CC13X2X7)
+#elif defined(DeviceFamily_CC26X2) || defined(DeviceFamily_CC13X2) || defined(DeviceFamily_CC26X2X7) || defined(DeviceFamily_CC13X2X7) || CONTIKI_TARGET_NATIVE
     #define FLASH_ADDRESS(page, offset)     (((page) << 13) + (offset))
     #define FLASH_PAGE(addr)                (addr >> 13)
     #define INTFLASH_PAGE_MASK              0xFFFFE000
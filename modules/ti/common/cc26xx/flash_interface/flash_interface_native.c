@@ -0,0 +1,286 @@
+/**
+ @code
+  ___ _____ _   ___ _  _____ ___  ___  ___ ___
+ / __|_   _/_\ / __| |/ / __/ _ \| _ \/ __| __|
+ \__ \ | |/ _ \ (__| ' <| _| (_) |   / (__| _|
+ |___/ |_/_/ \_\___|_|\_\_| \___/|_|_\\___|___|
+ embedded.connectivity.solutions.==============
+ @endcode
+
+ @file       flash_interface_native.c
+ @copyright  STACKFORCE GmbH, Germany, www.stackforce.de
+ @author     STACKFORCE
+ @brief      File backed emulation of the CC26xx internal flash for the
+             native (Linux host) target.
+
+             The image has the size of the on-chip flash and is mapped into
+             memory. Like NOR flash, an erase sets a page to 0xFF and a write
+             can only clear bits. The image file is taken from the
+             environment variable FLASH_INTERFACE_NATIVE_FILE or defaults to
+             FLASH_INTERFACE_NATIVE_CONF_FILE.
+*/
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "flash_interface.h"
+
+/*********************************************************************
+ * MACROS
+ */
+#ifndef FLASH_INTERFACE_NATIVE_CONF_FILE
+#define FLASH_INTERFACE_NATIVE_CONF_FILE   "flash.bin"
+#endif
+
+#define FLASH_NATIVE_ENV_FILE              "FLASH_INTERFACE_NATIVE_FILE"
+
+#define FLASH_NATIVE_SIZE                  (MAX_ONCHIP_FLASH_PAGES * INTFLASH_PAGE_SIZE)
+
+/*********************************************************************
+ * LOCAL VARIABLES
+ */
+
+/* Mapped flash image, NULL until the first access. */
+static uint8_t *gpFlashImage = NULL;
+
+/*********************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+static bool mapImage(void);
+
+/*********************************************************************
+ * @fn      flash_init
+ *
+ * @brief   Map the flash image file. A new file is created erased.
+ *
+ * @param   none
+ *
+ * @return  none
+ */
+void flash_init(void)
+{
+  (void)mapImage();
+}
+
+/*********************************************************************
+ * @fn      flash_open
+ *
+ * @brief   Open an OAD target for download. For internal flash
+ *          this function is a stub.
+ *
+ * @param   none
+ *
+ * @return  Always FALSE for the emulated internal flash
+ */
+bool flash_open(void)
+{
+  return (false);
+}
+
+/*********************************************************************
+ * @fn      flash_close
+ *
+ * @brief   For internal flash this function is a stub.
+ *
+ * @param   none
+ *
+ * @return  none
+ */
+void flash_close(void)
+{
+  // Intentionally left blank.
+}
+
+/*********************************************************************
+ * @fn      hasExternalFlash
+ *
+ * @brief   Check if the target has external flash
+ *
+ * @param   none
+ *
+ * @return  Always return FALSE, there is no external flash.
+ */
+bool hasExternalFlash(void)
+{
+  return (false);
+}
+
+/*********************************************************************
+ * @fn      readFlash
+ *
+ * @brief   Read data from flash.
+ *
+ * @param   addr   - address to read from in flash
+ * @param   pBuf   - pointer to buffer into which data is read.
+ * @param   len    - length of data to read in bytes.
+ *
+ * @return  FLASH_SUCCESS or FLASH_FAILURE.
+ */
+uint8_t readFlash(uint_least32_t addr, uint8_t *pBuf, size_t len)
+{
+  if (!mapImage() || (addr + len > FLASH_NATIVE_SIZE))
+  {
+    return (FLASH_FAILURE);
+  }
+
+  memcpy(pBuf, gpFlashImage + addr, len);
+
+  return (FLASH_SUCCESS);
+}
+
+/*********************************************************************
+ * @fn      readFlashPg
+ *
+ * @brief   Read data from flash.
+ *
+ * @param   page   - page to read from in flash
+ * @param   offset - offset into flash page to begin reading
+ * @param   pBuf   - pointer to buffer into which data is read.
+ * @param   len    - length of data to read in bytes.
+ *
+ * @return  FLASH_SUCCESS or FLASH_FAILURE.
+ */
+uint8_t readFlashPg(uint8_t page, uint32_t offset, uint8_t *pBuf, uint16_t len)
+{
+  return (readFlash(FLASH_ADDRESS(page, offset), pBuf, len));
+}
+
+/*********************************************************************
+ * @fn      writeFlash
+ *
+ * @brief   Write data to flash. As on NOR flash, bits can only be
+ *          cleared; the page has to be erased before it is rewritten.
+ *
+ * @param   addr   - address to write to in flash
+ * @param   pBuf   - pointer to buffer of data to write
+ * @param   len    - length of data to write in bytes
+ *
+ * @return  FLASH_SUCCESS or FLASH_FAILURE.
+ */
+uint8_t writeFlash(uint_least32_t addr, uint8_t *pBuf, size_t len)
+{
+  size_t i;
+
+  if (!mapImage() || (addr + len > FLASH_NATIVE_SIZE))
+  {
+    return (FLASH_FAILURE);
+  }
+
+  for (i = 0; i < len; i++)
+  {
+    gpFlashImage[addr + i] &= pBuf[i];
+  }
+
+  return (FLASH_SUCCESS);
+}
+
+/*********************************************************************
+ * @fn      writeFlashPg
+ *
+ * @brief   Write data to flash.
+ *
+ * @param   page   - page to write to in flash
+ * @param   offset - offset into flash page to begin writing
+ * @param   pBuf   - pointer to buffer of data to write
+ * @param   len    - length of data to write in bytes
+ *
+ * @return  FLASH_SUCCESS or FLASH_FAILURE.
+ */
+uint8_t writeFlashPg(uint8_t page, uint32_t offset, uint8_t *pBuf, uint16_t len)
+{
+  return (writeFlash(FLASH_ADDRESS(page, offset), pBuf, len));
+}
+
+/*********************************************************************
+ * @fn      eraseFlashPg
+ *
+ * @brief   Erase selected flash page.
+ *
+ * @param   page - the page to erase.
+ *
+ * @return  FLASH_SUCCESS or FLASH_FAILURE.
+ */
+uint8_t eraseFlashPg(uint8_t page)
+{
+  if (!mapImage() || (page >= MAX_ONCHIP_FLASH_PAGES))
+  {
+    return (FLASH_FAILURE);
+  }
+
+  memset(gpFlashImage + FLASH_ADDRESS(page, 0), 0xFF, INTFLASH_PAGE_SIZE);
+
+  return (FLASH_SUCCESS);
+}
+
+/*********************************************************************
+ * PRIVATE FUNCTIONS
+ */
+
+/*********************************************************************
+ * @fn      mapImage
+ *
+ * @brief   Map the flash image file on first use.
+ *
+ * @param   None.
+ *
+ * @return  TRUE if the image is mapped, FALSE otherwise.
+ */
+static bool mapImage(void)
+{
+  const char *pFile;
+  struct stat st;
+  void *pMap;
+  int fd;
+
+  if (gpFlashImage != NULL)
+  {
+    return (true);
+  }
+
+  pFile = getenv(FLASH_NATIVE_ENV_FILE);
+  if (pFile == NULL)
+  {
+    pFile = FLASH_INTERFACE_NATIVE_CONF_FILE;
+  }
+
+  fd = open(pFile, O_RDWR | O_CREAT, 0644);
+  if (fd < 0)
+  {
+    perror(pFile);
+    return (false);
+  }
+
+  if ((fstat(fd, &st) != 0) || (ftruncate(fd, FLASH_NATIVE_SIZE) != 0))
+  {
+    perror(pFile);
+    close(fd);
+    return (false);
+  }
+
+  pMap = mmap(NULL, FLASH_NATIVE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (pMap == MAP_FAILED)
+  {
+    perror(pFile);
+    return (false);
+  }
+  gpFlashImage = (uint8_t *)pMap;
+
+  // A new (or grown) image reads as erased flash.
+  if (st.st_size < FLASH_NATIVE_SIZE)
+  {
+    memset(gpFlashImage + st.st_size, 0xFF, FLASH_NATIVE_SIZE - st.st_size);
+  }
+
+  return (true);
+}
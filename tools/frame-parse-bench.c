@@ -0,0 +1,272 @@
+/**
+ * @code
+ *  ___ _____ _   ___ _  _____ ___  ___  ___ ___
+ * / __|_   _/_\ / __| |/ / __/ _ \| _ \/ __| __|
+ * \__ \ | |/ _ \ (__| ' <| _| (_) |   / (__| _|
+ * |___/ |_/_/ \_\___|_|\_\_| \___/|_|_\\___|___|
+ * embedded.connectivity.solutions.==============
+ * @endcode
+ *
+ * @copyright  STACKFORCE GmbH, Germany, www.stackforce.de
+ * @author     STACKFORCE
+ * @brief      Host microbenchmark of the IEEE 802.15.4 frame parsing on the
+ *             TSCH receive path.
+ *
+ * Compares the former receive path, which parsed every data frame three
+ * times with the generic frame802154_parse() (slot operation, pending input
+ * processing and framer), with the current one, which parses once with
+ * frame802154_parse_fast() and reuses the result. Before measuring, the
+ * fast parser is checked against the generic one on random frames.
+ *
+ * Build and run from the repository root:
+ *   gcc -O2 -DCONTIKI=1 -DCONTIKI_TARGET_NATIVE=1 \
+ *     -DSF_BMSCC_VERSION_MAJOR=1 -DSF_BMSCC_VERSION_MINOR=0 \
+ *     -DSF_BMSCC_VERSION_PATCH=2 \
+ *     -DPROJECT_CONF_PATH=\"project-conf.h\" -DMAC_CONF_WITH_TSCH=1 \
+ *     -DNETSTACK_CONF_WITH_NULLNET=1 -Iapp/app-bmscc -I. \
+ *     -Imodules/sf-tsch -Imodules/sf-join -Imodules/common \
+ *     -Imodules/sf-rf-regions \
+ *     -Imodules/thirdparty/sf-contiki-ng/arch/platform/native \
+ *     -Imodules/thirdparty/sf-contiki-ng/arch/cpu/native \
+ *     -Imodules/thirdparty/sf-contiki-ng/arch/cpu/native/dev \
+ *     -Imodules/thirdparty/sf-contiki-ng/os \
+ *     -Imodules/thirdparty/sf-contiki-ng/os/sys \
+ *     -Imodules/thirdparty/sf-contiki-ng/os/net/mac/tsch \
+ *     -o frame-parse-bench tools/frame-parse-bench.c
+ *   ./frame-parse-bench [iterations]
+ */
+
+/*==============================================================================
+                            INCLUDES
+==============================================================================*/
+/* Build the generic parser without the fast path to compare both */
+#define FRAME802154_CONF_FAST_PARSE 0
+
+#include "net/linkaddr.c"
+#include "net/mac/framer/frame802154.c"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_CYCLES()  __rdtsc()
+#else
+#define BENCH_CYCLES()  0ULL
+#endif
+
+/*==============================================================================
+                            MACROS
+==============================================================================*/
+/* Maximum IEEE 802.15.4 frame length */
+#define BENCH_FRAME_MAX_LEN   127
+/* Number of frames the measurement loops over */
+#define BENCH_FRAME_CNT       64U
+/* Default number of passes over the frames */
+#define BENCH_ITERATIONS      200000UL
+/* Number of random frames of the cross-check */
+#define BENCH_CHECK_CNT       1000000UL
+/* Parses of a data frame on the former receive path */
+#define BENCH_OLD_PARSE_CNT   3
+
+/*==============================================================================
+                            VARIABLES
+==============================================================================*/
+/* Data frames as sent by the TSCH nodes */
+static uint8_t gFrames[BENCH_FRAME_CNT][BENCH_FRAME_MAX_LEN];
+static int gFrameLen[BENCH_FRAME_CNT];
+/* Prevents the compiler from removing the parsing */
+static volatile uint32_t gSink;
+
+/*==============================================================================
+                            LOCAL FUNCTIONS
+==============================================================================*/
+static uint64_t loc_nowNs(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}/* loc_nowNs() */
+
+static int loc_sameFrame(const frame802154_t *a, const frame802154_t *b)
+{
+  return (memcmp(&a->fcf, &b->fcf, sizeof(a->fcf)) == 0) &&
+         (a->seq == b->seq) &&
+         (a->dest_pid == b->dest_pid) &&
+         (a->src_pid == b->src_pid) &&
+         (memcmp(a->dest_addr, b->dest_addr, sizeof(a->dest_addr)) == 0) &&
+         (memcmp(a->src_addr, b->src_addr, sizeof(a->src_addr)) == 0) &&
+         (a->payload == b->payload) &&
+         (a->payload_len == b->payload_len);
+}/* loc_sameFrame() */
+
+/* Checks that the fast parser either declines a frame or returns the
+ * result of the generic parser */
+static int loc_crossCheck(void)
+{
+  uint8_t data[BENCH_FRAME_MAX_LEN];
+  frame802154_t generic;
+  frame802154_t fast;
+  unsigned long i;
+  unsigned long fastCnt = 0;
+  int len;
+  int j;
+  int hdrGeneric;
+  int hdrFast;
+
+  for(i = 0; i < BENCH_CHECK_CNT; i++)
+  {
+    len = 2 + rand() % (BENCH_FRAME_MAX_LEN - 1);
+    for(j = 0; j < len; j++)
+    {
+      data[j] = (uint8_t)rand();
+    }
+    /* Every second frame uses the layout of the fast path */
+    if(i & 1U)
+    {
+      data[0] = (data[0] & ~0x48) | 0x40;
+      data[1] = (data[1] & ~0xcd) | 0x88;
+    }
+
+    memset(&generic, 0, sizeof(generic));
+    memset(&fast, 0, sizeof(fast));
+    hdrFast = frame802154_parse_fast(data, len, &fast);
+    if(hdrFast == 0)
+    {
+      continue;
+    }
+    fastCnt++;
+    hdrGeneric = frame802154_parse(data, len, &generic);
+    if((hdrFast != hdrGeneric) || !loc_sameFrame(&generic, &fast))
+    {
+      printf("mismatch: len %d fcf %02x%02x header %d/%d\n",
+             len, data[0], data[1], hdrGeneric, hdrFast);
+      return 0;
+    }
+  }
+  printf("cross-check: %lu frames, %lu on the fast path, no mismatch\n",
+         BENCH_CHECK_CNT, fastCnt);
+  return 1;
+}/* loc_crossCheck() */
+
+static void loc_initFrames(void)
+{
+  frame802154_t params;
+  unsigned int i;
+  int hdrLen;
+  int j;
+
+  for(i = 0; i < BENCH_FRAME_CNT; i++)
+  {
+    memset(&params, 0, sizeof(params));
+    params.fcf.frame_type = FRAME802154_DATAFRAME;
+    params.fcf.ack_required = 1;
+    params.fcf.panid_compression = 1;
+    params.fcf.frame_version = FRAME802154_IEEE802154_2015;
+    params.fcf.dest_addr_mode = FRAME802154_SHORTADDRMODE;
+    params.fcf.src_addr_mode = FRAME802154_SHORTADDRMODE;
+    params.seq = (uint8_t)i;
+    params.dest_pid = 0xabcd;
+    params.src_pid = 0xabcd;
+    params.dest_addr[0] = 0x00;
+    params.dest_addr[1] = 0x01;
+    params.src_addr[0] = 0x10;
+    params.src_addr[1] = (uint8_t)i;
+
+    hdrLen = frame802154_create(&params, gFrames[i]);
+    /* Measurement payloads of different lengths */
+    gFrameLen[i] = hdrLen + 8 + (int)(i % 32U);
+    for(j = hdrLen; j < gFrameLen[i]; j++)
+    {
+      gFrames[i][j] = (uint8_t)(i + j);
+    }
+  }
+}/* loc_initFrames() */
+
+/* Runs one receive path over all frames, returns the time in ns */
+static uint64_t loc_run(int fast, unsigned long iterations, uint64_t *cycles)
+{
+  frame802154_t frame;
+  unsigned long n;
+  unsigned int i;
+  int k;
+  uint32_t sum = 0;
+  uint64_t startNs;
+  uint64_t startCycles;
+
+  startNs = loc_nowNs();
+  startCycles = BENCH_CYCLES();
+  for(n = 0; n < iterations; n++)
+  {
+    for(i = 0; i < BENCH_FRAME_CNT; i++)
+    {
+      if(fast)
+      {
+        sum += frame802154_parse_fast(gFrames[i], gFrameLen[i], &frame);
+      }
+      else
+      {
+        for(k = 0; k < BENCH_OLD_PARSE_CNT; k++)
+        {
+          sum += frame802154_parse(gFrames[i], gFrameLen[i], &frame);
+        }
+      }
+      sum += frame.seq + frame.src_addr[1];
+    }
+  }
+  *cycles = BENCH_CYCLES() - startCycles;
+  gSink = sum;
+
+  return loc_nowNs() - startNs;
+}/* loc_run() */
+
+/*==============================================================================
+                            MAIN
+==============================================================================*/
+int main(int argc, char *argv[])
+{
+  unsigned long iterations = BENCH_ITERATIONS;
+  double frames;
+  uint64_t oldNs;
+  uint64_t newNs;
+  uint64_t oldCycles;
+  uint64_t newCycles;
+
+  if(argc > 1)
+  {
+    iterations = strtoul(argv[1], NULL, 0);
+  }
+  if(iterations == 0U)
+  {
+    iterations = 1U;
+  }
+
+  srand(1);
+  if(!loc_crossCheck())
+  {
+    return 1;
+  }
+
+  loc_initFrames();
+  /* Warm up the caches */
+  loc_run(0, iterations / 10U + 1U, &oldCycles);
+  loc_run(1, iterations / 10U + 1U, &newCycles);
+
+  oldNs = loc_run(0, iterations, &oldCycles);
+  newNs = loc_run(1, iterations, &newCycles);
+
+  frames = (double)iterations * BENCH_FRAME_CNT;
+  printf("%.0f frames per path\n", frames);
+  printf("old (%d x frame802154_parse): %7.2f ns/frame %7.1f cycles/frame\n",
+         BENCH_OLD_PARSE_CNT, oldNs / frames, oldCycles / frames);
+  printf("new (1 x frame802154_parse_fast): %7.2f ns/frame %7.1f cycles/frame\n",
+         newNs / frames, newCycles / frames);
+  if(newNs > 0U)
+  {
+    printf("speedup: %.1fx\n", (double)oldNs / newNs);
+  }
+
+  return 0;
+}/* main() */
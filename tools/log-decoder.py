@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+#
+# @copyright  STACKFORCE GmbH, Germany, www.stackforce.de
+# @author     STACKFORCE
+# @brief      Renders the binary log output (LOG_CONF_BINARY) as text.
+#
+# The format strings are collected from the sources: every log ID is an
+# enumerator LOG_ID_<name> = <value> followed by a doxygen comment that holds
+# the quoted format string, see os/sys/log.h. Text that is not part of a
+# binary record is passed through unchanged.
+#
+# Usage:
+#   log-decoder.py [-s SRC_DIR]... [--clock-second N] [INPUT]
+# INPUT is a file or serial device, stdin if omitted.
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+LOG_BIN_SYNC = 0xa5
+LOG_BIN_HEADER_LEN = 8
+
+LEVELS = {0: "PRI", 1: "ERR", 2: "WARN", 3: "INFO", 4: "DBG"}
+
+ID_RE = re.compile(r'\b(LOG_ID_\w+)\s*=\s*(0x[0-9a-fA-F]+|\d+)\s*,?\s*'
+                   r'/\*!\s*"((?:[^"\\]|\\.)*)"\s*\*/')
+MODULE_RE = re.compile(r'LOG_BIN_MODULE_(\w+)\s*=?\s*(0x[0-9a-fA-F]+|\d+)\b')
+CONV_RE = re.compile(r'%(\{[^}]*\}|[-+ #0]*\d*(?:\.\d+)?(?:hh|h|ll|l|z)?[diouxXcfABS%])')
+
+
+def collect(src_dirs):
+    """Returns the format strings by ID and the module names by number."""
+    formats = {}
+    modules = {}
+    for src_dir in src_dirs:
+        for root, dirs, files in os.walk(src_dir):
+            dirs[:] = [d for d in dirs if d not in ("build", ".git")]
+            for name in files:
+                if not name.endswith((".c", ".h")):
+                    continue
+                try:
+                    with open(os.path.join(root, name), errors="replace") as f:
+                        text = f.read()
+                except OSError:
+                    continue
+                if "LOG_ID_" not in text and "LOG_BIN_MODULE_" not in text:
+                    continue
+                for _, value, fmt in ID_RE.findall(text):
+                    formats[int(value, 0)] = bytes(fmt, "utf-8").decode("unicode_escape")
+                for module, value in MODULE_RE.findall(text):
+                    if module != "USER":
+                        modules[int(value, 0)] = module
+    return formats, modules
+
+
+def render(fmt, args, data):
+    """Formats the arguments and the data of a record like printf."""
+    args = list(args)
+
+    def next_arg():
+        return args.pop(0) if args else 0
+
+    def conv(match):
+        spec = match.group(1)
+        if spec == "%":
+            return "%"
+        if spec.startswith("{"):
+            options = spec[1:-1].split("|")
+            return options[min(next_arg(), len(options) - 1)]
+        kind = spec[-1]
+        flags = re.sub(r'(hh|h|ll|l|z)', '', spec[:-1])
+        if kind == "B":
+            return data.hex()
+        if kind == "S":
+            return data.split(b"\0", 1)[0].decode("latin-1")
+        value = next_arg()
+        if kind == "A":
+            return "LL-NULL" if value == 0 else "LL-%04x" % value
+        if kind == "f":
+            return ("%" + flags + "f") % struct.unpack("<f", struct.pack("<I", value))[0]
+        if kind in "di":
+            value = value - (1 << 32) if value & 0x80000000 else value
+            return ("%" + flags + "d") % value
+        if kind == "c":
+            return chr(value & 0xff)
+        return ("%" + flags + kind) % value
+
+    return CONV_RE.sub(conv, fmt)
+
+
+def read_varint(buf, pos, end):
+    value = 0
+    shift = 0
+    while pos < end and shift < 35:
+        byte = buf[pos]
+        pos += 1
+        value |= (byte & 0x7f) << shift
+        if not byte & 0x80:
+            return value & 0xffffffff, pos
+        shift += 7
+    return None, pos
+
+
+def parse_record(buf, pos):
+    """Parses the record at pos. Returns (record, next pos), (None, pos) if
+    more input is needed or (False, pos) if there is no valid record."""
+    if len(buf) - pos < 2:
+        return None, pos
+    length = buf[pos + 1]
+    if length < LOG_BIN_HEADER_LEN:
+        return False, pos
+    end = pos + 2 + length
+    if len(buf) < end:
+        return None, pos
+    ident, level, timestamp, argc = struct.unpack_from("<HBIB", buf, pos + 2)
+    if level not in LEVELS:
+        return False, pos
+    args = []
+    p = pos + 2 + LOG_BIN_HEADER_LEN
+    for _ in range(argc):
+        value, p = read_varint(buf, p, end)
+        if value is None:
+            return False, pos
+        args.append(value)
+    return (ident, level, timestamp, args, bytes(buf[p:end])), end
+
+
+class Decoder:
+    def __init__(self, formats, modules, clock_second, out):
+        self.formats = formats
+        self.modules = modules
+        self.clock_second = clock_second
+        self.out = out
+        self.buf = bytearray()
+
+    def line(self, record):
+        ident, level, timestamp, args, data = record
+        module = self.modules.get(ident >> 8, "0x%02x" % (ident >> 8))
+        prefix = "[%-4s: %-10s] " % (LEVELS[level], module)
+        if self.clock_second:
+            prefix = "%10.3f %s" % (timestamp / self.clock_second, prefix)
+        fmt = self.formats.get(ident)
+        if fmt is None:
+            text = "unknown log id 0x%04x args %s data %s" % (
+                ident, " ".join("%x" % a for a in args), data.hex())
+        else:
+            text = render(fmt, args, data)
+        return prefix + text + "\n"
+
+    def feed(self, chunk):
+        self.buf += chunk
+        pos = 0
+        text_start = 0
+        while pos < len(self.buf):
+            if self.buf[pos] != LOG_BIN_SYNC:
+                pos += 1
+                continue
+            record, end = parse_record(self.buf, pos)
+            if record is None:
+                break
+            if record is False:
+                pos += 1
+                continue
+            self.out.write(self.buf[text_start:pos].decode("latin-1"))
+            self.out.write(self.line(record))
+            pos = text_start = end
+        self.out.write(self.buf[text_start:pos].decode("latin-1"))
+        del self.buf[:pos]
+        self.out.flush()
+
+
+def main():
+    root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    parser = argparse.ArgumentParser(
+        description="Renders the binary log output as text.")
+    parser.add_argument("-s", "--source", action="append",
+                        help="source directory to collect the log IDs from "
+                             "(default: the repository)")
+    parser.add_argument("--clock-second", type=int, default=0,
+                        help="CLOCK_SECOND of the target, prints the "
+                             "timestamps in seconds")
+    parser.add_argument("input", nargs="?", help="log file or serial device")
+    opts = parser.parse_args()
+
+    formats, modules = collect(opts.source or [root])
+    modules.setdefault(0, "LOG")
+    decoder = Decoder(formats, modules, opts.clock_second, sys.stdout)
+
+    stream = open(opts.input, "rb") if opts.input else sys.stdin.buffer
+    with stream:
+        while True:
+            chunk = stream.read1(256) if hasattr(stream, "read1") else stream.read(256)
+            if not chunk:
+                break
+            decoder.feed(chunk)
+
+
+if __name__ == "__main__":
+    main()
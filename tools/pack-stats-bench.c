@@ -0,0 +1,297 @@
+/**
+ * @code
+ *  ___ _____ _   ___ _  _____ ___  ___  ___ ___
+ * / __|_   _/_\ / __| |/ / __/ _ \| _ \/ __| __|
+ * \__ \ | |/ _ \ (__| ' <| _| (_) |   / (__| _|
+ * |___/ |_/_/ \_\___|_|\_\_| \___/|_|_\\___|___|
+ * embedded.connectivity.solutions.==============
+ * @endcode
+ *
+ * @copyright  STACKFORCE GmbH, Germany, www.stackforce.de
+ * @author     STACKFORCE
+ * @brief      Host microbenchmark of the pack statistics kernel.
+ *
+ * Compares sf_app_packStats_compute() on fixed-point values with a two-pass
+ * computation in double precision on the float values of the measurement
+ * store, for packs of different sizes. Before measuring, the kernel is
+ * checked against the double-precision reference on random packs.
+ *
+ * The host has no Cortex-M4 DSP extension, so the scalar path of the kernel
+ * is measured. With -DBENCH_EMULATE_SIMD the SIMD path is built against C
+ * emulations of the intrinsics, which checks its lane handling but says
+ * nothing about its speed.
+ *
+ * Build and run from the repository root:
+ *   gcc -O2 -Iapp/app-bmscc -Imodules/common \
+ *     -o pack-stats-bench tools/pack-stats-bench.c -lm
+ *   ./pack-stats-bench [iterations]
+ */
+
+/*==============================================================================
+                            INCLUDES
+==============================================================================*/
+#include <stdint.h>
+
+#ifdef BENCH_EMULATE_SIMD
+/* The intrinsics of CMSIS core, the GE flags are kept in a variable */
+#define SF_APP_CONF_PACK_STATS_SIMD   1
+#define CMSIS_CONF_HEADER_PATH        <stddef.h>
+
+static uint32_t gBenchGe;
+
+static inline uint64_t __SMLALD(uint32_t op1, uint32_t op2, uint64_t acc)
+{
+  return acc + (uint64_t)((int64_t)(int16_t)op1 * (int16_t)op2 +
+                          (int64_t)(int16_t)(op1 >> 16) * (int16_t)(op2 >> 16));
+}
+
+static inline uint32_t __SSUB16(uint32_t op1, uint32_t op2)
+{
+  int32_t lo = (int16_t)op1 - (int16_t)op2;
+  int32_t hi = (int16_t)(op1 >> 16) - (int16_t)(op2 >> 16);
+
+  gBenchGe = ((lo >= 0) ? 0x0000ffffU : 0U) | ((hi >= 0) ? 0xffff0000U : 0U);
+  return ((uint32_t)hi << 16) | ((uint32_t)lo & 0xffffU);
+}
+
+static inline uint32_t __SEL(uint32_t op1, uint32_t op2)
+{
+  return (op1 & gBenchGe) | (op2 & ~gBenchGe);
+}
+#endif
+
+#include "sf_app_packStats.c"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_CYCLES()  __rdtsc()
+#else
+#define BENCH_CYCLES()  0ULL
+#endif
+
+/*==============================================================================
+                            MACROS
+==============================================================================*/
+/* Largest pack */
+#define BENCH_CELL_MAX        1024U
+/* Default number of computations per pack size */
+#define BENCH_ITERATIONS      100000UL
+/* Number of random packs of the cross-check */
+#define BENCH_CHECK_CNT       100000UL
+/* Outlier limit in mV */
+#define BENCH_OUTLIER_LIMIT   50
+/* Scale from mV to the unit of the measurement store (uV) */
+#define BENCH_SCALE           1000.0f
+
+/*==============================================================================
+                            VARIABLES
+==============================================================================*/
+/* Cell voltages as float in uV and as fixed point in mV */
+static float gFloatValues[BENCH_CELL_MAX];
+static int16_t gFixedValues[BENCH_CELL_MAX];
+static uint8_t gOutliers[SF_FRAME_BITMAP_LEN(BENCH_CELL_MAX)];
+/* Pack sizes of the measurement */
+static const uint16_t gPackSizes[] = {30U, 256U, 1024U};
+/* Prevents the compiler from removing the computation */
+static volatile float gSink;
+
+/*==============================================================================
+                            LOCAL FUNCTIONS
+==============================================================================*/
+static uint64_t loc_nowNs(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}/* loc_nowNs() */
+
+/* Cell voltages between 3.0 V and 4.2 V, some cells far off */
+static void loc_initPack(uint16_t cnt)
+{
+  uint16_t i;
+
+  for(i = 0; i < cnt; i++)
+  {
+    gFixedValues[i] = (int16_t)(3600 + rand() % 41 - 20);
+    if(rand() % 16 == 0)
+    {
+      gFixedValues[i] = (int16_t)(3000 + rand() % 1201);
+    }
+    gFloatValues[i] = gFixedValues[i] * BENCH_SCALE;
+  }
+}/* loc_initPack() */
+
+/* Statistics of the float values in double precision, two passes */
+static void loc_reference(const float *pValues, uint16_t cnt, int16_t limit,
+                          uint8_t *pOutliers, double *pMin, double *pMax,
+                          double *pMean, double *pStdDev,
+                          uint16_t *pOutlierCnt)
+{
+  double sum = 0;
+  double sumSq = 0;
+  double diff;
+  uint16_t i;
+
+  *pMin = pValues[0];
+  *pMax = pValues[0];
+  for(i = 0; i < cnt; i++)
+  {
+    sum += pValues[i];
+    *pMin = (pValues[i] < *pMin) ? pValues[i] : *pMin;
+    *pMax = (pValues[i] > *pMax) ? pValues[i] : *pMax;
+  }
+  *pMean = sum / cnt;
+
+  memset(pOutliers, 0, SF_FRAME_BITMAP_LEN(cnt));
+  *pOutlierCnt = 0;
+  for(i = 0; i < cnt; i++)
+  {
+    diff = pValues[i] - *pMean;
+    sumSq += diff * diff;
+    /* Compared like the kernel, cnt * |v - mean| is exact */
+    if(fabs(cnt * (double)pValues[i] - sum) > (double)cnt * limit * BENCH_SCALE)
+    {
+      pOutliers[i / 8U] |= (uint8_t)(1U << (i % 8U));
+      (*pOutlierCnt)++;
+    }
+  }
+  *pStdDev = sqrt(sumSq / cnt);
+}/* loc_reference() */
+
+/* Checks the kernel against the double-precision reference */
+static int loc_crossCheck(void)
+{
+  static uint8_t refOutliers[SF_FRAME_BITMAP_LEN(BENCH_CELL_MAX)];
+  sf_app_packStats_t stats;
+  double min;
+  double max;
+  double mean;
+  double stdDev;
+  uint16_t outlierCnt;
+  uint16_t cnt;
+  unsigned long n;
+
+  for(n = 0; n < BENCH_CHECK_CNT; n++)
+  {
+    cnt = (uint16_t)(1 + rand() % BENCH_CELL_MAX);
+    loc_initPack(cnt);
+    loc_reference(gFloatValues, cnt, BENCH_OUTLIER_LIMIT, refOutliers, &min,
+                  &max, &mean, &stdDev, &outlierCnt);
+    if(E_SF_SUCCESS != sf_app_packStats_compute(gFixedValues, cnt,
+                                                BENCH_OUTLIER_LIMIT,
+                                                gOutliers, &stats) ||
+       stats.cnt != cnt ||
+       stats.min * BENCH_SCALE != min || stats.max * BENCH_SCALE != max ||
+       fabs(stats.mean * BENCH_SCALE - mean) > 1e-6 * mean ||
+       fabs(stats.stdDev * BENCH_SCALE - stdDev) > 1e-4 * stdDev + 1.0 ||
+       stats.outlierCnt != outlierCnt ||
+       memcmp(gOutliers, refOutliers, SF_FRAME_BITMAP_LEN(cnt)) != 0)
+    {
+      printf("mismatch: %u cells, min %d/%.0f max %d/%.0f mean %f/%f "
+             "std dev %f/%f outliers %u/%u\n", cnt,
+             stats.min, min, stats.max, max, stats.mean * BENCH_SCALE, mean,
+             stats.stdDev * BENCH_SCALE, stdDev, stats.outlierCnt,
+             outlierCnt);
+      return 0;
+    }
+  }
+  printf("cross-check: %lu packs of up to %u cells (%s path), no mismatch\n",
+         BENCH_CHECK_CNT, BENCH_CELL_MAX,
+         SF_APP_PACK_STATS_SIMD ? "SIMD" : "scalar");
+  return 1;
+}/* loc_crossCheck() */
+
+/* Runs the reference or the kernel on the pack, returns the time in ns */
+static uint64_t loc_run(int kernel, uint16_t cnt, unsigned long iterations,
+                        uint64_t *cycles)
+{
+  sf_app_packStats_t stats;
+  double min;
+  double max;
+  double mean;
+  double stdDev;
+  uint16_t outlierCnt;
+  unsigned long n;
+  float sum = 0;
+  uint64_t startNs;
+  uint64_t startCycles;
+
+  startNs = loc_nowNs();
+  startCycles = BENCH_CYCLES();
+  for(n = 0; n < iterations; n++)
+  {
+    if(kernel)
+    {
+      sf_app_packStats_compute(gFixedValues, cnt, BENCH_OUTLIER_LIMIT,
+                               gOutliers, &stats);
+      sum += stats.stdDev + stats.outlierCnt;
+    }
+    else
+    {
+      loc_reference(gFloatValues, cnt, BENCH_OUTLIER_LIMIT, gOutliers, &min,
+                    &max, &mean, &stdDev, &outlierCnt);
+      sum += (float)stdDev + outlierCnt;
+    }
+  }
+  *cycles = BENCH_CYCLES() - startCycles;
+  gSink = sum;
+
+  return loc_nowNs() - startNs;
+}/* loc_run() */
+
+/*==============================================================================
+                            MAIN
+==============================================================================*/
+int main(int argc, char *argv[])
+{
+  unsigned long iterations = BENCH_ITERATIONS;
+  uint64_t refNs;
+  uint64_t kernelNs;
+  uint64_t refCycles;
+  uint64_t kernelCycles;
+  uint16_t cnt;
+  size_t i;
+
+  if(argc > 1)
+  {
+    iterations = strtoul(argv[1], NULL, 0);
+  }
+  if(iterations == 0U)
+  {
+    iterations = 1U;
+  }
+
+  srand(1);
+  if(!loc_crossCheck())
+  {
+    return 1;
+  }
+
+  for(i = 0; i < sizeof(gPackSizes) / sizeof(gPackSizes[0]); i++)
+  {
+    cnt = gPackSizes[i];
+    loc_initPack(cnt);
+    /* Warm up the caches */
+    loc_run(0, cnt, iterations / 10U + 1U, &refCycles);
+    loc_run(1, cnt, iterations / 10U + 1U, &kernelCycles);
+
+    refNs = loc_run(0, cnt, iterations, &refCycles);
+    kernelNs = loc_run(1, cnt, iterations, &kernelCycles);
+
+    printf("%4u cells: double reference %9.1f ns %9.0f cycles, "
+           "kernel %9.1f ns %9.0f cycles", cnt,
+           (double)refNs / iterations, (double)refCycles / iterations,
+           (double)kernelNs / iterations, (double)kernelCycles / iterations);
+    if(kernelNs > 0U)
+    {
+      printf(", speedup %.1fx", (double)refNs / kernelNs);
+    }
+    printf("\n");
+  }
+
+  return 0;
+}/* main() */
@@ -0,0 +1,1420 @@
+/**
+ * @code
+ *  ___ _____ _   ___ _  _____ ___  ___  ___ ___
+ * / __|_   _/_\ / __| |/ / __/ _ \| _ \/ __| __|
+ * \__ \ | |/ _ \ (__| ' <| _| (_) |   / (__| _|
+ * |___/ |_/_/ \_\___|_|\_\_| \___/|_|_\\___|___|
+ * embedded.connectivity.solutions.==============
+ * @endcode
+ *
+ * @copyright  STACKFORCE GmbH, Germany, www.stackforce.de
+ * @author     STACKFORCE
+ * @brief      Host simulator of the BMS-CC schedule.
+ *
+ * Builds the schedule of the coordinator with sf-tsch-schedule.c and the
+ * schedule engine of the selected layout (SCHEDULE_A, SCHEDULE_B or
+ * SCHEDULE_C of project-conf.h) and simulates a pack of cells timeslot by
+ * timeslot, with the link resolution of tsch-schedule.c deciding which link
+ * the coordinator runs:
+ *  - the cells synchronize on a beacon, send their join request in the
+ *    shared join request slots with the TSCH backoff and complete the join in
+ *    the join process slots of one of SF_JOIN_CONF_CONCURRENT_MAX join
+ *    contexts, which adds their data slots;
+ *  - each joined cell queues a measurement every period and sends it in its
+ *    RX slot, retransmits in its dedicated retry slot or with the TSCH backoff
+ *    in the shared retry slots and drops it after TSCH_MAC_MAX_FRAME_RETRIES;
+ *  - the coordinator answers a received measurement with a command in the TX
+ *    slot of the cell.
+ * Every transmission is lost with the given probability. Reports the join
+ * completion time, the uplink latency (measurement to reception), the
+ * downlink latency (reception to command delivery), the use of the data
+ * slots and the uplink queue occupancy of each cell and of the pack.
+ *
+ * A single configuration prints the layout of the slotframe and a report per
+ * cell, ranges of cells, loss and measurement period print one CSV line per
+ * configuration. The slot counts of the layout are compile-time options of
+ * project-conf.h, other layouts are simulated by building with them, e.g.
+ * -DAPP_SLOTFRAME_SECTION_JOIN_REQUEST_SLOTS=6. The TSCH runtime is replaced
+ * by stubs.
+ *
+ * Build and run from the repository root, add -DSCHEDULE_A=0 -DSCHEDULE_B=1
+ * or -DSCHEDULE_A=0 -DSCHEDULE_C=1 for the other layouts:
+ *   gcc -O2 -DCONTIKI=1 -DCONTIKI_TARGET_NATIVE=1 \
+ *     -DSF_BMSCC_VERSION_MAJOR=1 -DSF_BMSCC_VERSION_MINOR=0 \
+ *     -DSF_BMSCC_VERSION_PATCH=2 \
+ *     -DPROJECT_CONF_PATH=\"project-conf.h\" -DMAC_CONF_WITH_TSCH=1 \
+ *     -DNETSTACK_CONF_WITH_NULLNET=1 -DROUTING_CONF_NULLROUTING=1 \
+ *     -Iapp/app-bmscc -I. \
+ *     -Imodules/sf-tsch -Imodules/sf-join -Imodules/common \
+ *     -Imodules/sf-rf-regions \
+ *     -Imodules/thirdparty/sf-contiki-ng/arch/platform/native \
+ *     -Imodules/thirdparty/sf-contiki-ng/arch/cpu/native \
+ *     -Imodules/thirdparty/sf-contiki-ng/arch/cpu/native/dev \
+ *     -Imodules/thirdparty/sf-contiki-ng/os \
+ *     -Imodules/thirdparty/sf-contiki-ng/os/sys \
+ *     -Imodules/thirdparty/sf-contiki-ng/os/dev \
+ *     -Imodules/thirdparty/sf-contiki-ng/os/net \
+ *     -Imodules/thirdparty/sf-contiki-ng/os/net/mac/tsch \
+ *     -o schedule-sim tools/schedule-sim.c
+ *   ./schedule-sim [-n cells] [-l loss %] [-p period ms] [-c command %]
+ *                  [-q queue length] [-t seconds] [-s seed] [-b lookups]
+ * -n, -l and -p take a value or a range first:last[:step], e.g.
+ *   ./schedule-sim -n 1:30 -l 0:20:5 -p 500:4000:500
+ */
+
+/*==============================================================================
+                            INCLUDES
+==============================================================================*/
+#include <stdarg.h>
+
+/* The schedule is built with the link pool */
+#define APP_SLOTFRAME_STATIC  0
+
+/* The schedule logs every link, the simulator prints only its results */
+static int loc_noLog(const char *fmt, ...)
+{
+  (void)fmt;
+  return 0;
+}
+#define LOG_CONF_OUTPUT       loc_noLog
+
+#include "lib/list.c"
+#include "lib/memb.c"
+#include "lib/ringbufindex.c"
+#include "net/linkaddr.c"
+#include "net/mac/tsch/tsch-schedule.c"
+#include "sf-tsch-schedule-engine.c"
+#undef LOG_MODULE
+#undef LOG_LEVEL
+#include "sf-tsch-schedule.c"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*==============================================================================
+                            MACROS
+==============================================================================*/
+/* Timeslot length in us, see TSCH_CONF_DEFAULT_TIMESLOT_TIMING */
+#define SIM_TIMESLOT_US       7500UL
+/* Default number of link lookups per timeslot of the benchmark */
+#define SIM_ITERATIONS        100UL
+/* Default simulated time in s */
+#define SIM_DURATION_S        300UL
+/* Latencies are counted per timeslot up to this many, longer ones share the
+   last bin */
+#define SIM_HIST_SLOTS        8192U
+/* Longest queue of a cell or of the coordinator towards a cell */
+#define SIM_QUEUE_MAX         256U
+/* Link address of a cell before the join, the join assigns device id + 1 */
+#define SIM_JOIN_ADDR_BASE    0x1000U
+/* Concurrent joins of the coordinator, see SF_JOIN_CONCURRENT_MAX */
+#ifdef SF_JOIN_CONF_CONCURRENT_MAX
+#define SIM_JOIN_CONCURRENT   SF_JOIN_CONF_CONCURRENT_MAX
+#else
+#define SIM_JOIN_CONCURRENT   4U
+#endif
+/* Join process cancelled by the coordinator, see SF_JOIN_RESP_STATE_TIMEOUT */
+#define SIM_JOIN_TIMEOUT_MS   30000UL
+/* Pending ctimers of the schedule */
+#define SIM_TIMERS            4U
+
+/*==============================================================================
+                            ENUMS
+==============================================================================*/
+/* Join states of a cell. */
+typedef enum
+{
+  /* Waits for a beacon. */
+  E_SIM_CELL_SCAN = 0,
+  /* Sends the join request in the join request slots. */
+  E_SIM_CELL_JREQ,
+  /* The join request waits for a free join context. */
+  E_SIM_CELL_WAIT,
+  /* The coordinator sends the join response in the join process slots. */
+  E_SIM_CELL_RESP,
+  /* The cell sends the join success in the join process slots. */
+  E_SIM_CELL_SUCC,
+  /* The cell has its data slots. */
+  E_SIM_CELL_JOINED
+} E_SIM_CELL_STATE_t;
+
+/*==============================================================================
+                            STRUCTS
+==============================================================================*/
+/* A value or a range of values of a parameter. */
+typedef struct
+{
+  uint32_t first;
+  uint32_t last;
+  uint32_t step;
+} sim_range_t;
+
+/* Parameters of a simulation. */
+typedef struct
+{
+  /* Cells of the pack. */
+  uint16_t cells;
+  /* Loss of each transmission in percent, uplink and downlink. */
+  uint32_t lossPercent;
+  /* Measurement period of each cell in ms. */
+  uint32_t periodMs;
+  /* Measurements answered with a command in percent. */
+  uint32_t cmdPercent;
+  /* Frames a cell and the coordinator queue per cell. */
+  uint16_t queueLen;
+  /* Simulated time in ms. */
+  uint32_t durationMs;
+  /* Seed of the random numbers. */
+  uint32_t seed;
+} sim_config_t;
+
+/* Latency distribution in timeslots. */
+typedef struct
+{
+  uint32_t bins[SIM_HIST_SLOTS + 1];
+  uint32_t count;
+  uint64_t sum;
+  uint32_t max;
+} sim_hist_t;
+
+/* Frames queued towards one neighbor, oldest first. */
+typedef struct
+{
+  /* ASN each frame was queued at. */
+  uint64_t asn[SIM_QUEUE_MAX];
+  uint16_t head;
+  uint16_t cnt;
+  /* Transmissions of the oldest frame. */
+  uint8_t tx;
+  /* Frames dropped, the queue was full or the retries were exhausted. */
+  uint32_t drops;
+  /* Queue length found by the queued frames. */
+  uint64_t occupancySum;
+  uint32_t occupancySamples;
+  uint16_t occupancyMax;
+} sim_queue_t;
+
+/* A cell of the pack. */
+typedef struct
+{
+  E_SIM_CELL_STATE_t state;
+  /* Device id assigned by the join, -1 before. */
+  int16_t devid;
+  /* Join context, -1 without. */
+  int8_t ctx;
+  /* TSCH backoff on the shared links. */
+  uint8_t be;
+  uint16_t backoff;
+  /* ASN the join request was received, orders the pending requests. */
+  uint64_t reqAsn;
+  /* ASN the join process started, for its timeout. */
+  uint64_t ctxAsn;
+  /* ASN the join completed. */
+  uint64_t joinAsn;
+  /* Time of the next measurement in us. */
+  uint64_t nextMeasUs;
+  /* Measurements of the cell and commands of the coordinator to it. */
+  sim_queue_t up;
+  sim_queue_t down;
+  sim_hist_t upHist;
+  sim_hist_t downHist;
+} sim_cell_t;
+
+/* Timeslot statistics of a simulation. */
+typedef struct
+{
+  /* Occurrences of the RX, retry and TX slots of the cells. */
+  uint64_t dataSlots;
+  /* Data slots a frame was sent in. */
+  uint64_t dataSlotsUsed;
+  /* Shared slots with more than one transmission. */
+  uint64_t collisions;
+} sim_stats_t;
+
+/* A pending ctimer. */
+typedef struct
+{
+  struct ctimer *pTimer;
+  uint64_t asn;
+} sim_timer_t;
+
+/*==============================================================================
+                            GLOBAL VARIABLES
+==============================================================================*/
+/* Parameters of the running simulation. */
+static sim_config_t gCfg;
+/* ASN of the simulated timeslot. */
+static uint64_t gAsn;
+/* The cells, and the cell of each device id. */
+static sim_cell_t gCells[APP_MAX_DEVICE_SLOTS];
+static int16_t gDevCell[APP_MAX_DEVICE_SLOTS];
+static uint16_t gNextDevid;
+/* Cell of each join context, -1 for a free one. */
+static int16_t gCtxCell[SIM_JOIN_CONCURRENT];
+static sim_stats_t gStats;
+static sim_timer_t gTimers[SIM_TIMERS];
+/* Latencies of the pack. */
+static sim_hist_t gPackUp;
+static sim_hist_t gPackDown;
+/* State of the random numbers. */
+static uint32_t gRand;
+
+/*==============================================================================
+                            TSCH STUBS
+==============================================================================*/
+const linkaddr_t tsch_broadcast_address = { { 0xff, 0xff } };
+struct tsch_asn_t tsch_current_asn;
+int tsch_is_associated;
+struct tsch_link *current_link;
+tsch_timeslot_timing_usec tsch_timing_us;
+int curr_log_level_mac = LOG_LEVEL_NONE;
+
+int tsch_get_lock(void) { return 1; }
+void tsch_release_lock(void) { }
+int tsch_is_locked(void) { return 0; }
+struct tsch_neighbor *tsch_queue_add_nbr(const linkaddr_t *addr) { return NULL; }
+struct tsch_neighbor *tsch_queue_get_nbr(const linkaddr_t *addr) { return NULL; }
+void log_lladdr(const linkaddr_t *lladdr) { }
+void watchdog_periodic(void) { }
+void tsch_set_schedule_desc(const struct tsch_schedule_desc *desc) { }
+
+/* The ctimers of the schedule expire at the ASN of their time */
+void ctimer_stop(struct ctimer *c)
+{
+  for(uint8_t i = 0; i < SIM_TIMERS; i++)
+  {
+    if(c == gTimers[i].pTimer)
+    {
+      gTimers[i].pTimer = NULL;
+    }
+  }
+}
+
+void ctimer_set(struct ctimer *c, clock_time_t t, void (*f)(void *), void *ptr)
+{
+  uint64_t slots = ((uint64_t)t * 1000000UL + (CLOCK_SECOND * SIM_TIMESLOT_US) - 1) /
+                   (CLOCK_SECOND * SIM_TIMESLOT_US);
+
+  ctimer_stop(c);
+  c->f = f;
+  c->ptr = ptr;
+  for(uint8_t i = 0; i < SIM_TIMERS; i++)
+  {
+    if(NULL == gTimers[i].pTimer)
+    {
+      gTimers[i].pTimer = c;
+      gTimers[i].asn = gAsn + ((0 == slots) ? 1 : slots);
+      return;
+    }
+  }
+  printf("no free timer\n");
+  exit(1);
+}
+
+/*==============================================================================
+                            LOCAL FUNCTIONS
+==============================================================================*/
+static uint64_t loc_nowNs(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}/* loc_nowNs() */
+
+static double loc_slotsToMs(uint64_t slots)
+{
+  return slots * (SIM_TIMESLOT_US / 1000.0);
+}/* loc_slotsToMs() */
+
+/* xorshift32, the simulations are repeatable with the seed */
+static uint32_t loc_rand(void)
+{
+  gRand ^= gRand << 13;
+  gRand ^= gRand >> 17;
+  gRand ^= gRand << 5;
+  return gRand;
+}/* loc_rand() */
+
+static int loc_isLost(void)
+{
+  return (loc_rand() % 100U) < gCfg.lossPercent;
+}/* loc_isLost() */
+
+static void loc_setAsn(uint64_t asn)
+{
+  gAsn = asn;
+  TSCH_ASN_INIT(tsch_current_asn, (uint8_t)(asn >> 32), (uint32_t)asn);
+}/* loc_setAsn() */
+
+/* Address of the cell with the device id, see get_devid() */
+static linkaddr_t loc_cellAddr(uint16_t devid)
+{
+  linkaddr_t addr = linkaddr_null;
+
+#if LINKADDR_SIZE == 2
+  addr.u16 = devid + 1;
+#else
+  addr.u16[0] = devid + 1;
+#endif
+  return addr;
+}/* loc_cellAddr() */
+
+/* Address of a cell before the join */
+static linkaddr_t loc_joinAddr(uint16_t cell)
+{
+  linkaddr_t addr = linkaddr_null;
+
+#if LINKADDR_SIZE == 2
+  addr.u16 = SIM_JOIN_ADDR_BASE + cell;
+#else
+  addr.u16[0] = SIM_JOIN_ADDR_BASE + cell;
+#endif
+  return addr;
+}/* loc_joinAddr() */
+
+static uint16_t loc_addrValue(const linkaddr_t *pAddr)
+{
+#if LINKADDR_SIZE == 2
+  return pAddr->u16;
+#else
+  return pAddr->u16[0];
+#endif
+}/* loc_addrValue() */
+
+/* The slots of the coordinator before any cell joined */
+static int loc_initSchedule(void)
+{
+  tsch_schedule_init();
+  if(0 != sf_tsch_schedule_init() ||
+     0 != sf_tsch_schedule_add_beacon_slots() ||
+     0 != sf_tsch_schedule_add_broadcast_slots() ||
+     0 != sf_tsch_schedule_add_retry_slots() ||
+     0 != sf_tsch_schedule_add_jreq_slots())
+  {
+    printf("schedule not built\n");
+    return -1;
+  }
+  return 0;
+}/* loc_initSchedule() */
+
+static int loc_isJoinRequest(const struct tsch_link *pLink)
+{
+  uint16_t jreq;
+
+  for(uint8_t s = 0; s < APP_SLOTFRAME_SECTION_NUM; s++)
+  {
+    jreq = SF_TSCH_SCHEDULE_ENGINE.jreq_slot(s);
+    if(pLink->timeslot >= jreq &&
+       pLink->timeslot < jreq + APP_SLOTFRAME_SECTION_JOIN_REQUEST_SLOTS)
+    {
+      return 1;
+    }
+  }
+  return 0;
+}/* loc_isJoinRequest() */
+
+static int loc_isBeacon(const struct tsch_link *pLink)
+{
+  return LINK_TYPE_ADVERTISING_ONLY == pLink->link_type;
+}/* loc_isBeacon() */
+
+/* Device positions of the layout of the slotframe of a link */
+static uint16_t loc_linkPositions(const struct tsch_link *pLink)
+{
+  for(uint8_t l = 0; l < SCHEDULE_LAYOUTS; l++)
+  {
+    if(layout_handle[l] == pLink->slotframe_handle)
+    {
+      return layout_positions[l];
+    }
+  }
+  return layout_positions[active_layout];
+}/* loc_linkPositions() */
+
+static void loc_histPut(sim_hist_t *pHist, uint64_t slots)
+{
+  pHist->bins[(slots < SIM_HIST_SLOTS) ? slots : SIM_HIST_SLOTS]++;
+  pHist->count++;
+  pHist->sum += slots;
+  if(slots > pHist->max)
+  {
+    pHist->max = (uint32_t)slots;
+  }
+}/* loc_histPut() */
+
+static void loc_histAdd(sim_hist_t *pDst, const sim_hist_t *pSrc)
+{
+  for(uint32_t i = 0; i <= SIM_HIST_SLOTS; i++)
+  {
+    pDst->bins[i] += pSrc->bins[i];
+  }
+  pDst->count += pSrc->count;
+  pDst->sum += pSrc->sum;
+  if(pSrc->max > pDst->max)
+  {
+    pDst->max = pSrc->max;
+  }
+}/* loc_histAdd() */
+
+/* Latency in ms below which the percentage of the frames was delivered */
+static double loc_histPercentile(const sim_hist_t *pHist, uint32_t percent)
+{
+  uint64_t needed = ((uint64_t)pHist->count * percent + 99U) / 100U;
+  uint64_t seen = 0;
+
+  if(0 == pHist->count)
+  {
+    return 0.0;
+  }
+  for(uint32_t i = 0; i < SIM_HIST_SLOTS; i++)
+  {
+    seen += pHist->bins[i];
+    if(seen >= needed)
+    {
+      return loc_slotsToMs(i);
+    }
+  }
+  return loc_slotsToMs(pHist->max);
+}/* loc_histPercentile() */
+
+static double loc_histMean(const sim_hist_t *pHist)
+{
+  return (0 == pHist->count) ? 0.0 : loc_slotsToMs(pHist->sum) / pHist->count;
+}/* loc_histMean() */
+
+/* Queues a frame, drops it if the queue is full */
+static void loc_queuePut(sim_queue_t *pQueue, uint64_t asn)
+{
+  pQueue->occupancySum += pQueue->cnt;
+  pQueue->occupancySamples++;
+  if(pQueue->cnt >= gCfg.queueLen)
+  {
+    pQueue->drops++;
+    return;
+  }
+  pQueue->asn[(pQueue->head + pQueue->cnt) % SIM_QUEUE_MAX] = asn;
+  pQueue->cnt++;
+  if(pQueue->cnt > pQueue->occupancyMax)
+  {
+    pQueue->occupancyMax = pQueue->cnt;
+  }
+}/* loc_queuePut() */
+
+/* Removes the oldest frame, returns the ASN it was queued at */
+static uint64_t loc_queuePop(sim_queue_t *pQueue)
+{
+  uint64_t asn = pQueue->asn[pQueue->head];
+
+  pQueue->head = (pQueue->head + 1U) % SIM_QUEUE_MAX;
+  pQueue->cnt--;
+  pQueue->tx = 0;
+  return asn;
+}/* loc_queuePop() */
+
+/* Counts a failed transmission of the oldest frame, drops it after the last
+   retry */
+static void loc_queueFail(sim_queue_t *pQueue)
+{
+  if(++pQueue->tx > TSCH_MAC_MAX_FRAME_RETRIES)
+  {
+    loc_queuePop(pQueue);
+    pQueue->drops++;
+  }
+}/* loc_queueFail() */
+
+/* Backoff of a cell after a transmission on a shared link */
+static void loc_backoff(sim_cell_t *pCell, int success)
+{
+  if(success)
+  {
+    pCell->be = TSCH_MAC_MIN_BE;
+    pCell->backoff = 0;
+  }
+  else
+  {
+    if(pCell->be < TSCH_MAC_MAX_BE)
+    {
+      pCell->be++;
+    }
+    pCell->backoff = loc_rand() % (1U << pCell->be);
+  }
+}/* loc_backoff() */
+
+/* Runs a shared link, the cells accepted by the filter send unless they back
+   off, a failed transmission is passed to fail. Returns the cell that was
+   received, -1 for none, and the number of senders. */
+static int32_t loc_sharedSlot(int (*filter)(const sim_cell_t *),
+                              void (*fail)(sim_cell_t *), uint16_t *pSenders)
+{
+  static uint16_t senders[APP_MAX_DEVICE_SLOTS];
+  uint16_t cnt = 0;
+  int received;
+
+  for(uint16_t i = 0; i < gCfg.cells; i++)
+  {
+    if(!filter(&gCells[i]))
+    {
+      continue;
+    }
+    if(gCells[i].backoff > 0)
+    {
+      gCells[i].backoff--;
+      continue;
+    }
+    senders[cnt++] = i;
+  }
+  *pSenders = cnt;
+  if(0 == cnt)
+  {
+    return -1;
+  }
+  if(cnt > 1)
+  {
+    gStats.collisions++;
+  }
+
+  received = (1 == cnt) && !loc_isLost();
+  for(uint16_t i = 0; i < cnt; i++)
+  {
+    loc_backoff(&gCells[senders[i]], received);
+    if(!received && NULL != fail)
+    {
+      fail(&gCells[senders[i]]);
+    }
+  }
+  return received ? senders[0] : -1;
+}/* loc_sharedSlot() */
+
+static int loc_sendsJoinRequest(const sim_cell_t *pCell)
+{
+  return E_SIM_CELL_JREQ == pCell->state;
+}/* loc_sendsJoinRequest() */
+
+static int loc_sendsRetry(const sim_cell_t *pCell)
+{
+  return (E_SIM_CELL_JOINED == pCell->state) && (pCell->up.cnt > 0) &&
+         (pCell->up.tx > 0);
+}/* loc_sendsRetry() */
+
+static void loc_retryFailed(sim_cell_t *pCell)
+{
+  loc_queueFail(&pCell->up);
+}/* loc_retryFailed() */
+
+/* Starts the pending join requests the free join contexts can take */
+static void loc_startJoins(void)
+{
+  int32_t next;
+  linkaddr_t addr;
+
+  for(uint8_t ctx = 0; ctx < SIM_JOIN_CONCURRENT; ctx++)
+  {
+    if(gCtxCell[ctx] >= 0)
+    {
+      continue;
+    }
+    /* the oldest pending request */
+    next = -1;
+    for(uint16_t i = 0; i < gCfg.cells; i++)
+    {
+      if(E_SIM_CELL_WAIT == gCells[i].state &&
+         (next < 0 || gCells[i].reqAsn < gCells[next].reqAsn))
+      {
+        next = i;
+      }
+    }
+    if(next < 0)
+    {
+      return;
+    }
+    addr = loc_joinAddr(next);
+    if(0 != sf_tsch_schedule_add_jproc_slot_group(&addr, ctx, SIM_JOIN_CONCURRENT))
+    {
+      printf("join process slots of cell %d not added\n", next);
+      exit(1);
+    }
+    gCtxCell[ctx] = next;
+    gCells[next].ctx = ctx;
+    gCells[next].ctxAsn = gAsn;
+    gCells[next].state = E_SIM_CELL_RESP;
+  }
+}/* loc_startJoins() */
+
+/* Ends the join process of a cell, successful or not */
+static void loc_endJoin(uint16_t cell, int success)
+{
+  sim_cell_t *pCell = &gCells[cell];
+  linkaddr_t addr = loc_joinAddr(cell);
+
+  sf_tsch_schedule_delete_jproc_slot_group(&addr, pCell->ctx, SIM_JOIN_CONCURRENT);
+  gCtxCell[pCell->ctx] = -1;
+  pCell->ctx = -1;
+
+  if(success)
+  {
+    pCell->devid = gNextDevid++;
+    gDevCell[pCell->devid] = cell;
+    addr = loc_cellAddr(pCell->devid);
+    if(0 != sf_tsch_schedule_add_data_slots(&addr, E_SF_TSCH_SCHEDULE_DATA_SLOTS_ALL))
+    {
+      printf("data slots of cell %u not added\n", cell);
+      exit(1);
+    }
+    pCell->state = E_SIM_CELL_JOINED;
+    pCell->joinAsn = gAsn;
+    pCell->nextMeasUs = gAsn * SIM_TIMESLOT_US +
+                        (loc_rand() % gCfg.periodMs) * 1000ULL;
+  }
+  else
+  {
+    /* the cell starts over with a join request */
+    pCell->state = E_SIM_CELL_JREQ;
+    loc_backoff(pCell, 1);
+  }
+  loc_startJoins();
+}/* loc_endJoin() */
+
+/* Runs the join process slot of a join context */
+static void loc_joinProcessSlot(const struct tsch_link *pLink)
+{
+  uint16_t cell = loc_addrValue(&pLink->addr) - SIM_JOIN_ADDR_BASE;
+  sim_cell_t *pCell = &gCells[cell];
+
+  if(gAsn - pCell->ctxAsn > (SIM_JOIN_TIMEOUT_MS * 1000UL) / SIM_TIMESLOT_US)
+  {
+    loc_endJoin(cell, 0);
+    return;
+  }
+  if(loc_isLost())
+  {
+    return;
+  }
+  if(E_SIM_CELL_RESP == pCell->state)
+  {
+    /* join response of the coordinator */
+    pCell->state = E_SIM_CELL_SUCC;
+  }
+  else if(E_SIM_CELL_SUCC == pCell->state)
+  {
+    /* join success of the cell */
+    loc_endJoin(cell, 1);
+  }
+}/* loc_joinProcessSlot() */
+
+/* Cell owning an RX or dedicated retry slot of the coordinator, -1 for a
+   shared slot */
+static int32_t loc_uplinkOwner(const struct tsch_link *pLink, uint16_t positions)
+{
+  uint16_t slot;
+  uint16_t channelOffset;
+
+  for(uint16_t devid = 0; devid < gNextDevid; devid++)
+  {
+    SF_TSCH_SCHEDULE_ENGINE.data_slot(devid, 1, positions, &slot, &channelOffset);
+    if(channelOffset == pLink->channel_offset &&
+       pLink->timeslot >= slot && pLink->timeslot < slot + RX_SLOTS_PER_POSITION)
+    {
+      return gDevCell[devid];
+    }
+  }
+  return -1;
+}/* loc_uplinkOwner() */
+
+/* A measurement of the cell was received */
+static void loc_uplinkReceived(uint16_t cell)
+{
+  sim_cell_t *pCell = &gCells[cell];
+
+  loc_histPut(&pCell->upHist, gAsn - loc_queuePop(&pCell->up));
+  if((loc_rand() % 100U) < gCfg.cmdPercent)
+  {
+    loc_queuePut(&pCell->down, gAsn);
+  }
+}/* loc_uplinkReceived() */
+
+/* Runs an RX link of the coordinator in the data slots */
+static void loc_uplinkSlot(const struct tsch_link *pLink)
+{
+  uint16_t positions = loc_linkPositions(pLink);
+  uint8_t kind = SF_TSCH_SCHEDULE_ENGINE.uplink_slot_kind(pLink->timeslot, positions);
+  int32_t cell;
+  uint16_t senders;
+  sim_cell_t *pCell;
+
+  if(SF_TSCH_SCHEDULE_SLOT_OTHER == kind)
+  {
+    return;
+  }
+  gStats.dataSlots++;
+
+  cell = loc_uplinkOwner(pLink, positions);
+  if(cell < 0)
+  {
+    /* shared retry slot, only retransmissions with the backoff */
+    if(SF_TSCH_SCHEDULE_SLOT_RETRY != kind)
+    {
+      return;
+    }
+    cell = loc_sharedSlot(loc_sendsRetry, loc_retryFailed, &senders);
+    if(senders > 0)
+    {
+      gStats.dataSlotsUsed++;
+    }
+    if(cell >= 0)
+    {
+      loc_uplinkReceived(cell);
+    }
+    return;
+  }
+
+  pCell = &gCells[cell];
+  /* the dedicated retry slot is a LINK_TYPE_NORMAL_RTX link of the cell */
+  if(0 == pCell->up.cnt ||
+     (SF_TSCH_SCHEDULE_SLOT_RETRY == kind && 0 == pCell->up.tx))
+  {
+    return;
+  }
+  gStats.dataSlotsUsed++;
+  if(loc_isLost())
+  {
+    loc_queueFail(&pCell->up);
+  }
+  else
+  {
+    loc_uplinkReceived(cell);
+  }
+}/* loc_uplinkSlot() */
+
+/* Runs a TX link of the coordinator to a cell */
+static void loc_downlinkSlot(const struct tsch_link *pLink)
+{
+  sim_cell_t *pCell = &gCells[gDevCell[loc_addrValue(&pLink->addr) - 1]];
+
+  gStats.dataSlots++;
+  if(0 == pCell->down.cnt)
+  {
+    return;
+  }
+  gStats.dataSlotsUsed++;
+  if(loc_isLost())
+  {
+    loc_queueFail(&pCell->down);
+  }
+  else
+  {
+    loc_histPut(&pCell->downHist, gAsn - loc_queuePop(&pCell->down));
+  }
+}/* loc_downlinkSlot() */
+
+/* Runs a link of the coordinator at gAsn */
+static void loc_runLink(const struct tsch_link *pLink)
+{
+  int32_t cell;
+  uint16_t senders;
+
+  if(loc_isBeacon(pLink))
+  {
+    for(uint16_t i = 0; i < gCfg.cells; i++)
+    {
+      if(E_SIM_CELL_SCAN == gCells[i].state && !loc_isLost())
+      {
+        gCells[i].state = E_SIM_CELL_JREQ;
+        loc_backoff(&gCells[i], 1);
+      }
+    }
+  }
+  else if(linkaddr_cmp(&pLink->addr, &tsch_broadcast_address))
+  {
+    if(!(pLink->link_options & LINK_OPTION_RX))
+    {
+      /* broadcast slot, no broadcasts are simulated */
+      return;
+    }
+    if(loc_isJoinRequest(pLink))
+    {
+      cell = loc_sharedSlot(loc_sendsJoinRequest, NULL, &senders);
+      if(cell >= 0)
+      {
+        gCells[cell].state = E_SIM_CELL_WAIT;
+        gCells[cell].reqAsn = gAsn;
+        loc_startJoins();
+      }
+    }
+    else
+    {
+      loc_uplinkSlot(pLink);
+    }
+  }
+  else if(pLink->link_options & LINK_OPTION_RX)
+  {
+    loc_joinProcessSlot(pLink);
+  }
+  else
+  {
+    loc_downlinkSlot(pLink);
+  }
+}/* loc_runLink() */
+
+/* Queues the measurements of the joined cells up to gAsn */
+static void loc_measure(void)
+{
+  uint64_t nowUs = gAsn * SIM_TIMESLOT_US;
+
+  for(uint16_t i = 0; i < gCfg.cells; i++)
+  {
+    while(E_SIM_CELL_JOINED == gCells[i].state && gCells[i].nextMeasUs <= nowUs)
+    {
+      loc_queuePut(&gCells[i].up, gCells[i].nextMeasUs / SIM_TIMESLOT_US);
+      gCells[i].nextMeasUs += gCfg.periodMs * 1000ULL;
+    }
+  }
+}/* loc_measure() */
+
+/* Index of the ctimer expiring first, SIM_TIMERS for none */
+static uint8_t loc_nextTimer(void)
+{
+  uint8_t next = SIM_TIMERS;
+
+  for(uint8_t i = 0; i < SIM_TIMERS; i++)
+  {
+    if(NULL != gTimers[i].pTimer &&
+       (SIM_TIMERS == next || gTimers[i].asn < gTimers[next].asn))
+    {
+      next = i;
+    }
+  }
+  return next;
+}/* loc_nextTimer() */
+
+/* Simulates the pack with the parameters of gCfg */
+static int loc_simulate(void)
+{
+  uint64_t endAsn = ((uint64_t)gCfg.durationMs * 1000UL) / SIM_TIMESLOT_US;
+  struct tsch_asn_t asn;
+  struct tsch_link *pLink;
+  struct tsch_link *pChannelLink;
+  struct tsch_slotframe *pSlotframe;
+  struct ctimer *pTimer;
+  uint16_t offset;
+  uint16_t timeslot;
+  uint16_t channelOffset;
+  uint64_t next;
+  uint8_t timer;
+
+  memset(gCells, 0, sizeof(gCells));
+  memset(&gStats, 0, sizeof(gStats));
+  memset(gTimers, 0, sizeof(gTimers));
+  for(uint16_t i = 0; i < gCfg.cells; i++)
+  {
+    gCells[i].devid = -1;
+    gCells[i].ctx = -1;
+    gCells[i].be = TSCH_MAC_MIN_BE;
+  }
+  for(uint8_t ctx = 0; ctx < SIM_JOIN_CONCURRENT; ctx++)
+  {
+    gCtxCell[ctx] = -1;
+  }
+  gNextDevid = 0;
+  gRand = (0 == gCfg.seed) ? 1 : gCfg.seed;
+  loc_setAsn(0);
+  if(0 != loc_initSchedule())
+  {
+    return -1;
+  }
+
+  while(gAsn < endAsn)
+  {
+    TSCH_ASN_INIT(asn, (uint8_t)(gAsn >> 32), (uint32_t)gAsn);
+    pLink = tsch_schedule_get_next_active_link(&asn, &offset, NULL);
+    if(NULL == pLink)
+    {
+      break;
+    }
+    next = gAsn + offset;
+
+    timer = loc_nextTimer();
+    if(SIM_TIMERS != timer && gTimers[timer].asn <= next)
+    {
+      /* the timer may change the schedule, which is resolved again */
+      pTimer = gTimers[timer].pTimer;
+      gTimers[timer].pTimer = NULL;
+      loc_setAsn(gTimers[timer].asn);
+      pTimer->f(pTimer->ptr);
+      loc_setAsn(gAsn - 1);
+      continue;
+    }
+
+    loc_setAsn(next);
+    if(gAsn >= endAsn)
+    {
+      break;
+    }
+    loc_measure();
+
+    /* a receiver per channel offset, see APP_SLOTFRAME_CHANNEL_OFFSETS; a
+       link may be removed by the one before */
+    pSlotframe = tsch_schedule_get_slotframe_by_handle(pLink->slotframe_handle);
+    timeslot = pLink->timeslot;
+    channelOffset = pLink->channel_offset;
+    for(uint16_t c = 0; c < APP_SLOTFRAME_CHANNEL_OFFSETS; c++)
+    {
+      pChannelLink = (c == channelOffset) ? pLink :
+                     tsch_schedule_get_link_by_timeslot(pSlotframe, timeslot, c);
+      if(NULL != pChannelLink)
+      {
+        loc_runLink(pChannelLink);
+      }
+    }
+  }
+  loc_setAsn(endAsn);
+
+  memset(&gPackUp, 0, sizeof(gPackUp));
+  memset(&gPackDown, 0, sizeof(gPackDown));
+  for(uint16_t i = 0; i < gCfg.cells; i++)
+  {
+    loc_histAdd(&gPackUp, &gCells[i].upHist);
+    loc_histAdd(&gPackDown, &gCells[i].downHist);
+  }
+  return 0;
+}/* loc_simulate() */
+
+/* Link active at each timeslot of the slotframe, NULL for idle timeslots */
+static void loc_resolve(struct tsch_link **pLinks, uint16_t size)
+{
+  struct tsch_asn_t asn;
+  uint16_t offset;
+
+  /* The lookup returns the next link after the ASN */
+  for(uint16_t ts = 0; ts < size; ts++)
+  {
+    TSCH_ASN_INIT(asn, 0, size + ts - 1);
+    pLinks[ts] = tsch_schedule_get_next_active_link(&asn, &offset, NULL);
+    if(1 != offset)
+    {
+      pLinks[ts] = NULL;
+    }
+  }
+}/* loc_resolve() */
+
+/* Longest distance between two timeslots of the slotframe that match */
+static uint16_t loc_maxGap(struct tsch_link **pLinks, uint16_t size,
+                           int (*match)(const struct tsch_link *))
+{
+  int32_t first = -1;
+  int32_t last = -1;
+  uint16_t gap = 0;
+
+  for(uint16_t ts = 0; ts < size; ts++)
+  {
+    if(NULL == pLinks[ts] || !match(pLinks[ts]))
+    {
+      continue;
+    }
+    if(last >= 0 && ts - last > gap)
+    {
+      gap = ts - last;
+    }
+    if(first < 0)
+    {
+      first = ts;
+    }
+    last = ts;
+  }
+
+  if(first < 0)
+  {
+    return 0;
+  }
+  /* Across the end of the slotframe */
+  if(size - last + first > gap)
+  {
+    gap = size - last + first;
+  }
+  return gap;
+}/* loc_maxGap() */
+
+/* Prints the layout of the slotframe with all cells joined */
+static int loc_printLayout(uint16_t cells, unsigned long iterations)
+{
+  static struct tsch_link *links[APP_SLOTFRAME_SIZE];
+  uint16_t size;
+  uint16_t dataSlots = 0;
+  uint32_t latency;
+  uint32_t latencySum = 0;
+  uint32_t latencyMax = 0;
+  uint16_t rxSlot;
+  uint16_t txSlot;
+  uint16_t channelOffset;
+  uint16_t positions;
+  linkaddr_t addr;
+  struct tsch_asn_t asn;
+  uint16_t offset;
+  uint64_t startNs;
+  uint64_t lookupNs;
+
+  if(0 != loc_initSchedule())
+  {
+    return -1;
+  }
+  for(uint16_t devid = 0; devid < cells; devid++)
+  {
+    addr = loc_cellAddr(devid);
+    if(0 != sf_tsch_schedule_add_data_slots(&addr,
+                                            E_SF_TSCH_SCHEDULE_DATA_SLOTS_ALL))
+    {
+      printf("data slots of cell %u not added\n", devid);
+      return -1;
+    }
+  }
+
+  size = sf_tsch_schedule_get_slotframe_size();
+  positions = layout_positions[active_layout];
+  loc_resolve(links, size);
+
+  for(uint16_t ts = 0; ts < size; ts++)
+  {
+    if(NULL != links[ts] &&
+       SF_TSCH_SCHEDULE_SLOT_OTHER !=
+       SF_TSCH_SCHEDULE_ENGINE.uplink_slot_kind(ts, positions))
+    {
+      dataSlots++;
+    }
+    else if(NULL != links[ts] && !linkaddr_cmp(&links[ts]->addr,
+                                               &tsch_broadcast_address))
+    {
+      /* Downlink to a cell, the join process slots are not scheduled */
+      dataSlots++;
+    }
+  }
+
+  /* A measurement received in the RX slot of a cell is answered in the
+     next TX slot to the cell */
+  for(uint16_t devid = 0; devid < cells; devid++)
+  {
+    SF_TSCH_SCHEDULE_ENGINE.data_slot(devid, 1, positions, &rxSlot,
+                                      &channelOffset);
+    SF_TSCH_SCHEDULE_ENGINE.data_slot(devid, 0, positions, &txSlot,
+                                      &channelOffset);
+    latency = (txSlot + size - rxSlot) % size;
+    latency = (0 == latency) ? size : latency;
+    latencySum += latency;
+    latencyMax = (latency > latencyMax) ? latency : latencyMax;
+  }
+
+  /* Link lookup from every timeslot of the slotframe */
+  startNs = loc_nowNs();
+  for(unsigned long n = 0; n < iterations; n++)
+  {
+    for(uint16_t ts = 0; ts < size; ts++)
+    {
+      TSCH_ASN_INIT(asn, 0, n * size + ts);
+      current_link = tsch_schedule_get_next_active_link(&asn, &offset, NULL);
+    }
+  }
+  lookupNs = loc_nowNs() - startNs;
+
+  printf("schedule %s: %u cells, slotframe %u timeslots (%.1f ms), "
+         "%u sections, %u data timeslots (%.1f %%)\n",
+         SF_TSCH_SCHEDULE_ENGINE.name, cells, size, loc_slotsToMs(size),
+         APP_SLOTFRAME_SECTION_NUM, dataSlots, 100.0 * dataSlots / size);
+  printf("  beacon interval %.1f ms, join request interval up to %.1f ms\n",
+         loc_slotsToMs(loc_maxGap(links, size, loc_isBeacon)),
+         loc_slotsToMs(loc_maxGap(links, size, loc_isJoinRequest)));
+  printf("  measurement to downlink command mean %.1f ms, max %.1f ms\n",
+         loc_slotsToMs(latencySum) / cells, loc_slotsToMs(latencyMax));
+  printf("  next active link lookup %.1f ns\n",
+         (double)lookupNs / ((double)iterations * size));
+  return 0;
+}/* loc_printLayout() */
+
+/* Prints the report per cell of a simulation */
+static void loc_printCells(void)
+{
+  const sim_cell_t *pCell;
+  uint16_t joined = 0;
+  uint64_t joinMax = 0;
+  uint64_t queueSum = 0;
+  uint32_t queueSamples = 0;
+  uint16_t queueMax = 0;
+  uint32_t upDrops = 0;
+  uint32_t downDrops = 0;
+
+  printf("simulated %.1f s, loss %u %%, measurement period %u ms, "
+         "commands %u %%, queue %u frames\n",
+         gCfg.durationMs / 1000.0, gCfg.lossPercent, gCfg.periodMs,
+         gCfg.cmdPercent, gCfg.queueLen);
+  printf("cell devid   join ms |  uplink ms p50    p95    max |"
+         " downlink ms p50    p95    max | queue avg max | drops up down\n");
+  for(uint16_t i = 0; i < gCfg.cells; i++)
+  {
+    pCell = &gCells[i];
+    if(E_SIM_CELL_JOINED != pCell->state)
+    {
+      printf("%4u     - not joined\n", i);
+      continue;
+    }
+    joined++;
+    joinMax = (pCell->joinAsn > joinMax) ? pCell->joinAsn : joinMax;
+    queueSum += pCell->up.occupancySum;
+    queueSamples += pCell->up.occupancySamples;
+    queueMax = (pCell->up.occupancyMax > queueMax) ? pCell->up.occupancyMax : queueMax;
+    upDrops += pCell->up.drops;
+    downDrops += pCell->down.drops;
+    printf("%4u %5d %9.1f | %13.1f %6.1f %6.1f | %15.1f %6.1f %6.1f |"
+           " %9.2f %3u | %8u %4u\n",
+           i, pCell->devid, loc_slotsToMs(pCell->joinAsn),
+           loc_histPercentile(&pCell->upHist, 50),
+           loc_histPercentile(&pCell->upHist, 95),
+           loc_slotsToMs(pCell->upHist.max),
+           loc_histPercentile(&pCell->downHist, 50),
+           loc_histPercentile(&pCell->downHist, 95),
+           loc_slotsToMs(pCell->downHist.max),
+           (0 == pCell->up.occupancySamples) ? 0.0 :
+           (double)pCell->up.occupancySum / pCell->up.occupancySamples,
+           pCell->up.occupancyMax, pCell->up.drops, pCell->down.drops);
+  }
+  printf("pack: %u of %u cells joined, the last after %.1f ms\n",
+         joined, gCfg.cells, loc_slotsToMs(joinMax));
+  printf("  uplink   %u frames, mean %.1f ms, p50 %.1f ms, p95 %.1f ms, "
+         "p99 %.1f ms, max %.1f ms, %u dropped\n",
+         gPackUp.count, loc_histMean(&gPackUp), loc_histPercentile(&gPackUp, 50),
+         loc_histPercentile(&gPackUp, 95), loc_histPercentile(&gPackUp, 99),
+         loc_slotsToMs(gPackUp.max), upDrops);
+  printf("  downlink %u frames, mean %.1f ms, p50 %.1f ms, p95 %.1f ms, "
+         "p99 %.1f ms, max %.1f ms, %u dropped\n",
+         gPackDown.count, loc_histMean(&gPackDown), loc_histPercentile(&gPackDown, 50),
+         loc_histPercentile(&gPackDown, 95), loc_histPercentile(&gPackDown, 99),
+         loc_slotsToMs(gPackDown.max), downDrops);
+  printf("  data slots %.1f %% used, %llu collisions on shared slots, "
+         "uplink queue mean %.2f max %u\n",
+         (0 == gStats.dataSlots) ? 0.0 : 100.0 * gStats.dataSlotsUsed / gStats.dataSlots,
+         (unsigned long long)gStats.collisions,
+         (0 == queueSamples) ? 0.0 : (double)queueSum / queueSamples, queueMax);
+}/* loc_printCells() */
+
+static void loc_printCsvHeader(void)
+{
+  printf("schedule,cells,loss_pct,period_ms,joined,join_mean_ms,join_max_ms,"
+         "up_p50_ms,up_p95_ms,up_p99_ms,up_max_ms,up_drops,"
+         "down_p50_ms,down_p95_ms,down_p99_ms,down_max_ms,down_drops,"
+         "data_slots_used_pct,collisions,queue_mean,queue_max\n");
+}/* loc_printCsvHeader() */
+
+/* Prints the pack results of a simulation as a CSV line */
+static void loc_printCsv(void)
+{
+  uint16_t joined = 0;
+  uint64_t joinSum = 0;
+  uint64_t joinMax = 0;
+  uint64_t queueSum = 0;
+  uint32_t queueSamples = 0;
+  uint16_t queueMax = 0;
+  uint32_t upDrops = 0;
+  uint32_t downDrops = 0;
+
+  for(uint16_t i = 0; i < gCfg.cells; i++)
+  {
+    if(E_SIM_CELL_JOINED != gCells[i].state)
+    {
+      continue;
+    }
+    joined++;
+    joinSum += gCells[i].joinAsn;
+    joinMax = (gCells[i].joinAsn > joinMax) ? gCells[i].joinAsn : joinMax;
+    queueSum += gCells[i].up.occupancySum;
+    queueSamples += gCells[i].up.occupancySamples;
+    if(gCells[i].up.occupancyMax > queueMax)
+    {
+      queueMax = gCells[i].up.occupancyMax;
+    }
+    upDrops += gCells[i].up.drops;
+    downDrops += gCells[i].down.drops;
+  }
+
+  printf("%s,%u,%u,%u,%u,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%u,"
+         "%.1f,%.1f,%.1f,%.1f,%u,%.1f,%llu,%.2f,%u\n",
+         SF_TSCH_SCHEDULE_ENGINE.name, gCfg.cells, gCfg.lossPercent,
+         gCfg.periodMs, joined,
+         (0 == joined) ? 0.0 : loc_slotsToMs(joinSum) / joined,
+         loc_slotsToMs(joinMax),
+         loc_histPercentile(&gPackUp, 50), loc_histPercentile(&gPackUp, 95),
+         loc_histPercentile(&gPackUp, 99), loc_slotsToMs(gPackUp.max), upDrops,
+         loc_histPercentile(&gPackDown, 50), loc_histPercentile(&gPackDown, 95),
+         loc_histPercentile(&gPackDown, 99), loc_slotsToMs(gPackDown.max),
+         downDrops,
+         (0 == gStats.dataSlots) ? 0.0 : 100.0 * gStats.dataSlotsUsed / gStats.dataSlots,
+         (unsigned long long)gStats.collisions,
+         (0 == queueSamples) ? 0.0 : (double)queueSum / queueSamples, queueMax);
+}/* loc_printCsv() */
+
+/* Parses a value or a range first:last[:step] */
+static int loc_parseRange(const char *pArg, sim_range_t *pRange)
+{
+  char *pEnd;
+
+  pRange->first = strtoul(pArg, &pEnd, 0);
+  pRange->last = pRange->first;
+  pRange->step = 1;
+  if(':' == *pEnd)
+  {
+    pRange->last = strtoul(pEnd + 1, &pEnd, 0);
+    if(':' == *pEnd)
+    {
+      pRange->step = strtoul(pEnd + 1, &pEnd, 0);
+    }
+  }
+  return ('\0' == *pEnd) && (pRange->step > 0) && (pRange->last >= pRange->first);
+}/* loc_parseRange() */
+
+static uint32_t loc_rangeCount(const sim_range_t *pRange)
+{
+  return (pRange->last - pRange->first) / pRange->step + 1;
+}/* loc_rangeCount() */
+
+static void loc_usage(const char *pName)
+{
+  printf("usage: %s [-n cells] [-l loss %%] [-p period ms] [-c command %%]\n"
+         "       [-q queue length] [-t seconds] [-s seed] [-b lookups]\n"
+         "  -n, -l and -p take a value or a range first:last[:step]\n", pName);
+}/* loc_usage() */
+
+/*==============================================================================
+                            MAIN
+==============================================================================*/
+int main(int argc, char *argv[])
+{
+  sim_range_t cells = { APP_MAX_DEVICE_SLOTS, APP_MAX_DEVICE_SLOTS, 1 };
+  sim_range_t loss = { APP_SLOTFRAME_UPLINK_LOSS_PERCENT,
+                       APP_SLOTFRAME_UPLINK_LOSS_PERCENT, 1 };
+  sim_range_t period;
+  unsigned long iterations = SIM_ITERATIONS;
+  uint32_t configs;
+  uint32_t done = 0;
+  uint64_t startNs;
+  int opt;
+
+  /* One measurement per slotframe by default */
+  period.first = (uint32_t)((APP_SLOTFRAME_SIZE * SIM_TIMESLOT_US + 999UL) / 1000UL);
+  period.last = period.first;
+  period.step = 1;
+  gCfg.cmdPercent = 100;
+  gCfg.queueLen = TSCH_QUEUE_NUM_PER_NEIGHBOR;
+  gCfg.durationMs = SIM_DURATION_S * 1000UL;
+  gCfg.seed = 1;
+  tsch_timing_us[tsch_ts_timeslot_length] = SIM_TIMESLOT_US;
+
+  while(-1 != (opt = getopt(argc, argv, "n:l:p:c:q:t:s:b:h")))
+  {
+    switch(opt)
+    {
+      case 'n':
+        if(!loc_parseRange(optarg, &cells))
+        {
+          loc_usage(argv[0]);
+          return 1;
+        }
+        break;
+      case 'l':
+        if(!loc_parseRange(optarg, &loss))
+        {
+          loc_usage(argv[0]);
+          return 1;
+        }
+        break;
+      case 'p':
+        if(!loc_parseRange(optarg, &period))
+        {
+          loc_usage(argv[0]);
+          return 1;
+        }
+        break;
+      case 'c':
+        gCfg.cmdPercent = strtoul(optarg, NULL, 0);
+        break;
+      case 'q':
+        gCfg.queueLen = (uint16_t)strtoul(optarg, NULL, 0);
+        break;
+      case 't':
+        gCfg.durationMs = strtoul(optarg, NULL, 0) * 1000UL;
+        break;
+      case 's':
+        gCfg.seed = strtoul(optarg, NULL, 0);
+        break;
+      case 'b':
+        iterations = strtoul(optarg, NULL, 0);
+        break;
+      default:
+        loc_usage(argv[0]);
+        return 1;
+    }
+  }
+
+  if(0 == cells.first || cells.last > APP_MAX_DEVICE_SLOTS)
+  {
+    printf("cells must be between 1 and %u\n", APP_MAX_DEVICE_SLOTS);
+    return 1;
+  }
+  if(loss.last > 100 || gCfg.cmdPercent > 100)
+  {
+    printf("percentages must be between 0 and 100\n");
+    return 1;
+  }
+  if(0 == period.first)
+  {
+    printf("the measurement period must be at least 1 ms\n");
+    return 1;
+  }
+  if(0 == gCfg.queueLen || gCfg.queueLen > SIM_QUEUE_MAX)
+  {
+    printf("queue length must be between 1 and %u\n", SIM_QUEUE_MAX);
+    return 1;
+  }
+  if(0 == iterations)
+  {
+    iterations = 1;
+  }
+
+  configs = loc_rangeCount(&cells) * loc_rangeCount(&loss) * loc_rangeCount(&period);
+  if(1 == configs)
+  {
+    gCfg.cells = cells.first;
+    gCfg.lossPercent = loss.first;
+    gCfg.periodMs = period.first;
+    if(0 != loc_printLayout(gCfg.cells, iterations) || 0 != loc_simulate())
+    {
+      return 1;
+    }
+    loc_printCells();
+    return 0;
+  }
+
+  /* One CSV line per configuration */
+  loc_printCsvHeader();
+  startNs = loc_nowNs();
+  for(uint32_t n = cells.first; n <= cells.last; n += cells.step)
+  {
+    for(uint32_t l = loss.first; l <= loss.last; l += loss.step)
+    {
+      for(uint32_t p = period.first; p <= period.last; p += period.step)
+      {
+        gCfg.cells = n;
+        gCfg.lossPercent = l;
+        gCfg.periodMs = p;
+        if(0 != loc_simulate())
+        {
+          return 1;
+        }
+        loc_printCsv();
+        done++;
+      }
+    }
+  }
+  fprintf(stderr, "%u configurations in %.1f s\n", done,
+          (loc_nowNs() - startNs) / 1e9);
+
+  return 0;
+}/* main() */
@@ -0,0 +1,347 @@
+/**
+ * @code
+ *  ___ _____ _   ___ _  _____ ___  ___  ___ ___
+ * / __|_   _/_\ / __| |/ / __/ _ \| _ \/ __| __|
+ * \__ \ | |/ _ \ (__| ' <| _| (_) |   / (__| _|
+ * |___/ |_/_/ \_\___|_|\_\_| \___/|_|_\\___|___|
+ * embedded.connectivity.solutions.==============
+ * @endcode
+ *
+ * @copyright  STACKFORCE GmbH, Germany, www.stackforce.de
+ * @author     STACKFORCE
+ * @brief      Generator of the static schedule table.
+ *
+ * Builds the schedule of the coordinator on the host with sf-tsch-schedule.c
+ * and the schedule engine of the configuration, one group of links at a time
+ * (beacon, broadcast, retry and join request slots, then the RX and TX slots
+ * of the device ids below APP_MAX_DEVICE_SLOTS), and prints the links sorted
+ * by timeslot as the C source of the table of sf-tsch-schedule-table.h. The
+ * table carries a check of the slotframe configuration it was generated for.
+ * The TSCH runtime is replaced by stubs.
+ *
+ * Called by the Makefile of the application with make APP_SLOTFRAME_STATIC=1,
+ * or by hand from the repository root with the defines of the build:
+ *   gcc -DCONTIKI=1 -DCONTIKI_TARGET_NATIVE=1 \
+ *     -DSF_BMSCC_VERSION_MAJOR=1 -DSF_BMSCC_VERSION_MINOR=0 \
+ *     -DSF_BMSCC_VERSION_PATCH=2 \
+ *     -DPROJECT_CONF_PATH=\"project-conf.h\" -DMAC_CONF_WITH_TSCH=1 \
+ *     -DNETSTACK_CONF_WITH_NULLNET=1 -DROUTING_CONF_NULLROUTING=1 \
+ *     -Iapp/app-bmscc -I. \
+ *     -Imodules/sf-tsch -Imodules/sf-join -Imodules/common \
+ *     -Imodules/sf-rf-regions \
+ *     -Imodules/thirdparty/sf-contiki-ng/arch/platform/native \
+ *     -Imodules/thirdparty/sf-contiki-ng/arch/cpu/native \
+ *     -Imodules/thirdparty/sf-contiki-ng/arch/cpu/native/dev \
+ *     -Imodules/thirdparty/sf-contiki-ng/os \
+ *     -Imodules/thirdparty/sf-contiki-ng/os/sys \
+ *     -Imodules/thirdparty/sf-contiki-ng/os/dev \
+ *     -Imodules/thirdparty/sf-contiki-ng/os/net \
+ *     -Imodules/thirdparty/sf-contiki-ng/os/net/mac/tsch \
+ *     -o schedule-table-gen tools/schedule-table-gen.c
+ *   ./schedule-table-gen > sf-tsch-schedule-table.c
+ */
+
+/*==============================================================================
+                            INCLUDES
+==============================================================================*/
+#include <stdarg.h>
+
+/* The links are taken from the schedule built with the link pool */
+#define APP_SLOTFRAME_STATIC  0
+
+/* The schedule logs every link, the generator prints only the table */
+static int loc_noLog(const char *fmt, ...)
+{
+  (void)fmt;
+  return 0;
+}
+#define LOG_CONF_OUTPUT       loc_noLog
+
+#include "lib/list.c"
+#include "lib/memb.c"
+#include "lib/ringbufindex.c"
+#include "net/linkaddr.c"
+#include "net/mac/tsch/tsch-schedule.c"
+#include "sf-tsch-schedule-engine.c"
+#undef LOG_MODULE
+#undef LOG_LEVEL
+#include "sf-tsch-schedule.c"
+#include "sf-tsch-schedule-table.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/*==============================================================================
+                            TSCH STUBS
+==============================================================================*/
+const linkaddr_t tsch_broadcast_address = { { 0xff, 0xff } };
+struct tsch_asn_t tsch_current_asn;
+int tsch_is_associated;
+struct tsch_link *current_link;
+tsch_timeslot_timing_usec tsch_timing_us;
+int curr_log_level_mac = LOG_LEVEL_NONE;
+
+int tsch_get_lock(void) { return 1; }
+void tsch_release_lock(void) { }
+int tsch_is_locked(void) { return 0; }
+struct tsch_neighbor *tsch_queue_add_nbr(const linkaddr_t *addr) { return NULL; }
+struct tsch_neighbor *tsch_queue_get_nbr(const linkaddr_t *addr) { return NULL; }
+void log_lladdr(const linkaddr_t *lladdr) { }
+void watchdog_periodic(void) { }
+void ctimer_set(struct ctimer *c, clock_time_t t, void (*f)(void *), void *ptr) { }
+void ctimer_stop(struct ctimer *c) { }
+void tsch_set_schedule_desc(const struct tsch_schedule_desc *desc) { }
+
+/*==============================================================================
+                            VARIABLES
+==============================================================================*/
+/* Links of the table in the order they were added, and their group */
+static struct tsch_link gLinks[SF_TSCH_SCHEDULE_TABLE_MAX_LINKS];
+static uint16_t gLinkGroup[SF_TSCH_SCHEDULE_TABLE_MAX_LINKS];
+static uint16_t gLinkCnt;
+/* Links sorted by timeslot and channel offset, and the table index of each
+   added link */
+static uint16_t gSorted[SF_TSCH_SCHEDULE_TABLE_MAX_LINKS];
+static uint16_t gTableIndex[SF_TSCH_SCHEDULE_TABLE_MAX_LINKS];
+
+/*==============================================================================
+                            LOCAL FUNCTIONS
+==============================================================================*/
+/* Address of the device with the device id, see get_devid() */
+static linkaddr_t loc_deviceAddr(uint16_t devid)
+{
+  linkaddr_t addr = linkaddr_null;
+
+#if LINKADDR_SIZE == 2
+  addr.u16 = devid + 1;
+#else
+  addr.u16[0] = devid + 1;
+#endif
+  return addr;
+}/* loc_deviceAddr() */
+
+/* Takes the links added to the slotframe since the last call as a group */
+static int loc_takeLinks(struct tsch_slotframe *pSf, uint16_t group,
+                         uint16_t *pSeen)
+{
+  struct tsch_link *pLink = list_head(pSf->links_list);
+  uint16_t n = 0;
+
+  /* New links are appended to the list */
+  for(; NULL != pLink; pLink = list_item_next(pLink), n++)
+  {
+    if(n < *pSeen)
+    {
+      continue;
+    }
+    if(gLinkCnt >= SF_TSCH_SCHEDULE_TABLE_MAX_LINKS)
+    {
+      fprintf(stderr, "more than %u links\n", SF_TSCH_SCHEDULE_TABLE_MAX_LINKS);
+      return 0;
+    }
+    gLinks[gLinkCnt] = *pLink;
+    gLinkGroup[gLinkCnt] = group;
+    gLinkCnt++;
+  }
+  *pSeen = n;
+  return 1;
+}/* loc_takeLinks() */
+
+/* Orders by timeslot, then channel offset, then the order of adding */
+static int loc_compare(const void *pA, const void *pB)
+{
+  const struct tsch_link *pLinkA = &gLinks[*(const uint16_t *)pA];
+  const struct tsch_link *pLinkB = &gLinks[*(const uint16_t *)pB];
+
+  if(pLinkA->timeslot != pLinkB->timeslot)
+  {
+    return (pLinkA->timeslot < pLinkB->timeslot) ? -1 : 1;
+  }
+  if(pLinkA->channel_offset != pLinkB->channel_offset)
+  {
+    return (pLinkA->channel_offset < pLinkB->channel_offset) ? -1 : 1;
+  }
+  return (*(const uint16_t *)pA < *(const uint16_t *)pB) ? -1 : 1;
+}/* loc_compare() */
+
+static const char *loc_linkType(enum link_type type)
+{
+  switch(type)
+  {
+    case LINK_TYPE_NORMAL_RTX:
+      return "LINK_TYPE_NORMAL_RTX";
+    case LINK_TYPE_ADVERTISING:
+      return "LINK_TYPE_ADVERTISING";
+    case LINK_TYPE_ADVERTISING_ONLY:
+      return "LINK_TYPE_ADVERTISING_ONLY";
+    default:
+      return "LINK_TYPE_NORMAL";
+  }
+}/* loc_linkType() */
+
+static void loc_printLinkOptions(uint8_t options)
+{
+  static const struct
+  {
+    uint8_t option;
+    const char *pName;
+  } names[] = {
+    { LINK_OPTION_TX, "LINK_OPTION_TX" },
+    { LINK_OPTION_RX, "LINK_OPTION_RX" },
+    { LINK_OPTION_SHARED, "LINK_OPTION_SHARED" },
+    { LINK_OPTION_TIME_KEEPING, "LINK_OPTION_TIME_KEEPING" },
+  };
+  const char *pSep = "";
+
+  for(size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++)
+  {
+    if(options & names[i].option)
+    {
+      printf("%s%s", pSep, names[i].pName);
+      pSep = " | ";
+    }
+  }
+  if('\0' == *pSep)
+  {
+    printf("0");
+  }
+}/* loc_printLinkOptions() */
+
+/* Prints a check of a configuration value the table depends on */
+#define GEN_PRINT_CHECK(name) \
+  printf("#if (%s) != %ld\n#error \"The schedule table was generated for %s %ld\"\n#endif\n", \
+         #name, (long)(name), #name, (long)(name))
+
+static void loc_printTable(void)
+{
+  uint16_t i;
+  uint16_t group;
+  const struct tsch_link *pLink;
+
+  printf("/* Generated by tools/schedule-table-gen.c, do not edit */\n\n");
+  printf("#include \"sf-tsch-schedule-table.h\"\n\n");
+  printf("/* The slotframe configuration of the table */\n");
+  GEN_PRINT_CHECK(SCHEDULE_A);
+  GEN_PRINT_CHECK(SCHEDULE_B);
+  GEN_PRINT_CHECK(SCHEDULE_C);
+  GEN_PRINT_CHECK(APP_SLOTFRAME_HANDLE);
+  GEN_PRINT_CHECK(APP_SLOTFRAME_SIZE);
+  GEN_PRINT_CHECK(APP_SLOTFRAME_SECTION_NUM);
+  GEN_PRINT_CHECK(APP_SLOTFRAME_SECTION_SIZE);
+  GEN_PRINT_CHECK(APP_SLOTFRAME_SECTION_BEACON_SLOTS);
+  GEN_PRINT_CHECK(APP_SLOTFRAME_SECTION_JOIN_REQUEST_SLOTS);
+  GEN_PRINT_CHECK(APP_SLOTFRAME_SECTION_JOIN_PROCESS_SLOTS);
+  GEN_PRINT_CHECK(APP_SLOTFRAME_SECTION_DEVICE_TX_SLOTS);
+  GEN_PRINT_CHECK(APP_SLOTFRAME_SECTION_DEVICE_RX_SLOTS);
+  GEN_PRINT_CHECK(APP_SLOTFRAME_SECTION_BROADCAST_SLOTS);
+  GEN_PRINT_CHECK(APP_SLOTFRAME_SECTION_RETRY_SLOTS);
+  GEN_PRINT_CHECK(APP_SLOTFRAME_DEDICATED_RETRY_SLOT);
+  GEN_PRINT_CHECK(APP_SLOTFRAME_CHANNEL_OFFSETS);
+  GEN_PRINT_CHECK(APP_MAX_DEVICE_SLOTS);
+  GEN_PRINT_CHECK(LINKADDR_SIZE);
+
+  printf("\nconst struct tsch_link sf_tsch_schedule_table_links[] =\n{\n");
+  for(i = 0; i < gLinkCnt; i++)
+  {
+    pLink = &gLinks[gSorted[i]];
+    printf("  { .handle = SF_TSCH_SCHEDULE_TABLE_HANDLE + %u, .addr = { .u8 = { ", i);
+    for(uint8_t b = 0; b < LINKADDR_SIZE; b++)
+    {
+      printf("%s0x%02x", (b > 0) ? ", " : "", pLink->addr.u8[b]);
+    }
+    printf(" } },\n    .slotframe_handle = %u, .timeslot = %u, .channel_offset = %u,\n",
+           pLink->slotframe_handle, pLink->timeslot, pLink->channel_offset);
+    printf("    .link_options = ");
+    loc_printLinkOptions(pLink->link_options);
+    printf(", .link_type = %s,\n", loc_linkType(pLink->link_type));
+    printf("    .slot_next = TSCH_LINK_INDEX_NONE },\n");
+  }
+  printf("};\n\n");
+  printf("const uint16_t sf_tsch_schedule_table_links_count = %u;\n\n", gLinkCnt);
+
+  /* The links were added group by group */
+  printf("const uint16_t sf_tsch_schedule_table_group_first[SF_TSCH_SCHEDULE_TABLE_GROUPS + 1] =\n{");
+  i = 0;
+  for(group = 0; group <= SF_TSCH_SCHEDULE_TABLE_GROUPS; group++)
+  {
+    while((i < gLinkCnt) && (gLinkGroup[i] < group))
+    {
+      i++;
+    }
+    printf("%s%u,", (0 == group % 16) ? "\n  " : " ", i);
+  }
+  printf("\n};\n\n");
+
+  printf("const uint16_t sf_tsch_schedule_table_group_links[] =\n{");
+  for(i = 0; i < gLinkCnt; i++)
+  {
+    printf("%s%u,", (0 == i % 16) ? "\n  " : " ", gTableIndex[i]);
+  }
+  printf("\n};\n");
+}/* loc_printTable() */
+
+/*==============================================================================
+                            MAIN
+==============================================================================*/
+int main(void)
+{
+  struct tsch_slotframe *pSf;
+  uint16_t seen = 0;
+  linkaddr_t addr;
+  int ok;
+
+  tsch_schedule_init();
+  if(0 != sf_tsch_schedule_init())
+  {
+    fprintf(stderr, "schedule not initialized\n");
+    return 1;
+  }
+  pSf = tsch_schedule_get_slotframe_by_handle(APP_SLOTFRAME_HANDLE);
+
+  ok = (0 == sf_tsch_schedule_add_beacon_slots()) &&
+       loc_takeLinks(pSf, SF_TSCH_SCHEDULE_TABLE_BEACON, &seen) &&
+       (0 == sf_tsch_schedule_add_broadcast_slots()) &&
+       loc_takeLinks(pSf, SF_TSCH_SCHEDULE_TABLE_BROADCAST, &seen) &&
+       (0 == sf_tsch_schedule_add_retry_slots()) &&
+       loc_takeLinks(pSf, SF_TSCH_SCHEDULE_TABLE_RETRY, &seen) &&
+       (0 == sf_tsch_schedule_add_jreq_slots()) &&
+       loc_takeLinks(pSf, SF_TSCH_SCHEDULE_TABLE_JREQ, &seen);
+
+  /* One device at a time, so the link pool holds the links */
+  for(uint16_t devid = 0; ok && (devid < APP_MAX_DEVICE_SLOTS); devid++)
+  {
+    addr = loc_deviceAddr(devid);
+    ok = (0 == sf_tsch_schedule_add_data_slots(&addr, E_SF_TSCH_SCHEDULE_DATA_SLOTS_RX)) &&
+         loc_takeLinks(pSf, SF_TSCH_SCHEDULE_TABLE_DEVICE_RX(devid), &seen) &&
+         (0 == sf_tsch_schedule_add_data_slots(&addr, E_SF_TSCH_SCHEDULE_DATA_SLOTS_TX)) &&
+         loc_takeLinks(pSf, SF_TSCH_SCHEDULE_TABLE_DEVICE_TX(devid), &seen) &&
+         (0 == sf_tsch_schedule_delete_data_slots(&addr, E_SF_TSCH_SCHEDULE_DATA_SLOTS_ALL));
+    seen -= DATA_LINKS_PER_DEVICE;
+  }
+  if(!ok)
+  {
+    fprintf(stderr, "schedule not built\n");
+    return 1;
+  }
+
+  for(uint16_t i = 0; i < gLinkCnt; i++)
+  {
+    gSorted[i] = i;
+  }
+  qsort(gSorted, gLinkCnt, sizeof(gSorted[0]), loc_compare);
+  for(uint16_t i = 0; i < gLinkCnt; i++)
+  {
+    gTableIndex[gSorted[i]] = i;
+    /* A link replaced by a later group would be in the table twice */
+    if((i > 0) && (gLinks[gSorted[i]].timeslot == gLinks[gSorted[i - 1]].timeslot) &&
+       (gLinks[gSorted[i]].channel_offset == gLinks[gSorted[i - 1]].channel_offset))
+    {
+      fprintf(stderr, "two links at timeslot %u channel offset %u\n",
+              gLinks[gSorted[i]].timeslot, gLinks[gSorted[i]].channel_offset);
+      return 1;
+    }
+  }
+
+  loc_printTable();
+  return 0;
+}/* main() */